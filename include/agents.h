@@ -0,0 +1,227 @@
+/**
+ * @brief It defines the store of the simulated ants
+ *
+ * Ants that only take part in the simulation do not need a name, a graphic
+ * description or a message, so instead of a Character each one is a
+ * position in parallel arrays of ids, locations, health, friendliness and
+ * leaders. The bulk updates walk one or two of those arrays with simple
+ * loops without branches, that the compiler can vectorize (build with
+ * OPT=-O3). Named characters keep using the Character module.
+ *
+ * @file agents.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef AGENTS_H
+#define AGENTS_H
+
+#include "types.h"
+
+/**
+ * @brief Store of simulated ants
+ *
+ * This struct stores every field of the ants in its own array
+ */
+typedef struct _Agents Agents;
+
+/**
+ * @brief It creates an empty store
+ *
+ * @return A new store, NULL if there was an error
+ */
+Agents *agents_create();
+
+/**
+ * @brief It frees a store
+ *
+ * @param agents A pointer to the store
+ */
+void agents_destroy(Agents *agents);
+
+/**
+ * @brief It makes room for a number of ants without more allocations
+ *
+ * @param agents A pointer to the store
+ * @param n The number of ants
+ * @return OK if there is room, ERROR otherwise
+ */
+Status agents_reserve(Agents *agents, int n);
+
+/**
+ * @brief It adds an ant that follows nobody
+ *
+ * Ids are stored in 32 bits, so the ids of the ants and their spaces must
+ * fit in an int.
+ *
+ * @param agents A pointer to the store
+ * @param id The id of the ant
+ * @param location The id of its space
+ * @param health Its health points
+ * @param friendly TRUE if it is friendly
+ * @return The position of the ant, -1 if there was an error
+ */
+int agents_add(Agents *agents, Id id, Id location, int health, Bool friendly);
+
+/**
+ * @brief It gets the number of ants
+ *
+ * @param agents A pointer to the store
+ * @return The number of ants, -1 if there was an error
+ */
+int agents_get_count(Agents *agents);
+
+/**
+ * @brief It finds an ant by id
+ *
+ * @param agents A pointer to the store
+ * @param id The id of the ant
+ * @return The position of the ant, -1 if it is not in the store
+ */
+int agents_find(Agents *agents, Id id);
+
+/**
+ * @brief It gets the id of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @return The id, NO_ID if there was an error
+ */
+Id agents_get_id(Agents *agents, int position);
+
+/**
+ * @brief It gets the location of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @return The id of its space, NO_ID if there was an error
+ */
+Id agents_get_location(Agents *agents, int position);
+
+/**
+ * @brief It sets the location of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @param location The id of its space
+ * @return OK if it was set, ERROR otherwise
+ */
+Status agents_set_location(Agents *agents, int position, Id location);
+
+/**
+ * @brief It gets the health of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @return The health points, 0 if there was an error
+ */
+int agents_get_health(Agents *agents, int position);
+
+/**
+ * @brief It sets the health of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @param health The health points
+ * @return OK if it was set, ERROR otherwise
+ */
+Status agents_set_health(Agents *agents, int position, int health);
+
+/**
+ * @brief It tells whether an ant is friendly
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @return TRUE if it is friendly, FALSE if it is not or there was an error
+ */
+Bool agents_get_friendly(Agents *agents, int position);
+
+/**
+ * @brief It gets the leader of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @return The id of the leader, NO_ID if it follows nobody or there was an error
+ */
+Id agents_get_following(Agents *agents, int position);
+
+/**
+ * @brief It sets the leader of an ant
+ *
+ * @param agents A pointer to the store
+ * @param position The position of the ant
+ * @param following The id of the leader, NO_ID to follow nobody
+ * @return OK if it was set, ERROR otherwise
+ */
+Status agents_set_following(Agents *agents, int position, Id following);
+
+/**
+ * @brief It counts the ants in a space
+ *
+ * @param agents A pointer to the store
+ * @param location The id of the space
+ * @return The number of ants, -1 if there was an error
+ */
+int agents_count_at(Agents *agents, Id location);
+
+/**
+ * @brief It moves every ant of a space to another one
+ *
+ * @param agents A pointer to the store
+ * @param from The id of the space they leave
+ * @param to The id of the space they go to
+ * @return The number of ants moved, -1 if there was an error
+ */
+int agents_move(Agents *agents, Id from, Id to);
+
+/**
+ * @brief It moves the ants that follow a leader to the space of the leader
+ *
+ * @param agents A pointer to the store
+ * @param leader The id of the leader
+ * @param location The id of the space of the leader
+ * @return The number of ants moved, -1 if there was an error
+ */
+int agents_follow(Agents *agents, Id leader, Id location);
+
+/**
+ * @brief It makes the friendly ants of a space that follow nobody follow a leader
+ *
+ * @param agents A pointer to the store
+ * @param leader The id of the leader
+ * @param location The id of the space of the leader
+ * @return The number of ants recruited, -1 if there was an error
+ */
+int agents_recruit(Agents *agents, Id leader, Id location);
+
+/**
+ * @brief It makes every ant that follows a leader follow nobody
+ *
+ * @param agents A pointer to the store
+ * @param leader The id of the leader
+ * @return The number of ants left, -1 if there was an error
+ */
+int agents_abandon(Agents *agents, Id leader);
+
+/**
+ * @brief It hurts the hostile ants of a space
+ *
+ * @param agents A pointer to the store
+ * @param location The id of the space
+ * @param damage The health points each one loses
+ * @return The number of ants hurt, -1 if there was an error
+ */
+int agents_damage(Agents *agents, Id location, int damage);
+
+/**
+ * @brief It removes the ants without health, keeping the order of the rest
+ *
+ * Positions change, so positions kept from before are not valid any more.
+ *
+ * @param agents A pointer to the store
+ * @return The number of ants removed, -1 if there was an error
+ */
+int agents_remove_dead(Agents *agents);
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @brief It defines the saves of a game in the background
+ *
+ * Writing a big world to disk would stop the game for as long as it takes.
+ * Instead, the process forks: the child has a copy-on-write view of the
+ * game as it was, writes a snapshot of it (see snapshot_write) and its
+ * undo ring (see game_write_undo) to a temporary file and renames it over
+ * the save, while the parent keeps playing. The game only waits for the
+ * fork itself, which is measured.
+ * The saves before the last one are kept as <file>.1, <file>.2... up to
+ * the number of files to keep. Only one save runs at a time, a save that
+ * is due while another is running waits for the next tick.
+ *
+ * @file autosave.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Files kept by default, the last save and the ones before it
+ */
+#define AUTOSAVE_KEEP 3
+
+/**
+ * @brief Saver of a game in the background
+ *
+ * This struct stores when the game is saved, where, and the save running
+ */
+typedef struct _Autosave Autosave;
+
+/**
+ * @brief It creates a saver
+ *
+ * @param path The name of the save file
+ * @param every_turns Turns between saves, 0 not to save by turns
+ * @param every_seconds Seconds between saves, 0 not to save by time
+ * @param keep The number of files kept, at least 1
+ * @return A new saver, NULL if there was an error
+ */
+Autosave *autosave_create(const char *path, int every_turns, long every_seconds, int keep);
+
+/**
+ * @brief It frees a saver, waiting for the save running
+ *
+ * @param autosave A pointer to the saver
+ */
+void autosave_destroy(Autosave *autosave);
+
+/**
+ * @brief It counts a turn and saves the game in the background if it is due
+ *
+ * @param autosave A pointer to the saver
+ * @param game A pointer to the game
+ * @param mark A number kept with the save, such as the turns played
+ * @return OK if no save was due or one was started, ERROR otherwise
+ */
+Status autosave_tick(Autosave *autosave, Game *game, long mark);
+
+/**
+ * @brief It saves the game in the background now
+ *
+ * Paged games are not supported, because snapshots do not support them.
+ *
+ * @param autosave A pointer to the saver
+ * @param game A pointer to the game
+ * @param mark A number kept with the save, such as the turns played
+ * @return OK if the save was started, ERROR if there was an error or another save is running
+ */
+Status autosave_start(Autosave *autosave, Game *game, long mark);
+
+/**
+ * @brief It waits for the save running, if any
+ *
+ * @param autosave A pointer to the saver
+ * @return OK if there was no save running or it was written, ERROR otherwise
+ */
+Status autosave_wait(Autosave *autosave);
+
+/**
+ * @brief It gets the number of saves written
+ *
+ * @param autosave A pointer to the saver
+ * @return The number of saves, -1 if there was an error
+ */
+int autosave_get_n_saves(Autosave *autosave);
+
+/**
+ * @brief It gets the number of saves that failed
+ *
+ * @param autosave A pointer to the saver
+ * @return The number of saves, -1 if there was an error
+ */
+int autosave_get_n_failed(Autosave *autosave);
+
+/**
+ * @brief It gets the longest time the game waited for a save to start
+ *
+ * @param autosave A pointer to the saver
+ * @return The time in nanoseconds, 0 if there was an error or no save
+ */
+unsigned long autosave_get_max_pause(Autosave *autosave);
+
+/**
+ * @brief It gets the mark of the last save written
+ *
+ * @param autosave A pointer to the saver
+ * @return The mark given when it started, -1 if there was an error or no save was written
+ */
+long autosave_get_last_mark(Autosave *autosave);
+
+/**
+ * @brief It gets the name of a save file
+ *
+ * @param autosave A pointer to the saver
+ * @param age 0 for the last save, 1 for the one before it...
+ * @return The name, valid until the next call, NULL if there was an error or that save is not kept
+ */
+const char *autosave_get_file(Autosave *autosave, int age);
+
+#endif
@@ -167,6 +167,25 @@ Id character_get_following(Character *character);
  */
 Status character_set_following(Character *character, Id following);
 
+/**
+ * @brief Gets the next character of the party the character is in
+ *
+ * The party of a player is a list threaded through its followers, see player_get_followers.
+ *
+ * @param character A pointer to the character
+ * @return The next follower, NULL if it is the last one or there was an error
+ */
+Character *character_get_next_follower(Character *character);
+
+/**
+ * @brief Sets the next character of the party the character is in
+ *
+ * @param character A pointer to the character
+ * @param next The next follower, NULL if it is the last one
+ * @return OK if successful, ERROR if there was a problem
+ */
+Status character_set_next_follower(Character *character, Character *next);
+
 /**
  * @brief Prints the character information
  * @author Izan Robles
@@ -0,0 +1,96 @@
+/**
+ * @brief It defines the resolution of the fights between a player and its enemies
+ *
+ * A fight is resolved on a compact table of combatants, with no game, no
+ * characters and no messages, so the same code serves the attack command
+ * and the balancing tool that runs millions of fights. In every round each
+ * living enemy, in order, trades one blow with the player: a coin decides
+ * whether the player hits the enemy or the enemy hits the player. Health
+ * never goes below 0 and dead combatants give no more blows. The coins come
+ * from a xorshift generator whose state belongs to the caller, so fights
+ * with the same seed have the same result and threads do not share it.
+ *
+ * @file combat.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef COMBAT_H
+#define COMBAT_H
+
+#include "types.h"
+
+/**
+ * @brief Health taken by each blow in the game
+ */
+#define COMBAT_DAMAGE 10
+
+/**
+ * @brief Rounds of a fight before it is given up as a draw
+ */
+#define COMBAT_MAX_ROUNDS 1000
+
+/**
+ * @brief A side of a fight
+ */
+typedef struct
+{
+	int health; /*!< Health left */
+	int damage; /*!< Health taken by each of its blows */
+} Combatant;
+
+/**
+ * @brief Who was hit by the blow of an enemy
+ */
+typedef enum
+{
+	COMBAT_NO_HIT,	  /*!< The enemy or the player was already dead */
+	COMBAT_ENEMY_HIT, /*!< The player hit the enemy */
+	COMBAT_PLAYER_HIT /*!< The enemy hit the player */
+} CombatHit;
+
+/**
+ * @brief The blow traded by an enemy in a round
+ */
+typedef struct
+{
+	CombatHit hit; /*!< Who was hit */
+	int health;	   /*!< Health left to the one hit, just after the blow */
+} CombatBlow;
+
+/**
+ * @brief The result of a whole fight
+ */
+typedef struct
+{
+	Bool won;	/*!< Whether every enemy died and the player did not */
+	int rounds; /*!< Rounds fought */
+	int damage; /*!< Health lost by the player */
+} CombatOutcome;
+
+/**
+ * @brief It resolves a round of a fight
+ *
+ * @param player A pointer to the player, its health is updated
+ * @param enemies The enemies, their health is updated
+ * @param n_enemies The number of enemies
+ * @param rng A pointer to the state of the generator, 0 is taken as 1
+ * @param blows Where the blow of each enemy is stored, it can be NULL
+ * @return The number of enemies alive after the round, -1 if there was an error
+ */
+int combat_round(Combatant *player, Combatant *enemies, int n_enemies, unsigned long *rng, CombatBlow *blows);
+
+/**
+ * @brief It resolves rounds until the player or every enemy is dead
+ *
+ * @param player A pointer to the player, its health is updated
+ * @param enemies The enemies, their health is updated
+ * @param n_enemies The number of enemies
+ * @param rng A pointer to the state of the generator, 0 is taken as 1
+ * @param outcome Where the result is stored
+ * @return OK if the fight was resolved, ERROR otherwise
+ */
+Status combat_encounter(Combatant *player, Combatant *enemies, int n_enemies, unsigned long *rng, CombatOutcome *outcome);
+
+#endif
@@ -25,7 +25,7 @@
  /**
   * @brief Number of available commands.
   */
- #define N_CMD 11
+ #define N_CMD 13
  
  /**
   * @brief Command type enumeration.
@@ -54,7 +54,9 @@
      MOVE,         /**< Move command. */
      INSPECT,       /**< Inspect command. */
      RECRUIT,      /**< Recruit command. */
-     ABANDON       /**< Abandon command. */
+     ABANDON,      /**< Abandon command. */
+     STATS,        /**< Stats command. */
+     UNDO          /**< Undo command. */
  } CommandCode;
  
  /**
@@ -111,6 +113,16 @@
   */
  Status command_get_user_input(Command* command);
 
+ /**
+  * @brief Parses a line of user input and sets the corresponding command code and argument.
+  *
+  * The line is tokenized in place, so its contents are modified.
+  * @param command A pointer to the command.
+  * @param input The line to parse.
+  * @return OK if the line was successfully processed, ERROR otherwise.
+  */
+ Status command_parse_input(Command* command, char* input);
+
  /**
   * @brief Gets the argument from a given command.
   * @author Izan Robles
@@ -0,0 +1,183 @@
+/**
+ * @brief It defines the bus of the events of the game
+ *
+ * The actions of the game publish what they change as typed events, and
+ * the events of a turn wait in a buffer until the loop dispatches them.
+ * Each subscriber then gets the whole batch once, instead of polling the
+ * world for changes. Events of a type nobody subscribed to are not kept.
+ *
+ * @file events.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include "types.h"
+
+/**
+ * @brief Maximum number of subscribers of a bus
+ */
+#define EVENT_MAX_SUBSCRIBERS 8
+
+/**
+ * @brief Types of event, and what the fields of the event hold for each one
+ */
+typedef enum
+{
+	EVENT_PLAYER_MOVED,		   /*!< subject: player, from and to: spaces */
+	EVENT_OBJECT_TAKEN,		   /*!< subject: object, from: space, to: player */
+	EVENT_OBJECT_DROPPED,	   /*!< subject: object, from: player, to: space */
+	EVENT_HEALTH_CHANGED,	   /*!< subject: player or character, from: its space, value: new health */
+	EVENT_CHARACTER_RECRUITED, /*!< subject: character, to: player it follows */
+	EVENT_CHARACTER_ABANDONED, /*!< subject: character, from: player it followed */
+	EVENT_CHARACTER_MOVED,	   /*!< subject: character, from and to: spaces */
+	EVENT_LINK_OPENED,		   /*!< subject: link, from and to: spaces, value: direction */
+	EVENT_LINK_CLOSED,		   /*!< subject: link, from and to: spaces, value: direction */
+	EVENT_TYPES				   /*!< Number of types */
+} EventType;
+
+/**
+ * @brief Bit of a type of event in the mask of a subscriber
+ */
+#define EVENT_MASK(type) (1UL << (type))
+
+/**
+ * @brief Mask with every type of event
+ */
+#define EVENT_ALL (EVENT_MASK(EVENT_TYPES) - 1)
+
+/**
+ * @brief An event
+ */
+typedef struct
+{
+	EventType type; /*!< Type of the event */
+	int turn;		/*!< Position of the player whose turn it was */
+	Id subject;		/*!< What changed */
+	Id from;		/*!< Where or whom it comes from, NO_ID if it does not apply */
+	Id to;			/*!< Where or whom it goes to, NO_ID if it does not apply */
+	int value;		/*!< A number that depends on the type, 0 if it does not apply */
+} Event;
+
+/**
+ * @brief Function that receives the events of a turn
+ *
+ * The batch has every event of the turn, also those of other types, in the
+ * order they were published.
+ *
+ * @param events The events
+ * @param n_events The number of events
+ * @param data The data given when subscribing
+ */
+typedef void (*EventHandler)(const Event *events, int n_events, void *data);
+
+/**
+ * @brief Bus of events
+ *
+ * This struct stores the subscribers and the events of the current turn
+ */
+typedef struct _EventBus EventBus;
+
+/**
+ * @brief It creates a bus without subscribers
+ *
+ * @return A new bus, NULL if there was an error
+ */
+EventBus *event_bus_create();
+
+/**
+ * @brief It frees a bus and the events it holds
+ *
+ * @param bus A pointer to the bus
+ */
+void event_bus_destroy(EventBus *bus);
+
+/**
+ * @brief It adds a subscriber
+ *
+ * @param bus A pointer to the bus
+ * @param mask The types of event it wants, built with EVENT_MASK
+ * @param handler The function that receives the events
+ * @param data Data given to the function, it can be NULL
+ * @return OK if it was added, ERROR otherwise
+ */
+Status event_bus_subscribe(EventBus *bus, unsigned long mask, EventHandler handler, void *data);
+
+/**
+ * @brief It tells whether some subscriber wants a type of event
+ *
+ * @param bus A pointer to the bus
+ * @param type The type of event
+ * @return TRUE if it is wanted, FALSE otherwise
+ */
+Bool event_bus_wants(EventBus *bus, EventType type);
+
+/**
+ * @brief It adds an event to the batch of the turn
+ *
+ * @param bus A pointer to the bus
+ * @param event The event, which is copied
+ * @return OK if it was added or nobody wants it, ERROR otherwise
+ */
+Status event_bus_publish(EventBus *bus, const Event *event);
+
+/**
+ * @brief It gets the number of events waiting in the batch
+ *
+ * @param bus A pointer to the bus
+ * @return The number of events, -1 if there was an error
+ */
+int event_bus_get_count(EventBus *bus);
+
+/**
+ * @brief It gets an event waiting in the batch
+ *
+ * @param bus A pointer to the bus
+ * @param position The position of the event
+ * @return The event, NULL if there was an error
+ */
+const Event *event_bus_get_event(EventBus *bus, int position);
+
+/**
+ * @brief It gives the batch to the subscribers and empties it
+ *
+ * A subscriber is only called when the batch has a type it wants. Events
+ * published by the subscribers go to the next batch.
+ *
+ * @param bus A pointer to the bus
+ * @return The number of events dispatched, -1 if there was an error
+ */
+int event_bus_dispatch(EventBus *bus);
+
+/**
+ * @brief It creates a bus without subscribers that keeps the same types as another one
+ *
+ * Shadows of a game publish into their own fork, so threads do not share a
+ * batch, and the forks are joined in order afterwards.
+ *
+ * @param bus A pointer to the bus
+ * @return A new bus, NULL if there was an error
+ */
+EventBus *event_bus_fork(EventBus *bus);
+
+/**
+ * @brief It moves the events of a fork to the end of the batch of a bus and frees the fork
+ *
+ * @param bus A pointer to the bus
+ * @param child A pointer to the fork, freed by this call
+ * @return OK if every event was moved, ERROR otherwise
+ */
+Status event_bus_join(EventBus *bus, EventBus *child);
+
+/**
+ * @brief It gets the name of a type of event
+ *
+ * @param type The type of event
+ * @return The name, "?" if the type is not valid
+ */
+const char *event_type_name(EventType type);
+
+#endif
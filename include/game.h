@@ -11,6 +11,8 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <stdio.h>
+
 #include "command.h"
 #include "space.h"
 #include "types.h"
@@ -18,24 +20,26 @@
 #include "player.h"
 #include "character.h"
 #include "link_l.h"
+#include "events.h"
+#include "zobrist.h"
 
 /**
- * @brief Maximum of spaces in a game
+ * @brief Initial capacity for spaces in a game, the array grows as needed
  */
 #define MAX_SPACES 100
 
 /**
- * @brief Maximum of objects per game
+ * @brief Initial capacity for objects in a game, the array grows as needed
  */
 #define MAX_OBJECTS 10
 
 /**
- * @brief Maximum of characters per game
+ * @brief Initial capacity for characters in a game, the array grows as needed
  */
 #define MAX_CHARACTERS 5
 
 /**
- * @brief Maximum of links per game
+ * @brief Initial capacity for links in a game, the array grows as needed
  */
 #define MAX_LINKS 400
 
@@ -44,6 +48,11 @@
  */
 #define MAX_PLAYERS 8
 
+/**
+ * @brief Number of commands that can be undone
+ */
+#define GAME_UNDO_DEPTH 32
+
 /**
  * @brief Interface structure
  * 
@@ -59,6 +68,11 @@ typedef struct _InterfaceData InterfaceData;
  */
 typedef struct _Game Game;
 
+/**
+ * @brief A saved state of the game, see snapshot.h.
+ */
+struct _Snapshot;
+
 /**
  * @brief Creates a new game.
  * @author Profesores PPROG
@@ -72,6 +86,8 @@ Status game_create(Game **game);
  * @brief Creates a new game from a file.
  * @author Profesores PPROG
  *
+ * The file can also be an image written by anthill_compile (see image.h).
+ *
  * @param game A pointer to the game structure to be initialized.
  * @param filename The name of the file containing the game data.
  * @return OK if the game was successfully created, ERROR otherwise.
@@ -82,16 +98,119 @@ Status game_create_from_file(Game **game, char *filename);
  * @brief Destroys a game, freeing the allocated memory.
  * @author Profesores PPROG
  *
+ * A session only frees what it owns, and a world must outlive its sessions.
+ *
  * @param game A pointer to the game structure to be destroyed.
  * @return OK if the game was successfully destroyed, ERROR otherwise.
  */
 Status game_destroy(Game *game);
 
+/**
+ * @brief Creates a shadow of a game to run the command of one player.
+ *
+ * The shadow shares every space, player, object and character with the game,
+ * but has its own active player, temporal feedback and events, so commands of players
+ * that touch different spaces can run on different threads. Paged games
+ * cannot have shadows, since loading a region changes the game.
+ *
+ * @param game A pointer to the game structure.
+ * @param turn The position of the player that acts in the shadow.
+ * @return The shadow, NULL if there was an error.
+ */
+Game *game_create_shadow(Game *game, int turn);
+
+/**
+ * @brief Frees a shadow and gives its feedback, active player and events to the game.
+ *
+ * The feedback is only copied if the commands run in the shadow set it. The
+ * events the shadow published go after those already in the game.
+ *
+ * @param game A pointer to the game structure.
+ * @param shadow The shadow, freed by this call.
+ * @return OK if the shadow was merged, ERROR otherwise.
+ */
+Status game_merge_shadow(Game *game, Game *shadow);
+
+/**
+ * @brief Creates a session that plays a world loaded once.
+ *
+ * The session shares every space, link, player, object and character of the
+ * world, with their names and descriptions, and only owns its overlay: a
+ * snapshot of the state the commands change (see snapshot.h), its players'
+ * last commands and messages, its events and its undo ring. A new session
+ * starts in the state the world was loaded with, so it takes a copy of a
+ * snapshot instead of a load. Paged games cannot be worlds, and the world
+ * itself must not be played once it has sessions. game_actions_update and
+ * graphic_engine_paint_game enter the session they get, so any number of
+ * sessions can be played in turns.
+ *
+ * Sessions of a world take turns in its entities and are used by one thread.
+ *
+ * @param session A pointer where the session is returned.
+ * @param world A pointer to the game loaded from the world file.
+ * @return OK if the session was created, ERROR otherwise.
+ */
+Status game_create_session(Game **session, Game *world);
+
+/**
+ * @brief Puts the state of a session in the entities it shares with its world.
+ *
+ * The state of the session that was in them is saved in its overlay first.
+ * The actions, the painting and game_create_shadow call it, any other read
+ * of a session must call it first if another session of the same world was
+ * used since. It does nothing for other games and for shadows.
+ *
+ * @param game A pointer to the game structure.
+ * @return OK if the session can be used, ERROR otherwise.
+ */
+Status game_enter(Game *game);
+
+/**
+ * @brief Gets the world a session plays.
+ *
+ * @param game A pointer to the game structure.
+ * @return The world, NULL if the game is not a session.
+ */
+Game *game_get_world(Game *game);
+
+/**
+ * @brief Creates a new game that pages the spaces of a big world from its file
+ *
+ * Players, objects and characters are loaded, while spaces and links are
+ * read by regions when they are first needed (see region.h).
+ *
+ * @param game A pointer to the game structure to be initialized.
+ * @param filename The name of the file containing the game data.
+ * @param budget Memory budget in bytes for the loaded spaces and links.
+ * @return OK if the game was successfully created, ERROR otherwise.
+ */
+Status game_create_paged(Game **game, char *filename, long budget);
+
+/**
+ * @brief Frees the least recently used regions of a paged game that go over its budget.
+ *
+ * Spaces and links got before must not be used after it, so it is called between turns.
+ *
+ * @param game A pointer to the game structure.
+ * @return The number of regions freed, 0 if the game is not paged.
+ */
+int game_evict_regions(Game *game);
+
+/**
+ * @brief Gets the region cache of a paged game.
+ *
+ * @param game A pointer to the game structure.
+ * @return The region cache, NULL if the whole world is loaded.
+ */
+struct _RegionCache *game_get_regions(Game *game);
+
 
 /**
  * @brief Gets a space by its ID.
  * @author Profesores PPROG
  *
+ * The space is found in a hash index of the spaces by id.
+ *
  * @param game A pointer to the game structure.
  * @param id The ID of the space to retrieve.
  * @return A pointer to the space, or NULL if the space is not found.
@@ -207,6 +326,9 @@ int *game_get_n_spaces(Game *game);
  * @brief Gets the spaces in the game.
  * @author Alejandro Gonzalez
  *
+ * New spaces are added at the end with game_add_space. Code that removes or
+ * moves spaces calls game_refresh afterwards, so the index is built again.
+ *
  * @param game A pointer to the game structure.
  * @return The spaces in the game.
  */
@@ -414,6 +536,8 @@ int *game_get_n_characters(Game *game);
  * @brief Searches through the game spaces until it finds a given character
  * @author Daniel Martín Jaén
  * 
+ * The space where the character was last found is checked first.
+ *
  * @param game A pointer to the game struct
  * @param id The id of the character that's being searched for
  * @return NO_ID if something went wrong, the id of the space the character is in otherwise
@@ -431,4 +555,306 @@ Id game_find_character(Game *game, Id id);
  */
 Status game_change_character_location(Game *game, Character *char_p, Id new_location);
 
+/**
+ * @brief Sets whether a character is friendly
+ *
+ * The character moves to the side of its space for its new disposition, and
+ * leaves the party it was in if it becomes hostile.
+ *
+ * @param game A pointer to the game struct
+ * @param character A pointer to the character
+ * @param friendly Whether it is friendly
+ * @return ERROR if something went wrong, OK if everything went correctly
+ */
+Status game_set_character_friendly(Game *game, Character *character, Bool friendly);
+
+/**
+ * @brief Moves the party of a player from one space to another
+ *
+ * Only the player's followers are walked, and those that are not in the
+ * space it leaves stay where they are.
+ *
+ * @param game A pointer to the game struct
+ * @param player A pointer to the player whose party moves
+ * @param from The id of the space the player leaves
+ * @param to The id of the space the player arrives at
+ * @return ERROR if something went wrong, OK if everything went correctly
+ */
+Status game_move_party(Game *game, Player *player, Id from, Id to);
+
+/**
+ * @brief Gets the bus of the events of the game
+ *
+ * @param game A pointer to the game struct
+ * @return The bus, NULL if there was an error
+ */
+EventBus *game_get_events(Game *game);
+
+/**
+ * @brief Publishes an event of the active player in the bus of the game
+ *
+ * @param game A pointer to the game struct
+ * @param type The type of event
+ * @param subject What changed
+ * @param from Where or whom it comes from, NO_ID if it does not apply
+ * @param to Where or whom it goes to, NO_ID if it does not apply
+ * @param value A number that depends on the type (see events.h)
+ * @return OK if it was published or nobody wants it, ERROR otherwise
+ */
+Status game_publish_event(Game *game, EventType type, Id subject, Id from, Id to, int value);
+
+/**
+ * @brief Opens or closes the link that leaves a space in a direction
+ *
+ * @param game A pointer to the game struct
+ * @param id_orig The id of the origin space
+ * @param dir The direction
+ * @param open TRUE to open the link, FALSE to close it
+ * @return OK if the link was found and set, ERROR otherwise
+ */
+Status game_set_link_open(Game *game, Id id_orig, Direction dir, Bool open);
+
+/**
+ * @brief Sets whether a space is discovered
+ *
+ * @param game A pointer to the game struct
+ * @param id The id of the space
+ * @param discovered TRUE if it is discovered, FALSE otherwise
+ * @return OK if the space was found and set, ERROR otherwise
+ */
+Status game_set_space_discovered(Game *game, Id id, Bool discovered);
+
+/**
+ * @brief Sets the health of a player
+ *
+ * @param game A pointer to the game struct
+ * @param position The position of the player in the players array
+ * @param health The new health
+ * @return OK if it was set, ERROR otherwise
+ */
+Status game_set_player_health(Game *game, int position, int health);
+
+/**
+ * @brief Adds an object to the inventory of a player
+ *
+ * @param game A pointer to the game struct
+ * @param position The position of the player in the players array
+ * @param id The id of the object
+ * @return OK if it was added, ERROR otherwise
+ */
+Status game_add_player_object(Game *game, int position, Id id);
+
+/**
+ * @brief Removes an object from the inventory of a player
+ *
+ * @param game A pointer to the game struct
+ * @param position The position of the player in the players array
+ * @param id The id of the object
+ * @return OK if it was removed, ERROR otherwise
+ */
+Status game_del_player_object(Game *game, int position, Id id);
+
+/**
+ * @brief Sets the health of a character
+ *
+ * @param game A pointer to the game struct
+ * @param character A pointer to the character
+ * @param health The new health
+ * @return OK if it was set, ERROR otherwise
+ */
+Status game_set_character_health(Game *game, Character *character, int health);
+
+/**
+ * @brief Sets the player a character follows
+ *
+ * The character also leaves the party of the player it followed and joins
+ * the one of the new player.
+ *
+ * @param game A pointer to the game struct
+ * @param character A pointer to the character
+ * @param following The id of the player, NO_ID to follow nobody
+ * @return OK if it was set, ERROR otherwise
+ */
+Status game_set_character_following(Game *game, Character *character, Id following);
+
+/**
+ * @brief Updates the hash of the game after a feature of the state changed
+ *
+ * The setters of the game call it, a module that changes the state by
+ * other means must call it too (see zobrist.h). Paged games are not hashed.
+ *
+ * @param game A pointer to the game struct
+ * @param kind The kind of feature
+ * @param subject The id of the subject
+ * @param old_value The value before the change
+ * @param new_value The value after the change
+ * @return OK if it was updated, ERROR otherwise
+ */
+Status game_hash_change(Game *game, ZobristKind kind, Id subject, Id old_value, Id new_value);
+
+/**
+ * @brief Gets the Zobrist hash of the state of the game, kept up to date by every change
+ *
+ * In a shadow it is the hash of the changes made in the shadow, which are
+ * added to the game when it is merged.
+ *
+ * @param game A pointer to the game struct
+ * @return The hash, 0 if there was an error or the game is paged
+ */
+unsigned long game_get_hash(Game *game);
+
+/**
+ * @brief Sets the hash of the game, when its state is replaced as a whole
+ *
+ * @param game A pointer to the game struct
+ * @param hash The hash of the new state
+ * @return OK if it was set, ERROR otherwise
+ */
+Status game_set_hash(Game *game, unsigned long hash);
+
+/**
+ * @brief Computes the hash of the state of the game from scratch
+ *
+ * It is the same as game_get_hash if every change went through the game.
+ *
+ * @param game A pointer to the game struct
+ * @return The hash, 0 if there was an error or the game is paged
+ */
+unsigned long game_compute_hash(Game *game);
+
+/**
+ * @brief Saves the current state of the game so it can be undone
+ *
+ * Only the state that commands change is saved (see snapshot.h), and the
+ * oldest state is forgotten after GAME_UNDO_DEPTH saves. Shadows and paged
+ * games keep no states.
+ *
+ * @param game A pointer to the game struct
+ * @return OK if it was saved, ERROR otherwise
+ */
+Status game_save_undo(Game *game);
+
+/**
+ * @brief Forgets the last saved state, used when the command after it changed nothing
+ *
+ * @param game A pointer to the game struct
+ * @return OK if it was forgotten, ERROR if there was none
+ */
+Status game_drop_undo(Game *game);
+
+/**
+ * @brief Puts a state saved by the caller on top of the states that can be undone
+ *
+ * It is used when the state before a command was saved somewhere else, such
+ * as in a shadow (see turns.h). The oldest state is forgotten as with
+ * game_save_undo.
+ *
+ * @param game A pointer to the game struct
+ * @param snapshot A snapshot of the game (see snapshot.h), freed by the game from then on
+ * @return OK if it was kept, ERROR otherwise (it is then freed)
+ */
+Status game_push_undo(Game *game, struct _Snapshot *snapshot);
+
+/**
+ * @brief Puts the game back in the last saved state and forgets it
+ *
+ * The state is the same for every player, so it undoes the last command of
+ * whoever played it. The active player is not changed.
+ *
+ * @param game A pointer to the game struct
+ * @return OK if it was undone, ERROR if there was nothing to undo
+ */
+Status game_undo(Game *game);
+
+/**
+ * @brief Gets the number of saved states that can be undone
+ *
+ * @param game A pointer to the game struct
+ * @return The number of states, -1 if there was an error
+ */
+int game_get_n_undo(Game *game);
+
+/**
+ * @brief Writes the saved states that can be undone to a file
+ *
+ * They are written as snapshots (see snapshot_write), the oldest first, so
+ * a save that holds them can be played back with its undos.
+ *
+ * @param game A pointer to the game struct
+ * @param f The file, open for writing
+ * @return OK if they were written, ERROR otherwise
+ */
+Status game_write_undo(Game *game, FILE *f);
+
+/**
+ * @brief Reads the states written by game_write_undo, in place of the ones the game had
+ *
+ * The game must be loaded from the same world file as the game that wrote them.
+ *
+ * @param game A pointer to the game struct
+ * @param f The file, open for reading
+ * @return OK if they were read, ERROR otherwise (the states of the game are then kept)
+ */
+Status game_read_undo(Game *game, FILE *f);
+
+/**
+ * @brief Makes room for at least n spaces in the game
+ *
+ * @param game A pointer to the game struct
+ * @param n The number of spaces the game must be able to hold
+ * @return OK if everything went correctly, ERROR if there was not enough memory
+ */
+Status game_reserve_spaces(Game *game, int n);
+
+/**
+ * @brief Makes room for at least n objects in the game
+ *
+ * @param game A pointer to the game struct
+ * @param n The number of objects the game must be able to hold
+ * @return OK if everything went correctly, ERROR if there was not enough memory
+ */
+Status game_reserve_objects(Game *game, int n);
+
+/**
+ * @brief Makes room for at least n characters in the game
+ *
+ * @param game A pointer to the game struct
+ * @param n The number of characters the game must be able to hold
+ * @return OK if everything went correctly, ERROR if there was not enough memory
+ */
+Status game_reserve_characters(Game *game, int n);
+
+/**
+ * @brief Makes room for at least n links in the game
+ *
+ * @param game A pointer to the game struct
+ * @param n The number of links the game must be able to hold
+ * @return OK if everything went correctly, ERROR if there was not enough memory
+ */
+Status game_reserve_links(Game *game, int n);
+
+/**
+ * @brief Sets the index of the links by origin from an order computed before
+ *
+ * The order is checked to be the one game_index_links would compute, and
+ * the links are indexed again when it is not.
+ *
+ * @param game A pointer to the game struct
+ * @param order The positions of the links sorted by origin, direction and position
+ * @param n The number of positions, which must be the number of links
+ * @return OK if the order was taken, ERROR otherwise
+ */
+Status game_set_link_index(Game *game, const int *order, int n);
+
+/**
+ * @brief Sets up the game again after entities were added, removed or changed outside of it
+ *
+ * The links and spaces are indexed again, the hash is computed again and the states
+ * saved to be undone are dropped, since they hold the entities there were.
+ *
+ * @param game A pointer to the game struct
+ * @return OK if everything went correctly, ERROR otherwise
+ */
+Status game_refresh(Game *game);
+
 #endif
\ No newline at end of file
@@ -27,5 +27,13 @@
  */
 Status game_actions_update(Game *game, Command *command);
 
+/**
+ * @brief Tells whether a command can change the state of the game.
+ *
+ * @param cmd The code of the command.
+ * @return TRUE if the state is saved before running it, so it can be undone, FALSE otherwise.
+ */
+Bool game_actions_changes_state(CommandCode cmd);
+
 #endif
 
@@ -11,6 +11,7 @@
 #define GAME_READER_H
 
 #include "game.h"
+#include "record.h"
 
 /**
  * @brief Loads spaces for a Map inside a game structure.
@@ -121,6 +122,68 @@ Status game_add_character(Game *game, Character *char_p, Id location);
  */
 Status game_load_characters(Game *game, char *filename);
 
+/**
+ * @brief Parses the current #s: record of a scanner
+ *
+ * @param record A pointer to the scanner
+ * @param space Where the new space is stored
+ * @return OK if the record is valid, ERROR otherwise
+ */
+Status game_reader_parse_space(Record *record, Space **space);
+
+/**
+ * @brief Parses the current #o: record of a scanner
+ *
+ * @param record A pointer to the scanner
+ * @param object Where the new object is stored
+ * @return OK if the record is valid, ERROR otherwise
+ */
+Status game_reader_parse_object(Record *record, Object **object);
+
+/**
+ * @brief Parses the current #l: record of a scanner
+ *
+ * @param record A pointer to the scanner
+ * @param link Where the new link is stored
+ * @return OK if the record is valid, ERROR otherwise
+ */
+Status game_reader_parse_link(Record *record, Link **link);
+
+/**
+ * @brief Parses the current #p: record of a scanner
+ *
+ * @param record A pointer to the scanner
+ * @param player Where the new player, with its inventory, is stored
+ * @param location Where the location of the player is stored
+ * @return OK if the record is valid, ERROR otherwise
+ */
+Status game_reader_parse_player(Record *record, Player **player, Id *location);
+
+/**
+ * @brief Parses the current #c: record of a scanner
+ *
+ * @param record A pointer to the scanner
+ * @param character Where the new character is stored
+ * @param location Where the location of the character is stored
+ * @return OK if the record is valid, ERROR otherwise
+ */
+Status game_reader_parse_character(Record *record, Character **character, Id *location);
+
+/**
+ * @brief Loads every entity of a file into the game struct in one pass
+ *
+ * Big files are split into chunks that are parsed at the same time by
+ * several threads, and then added to the game in the same order as the
+ * individual loaders do, so the result does not depend on the number of
+ * threads. Locations of players and characters are resolved at the end.
+ *
+ * @param game A pointer to the game struct
+ * @param filename A pointer to the name string of the file
+ * @param n_threads Maximum number of threads, 0 to use one per core
+ * @return OK if everything went correctly ERROR if something went wrong
+ */
+Status game_load_world(Game *game, char *filename, int n_threads);
+
 /**
  * @brief Adds a player to the game struct
  * @author Daniel Martín Jaén
@@ -0,0 +1,142 @@
+/**
+ * @brief It defines the compiled images of the world files
+ *
+ * anthill_compile checks a world file once, before it is shipped, and writes
+ * it as an image that is loaded without parsing anything. Every id the file
+ * refers to must exist: the locations of players, objects and characters and
+ * both ends of every link, and no id is used twice by entities of the same
+ * kind. In the image each entity has a slot, its position in the file among
+ * the ones of its kind, and the references are slots, so the loader finds
+ * every space in constant time. The image also keeps the links sorted by
+ * origin and direction, as the game indexes them, the names of the objects
+ * and characters sorted without case, as the commands look them up, and
+ * whether each space can be reached from where the players start.
+ *
+ * An image is meant for the machine it was compiled on: its records are
+ * written as they are in memory.
+ *
+ * @file image.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stdio.h>
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Kinds of entities of an image
+ */
+typedef enum
+{
+	IMAGE_SPACE,	 /*!< Spaces */
+	IMAGE_LINK,		 /*!< Links */
+	IMAGE_OBJECT,	 /*!< Objects */
+	IMAGE_PLAYER,	 /*!< Players */
+	IMAGE_CHARACTER, /*!< Characters */
+	IMAGE_KINDS		 /*!< Number of kinds */
+} ImageKind;
+
+/**
+ * @brief Compiled image of a world
+ *
+ * This struct stores the whole image as it was read from its file
+ */
+typedef struct _Image Image;
+
+/**
+ * @brief What the compiler found in a world file
+ */
+typedef struct
+{
+	int n[IMAGE_KINDS]; /*!< Entities of each kind */
+	int n_errors;		/*!< Errors, the image is only written without them */
+	int n_warnings;		/*!< Warnings, such as spaces that can not be reached */
+	int n_unreachable;	/*!< Spaces that can not be reached from where the players start */
+	long size;			/*!< Size of the image in bytes, 0 if it was not written */
+} ImageReport;
+
+/**
+ * @brief It compiles a world file into an image
+ *
+ * The errors and warnings are printed on stderr with the line of the record,
+ * as the loaders print theirs.
+ *
+ * @param world The name of the world file
+ * @param image The name of the image file
+ * @param report Where what was found is stored, it can be NULL
+ * @return OK if the image was written, ERROR if the world has errors or the image could not be written
+ */
+Status image_compile(char *world, char *image, ImageReport *report);
+
+/**
+ * @brief It tells whether a file is a compiled image, by its first bytes
+ *
+ * @param filename The name of the file
+ * @return TRUE if it is an image, FALSE otherwise
+ */
+Bool image_check(char *filename);
+
+/**
+ * @brief It reads an image, checking that it is whole and consistent
+ *
+ * @param filename The name of the image file
+ * @return The image, NULL if it can not be read or it is not valid
+ */
+Image *image_open(char *filename);
+
+/**
+ * @brief It frees an image
+ *
+ * @param image A pointer to the image
+ */
+void image_close(Image *image);
+
+/**
+ * @brief It loads the world of an image into a game
+ *
+ * The game gets the same entities, in the same order, as if it was loaded
+ * from the world file, and the index of its links is taken from the image.
+ *
+ * @param image A pointer to the image
+ * @param game A pointer to a game without entities
+ * @return OK if the world was loaded, ERROR otherwise
+ */
+Status image_load(Image *image, Game *game);
+
+/**
+ * @brief It gets the number of entities of a kind of an image
+ *
+ * @param image A pointer to the image
+ * @param kind The kind of the entities
+ * @return The number of entities, -1 if there was an error
+ */
+int image_get_n(Image *image, ImageKind kind);
+
+/**
+ * @brief It finds an object or character by its name, without case
+ *
+ * @param image A pointer to the image
+ * @param kind IMAGE_OBJECT or IMAGE_CHARACTER
+ * @param name The name
+ * @return The slot of the first one of the file with that name, -1 if there is none
+ */
+int image_find_name(Image *image, ImageKind kind, const char *name);
+
+/**
+ * @brief It tells whether a space can be reached from where some player starts
+ *
+ * Only the links open in the file are followed, as no command opens the others.
+ *
+ * @param image A pointer to the image
+ * @param slot The slot of the space
+ * @return TRUE if it can be reached, FALSE otherwise
+ */
+Bool image_is_reachable(Image *image, int slot);
+
+#endif
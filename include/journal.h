@@ -0,0 +1,134 @@
+/**
+ * @brief It defines the journal of the commands applied to a game
+ *
+ * Every command is written to the journal before it is applied, so a game
+ * that stops without closing its journal can be put back by restoring the
+ * last save (see autosave.h) and applying again the commands written after
+ * it. A record is a text line with its sequence number, the player, the
+ * command and the seed given to srand() before it, since the attacks use
+ * rand(); a seed of 0 means the command goes on with the numbers of the
+ * one before. The commands of a round resolved together (see turns.h) are
+ * written in queued order, each with its own seed, so applying them one
+ * after the other gives the same game. Records are flushed to the system as they are written, so
+ * they survive the end of the process, and synced to the disk in batches,
+ * which bounds what a crash of the machine can lose. Once a save of the
+ * game is on disk, the records it holds are dropped from the journal, so
+ * recovering never applies more than the commands of one save interval.
+ * Saves hold the undo ring with the state, so an undo replayed from a save
+ * undoes the same command it undid when it was played.
+ *
+ * @file journal.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "command.h"
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Records written between syncs to the disk, if no other number is given
+ */
+#define JOURNAL_BATCH 8
+
+/**
+ * @brief Journal of the commands of a game
+ *
+ * This struct stores the file of the journal and the number of its last record
+ */
+typedef struct _Journal Journal;
+
+/**
+ * @brief It creates an empty journal, replacing the file if there is one
+ *
+ * @param path The name of the file
+ * @param batch The number of records written between syncs, at least 1
+ * @return A new journal, NULL if there was an error
+ */
+Journal *journal_create(const char *path, int batch);
+
+/**
+ * @brief It opens the journal left by a game that did not close it
+ *
+ * A last record cut in the middle by the crash is dropped.
+ *
+ * @param path The name of the file
+ * @param batch The number of records written between syncs, at least 1
+ * @return The journal, ready to be replayed and written, NULL if there is no journal or it is not valid
+ */
+Journal *journal_open(const char *path, int batch);
+
+/**
+ * @brief It closes a journal, syncing its records and keeping the file
+ *
+ * @param journal A pointer to the journal
+ */
+void journal_destroy(Journal *journal);
+
+/**
+ * @brief It closes the journal of a game that was closed, removing the file
+ *
+ * @param journal A pointer to the journal
+ * @return OK if the file was removed, ERROR otherwise
+ */
+Status journal_close(Journal *journal);
+
+/**
+ * @brief It writes a command before it is applied
+ *
+ * @param journal A pointer to the journal
+ * @param turn The player that typed the command
+ * @param command A pointer to the command
+ * @param seed The seed given to srand() just before the command, 0 if it was not reseeded
+ * @return OK if it was written, ERROR otherwise
+ */
+Status journal_append(Journal *journal, int turn, Command *command, unsigned int seed);
+
+/**
+ * @brief It syncs the records written to the disk
+ *
+ * @param journal A pointer to the journal
+ * @return OK if they were synced, ERROR otherwise
+ */
+Status journal_sync(Journal *journal);
+
+/**
+ * @brief It applies again the records written after a save
+ *
+ * @param journal A pointer to the journal
+ * @param game A pointer to the game, in the state of the save
+ * @param mark The number of the last record the save holds, see journal_get_last
+ * @return The number of commands applied, -1 if there was an error or the records after the mark were dropped
+ */
+long journal_replay(Journal *journal, Game *game, long mark);
+
+/**
+ * @brief It drops the records held by a save
+ *
+ * @param journal A pointer to the journal
+ * @param mark The number of the last record the save holds
+ * @return OK if they were dropped, ERROR otherwise (the journal is then not changed)
+ */
+Status journal_compact(Journal *journal, long mark);
+
+/**
+ * @brief It gets the number of the last record, the one a save taken now holds
+ *
+ * @param journal A pointer to the journal
+ * @return The number, 0 for a new journal, -1 if there was an error
+ */
+long journal_get_last(Journal *journal);
+
+/**
+ * @brief It gets the number of the last record dropped, the oldest save a recovery can start from
+ *
+ * @param journal A pointer to the journal
+ * @return The number, 0 if none was dropped, -1 if there was an error
+ */
+long journal_get_base(Journal *journal);
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @brief It defines the extra functions of the in-memory screen backend
+ *
+ * libscreen_null.c implements libscreen.h without a terminal. Besides that
+ * interface, the text of its screen can be read, so that a frame can be
+ * sent somewhere else than the standard output.
+ *
+ * @file libscreen_null.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef LIBSCREEN_NULL_H
+#define LIBSCREEN_NULL_H
+
+#include "libscreen.h"
+
+/**
+ * @brief It gets the text of the in-memory screen
+ *
+ * Every row ends with '\n' and has no trailing spaces. The text is valid
+ * until the next call.
+ *
+ * @param len Where the length of the text is stored
+ * @return The text, NULL if the screen was not initialized
+ */
+char *screen_get_text(int *len);
+
+#endif
@@ -39,6 +39,14 @@ Link* link_create(Id id);
  */
 Status link_destroy(Link* link);
 
+/**
+ * @brief Gets the id of a link.
+ *
+ * @param link A pointer to the link.
+ * @return The id of the link, NO_ID if there was an error.
+ */
+Id link_get_id(Link* link);
+
 /**
  * @brief Sets the name of the link.
  * 
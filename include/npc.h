@@ -0,0 +1,121 @@
+/**
+ * @brief It defines the scheduler of the behaviours of the characters
+ *
+ * The game advances in fixed ticks. Every character runs a small finite
+ * state machine (wander across open links, chase a player, flee from it)
+ * when it wakes up, and then sleeps until its next wake tick. Sleeping
+ * characters wait in a priority queue ordered by that tick, so a tick only
+ * touches the characters that are due, and it stops when its time budget
+ * is spent, leaving the rest for the next tick.
+ *
+ * @file npc.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef NPC_H
+#define NPC_H
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Time budget of a tick used by the game loop, in nanoseconds
+ */
+#define NPC_TICK_BUDGET_NS 2000000L
+
+/**
+ * @brief States of the behaviour of a character
+ */
+typedef enum
+{
+	NPC_IDLE,	/*!< Following a player, or without an open exit */
+	NPC_WANDER, /*!< Walking across random open links */
+	NPC_CHASE,	/*!< Going to a player in its space or next to it */
+	NPC_FLEE,	/*!< Going away from a player, a hostile character with little health */
+	NPC_DEAD	/*!< Without health, it is not scheduled any more */
+} NpcState;
+
+/**
+ * @brief Scheduler of the characters of a game
+ *
+ * This struct stores the wake queue and the state of every character
+ */
+typedef struct _NpcScheduler NpcScheduler;
+
+/**
+ * @brief It creates a scheduler for the characters of a game
+ *
+ * Every character wakes up in the first tick. Paged games are not
+ * supported, because their characters are freed with their regions.
+ *
+ * @param game A pointer to the game, which must outlive the scheduler
+ * @param budget The time budget of a tick in nanoseconds, 0 for no limit
+ * @param seed The seed of the random choices, the same seed gives the same moves
+ * @return A new scheduler, NULL if there was an error or the game is paged
+ */
+NpcScheduler *npc_create(Game *game, long budget, unsigned long seed);
+
+/**
+ * @brief It frees a scheduler
+ *
+ * @param npcs A pointer to the scheduler
+ */
+void npc_destroy(NpcScheduler *npcs);
+
+/**
+ * @brief It runs a tick, waking up the characters that are due
+ *
+ * At least one due character runs in every tick, so the queue always
+ * advances even with a very small budget.
+ *
+ * @param npcs A pointer to the scheduler
+ * @return The number of characters that ran, -1 if there was an error
+ */
+int npc_tick(NpcScheduler *npcs);
+
+/**
+ * @brief It gets the number of ticks run
+ *
+ * @param npcs A pointer to the scheduler
+ * @return The number of ticks, -1 if there was an error
+ */
+long npc_get_tick(NpcScheduler *npcs);
+
+/**
+ * @brief It gets the number of characters waiting in the queue
+ *
+ * @param npcs A pointer to the scheduler
+ * @return The number of characters, -1 if there was an error
+ */
+int npc_get_n_scheduled(NpcScheduler *npcs);
+
+/**
+ * @brief It counts the characters that are due but did not fit in the budget of the last tick
+ *
+ * Only the due characters of the queue are visited.
+ *
+ * @param npcs A pointer to the scheduler
+ * @return The number of characters, -1 if there was an error
+ */
+int npc_get_n_late(NpcScheduler *npcs);
+
+/**
+ * @brief It gets the state of a character
+ *
+ * @param npcs A pointer to the scheduler
+ * @param id The id of the character
+ * @return The state, NPC_DEAD if the character is not in the scheduler
+ */
+NpcState npc_get_state(NpcScheduler *npcs, Id id);
+
+/**
+ * @brief It gets the name of a state
+ *
+ * @param state The state
+ * @return The name, "?" if the state is not valid
+ */
+const char *npc_state_name(NpcState state);
+
+#endif
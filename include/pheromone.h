@@ -0,0 +1,138 @@
+/**
+ * @brief It defines the pheromone fields of the spaces
+ *
+ * Every space holds an amount of each pheromone. In every step a space
+ * keeps part of its amount and shares the rest evenly across its open
+ * links, and then every amount decays. The amounts are dense arrays
+ * indexed by the slot of the space in the game, and a step is a product of
+ * a sparse matrix, built from the open links in CSR form, and those
+ * arrays. The dense loops of a step are vectorized (build with OPT=-O3).
+ *
+ * @file pheromone.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef PHEROMONE_H
+#define PHEROMONE_H
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Kinds of pheromone
+ */
+typedef enum
+{
+	PHEROMONE_FOOD,	  /*!< Left by ants that found food */
+	PHEROMONE_DANGER, /*!< Left where ants were attacked */
+	PHEROMONE_KINDS	  /*!< Number of kinds */
+} PheromoneKind;
+
+/**
+ * @brief Pheromone fields of the spaces of a game
+ *
+ * This struct stores the links in CSR form and the amount of each kind in every space
+ */
+typedef struct _Pheromones Pheromones;
+
+/**
+ * @brief It creates empty fields for the spaces of a game
+ *
+ * Paged games are not supported, because their spaces come and go with
+ * their regions.
+ *
+ * @param game A pointer to the game, which must outlive the fields
+ * @param diffusion The fraction of its amount a space shares in a step, between 0 and 1
+ * @param decay The fraction of every amount lost in a step, between 0 and 1
+ * @return New fields, NULL if there was an error or the game is paged
+ */
+Pheromones *pheromone_create(Game *game, double diffusion, double decay);
+
+/**
+ * @brief It creates empty fields for the spaces of a world file
+ *
+ * Only the ids of the spaces and the ends of the open links are read, so
+ * it works for worlds whose spaces and links do not fit in memory. The
+ * fields cannot be refreshed, they have no game to read links from.
+ *
+ * @param filename The name of the world file
+ * @param diffusion The fraction of its amount a space shares in a step, between 0 and 1
+ * @param decay The fraction of every amount lost in a step, between 0 and 1
+ * @return New fields, NULL if there was an error
+ */
+Pheromones *pheromone_create_from_file(char *filename, double diffusion, double decay);
+
+/**
+ * @brief It frees the fields
+ *
+ * @param pheromones A pointer to the fields
+ */
+void pheromone_destroy(Pheromones *pheromones);
+
+/**
+ * @brief It builds the matrix again from the links that are open now
+ *
+ * It must be called after links are opened or closed, the amounts are kept.
+ *
+ * @param pheromones A pointer to the fields
+ * @return OK if it was built, ERROR if there was an error or the fields were read from a file (the old matrix is kept)
+ */
+Status pheromone_refresh(Pheromones *pheromones);
+
+/**
+ * @brief It adds pheromone to a space
+ *
+ * @param pheromones A pointer to the fields
+ * @param kind The kind of pheromone
+ * @param space The id of the space
+ * @param amount The amount added, it may be negative but the result is never below 0
+ * @return OK if it was added, ERROR otherwise
+ */
+Status pheromone_deposit(Pheromones *pheromones, PheromoneKind kind, Id space, double amount);
+
+/**
+ * @brief It gets the amount of pheromone of a space
+ *
+ * @param pheromones A pointer to the fields
+ * @param kind The kind of pheromone
+ * @param space The id of the space
+ * @return The amount, -1 if there was an error
+ */
+double pheromone_get(Pheromones *pheromones, PheromoneKind kind, Id space);
+
+/**
+ * @brief It adds up the amount of pheromone of every space
+ *
+ * @param pheromones A pointer to the fields
+ * @param kind The kind of pheromone
+ * @return The total amount, -1 if there was an error
+ */
+double pheromone_total(Pheromones *pheromones, PheromoneKind kind);
+
+/**
+ * @brief It diffuses and decays every kind of pheromone once
+ *
+ * @param pheromones A pointer to the fields
+ * @return OK if it was done, ERROR otherwise
+ */
+Status pheromone_step(Pheromones *pheromones);
+
+/**
+ * @brief It gets the number of spaces of the fields
+ *
+ * @param pheromones A pointer to the fields
+ * @return The number of spaces, -1 if there was an error
+ */
+int pheromone_get_n_spaces(Pheromones *pheromones);
+
+/**
+ * @brief It gets the number of open links of the matrix
+ *
+ * @param pheromones A pointer to the fields
+ * @return The number of links, -1 if there was an error
+ */
+int pheromone_get_n_links(Pheromones *pheromones);
+
+#endif
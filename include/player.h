@@ -13,6 +13,7 @@
 
 #include "types.h"
 #include "inventory.h"
+#include "character.h"
 
 /**
  * @brief Maximum number of colums of the graphical description of the player
@@ -200,4 +201,34 @@ Status player_set_location(Player *player, Id location);
  */
 Status player_set_inventory(Player *player, Inventory *inv);
 
+/**
+ * @brief Gets the first character of the player's party
+ *
+ * The party is the list of the characters that follow the player, walked with
+ * character_get_next_follower. The game keeps it in step with the following
+ * id of the characters, see game_set_character_following.
+ *
+ * @param player A pointer to the player struct
+ * @return The first follower, NULL if the player has none or there was an error
+ */
+Character *player_get_followers(Player *player);
+
+/**
+ * @brief Puts a character first in the player's party
+ *
+ * @param player A pointer to the player struct
+ * @param character A pointer to the character, which must not be in a party
+ * @return OK if everything went correctly ERROR if something went wrong
+ */
+Status player_add_follower(Player *player, Character *character);
+
+/**
+ * @brief Takes a character out of the player's party
+ *
+ * @param player A pointer to the player struct
+ * @param character A pointer to the character
+ * @return OK if everything went correctly ERROR if it was not in the party
+ */
+Status player_del_follower(Player *player, Character *character);
+
 #endif
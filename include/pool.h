@@ -0,0 +1,76 @@
+/**
+ * @brief It defines the pools the small records of the world are taken from
+ *
+ * A world has many spaces and links that are created one after another and
+ * walked in that order. A pool hands out records of one size from blocks,
+ * so they end up packed next to each other instead of spread over the heap,
+ * and keeps the records given back for the next ones. The blocks are never
+ * freed. Pools are shared by the threads that load a world, so every call
+ * takes the lock of the pool.
+ *
+ * It also keeps one copy of each string that is interned, for names that
+ * many records repeat.
+ *
+ * @file pool.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include "types.h"
+
+/**
+ * @brief A pool of records of one size
+ *
+ * Declare it static with POOL_INITIALIZER, its fields are private.
+ */
+typedef struct
+{
+	size_t size;		  /*!< Size of a record, at least a pointer */
+	int per_block;		  /*!< Number of records of each block */
+	void *blocks;		  /*!< Newest block, each one points to the one before */
+	int used;			  /*!< Number of records of the newest block already taken */
+	void *free;			  /*!< Records given back, each one points to the next */
+	pthread_mutex_t lock; /*!< Protects the pool */
+} Pool;
+
+/**
+ * @brief Initializer of a pool of records of a type
+ *
+ * @param type The type of the records
+ * @param per_block The number of records allocated at once
+ */
+#define POOL_INITIALIZER(type, per_block) \
+	{sizeof(type) < sizeof(void *) ? sizeof(void *) : sizeof(type), (per_block), NULL, (per_block), NULL, PTHREAD_MUTEX_INITIALIZER}
+
+/**
+ * @brief It takes a record from a pool
+ *
+ * @param pool A pointer to the pool
+ * @return The record, not initialized, NULL if there was not enough memory
+ */
+void *pool_alloc(Pool *pool);
+
+/**
+ * @brief It gives a record back to its pool
+ *
+ * @param pool A pointer to the pool
+ * @param record The record, it can be NULL
+ */
+void pool_release(Pool *pool, void *record);
+
+/**
+ * @brief It gets the copy of a string kept for the life of the process
+ *
+ * @param string The string
+ * @return The copy, the same one for equal strings, NULL if there was not enough memory
+ */
+const char *pool_intern(const char *string);
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * @brief It defines the record scanner of the data files
+ *
+ * The whole file is read into one buffer and every record is split into
+ * fields that point into that buffer, without copies. Each scanner keeps its
+ * own state, so several files can be scanned at the same time.
+ *
+ * @file record.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef RECORD_H
+#define RECORD_H
+
+#include "types.h"
+
+/**
+ * @brief Maximum number of fields of a record
+ */
+#define RECORD_MAX_FIELDS 16
+
+/**
+ * @brief A field of a record, as a slice of the read buffer
+ *
+ * The field is also terminated by '\0' in the buffer, so ptr can be passed
+ * directly to the functions that expect a string.
+ */
+typedef struct
+{
+	char *ptr;	/*!< First character of the field */
+	int len;	/*!< Number of characters of the field */
+	int column; /*!< Column of the field in its line, starting at 1 */
+} Field;
+
+/**
+ * @brief Record scanner
+ *
+ * This struct stores the buffer of the file and the current record
+ */
+typedef struct _Record Record;
+
+/**
+ * @brief It reads a whole file and creates a scanner for it
+ *
+ * @param filename The name of the file
+ * @return A new scanner, NULL if the file could not be read
+ */
+Record *record_open(char *filename);
+
+/**
+ * @brief It creates a scanner over a copy of a text, named as a file in the errors
+ *
+ * @param name The name shown in the errors
+ * @param text The text to scan
+ * @return A new scanner, NULL if there was an error
+ */
+Record *record_open_text(char *name, char *text);
+
+/**
+ * @brief It frees a scanner and its buffer
+ *
+ * @param record A pointer to the scanner
+ */
+void record_close(Record *record);
+
+/**
+ * @brief It moves to the next record of a type and splits its fields
+ *
+ * Records are the lines that start with the tag. The fields after the tag
+ * are separated by '|', and the empty field after a final '|' is ignored.
+ *
+ * @param record A pointer to the scanner
+ * @param tag The start of the records, for example "#s:"
+ * @return The number of fields, 0 when there are no more records, -1 if the record has too many fields
+ */
+int record_next(Record *record, char *tag);
+
+/**
+ * @brief It moves to the next record of any of several types
+ *
+ * @param record A pointer to the scanner
+ * @param tags The starts of the records
+ * @param n_tags The number of tags
+ * @param which Where the position of the tag of the record is stored, it can be NULL
+ * @return The number of fields, 0 when there are no more records, -1 if the record has too many fields
+ */
+int record_next_of(Record *record, char **tags, int n_tags, int *which);
+
+/**
+ * @brief It splits the text left to scan into chunks of whole lines
+ *
+ * The chunks are scanners that share the buffer of the record, so they must
+ * be closed before it. Each one can be scanned by a different thread, and
+ * their errors show the lines of the whole file.
+ *
+ * @param record A pointer to the scanner
+ * @param n The maximum number of chunks
+ * @param min_size The minimum size of a chunk in bytes, fewer chunks are made for small texts
+ * @param chunks An array of at least n pointers where the chunks are stored
+ * @return The number of chunks, 0 if there was an error
+ */
+int record_split(Record *record, int n, long min_size, Record **chunks);
+
+/**
+ * @brief It gets a field of the current record
+ *
+ * @param record A pointer to the scanner
+ * @param position The position of the field, starting at 0
+ * @return A pointer to the field, NULL if the record does not have it
+ */
+Field *record_get_field(Record *record, int position);
+
+/**
+ * @brief It gets a field as a string, checking its length
+ *
+ * Missing or too long fields are reported with their line and column.
+ *
+ * @param record A pointer to the scanner
+ * @param position The position of the field
+ * @param max_len Maximum number of characters of the field
+ * @param what Description of the field used in the errors
+ * @return The field as a string inside the buffer, NULL if there was an error
+ */
+char *record_get_string(Record *record, int position, int max_len, char *what);
+
+/**
+ * @brief It parses a field as an integer
+ *
+ * The whole field must be a number, with an optional sign, that fits in a
+ * long. Errors are reported with their line and column.
+ *
+ * @param record A pointer to the scanner
+ * @param position The position of the field
+ * @param what Description of the field used in the errors
+ * @param value Where the number is stored
+ * @return OK if the field is a valid number, ERROR otherwise
+ */
+Status record_get_long(Record *record, int position, char *what, long *value);
+
+/**
+ * @brief It parses a field as an integer within a range
+ *
+ * @param record A pointer to the scanner
+ * @param position The position of the field
+ * @param what Description of the field used in the errors
+ * @param min Minimum valid value
+ * @param max Maximum valid value
+ * @param value Where the number is stored
+ * @return OK if the field is a valid number in the range, ERROR otherwise
+ */
+Status record_get_int(Record *record, int position, char *what, int min, int max, int *value);
+
+/**
+ * @brief It reports an error at a field of the current record
+ *
+ * The error is printed on stderr as "Error: file:line:column: message".
+ *
+ * @param record A pointer to the scanner
+ * @param position The position of the field, or -1 for the whole record
+ * @param message The message
+ */
+void record_error(Record *record, int position, char *message);
+
+/**
+ * @brief It gets the line of the current record
+ *
+ * @param record A pointer to the scanner
+ * @return The line, starting at 1, or 0 if there is no current record
+ */
+int record_get_line(Record *record);
+
+/**
+ * @brief It sets the line number of the next line to scan
+ *
+ * It is used when the text is a single line read from a larger file.
+ *
+ * @param record A pointer to the scanner
+ * @param line The line, starting at 1
+ * @return OK if the line was set, ERROR otherwise
+ */
+Status record_set_line(Record *record, int line);
+
+#endif
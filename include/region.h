@@ -0,0 +1,136 @@
+/**
+ * @brief It defines the region cache, which pages the spaces of a world in and out
+ *
+ * An index next to the world file ("<world>.idx") keeps the byte offset of
+ * every space and of its outgoing links, with the size and modification
+ * time of the world file, and is built again when they change. A record
+ * that is not the indexed space or link is rejected when it is read.
+ * Spaces are grouped in regions of REGION_SPACES consecutive ids, and a
+ * region is read from the world file the first time one of its spaces or
+ * links is needed. When the loaded regions go over the memory budget, the
+ * least recently used ones that are not around a player are freed again,
+ * keeping which spaces were discovered and which characters they had.
+ *
+ * @file region.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef REGION_H
+#define REGION_H
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Number of spaces of a region
+ */
+#define REGION_SPACES 64
+
+/**
+ * @brief Region cache
+ *
+ * This struct stores the index of the world and the state of every region
+ */
+typedef struct _RegionCache RegionCache;
+
+/**
+ * @brief It writes the index of a world file
+ *
+ * The file is read line by line, so it does not need to fit in memory.
+ *
+ * @param world The name of the world file
+ * @param index The name of the index file
+ * @return OK if the index was written, ERROR otherwise
+ */
+Status region_build_index(char *world, char *index);
+
+/**
+ * @brief It opens a world for paging, building its index if it is missing or out of date
+ *
+ * @param world The name of the world file
+ * @param budget Memory budget in bytes for the loaded regions
+ * @return A new region cache, NULL if there was an error
+ */
+RegionCache *region_cache_open(char *world, long budget);
+
+/**
+ * @brief It frees a region cache
+ *
+ * The loaded spaces and links belong to the game and are not freed.
+ *
+ * @param cache A pointer to the region cache
+ */
+void region_cache_close(RegionCache *cache);
+
+/**
+ * @brief It loads the players, objects and characters of the world into the game
+ *
+ * Characters are only put in their spaces when their regions are loaded.
+ *
+ * @param cache A pointer to the region cache
+ * @param game A pointer to the game
+ * @return OK if everything was loaded, ERROR otherwise
+ */
+Status region_cache_load_entities(RegionCache *cache, Game *game);
+
+/**
+ * @brief It gets a space, loading its region if needed
+ *
+ * @param cache A pointer to the region cache
+ * @param game A pointer to the game
+ * @param id The id of the space
+ * @return The space, NULL if there is no space with that id
+ */
+Space *region_get_space(RegionCache *cache, Game *game, Id id);
+
+/**
+ * @brief It checks whether a space exists without loading its region
+ *
+ * @param cache A pointer to the region cache
+ * @param id The id of the space
+ * @return TRUE if the world has a space with that id, FALSE otherwise
+ */
+Bool region_has_space(RegionCache *cache, Id id);
+
+/**
+ * @brief It gets the link that leaves a space in a direction, loading its region if needed
+ *
+ * @param cache A pointer to the region cache
+ * @param game A pointer to the game
+ * @param id_orig The id of the origin space
+ * @param dir The direction of the link
+ * @return The link, NULL if there is none
+ */
+Link *region_get_link(RegionCache *cache, Game *game, Id id_orig, Direction dir);
+
+/**
+ * @brief It frees regions until the budget is met or no region can be freed
+ *
+ * Spaces returned before must not be used after this call, so it is only
+ * called between turns.
+ *
+ * @param cache A pointer to the region cache
+ * @param game A pointer to the game
+ * @return The number of regions freed
+ */
+int region_evict(RegionCache *cache, Game *game);
+
+/**
+ * @brief It gets the memory used by the loaded regions
+ *
+ * @param cache A pointer to the region cache
+ * @return The approximate number of bytes, 0 if there was an error
+ */
+long region_get_resident_bytes(RegionCache *cache);
+
+/**
+ * @brief It gets the number of times a region was read from the world file
+ *
+ * @param cache A pointer to the region cache
+ * @return The number of region loads
+ */
+long region_get_n_loads(RegionCache *cache);
+
+#endif
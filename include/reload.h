@@ -0,0 +1,95 @@
+/**
+ * @brief It defines the reload of the data file of a running game
+ *
+ * A thread watches the data file with inotify and parses it again each time
+ * it is written, so the game does not stop while it is read. Between turns
+ * the game takes the last version parsed and applies what changed since the
+ * version before: the spaces, links, objects and characters that were added,
+ * removed or changed in the file. Players are not touched, and neither is
+ * what they did to the world unless the file changes it: an object taken
+ * stays with its player, a space they are in is not removed and a door they
+ * opened stays open unless the file opens or closes it. The changes that a
+ * command could also make publish the same events (see events.h), so the
+ * subscribers follow them: characters that move or change their health, and
+ * links opened or closed.
+ *
+ * @file reload.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef RELOAD_H
+#define RELOAD_H
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Watcher of the data file of a game
+ *
+ * This struct stores the file watched, the version of it applied last and the one parsed since
+ */
+typedef struct _Reload Reload;
+
+/**
+ * @brief The changes applied by a reload
+ */
+typedef struct
+{
+	int added;			   /*!< Entities added */
+	int changed;		   /*!< Entities changed */
+	int removed;		   /*!< Entities removed */
+	int kept;			   /*!< Changes not applied to keep the state of the players */
+	unsigned long parse;   /*!< Time parsing the file, in nanoseconds */
+	unsigned long apply;   /*!< Time applying the changes, in nanoseconds */
+	unsigned long latency; /*!< Time from the write of the file to the end of the apply, in nanoseconds */
+} ReloadDiff;
+
+/**
+ * @brief It starts watching a data file
+ *
+ * @param path The name of the file the game was loaded from
+ * @return A new watcher, NULL if the file can not be read or watched
+ */
+Reload *reload_create(const char *path);
+
+/**
+ * @brief It stops watching the file and frees the watcher
+ *
+ * @param reload A pointer to the watcher
+ */
+void reload_destroy(Reload *reload);
+
+/**
+ * @brief It applies the last version of the file parsed, if there is a new one
+ *
+ * It must be called between turns, by the thread that plays them.
+ *
+ * @param reload A pointer to the watcher
+ * @param game A pointer to the game loaded from the file, not paged nor a session
+ * @param diff Where the changes applied are stored, it can be NULL
+ * @return 1 if a new version was applied, 0 if there was none, -1 if there was an error
+ */
+int reload_apply(Reload *reload, Game *game, ReloadDiff *diff);
+
+/**
+ * @brief It applies to a game the changes between two versions of its file
+ *
+ * @param game A pointer to the game
+ * @param before A pointer to the game as loaded from the version before
+ * @param after A pointer to the game as loaded from the new version
+ * @param diff Where the changes applied are stored, it can be NULL
+ * @return OK if they were applied, ERROR otherwise
+ */
+Status reload_diff(Game *game, Game *before, Game *after, ReloadDiff *diff);
+
+/**
+ * @brief It gets the number of versions of the file that could not be parsed
+ *
+ * @param reload A pointer to the watcher
+ * @return The number of versions, -1 if there was an error
+ */
+int reload_get_n_failed(Reload *reload);
+
+#endif
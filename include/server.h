@@ -0,0 +1,121 @@
+/**
+ * @brief It defines the game server
+ *
+ * Players connect over a local TCP port or a Unix socket instead of sharing
+ * the terminal. Each connection plays the player of its slot: a command is
+ * run as soon as its line arrives, and then every connected player gets its
+ * own view, painted with the in-memory screen. All sockets are non-blocking
+ * and served by one epoll loop, and a client that does not read only gets
+ * the newest view when it does, so it never stalls the others.
+ *
+ * A server can also run several sessions of one world (see
+ * game_create_session): clients fill the players of the first session that
+ * has a free one, and only the clients of a session see its commands.
+ *
+ * @file server.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "game.h"
+#include "graphic_engine.h"
+#include "types.h"
+
+/**
+ * @brief Text sent to a client when every player is taken
+ */
+#define SERVER_FULL "The game is full.\n"
+
+/**
+ * @brief Text sent after each view
+ */
+#define SERVER_PROMPT "prompt:> "
+
+/**
+ * @brief Game server
+ *
+ * This struct stores the epoll loop and the connection of each player
+ */
+typedef struct _Server Server;
+
+/**
+ * @brief It opens the listening socket
+ *
+ * @param address "unix:<path>" for a Unix socket, or a port of 127.0.0.1
+ * @return The socket, -1 if there was an error
+ */
+int server_listen(char *address);
+
+/**
+ * @brief It creates a server for a game
+ *
+ * @param world A pointer to the game
+ * @param gengine The graphic engine, backed by the in-memory screen
+ * @param listen_fd The listening socket, -1 if the clients are only added with server_add_client
+ * @param n_sessions Number of sessions of the world to run, 0 to play the world itself
+ * @return A new server, NULL if there was an error
+ */
+Server *server_create(Game *world, Graphic_engine *gengine, int listen_fd, int n_sessions);
+
+/**
+ * @brief It frees a server, closing its clients and destroying its sessions
+ *
+ * The listening socket, the world and the graphic engine are not closed.
+ *
+ * @param server A pointer to the server
+ */
+void server_destroy(Server *server);
+
+/**
+ * @brief It gives a connected socket the first free player and sends it its view
+ *
+ * When every player of every game that is not finished is taken,
+ * SERVER_FULL is sent and the socket is closed.
+ *
+ * @param server A pointer to the server
+ * @param fd The socket of the client, which then belongs to the server
+ * @return OK if the client got a player, ERROR otherwise
+ */
+Status server_add_client(Server *server, int fd);
+
+/**
+ * @brief It waits for the sockets and serves what they are ready for
+ *
+ * @param server A pointer to the server
+ * @param timeout Milliseconds to wait, -1 to wait until something happens
+ * @return The number of events served, 0 if the wait timed out or was interrupted, -1 if there was an error
+ */
+int server_poll(Server *server, int timeout);
+
+/**
+ * @brief It gets the number of connected clients
+ *
+ * @param server A pointer to the server
+ * @return The number of clients, -1 if there was an error
+ */
+int server_get_n_clients(Server *server);
+
+/**
+ * @brief It tells whether every game of the server is finished
+ *
+ * The clients of a game are closed once it is finished.
+ *
+ * @param server A pointer to the server
+ * @return TRUE if there is nothing left to play or there was an error, FALSE otherwise
+ */
+Bool server_is_finished(Server *server);
+
+/**
+ * @brief It gets one of the games the server plays
+ *
+ * @param server A pointer to the server
+ * @param position The position of the session, 0 when the world is played
+ * @return The game, NULL if there was an error
+ */
+Game *server_get_game(Server *server, int position);
+
+#endif
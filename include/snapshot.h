@@ -0,0 +1,133 @@
+/**
+ * @brief It defines the snapshots of the state of a game
+ *
+ * A snapshot keeps only what the commands can change: where the players,
+ * objects and characters are, the health of players and characters, the
+ * inventories, whom the characters follow, the discovered spaces and the
+ * open links. Names, descriptions, gdesc and the topology of the links are
+ * shared with the game and never copied, so a snapshot of a world is a few
+ * flat arrays and saving it again reuses them. Restoring only rewrites the
+ * sets of the spaces and inventories whose contents differ.
+ *
+ * @file snapshot.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdio.h>
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Snapshot of the mutable state of a game
+ *
+ * This struct stores the state in arrays indexed like the arrays of the game
+ */
+typedef struct _Snapshot Snapshot;
+
+/**
+ * @brief It creates a snapshot of the current state of a game
+ *
+ * Paged games are not supported, because their entities come and go with
+ * their regions.
+ *
+ * @param game A pointer to the game
+ * @return A new snapshot, NULL if there was an error or the game is paged
+ */
+Snapshot *snapshot_create(Game *game);
+
+/**
+ * @brief It creates a copy of a snapshot
+ *
+ * @param snapshot A pointer to the snapshot
+ * @return A new snapshot with the same state, NULL if there was an error
+ */
+Snapshot *snapshot_copy(Snapshot *snapshot);
+
+/**
+ * @brief It frees a snapshot
+ *
+ * @param snapshot A pointer to the snapshot
+ */
+void snapshot_destroy(Snapshot *snapshot);
+
+/**
+ * @brief It saves the current state of a game in a snapshot, reusing its memory
+ *
+ * @param snapshot A pointer to the snapshot
+ * @param game A pointer to the game
+ * @return OK if it was saved, ERROR otherwise (the snapshot is then not valid)
+ */
+Status snapshot_save(Snapshot *snapshot, Game *game);
+
+/**
+ * @brief It puts a game back in the state of a snapshot
+ *
+ * The game must have the same entities as when the snapshot was saved.
+ * The active player and the messages are not part of the state.
+ *
+ * @param snapshot A pointer to the snapshot
+ * @param game A pointer to the game
+ * @return OK if it was restored, ERROR otherwise
+ */
+Status snapshot_restore(Snapshot *snapshot, Game *game);
+
+/**
+ * @brief It tells whether two snapshots hold the same state
+ *
+ * @param a A pointer to a snapshot
+ * @param b A pointer to another snapshot
+ * @return TRUE if they are equal, FALSE otherwise or if there was an error
+ */
+Bool snapshot_equal(Snapshot *a, Snapshot *b);
+
+/**
+ * @brief It sets the hash a snapshot gives back to the game it is restored to
+ *
+ * @param snapshot A pointer to the snapshot
+ * @param hash The hash of the state, see game_get_hash
+ * @return OK if it was set, ERROR otherwise
+ */
+Status snapshot_set_hash(Snapshot *snapshot, unsigned long hash);
+
+/**
+ * @brief It gets the memory used by a snapshot
+ *
+ * @param snapshot A pointer to the snapshot
+ * @return The number of bytes, -1 if there was an error
+ */
+long snapshot_get_size(Snapshot *snapshot);
+
+/**
+ * @brief It writes a snapshot to a file
+ *
+ * The file holds the arrays as they are in memory, with the characters of
+ * the spaces written as their ids, so it is only read back by the same
+ * build of the program.
+ *
+ * @param snapshot A pointer to the snapshot
+ * @param f The file, open for writing
+ * @param mark A number kept with the snapshot, such as the turns played
+ * @return OK if it was written, ERROR otherwise
+ */
+Status snapshot_write(Snapshot *snapshot, FILE *f, long mark);
+
+/**
+ * @brief It reads a snapshot written by snapshot_write
+ *
+ * The game must be loaded from the same world file as the game of the
+ * snapshot, the snapshot can then be restored in it.
+ *
+ * @param f The file, open for reading
+ * @param game A pointer to the game
+ * @param mark Where the mark of the snapshot is stored, it can be NULL
+ * @return A new snapshot, NULL if there was an error or the file is not of this game
+ */
+Snapshot *snapshot_read(FILE *f, Game *game, long *mark);
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @brief It defines the solvability checker of a world
+ *
+ * Before a world is shipped, the solver checks that every player can reach
+ * the goal space (the Pantry) from where it starts and that every object can
+ * be taken by some player. It explores the states of the game breadth first
+ * for each player, running the real moves and takes of game_actions_update
+ * in a shadow of the game, so the doors of the #l: records and any other rule
+ * of the commands are the ones the players meet. A state is kept as the space
+ * of the player and the step that reached it, and a state already seen is
+ * found by its Zobrist hash in a transposition table, so each one is
+ * explored once and the first path found to a goal is a shortest one.
+ *
+ * Only what changes what a player can do is explored: every space is marked
+ * discovered and the followers of the player are dismissed before the search,
+ * and an object that is taken is put back, since carrying it does not open
+ * any door. The game is left as it was when the search ends.
+ *
+ * @file solver.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdio.h>
+
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Space the players have to reach, the Pantry of anthill.dat
+ */
+#define SOLVER_GOAL_SPACE 13
+
+/**
+ * @brief Kinds of goal checked by the solver
+ */
+typedef enum
+{
+	SOLVER_GOAL_REACH, /*!< A player reaches the goal space, the subject is the player */
+	SOLVER_GOAL_TAKE   /*!< Some player takes an object, the subject is the object */
+} SolverGoalKind;
+
+/**
+ * @brief Solvability checker
+ *
+ * This struct stores the states of the search and the goals found
+ */
+typedef struct _Solver Solver;
+
+/**
+ * @brief It creates a solver for a game
+ *
+ * The goals are one SOLVER_GOAL_REACH for each player, in the order of the
+ * players, and then one SOLVER_GOAL_TAKE for each object, in the order of
+ * the objects.
+ *
+ * @param game A pointer to the game, which must not be paged
+ * @param goal The id of the space the players have to reach
+ * @param max_states The number of states explored for each player before giving up, at least 1
+ * @return A new solver, NULL if there was an error
+ */
+Solver *solver_create(Game *game, Id goal, long max_states);
+
+/**
+ * @brief It frees a solver
+ *
+ * @param solver A pointer to the solver
+ */
+void solver_destroy(Solver *solver);
+
+/**
+ * @brief It searches the shortest way to every goal
+ *
+ * @param solver A pointer to the solver
+ * @return OK if the search was done, ERROR otherwise
+ */
+Status solver_run(Solver *solver);
+
+/**
+ * @brief It gets the number of goals
+ *
+ * @param solver A pointer to the solver
+ * @return The number of goals, -1 if there was an error
+ */
+int solver_get_n_goals(Solver *solver);
+
+/**
+ * @brief It gets the kind of a goal
+ *
+ * @param solver A pointer to the solver
+ * @param position The position of the goal
+ * @return The kind of goal, SOLVER_GOAL_REACH if there was an error
+ */
+SolverGoalKind solver_get_goal_kind(Solver *solver, int position);
+
+/**
+ * @brief It gets the player or the object of a goal
+ *
+ * @param solver A pointer to the solver
+ * @param position The position of the goal
+ * @return The id of the subject, NO_ID if there was an error
+ */
+Id solver_get_goal_subject(Solver *solver, int position);
+
+/**
+ * @brief It gets the number of commands of the shortest way to a goal
+ *
+ * @param solver A pointer to the solver
+ * @param position The position of the goal
+ * @return The number of commands, -1 if it was not reached or there was an error
+ */
+int solver_get_goal_length(Solver *solver, int position);
+
+/**
+ * @brief It gets the commands of the shortest way to a goal
+ *
+ * @param solver A pointer to the solver
+ * @param position The position of the goal
+ * @return The commands separated by ", ", NULL if it was not reached or there was an error
+ */
+const char *solver_get_goal_path(Solver *solver, int position);
+
+/**
+ * @brief It gets the player that reaches a goal
+ *
+ * @param solver A pointer to the solver
+ * @param position The position of the goal
+ * @return The position of the player, -1 if it was not reached or there was an error
+ */
+int solver_get_goal_player(Solver *solver, int position);
+
+/**
+ * @brief It gets the number of states explored by the last search
+ *
+ * @param solver A pointer to the solver
+ * @return The number of states of all the players, -1 if there was an error
+ */
+long solver_get_n_states(Solver *solver);
+
+/**
+ * @brief It tells whether the last search stopped at the limit of states
+ *
+ * Goals not reached by a search that stopped may still be reachable.
+ *
+ * @param solver A pointer to the solver
+ * @return TRUE if it stopped for some player, FALSE otherwise
+ */
+Bool solver_get_truncated(Solver *solver);
+
+/**
+ * @brief It prints the goals, with the shortest way to each one or why it was not reached
+ *
+ * @param pf The file to print to
+ * @param solver A pointer to the solver
+ * @return The number of goals not reached, -1 if there was an error
+ */
+int solver_print(FILE *pf, Solver *solver);
+
+#endif
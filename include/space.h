@@ -28,6 +28,11 @@
 
 /**
  * @brief Private implementation of space datatype
+ *
+ * A space is split in two: its id, discovered flag and characters, which
+ * moves and paint read for every space, are a small record taken from
+ * packed blocks, and its name and graphic description are kept apart, so
+ * walking the spaces of a world does not read them.
  */
 typedef struct _Space Space;
 
@@ -265,6 +270,15 @@ Status space_set_discovered(Space *space, Bool discovered);
  */
 Set *space_get_characters(Space *space);
 
+/**
+ * @brief It tells whether a character is in a space
+ *
+ * @param space A pointer to the space
+ * @param id The id of the character
+ * @return TRUE if the character is in the space, FALSE otherwise or if there was an error
+ */
+Bool space_has_character(Space *space, Id id);
+
 /**
  * @brief Removes a character in a given space
  * @author Daniel Martín Jaén
@@ -285,4 +299,37 @@ Status space_del_character(Space *space, Character *character);
  */
 Status space_add_character(Space *space, Character *character);
 
+/**
+ * @brief Gets the number of characters of one disposition in a space
+ *
+ * The characters of a space are kept split in hostile and friendly ones,
+ * so an attack or a chat only looks at the side it needs.
+ *
+ * @param space A pointer to the space
+ * @param friendly TRUE for the friendly characters, FALSE for the hostile ones
+ * @return The number of characters, -1 if there was an error
+ */
+int space_get_n_occupants(Space *space, Bool friendly);
+
+/**
+ * @brief Gets a character of one disposition in a space
+ *
+ * @param space A pointer to the space
+ * @param friendly TRUE for the friendly characters, FALSE for the hostile ones
+ * @param position The position among the characters of that disposition
+ * @return The character, NULL if there was an error
+ */
+Character *space_get_occupant_at(Space *space, Bool friendly, int position);
+
+/**
+ * @brief Moves a character of a space to the side of its current disposition
+ *
+ * It is called after the character becomes friendly or hostile.
+ *
+ * @param space A pointer to the space
+ * @param character A pointer to the character, which must be in the space
+ * @return ERROR if something went wrong, OK otherwise
+ */
+Status space_update_occupant(Space *space, Character *character);
+
 #endif
@@ -157,6 +157,34 @@
   * @post Output == ERROR
   */
  void test2_space_add_character();
+
+ /**
+  * @test Tests that the characters of a space are split by disposition
+  * @pre Valid space, two hostile and two friendly characters
+  * @post Two occupants of each disposition, hostile ones in the hostile side
+  */
+ void test1_space_get_n_occupants();
+
+ /**
+  * @test Tests the occupants left when characters leave a space
+  * @pre Valid space with hostile and friendly characters
+  * @post The remaining ones keep their side
+  */
+ void test1_space_get_occupant_at();
+
+ /**
+  * @test Tests moving a character to the side of its new disposition
+  * @pre Valid space with a friendly character that becomes hostile
+  * @post It is the hostile occupant
+  */
+ void test1_space_update_occupant();
+
+ /**
+  * @test Tests whether a character is in a space
+  * @pre Valid space with one character
+  * @post TRUE for it, FALSE for another one
+  */
+ void test1_space_has_character();
  
  #endif
  
\ No newline at end of file
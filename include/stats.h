@@ -0,0 +1,136 @@
+/**
+ * @brief It defines the runtime statistics module
+ *
+ * Latency counters and histograms for the hot paths of the game loop. The
+ * timing macros only generate code when the project is built with
+ * USE_STATS defined (make STATS=1), so the default build pays nothing.
+ *
+ * @file stats.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+#include "types.h"
+#include "command.h"
+
+/**
+ * @brief Number of histogram buckets per slot (4 sub-buckets per power of two)
+ */
+#define STATS_BUCKETS 256
+
+/**
+ * @brief Slots that can be measured
+ *
+ * The first N_CMD slots hold one entry per CommandCode, see stats_slot_for_command().
+ */
+typedef enum
+{
+    STATS_SLOT_ACTIONS = 0,                         /**< First game_actions_update slot (NO_CMD) */
+    STATS_SLOT_PAINT = N_CMD,                       /**< graphic_engine_paint_game */
+    STATS_SLOT_INPUT,                               /**< Time blocked in command_get_user_input */
+    STATS_SLOT_LOAD_PARSE,                          /**< Parsing of the chunks in game_load_world */
+    STATS_SLOT_LOAD_MERGE,                          /**< Merge of the chunks into the game in game_load_world */
+    STATS_SLOT_NPC,                                 /**< Tick of the behaviours of the characters in npc_tick */
+    STATS_SLOT_AUTOSAVE,                            /**< Pause of the game while autosave_start forks */
+    STATS_SLOT_RELOAD,                              /**< Apply of a new version of the data file in reload_apply */
+    STATS_N_SLOTS                                   /**< Number of slots */
+} StatsSlot;
+
+#ifdef USE_STATS
+/** @brief Stores the current time in the timer t */
+#define STATS_START(t) ((t) = stats_now())
+/** @brief Records the time elapsed since STATS_START(t) into the given slot */
+#define STATS_STOP(slot, t) stats_record((slot), stats_now() - (t))
+#else
+/** @brief Does nothing when statistics are disabled */
+#define STATS_START(t) ((void)(t))
+/** @brief Does nothing when statistics are disabled */
+#define STATS_STOP(slot, t) ((void)(t))
+#endif
+
+/**
+ * @brief Tells whether the timing macros were compiled in
+ *
+ * @return TRUE if the project was built with USE_STATS, FALSE otherwise
+ */
+Bool stats_enabled();
+
+/**
+ * @brief Reads the monotonic clock
+ *
+ * @return The current monotonic time in nanoseconds
+ */
+unsigned long stats_now();
+
+/**
+ * @brief Gets the slot used to measure a command
+ *
+ * @param cmd The command code
+ * @return The slot of that command, STATS_N_SLOTS if the code is out of range
+ */
+StatsSlot stats_slot_for_command(CommandCode cmd);
+
+/**
+ * @brief Records one measure in a slot
+ *
+ * @param slot The slot being measured
+ * @param ns The duration of the measure in nanoseconds
+ */
+void stats_record(StatsSlot slot, unsigned long ns);
+
+/**
+ * @brief Clears every slot
+ */
+void stats_reset();
+
+/**
+ * @brief Gets the number of measures recorded in a slot
+ *
+ * @param slot The slot
+ * @return The number of measures, 0 if the slot is not valid
+ */
+unsigned long stats_get_count(StatsSlot slot);
+
+/**
+ * @brief Estimates a percentile of the latencies recorded in a slot
+ *
+ * The estimate has the resolution of a histogram bucket (about 25%) and is
+ * clamped to the minimum and maximum recorded values.
+ *
+ * @param slot The slot
+ * @param percentile The percentile wanted, from 0 to 100
+ * @return The estimated latency in nanoseconds, 0 if there are no measures
+ */
+unsigned long stats_get_percentile(StatsSlot slot, int percentile);
+
+/**
+ * @brief Gets a printable name for a slot
+ *
+ * @param slot The slot
+ * @return The name of the slot, "?" if the slot is not valid
+ */
+const char *stats_slot_name(StatsSlot slot);
+
+/**
+ * @brief Writes a one line summary of every used slot
+ *
+ * @param buffer Where the summary is written
+ * @param size The size of the buffer
+ * @return OK if the summary was written, ERROR otherwise
+ */
+Status stats_summary(char *buffer, int size);
+
+/**
+ * @brief Prints a table with the call count and latencies of every used slot
+ *
+ * @param f The stream to print to
+ */
+void stats_print(FILE *f);
+
+#endif
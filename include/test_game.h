@@ -0,0 +1,53 @@
+/**
+ * @brief It defines the game the unit tests play on
+ *
+ * Several tests play the same anthill world: the first player, the ant,
+ * starts in space 11 with the Grain and the Crumb, the second one, the
+ * worm, in space 122, and the Spider waits south of it in space 123.
+ *
+ * @file test_game.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef TEST_GAME_H
+#define TEST_GAME_H
+
+#include "command.h"
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief File of the world of the tests, relative to the directory they are run from
+ */
+#define TEST_GAME_FILE "resources/anthill.dat"
+
+/**
+ * @brief It loads the anthill
+ *
+ * @return A new game, NULL if it could not be loaded
+ */
+Game *test_game_create();
+
+/**
+ * @brief It parses a command line into the command of a player, making that player the active one
+ *
+ * @param game A pointer to the game
+ * @param player The position of the player
+ * @param input The command line
+ * @return The command of the player, which the game keeps
+ */
+Command *test_game_command(Game *game, int player, const char *input);
+
+/**
+ * @brief It runs a command line as a player, with the command of the game
+ *
+ * @param game A pointer to the game
+ * @param player The position of the player
+ * @param input The command line
+ * @return The status of the command
+ */
+Status test_game_play(Game *game, int player, const char *input);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @brief It defines a transposition table keyed by the hash of a game state
+ *
+ * A search over the states of a game (a solver, the look-ahead of a
+ * character) reaches the same state through different orders of commands.
+ * The table maps the Zobrist hash of a state (see game_get_hash) to a value
+ * chosen by the search, such as a distance or a score, so a state is only
+ * explored once. It is an open addressing table with linear probing that
+ * grows when it is three quarters full, nothing stored is ever dropped.
+ *
+ * @file transposition.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include "types.h"
+
+/**
+ * @brief Transposition table
+ *
+ * This struct stores the hashes and their values
+ */
+typedef struct _Transpositions Transpositions;
+
+/**
+ * @brief It creates an empty table
+ *
+ * @param capacity The number of states it holds before growing, at least 1
+ * @return A new table, NULL if there was an error
+ */
+Transpositions *transposition_create(int capacity);
+
+/**
+ * @brief It frees a table
+ *
+ * @param table A pointer to the table
+ */
+void transposition_destroy(Transpositions *table);
+
+/**
+ * @brief It stores the value of a state, replacing the one it had
+ *
+ * @param table A pointer to the table
+ * @param hash The hash of the state
+ * @param value The value
+ * @return OK if it was stored, ERROR otherwise
+ */
+Status transposition_store(Transpositions *table, unsigned long hash, long value);
+
+/**
+ * @brief It looks up the value of a state
+ *
+ * @param table A pointer to the table
+ * @param hash The hash of the state
+ * @param value Where the value is stored if it is found, it can be NULL
+ * @return TRUE if the state is in the table, FALSE otherwise
+ */
+Bool transposition_lookup(Transpositions *table, unsigned long hash, long *value);
+
+/**
+ * @brief It gets the number of states in the table
+ *
+ * @param table A pointer to the table
+ * @return The number of states, -1 if there was an error
+ */
+int transposition_get_count(Transpositions *table);
+
+/**
+ * @brief It removes every state, keeping the memory of the table
+ *
+ * @param table A pointer to the table
+ * @return OK if it was emptied, ERROR otherwise
+ */
+Status transposition_clear(Transpositions *table);
+
+#endif
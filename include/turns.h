@@ -0,0 +1,64 @@
+/**
+ * @brief It defines the resolution of the commands of a turn
+ *
+ * The commands queued by the players in a turn are grouped by what they can
+ * touch: the space of the player, its neighbours and the followers that
+ * move with it, plus the data that some actions share in the whole game
+ * (the parties, objects, the random numbers of the attacks). Commands that
+ * conflict are in the same group and run in their queued order, and groups
+ * run in parallel, so the result is the same as running every command in
+ * order. That includes the states saved to undo them: each shadow saves the
+ * state before its commands that can change it, and they are kept in queued
+ * order for the commands that did not fail. This is only exact when the
+ * other groups do not change the game, so a turn with such commands in
+ * several groups runs in order. Each command can be given its own seed for
+ * the random numbers, as if srand() was called just before it.
+ *
+ * @file turns.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef TURNS_H
+#define TURNS_H
+
+#include "command.h"
+#include "game.h"
+#include "types.h"
+
+/**
+ * @brief Maximum number of threads used to resolve a turn
+ */
+#define TURNS_MAX_THREADS 64
+
+/**
+ * @brief It groups the commands of a turn that conflict
+ *
+ * @param game A pointer to the game
+ * @param players The position of the player of each command
+ * @param commands The commands, in the order they were queued
+ * @param n The number of commands
+ * @param groups Where the group of each command is stored, groups are numbered from 0 in queued order
+ * @return The number of groups, -1 if there was an error
+ */
+int turns_plan(Game *game, int *players, Command **commands, int n, int *groups);
+
+/**
+ * @brief It runs the commands of a turn, each group of conflicting commands on a thread
+ *
+ * A paged game, a turn with a single group, or one whose commands that can
+ * change the state are in several groups, runs in the calling thread.
+ * When it returns, the active player is the one of the last command.
+ *
+ * @param game A pointer to the game
+ * @param players The position of the player of each command
+ * @param commands The commands, in the order they were queued, their status is set
+ * @param n The number of commands
+ * @param seeds The seed given to srand() before each command, 0 or NULL to leave the random numbers as they are
+ * @param n_threads The maximum number of threads
+ * @return OK if the turn was resolved, ERROR if the arguments were not valid
+ */
+Status turns_resolve(Game *game, int *players, Command **commands, int n, unsigned int *seeds, int n_threads);
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @brief It defines the Zobrist hash of the state of a game
+ *
+ * The state that commands change is a list of features, each one a subject
+ * with a value: where a player is, who carries an object, the health of a
+ * character, whether a link is open... Every (kind, subject, value) has a
+ * 64-bit key, and the hash of a state is the XOR of the keys of its
+ * features. When a feature changes, the hash changes by the XOR of its old
+ * and new keys, so the game keeps it up to date in every mutation, and the
+ * changes made in different shadows can be joined in any order.
+ *
+ * The keys are mixed from the kind, the subject and the value, there is no
+ * table of random keys to store or to seed.
+ *
+ * @file zobrist.h
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "types.h"
+
+/**
+ * @brief Kinds of feature of the state, and what the subject and the value are for each one
+ */
+typedef enum
+{
+	ZOBRIST_PLAYER_AT,		  /*!< subject: player, value: its space */
+	ZOBRIST_PLAYER_HEALTH,	  /*!< subject: player, value: its health */
+	ZOBRIST_OBJECT_AT,		  /*!< subject: object, value: its space, NO_ID if it is carried */
+	ZOBRIST_CARRIED_BY,		  /*!< subject: object, value: the player that carries it, NO_ID if none */
+	ZOBRIST_CHARACTER_AT,	  /*!< subject: character, value: its space, NO_ID if none */
+	ZOBRIST_CHARACTER_HEALTH, /*!< subject: character, value: its health */
+	ZOBRIST_FOLLOWS,		  /*!< subject: character, value: the player it follows, NO_ID if none */
+	ZOBRIST_LINK_OPEN,		  /*!< subject: link, value: TRUE or FALSE */
+	ZOBRIST_DISCOVERED,		  /*!< subject: space, value: TRUE or FALSE */
+	ZOBRIST_KINDS			  /*!< Number of kinds */
+} ZobristKind;
+
+/**
+ * @brief It gets the key of a feature with a value
+ *
+ * @param kind The kind of feature
+ * @param subject The id of the subject
+ * @param value The value
+ * @return The key
+ */
+unsigned long zobrist_key(ZobristKind kind, Id subject, Id value);
+
+/**
+ * @brief It gets how the hash changes when a feature changes its value
+ *
+ * @param kind The kind of feature
+ * @param subject The id of the subject
+ * @param old_value The value before the change
+ * @param new_value The value after the change
+ * @return The XOR of both keys, 0 if the value is the same
+ */
+unsigned long zobrist_change(ZobristKind kind, Id subject, Id old_value, Id new_value);
+
+#endif
@@ -0,0 +1,451 @@
+/**
+ * @brief It implements the store of the simulated ants
+ *
+ * @file agents.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "agents.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+/**
+ * @brief Tells whether an id fits in the 32 bits of the store
+ */
+#define AGENTS_FITS(id) ((id) >= INT_MIN && (id) <= INT_MAX)
+
+/**
+ * @brief Private implementation of the store
+ *
+ * Ids are kept in 32 bits: with SSE2 alone there is no 64-bit compare, so
+ * the loops over Id arrays would not be vectorized, and the arrays are half
+ * as big. The bulk loops copy the arrays to local pointers, so the compiler
+ * knows the count and the pointers do not change inside them.
+ */
+struct _Agents
+{
+	int *ids;		 /*!< Id of each ant */
+	int *locations;	 /*!< Id of the space of each ant */
+	int *health;	 /*!< Health points of each ant */
+	char *friendly;	 /*!< 1 if the ant is friendly, 0 otherwise */
+	int *following;	 /*!< Id of the leader of each ant, NO_ID if it follows nobody */
+	int n_agents;	 /*!< Number of ants */
+	int max_agents;	 /*!< Number of ants the arrays have room for */
+};
+
+Agents *agents_create()
+{
+	Agents *agents = NULL;
+
+	if (!(agents = (Agents *)calloc(1, sizeof(Agents))))
+	{
+		return NULL;
+	}
+
+	return agents;
+}
+
+void agents_destroy(Agents *agents)
+{
+	if (!agents)
+	{
+		return;
+	}
+
+	free(agents->ids);
+	free(agents->locations);
+	free(agents->health);
+	free(agents->friendly);
+	free(agents->following);
+	free(agents);
+}
+
+/**
+ * @brief It grows an array of the store
+ *
+ * @param array A pointer to the array, which is replaced
+ * @param size The size of an element
+ * @param capacity The new number of elements
+ * @return OK if the array grew, ERROR otherwise (the old array is kept)
+ */
+static Status agents_grow(void **array, size_t size, int capacity)
+{
+	void *grown = NULL;
+
+	if (!(grown = realloc(*array, size * capacity)))
+	{
+		return ERROR;
+	}
+
+	*array = grown;
+	return OK;
+}
+
+Status agents_reserve(Agents *agents, int n)
+{
+	int capacity;
+
+	if (!agents || n < 0)
+	{
+		return ERROR;
+	}
+
+	if (n <= agents->max_agents)
+	{
+		return OK;
+	}
+
+	capacity = agents->max_agents > 0 ? agents->max_agents : 16;
+	while (capacity < n)
+	{
+		capacity *= 2;
+	}
+
+	/* Every array is grown before the capacity changes, a failure leaves the store as it was */
+	if (agents_grow((void **)&agents->ids, sizeof(int), capacity) == ERROR || agents_grow((void **)&agents->locations, sizeof(int), capacity) == ERROR ||
+		agents_grow((void **)&agents->health, sizeof(int), capacity) == ERROR || agents_grow((void **)&agents->friendly, sizeof(char), capacity) == ERROR ||
+		agents_grow((void **)&agents->following, sizeof(int), capacity) == ERROR)
+	{
+		return ERROR;
+	}
+
+	agents->max_agents = capacity;
+	return OK;
+}
+
+int agents_add(Agents *agents, Id id, Id location, int health, Bool friendly)
+{
+	int position;
+
+	if (!agents || id == NO_ID || !AGENTS_FITS(id) || !AGENTS_FITS(location) || agents_reserve(agents, agents->n_agents + 1) == ERROR)
+	{
+		return -1;
+	}
+
+	position = agents->n_agents++;
+	agents->ids[position] = (int)id;
+	agents->locations[position] = (int)location;
+	agents->health[position] = health;
+	agents->friendly[position] = (friendly == TRUE) ? 1 : 0;
+	agents->following[position] = NO_ID;
+
+	return position;
+}
+
+int agents_get_count(Agents *agents)
+{
+	if (!agents)
+	{
+		return -1;
+	}
+
+	return agents->n_agents;
+}
+
+int agents_find(Agents *agents, Id id)
+{
+	int i;
+
+	if (!agents || id == NO_ID || !AGENTS_FITS(id))
+	{
+		return -1;
+	}
+
+	for (i = 0; i < agents->n_agents; i++)
+	{
+		if (agents->ids[i] == id)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+Id agents_get_id(Agents *agents, int position)
+{
+	if (!agents || position < 0 || position >= agents->n_agents)
+	{
+		return NO_ID;
+	}
+
+	return agents->ids[position];
+}
+
+Id agents_get_location(Agents *agents, int position)
+{
+	if (!agents || position < 0 || position >= agents->n_agents)
+	{
+		return NO_ID;
+	}
+
+	return agents->locations[position];
+}
+
+Status agents_set_location(Agents *agents, int position, Id location)
+{
+	if (!agents || position < 0 || position >= agents->n_agents || !AGENTS_FITS(location))
+	{
+		return ERROR;
+	}
+
+	agents->locations[position] = (int)location;
+	return OK;
+}
+
+int agents_get_health(Agents *agents, int position)
+{
+	if (!agents || position < 0 || position >= agents->n_agents)
+	{
+		return 0;
+	}
+
+	return agents->health[position];
+}
+
+Status agents_set_health(Agents *agents, int position, int health)
+{
+	if (!agents || position < 0 || position >= agents->n_agents)
+	{
+		return ERROR;
+	}
+
+	agents->health[position] = health;
+	return OK;
+}
+
+Bool agents_get_friendly(Agents *agents, int position)
+{
+	if (!agents || position < 0 || position >= agents->n_agents)
+	{
+		return FALSE;
+	}
+
+	return agents->friendly[position] ? TRUE : FALSE;
+}
+
+Id agents_get_following(Agents *agents, int position)
+{
+	if (!agents || position < 0 || position >= agents->n_agents)
+	{
+		return NO_ID;
+	}
+
+	return agents->following[position];
+}
+
+Status agents_set_following(Agents *agents, int position, Id following)
+{
+	if (!agents || position < 0 || position >= agents->n_agents || !AGENTS_FITS(following))
+	{
+		return ERROR;
+	}
+
+	agents->following[position] = (int)following;
+	return OK;
+}
+
+int agents_count_at(Agents *agents, Id location)
+{
+	const int *locations;
+	int i, n, key, count = 0;
+
+	if (!agents)
+	{
+		return -1;
+	}
+	if (!AGENTS_FITS(location))
+	{
+		return 0;
+	}
+
+	/* The arguments are compared as int too, a long would widen the whole loop */
+	key = (int)location;
+	locations = agents->locations;
+	n = agents->n_agents;
+	for (i = 0; i < n; i++)
+	{
+		count += (locations[i] == key);
+	}
+
+	return count;
+}
+
+int agents_move(Agents *agents, Id from, Id to)
+{
+	int *locations;
+	int i, n, key, value, hit, count = 0;
+
+	if (!agents || !AGENTS_FITS(to))
+	{
+		return -1;
+	}
+	if (!AGENTS_FITS(from))
+	{
+		return 0;
+	}
+
+	key = (int)from;
+	value = (int)to;
+	locations = agents->locations;
+	n = agents->n_agents;
+	for (i = 0; i < n; i++)
+	{
+		hit = (locations[i] == key);
+		locations[i] = hit ? value : locations[i];
+		count += hit;
+	}
+
+	return count;
+}
+
+int agents_follow(Agents *agents, Id leader, Id location)
+{
+	int *locations;
+	const int *following;
+	int i, n, key, value, hit, count = 0;
+
+	if (!agents || leader == NO_ID || !AGENTS_FITS(location))
+	{
+		return -1;
+	}
+	if (!AGENTS_FITS(leader))
+	{
+		return 0;
+	}
+
+	key = (int)leader;
+	value = (int)location;
+	locations = agents->locations;
+	following = agents->following;
+	n = agents->n_agents;
+	for (i = 0; i < n; i++)
+	{
+		hit = (following[i] == key);
+		locations[i] = hit ? value : locations[i];
+		count += hit;
+	}
+
+	return count;
+}
+
+int agents_recruit(Agents *agents, Id leader, Id location)
+{
+	const int *locations;
+	const char *friendly;
+	int *following;
+	int i, n, key, value, hit, count = 0;
+
+	if (!agents || leader == NO_ID || !AGENTS_FITS(leader))
+	{
+		return -1;
+	}
+	if (!AGENTS_FITS(location))
+	{
+		return 0;
+	}
+
+	key = (int)location;
+	value = (int)leader;
+	locations = agents->locations;
+	friendly = agents->friendly;
+	following = agents->following;
+	n = agents->n_agents;
+	for (i = 0; i < n; i++)
+	{
+		hit = (locations[i] == key) & (friendly[i] != 0) & (following[i] == NO_ID);
+		following[i] = hit ? value : following[i];
+		count += hit;
+	}
+
+	return count;
+}
+
+int agents_abandon(Agents *agents, Id leader)
+{
+	int *following;
+	int i, n, key, hit, count = 0;
+
+	if (!agents || leader == NO_ID)
+	{
+		return -1;
+	}
+	if (!AGENTS_FITS(leader))
+	{
+		return 0;
+	}
+
+	key = (int)leader;
+	following = agents->following;
+	n = agents->n_agents;
+	for (i = 0; i < n; i++)
+	{
+		hit = (following[i] == key);
+		following[i] = hit ? NO_ID : following[i];
+		count += hit;
+	}
+
+	return count;
+}
+
+int agents_damage(Agents *agents, Id location, int damage)
+{
+	const int *locations;
+	const char *friendly;
+	int *health;
+	int i, n, key, hit, count = 0;
+
+	if (!agents)
+	{
+		return -1;
+	}
+	if (!AGENTS_FITS(location))
+	{
+		return 0;
+	}
+
+	key = (int)location;
+	locations = agents->locations;
+	friendly = agents->friendly;
+	health = agents->health;
+	n = agents->n_agents;
+	for (i = 0; i < n; i++)
+	{
+		hit = (locations[i] == key) & (friendly[i] == 0);
+		health[i] -= hit * damage;
+		count += hit;
+	}
+
+	return count;
+}
+
+int agents_remove_dead(Agents *agents)
+{
+	int i, kept = 0, removed;
+
+	if (!agents)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < agents->n_agents; i++)
+	{
+		if (agents->health[i] <= 0)
+		{
+			continue;
+		}
+		agents->ids[kept] = agents->ids[i];
+		agents->locations[kept] = agents->locations[i];
+		agents->health[kept] = agents->health[i];
+		agents->friendly[kept] = agents->friendly[i];
+		agents->following[kept] = agents->following[i];
+		kept++;
+	}
+
+	removed = agents->n_agents - kept;
+	agents->n_agents = kept;
+	return removed;
+}
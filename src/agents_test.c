@@ -0,0 +1,247 @@
+/**
+ * @brief It tests the store of the simulated ants
+ *
+ * @file agents_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "agents.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 9
+
+/**
+ * @brief Test that an ant is added with its fields.
+ */
+void test1_agents_add();
+
+/**
+ * @brief Test that ids that do not fit in 32 bits are rejected.
+ */
+void test2_agents_add();
+
+/**
+ * @brief Test that the store grows past its first capacity.
+ */
+void test1_agents_reserve();
+
+/**
+ * @brief Test that the ants of a space move to another one.
+ */
+void test1_agents_move();
+
+/**
+ * @brief Test that only friendly ants without leader are recruited.
+ */
+void test1_agents_recruit();
+
+/**
+ * @brief Test that followers go to their leader and are abandoned.
+ */
+void test1_agents_follow();
+
+/**
+ * @brief Test that only the hostile ants of a space are hurt.
+ */
+void test1_agents_damage();
+
+/**
+ * @brief Test that dead ants are removed keeping the order of the rest.
+ */
+void test1_agents_remove_dead();
+
+/**
+ * @brief Test that a NULL store is rejected.
+ */
+void test3_agents_add();
+
+/**
+ * @brief Main function for agents unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Agents:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_agents_add();
+	if (all || test == 2)
+		test2_agents_add();
+	if (all || test == 3)
+		test1_agents_reserve();
+	if (all || test == 4)
+		test1_agents_move();
+	if (all || test == 5)
+		test1_agents_recruit();
+	if (all || test == 6)
+		test1_agents_follow();
+	if (all || test == 7)
+		test1_agents_damage();
+	if (all || test == 8)
+		test1_agents_remove_dead();
+	if (all || test == 9)
+		test3_agents_add();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It creates a store with six ants: 1-3 friendly in space 10, 4-5 hostile in space 10, 6 hostile in space 20
+ *
+ * @return A new store, NULL if there was an error
+ */
+static Agents *colony_create()
+{
+	Agents *agents = NULL;
+	Id id;
+
+	if (!(agents = agents_create()))
+	{
+		return NULL;
+	}
+
+	for (id = 1; id <= 6; id++)
+	{
+		if (agents_add(agents, id, id == 6 ? 20 : 10, 10, id <= 3 ? TRUE : FALSE) < 0)
+		{
+			agents_destroy(agents);
+			return NULL;
+		}
+	}
+
+	return agents;
+}
+
+void test1_agents_add()
+{
+	Agents *agents = agents_create();
+	int position = agents_add(agents, 7, 11, 25, TRUE);
+
+	PRINT_TEST_RESULT(position == 0 && agents_get_count(agents) == 1 && agents_get_id(agents, 0) == 7 && agents_get_location(agents, 0) == 11 &&
+					  agents_get_health(agents, 0) == 25 && agents_get_friendly(agents, 0) == TRUE && agents_get_following(agents, 0) == NO_ID &&
+					  agents_find(agents, 7) == 0 && agents_find(agents, 8) == -1 && agents_get_id(agents, 1) == NO_ID);
+	agents_destroy(agents);
+}
+
+void test2_agents_add()
+{
+	Agents *agents = agents_create();
+
+	PRINT_TEST_RESULT(agents_add(agents, (Id)INT_MAX + 1, 11, 25, TRUE) == -1 && agents_add(agents, 7, (Id)INT_MAX + 1, 25, TRUE) == -1 &&
+					  agents_add(agents, NO_ID, 11, 25, TRUE) == -1 && agents_get_count(agents) == 0 && agents_add(agents, 7, 11, 25, TRUE) == 0 &&
+					  agents_set_following(agents, 0, (Id)INT_MAX + 1) == ERROR && agents_count_at(agents, (Id)INT_MAX + 1) == 0);
+	agents_destroy(agents);
+}
+
+void test1_agents_reserve()
+{
+	Agents *agents = agents_create();
+	Bool ok = agents ? TRUE : FALSE;
+	int i;
+
+	for (i = 0; i < 1000 && ok == TRUE; i++)
+	{
+		ok = agents_add(agents, i + 1, i % 3, 1, FALSE) == i ? TRUE : FALSE;
+	}
+	PRINT_TEST_RESULT(ok == TRUE && agents_get_count(agents) == 1000 && agents_get_id(agents, 999) == 1000 && agents_count_at(agents, 0) == 334 &&
+					  agents_reserve(agents, 5000) == OK && agents_reserve(agents, -1) == ERROR);
+	agents_destroy(agents);
+}
+
+void test1_agents_move()
+{
+	Agents *agents = colony_create();
+
+	PRINT_TEST_RESULT(agents_move(agents, 10, 30) == 5 && agents_count_at(agents, 10) == 0 && agents_count_at(agents, 30) == 5 &&
+					  agents_get_location(agents, 5) == 20 && agents_move(agents, 10, 30) == 0);
+	agents_destroy(agents);
+}
+
+void test1_agents_recruit()
+{
+	Agents *agents = colony_create();
+	int first, second;
+
+	agents_set_following(agents, 0, 99);
+	first = agents_recruit(agents, 1, 10);
+	second = agents_recruit(agents, 1, 10);
+	PRINT_TEST_RESULT(first == 2 && second == 0 && agents_get_following(agents, 0) == 99 && agents_get_following(agents, 1) == 1 &&
+					  agents_get_following(agents, 2) == 1 && agents_get_following(agents, 3) == NO_ID && agents_recruit(agents, NO_ID, 10) == -1);
+	agents_destroy(agents);
+}
+
+void test1_agents_follow()
+{
+	Agents *agents = colony_create();
+	int moved, left;
+
+	agents_recruit(agents, 1, 10);
+	moved = agents_follow(agents, 1, 40);
+	left = agents_abandon(agents, 1);
+	PRINT_TEST_RESULT(moved == 3 && agents_count_at(agents, 40) == 3 && agents_get_location(agents, 3) == 10 && left == 3 &&
+					  agents_follow(agents, 1, 50) == 0 && agents_count_at(agents, 40) == 3);
+	agents_destroy(agents);
+}
+
+void test1_agents_damage()
+{
+	Agents *agents = colony_create();
+
+	PRINT_TEST_RESULT(agents_damage(agents, 10, 4) == 2 && agents_get_health(agents, 0) == 10 && agents_get_health(agents, 3) == 6 &&
+					  agents_get_health(agents, 4) == 6 && agents_get_health(agents, 5) == 10);
+	agents_destroy(agents);
+}
+
+void test1_agents_remove_dead()
+{
+	Agents *agents = colony_create();
+	int removed;
+
+	agents_set_health(agents, 1, 0);
+	agents_damage(agents, 20, 10);
+	removed = agents_remove_dead(agents);
+	PRINT_TEST_RESULT(removed == 2 && agents_get_count(agents) == 4 && agents_get_id(agents, 0) == 1 && agents_get_id(agents, 1) == 3 &&
+					  agents_get_id(agents, 2) == 4 && agents_get_id(agents, 3) == 5 && agents_get_friendly(agents, 1) == TRUE &&
+					  agents_find(agents, 6) == -1);
+	agents_destroy(agents);
+}
+
+void test3_agents_add()
+{
+	PRINT_TEST_RESULT(agents_add(NULL, 1, 10, 10, TRUE) == -1 && agents_get_count(NULL) == -1 && agents_move(NULL, 10, 20) == -1 &&
+					  agents_damage(NULL, 10, 1) == -1 && agents_remove_dead(NULL) == -1 && agents_get_location(NULL, 0) == NO_ID &&
+					  agents_set_health(NULL, 0, 1) == ERROR);
+}
@@ -0,0 +1,324 @@
+/**
+ * @brief It implements the saves of a game in the background
+ *
+ * @file autosave.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "autosave.h"
+#include "snapshot.h"
+#include "stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief Room for the suffixes added to the name of the save file
+ */
+#define AUTOSAVE_SUFFIX_SIZE 24
+
+/**
+ * @brief Private implementation of the saver
+ */
+struct _Autosave
+{
+	char *path;				 /*!< Name of the save file */
+	char *name;				 /*!< Buffer for the names of the temporary and the older files */
+	char *other;			 /*!< Buffer for a second name, to rename from name to other */
+	int every_turns;		 /*!< Turns between saves, 0 if not by turns */
+	long every_seconds;		 /*!< Seconds between saves, 0 if not by time */
+	int keep;				 /*!< Number of files kept */
+	int turns;				 /*!< Turns since the last save started */
+	time_t last;			 /*!< When the last save started */
+	pid_t child;			 /*!< Process writing the save, 0 if none */
+	long mark;				 /*!< Mark of the save being written */
+	long last_mark;			 /*!< Mark of the last save written, -1 if none */
+	int n_saves;			 /*!< Saves written */
+	int n_failed;			 /*!< Saves that failed */
+	unsigned long max_pause; /*!< Longest fork, in nanoseconds */
+};
+
+Autosave *autosave_create(const char *path, int every_turns, long every_seconds, int keep)
+{
+	Autosave *autosave = NULL;
+	size_t size;
+
+	if (!path || every_turns < 0 || every_seconds < 0 || keep < 1 || !(autosave = (Autosave *)calloc(1, sizeof(Autosave))))
+	{
+		return NULL;
+	}
+
+	size = strlen(path) + AUTOSAVE_SUFFIX_SIZE;
+	autosave->path = (char *)malloc(size);
+	autosave->name = (char *)malloc(size);
+	autosave->other = (char *)malloc(size);
+	if (!autosave->path || !autosave->name || !autosave->other)
+	{
+		autosave_destroy(autosave);
+		return NULL;
+	}
+
+	strcpy(autosave->path, path);
+	autosave->every_turns = every_turns;
+	autosave->every_seconds = every_seconds;
+	autosave->keep = keep;
+	autosave->last = time(NULL);
+	autosave->last_mark = -1;
+	return autosave;
+}
+
+void autosave_destroy(Autosave *autosave)
+{
+	if (!autosave)
+	{
+		return;
+	}
+
+	autosave_wait(autosave);
+	free(autosave->path);
+	free(autosave->name);
+	free(autosave->other);
+	free(autosave);
+}
+
+/**
+ * @brief Moves the older saves one place back and links the last one as the first older save
+ *
+ * Every step is a rename or a link, so a crash leaves every file whole,
+ * and the save file itself is only replaced afterwards by the rename of
+ * the new one.
+ */
+static void autosave_rotate(Autosave *autosave)
+{
+	int i;
+
+	for (i = autosave->keep - 1; i > 1; i--)
+	{
+		sprintf(autosave->name, "%s.%d", autosave->path, i - 1);
+		sprintf(autosave->other, "%s.%d", autosave->path, i);
+		rename(autosave->name, autosave->other);
+	}
+	if (autosave->keep > 1)
+	{
+		sprintf(autosave->name, "%s.1", autosave->path);
+		unlink(autosave->name);
+		link(autosave->path, autosave->name);
+	}
+}
+
+/**
+ * @brief Writes the save, run by the child
+ *
+ * @return 0 if it was written, 1 otherwise, the exit status of the child
+ */
+static int autosave_write(Autosave *autosave, Game *game, long mark)
+{
+	Snapshot *snapshot = NULL;
+	FILE *f = NULL;
+	Status status = ERROR;
+
+	sprintf(autosave->name, "%s.tmp", autosave->path);
+	if ((snapshot = snapshot_create(game)) != NULL && (f = fopen(autosave->name, "wb")) != NULL)
+	{
+		/* The undo ring goes with the state, so an undo replayed from the save finds what it undoes */
+		if ((status = snapshot_write(snapshot, f, mark)) == OK)
+		{
+			status = game_write_undo(game, f);
+		}
+		/* The data must be on disk before the rename makes it the save */
+		if (fflush(f) != 0 || fsync(fileno(f)) != 0)
+		{
+			status = ERROR;
+		}
+		if (fclose(f) != 0)
+		{
+			status = ERROR;
+		}
+	}
+	snapshot_destroy(snapshot);
+
+	if (status == ERROR)
+	{
+		unlink(autosave->name);
+		return 1;
+	}
+
+	autosave_rotate(autosave);
+	sprintf(autosave->name, "%s.tmp", autosave->path);
+	return rename(autosave->name, autosave->path) == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Collects the child when it has finished
+ *
+ * @param autosave A pointer to the saver
+ * @param block TRUE to wait for it, FALSE to only check
+ * @return OK if there is no child any more and its save was written, ERROR otherwise
+ */
+static Status autosave_reap(Autosave *autosave, Bool block)
+{
+	int exit_status;
+	pid_t pid;
+
+	if (autosave->child == 0)
+	{
+		return OK;
+	}
+
+	pid = waitpid(autosave->child, &exit_status, block == TRUE ? 0 : WNOHANG);
+	if (pid == 0)
+	{
+		return ERROR;
+	}
+
+	autosave->child = 0;
+	if (pid < 0 || !WIFEXITED(exit_status) || WEXITSTATUS(exit_status) != 0)
+	{
+		autosave->n_failed++;
+		return ERROR;
+	}
+
+	autosave->n_saves++;
+	autosave->last_mark = autosave->mark;
+	return OK;
+}
+
+Status autosave_tick(Autosave *autosave, Game *game, long mark)
+{
+	if (!autosave || !game)
+	{
+		return ERROR;
+	}
+
+	autosave_reap(autosave, FALSE);
+	autosave->turns++;
+	if ((autosave->every_turns > 0 && autosave->turns >= autosave->every_turns) ||
+		(autosave->every_seconds > 0 && time(NULL) - autosave->last >= autosave->every_seconds))
+	{
+		/* A save still running leaves this one due for the next tick */
+		if (autosave->child != 0)
+		{
+			return OK;
+		}
+		return autosave_start(autosave, game, mark);
+	}
+
+	return OK;
+}
+
+Status autosave_start(Autosave *autosave, Game *game, long mark)
+{
+	unsigned long t, pause;
+	pid_t pid;
+
+	if (!autosave || !game || game_get_regions(game))
+	{
+		return ERROR;
+	}
+
+	autosave_reap(autosave, FALSE);
+	if (autosave->child != 0)
+	{
+		return ERROR;
+	}
+
+	/* The child leaves with _exit, so it does not flush the buffers of stdio it shares with the game */
+	t = stats_now();
+	pid = fork();
+	if (pid == 0)
+	{
+		_exit(autosave_write(autosave, game, mark));
+	}
+	pause = stats_now() - t;
+	STATS_STOP(STATS_SLOT_AUTOSAVE, t);
+	if (pid < 0)
+	{
+		autosave->n_failed++;
+		return ERROR;
+	}
+
+	autosave->child = pid;
+	autosave->mark = mark;
+	autosave->turns = 0;
+	autosave->last = time(NULL);
+	if (pause > autosave->max_pause)
+	{
+		autosave->max_pause = pause;
+	}
+	return OK;
+}
+
+Status autosave_wait(Autosave *autosave)
+{
+	if (!autosave)
+	{
+		return ERROR;
+	}
+
+	return autosave_reap(autosave, TRUE);
+}
+
+int autosave_get_n_saves(Autosave *autosave)
+{
+	if (!autosave)
+	{
+		return -1;
+	}
+
+	return autosave->n_saves;
+}
+
+int autosave_get_n_failed(Autosave *autosave)
+{
+	if (!autosave)
+	{
+		return -1;
+	}
+
+	return autosave->n_failed;
+}
+
+unsigned long autosave_get_max_pause(Autosave *autosave)
+{
+	if (!autosave)
+	{
+		return 0;
+	}
+
+	return autosave->max_pause;
+}
+
+long autosave_get_last_mark(Autosave *autosave)
+{
+	if (!autosave)
+	{
+		return -1;
+	}
+
+	return autosave->last_mark;
+}
+
+const char *autosave_get_file(Autosave *autosave, int age)
+{
+	if (!autosave || age < 0 || age >= autosave->keep)
+	{
+		return NULL;
+	}
+
+	if (age == 0)
+	{
+		return autosave->path;
+	}
+
+	sprintf(autosave->name, "%s.%d", autosave->path, age);
+	return autosave->name;
+}
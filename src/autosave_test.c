@@ -0,0 +1,280 @@
+/**
+ * @brief It tests the saves of a game in the background
+ *
+ * @file autosave_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autosave.h"
+#include "game_actions.h"
+#include "snapshot.h"
+#include "test.h"
+#include "test_game.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 6
+
+/**
+ * @brief Save file of the tests, in the directory they are run from
+ */
+#define SAVE_FILE "autosave_test.save"
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_autosave_create();
+
+/**
+ * @brief Test that a save holds the state of the game and its mark.
+ */
+void test1_autosave_start();
+
+/**
+ * @brief Test that the save holds the game as it was when it started, not the changes made while it runs.
+ */
+void test2_autosave_start();
+
+/**
+ * @brief Test that a save holds the undo ring, so a game put back from it undoes the same commands.
+ */
+void test3_autosave_start();
+
+/**
+ * @brief Test that a save starts every few turns and not before.
+ */
+void test1_autosave_tick();
+
+/**
+ * @brief Test that only the last saves are kept, each one moved back by the next.
+ */
+void test2_autosave_tick();
+
+/**
+ * @brief Main function for autosave unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Autosave:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	/* The output is flushed so the children do not inherit what is still buffered */
+	fflush(stdout);
+	if (all || test == 1)
+		test1_autosave_create();
+	if (all || test == 2)
+		test1_autosave_start();
+	if (all || test == 3)
+		test2_autosave_start();
+	if (all || test == 6)
+		test3_autosave_start();
+	if (all || test == 4)
+		test1_autosave_tick();
+	if (all || test == 5)
+		test2_autosave_tick();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It reads a save file
+ *
+ * @return The location of the first player in the save, NO_ID if it could not be read
+ */
+static Id read_save(Game *game, const char *name, long *mark)
+{
+	Snapshot *snapshot = NULL;
+	FILE *f = fopen(name, "rb");
+	Game *copy = test_game_create();
+	Id location = NO_ID;
+
+	if (f && copy && (snapshot = snapshot_read(f, game, mark)) != NULL && snapshot_restore(snapshot, copy) == OK)
+	{
+		location = player_get_location(game_get_player_at(copy, 0));
+	}
+	if (f)
+	{
+		fclose(f);
+	}
+	snapshot_destroy(snapshot);
+	game_destroy(copy);
+	return location;
+}
+
+/**
+ * @brief It removes the files of the tests
+ */
+static void remove_saves()
+{
+	remove(SAVE_FILE);
+	remove(SAVE_FILE ".1");
+	remove(SAVE_FILE ".2");
+	remove(SAVE_FILE ".3");
+	remove(SAVE_FILE ".tmp");
+}
+
+void test1_autosave_create()
+{
+	Autosave *autosave = autosave_create(SAVE_FILE, 1, 0, 1);
+	Game *game = NULL;
+
+	game_create(&game);
+	PRINT_TEST_RESULT(autosave && autosave_create(NULL, 1, 0, 1) == NULL && autosave_create(SAVE_FILE, -1, 0, 1) == NULL &&
+					  autosave_create(SAVE_FILE, 1, 0, 0) == NULL && autosave_start(NULL, game, 0) == ERROR && autosave_start(autosave, NULL, 0) == ERROR &&
+					  autosave_tick(NULL, game, 0) == ERROR && autosave_wait(NULL) == ERROR && autosave_wait(autosave) == OK &&
+					  autosave_get_n_saves(autosave) == 0 && autosave_get_n_saves(NULL) == -1 && autosave_get_max_pause(NULL) == 0);
+	autosave_destroy(autosave);
+	game_destroy(game);
+}
+
+void test1_autosave_start()
+{
+	Game *game = test_game_create();
+	Autosave *autosave = autosave_create(SAVE_FILE, 0, 0, 1);
+	long mark = 0;
+
+	remove_saves();
+	test_game_play(game, 0, "m s");
+	PRINT_TEST_RESULT(autosave_start(autosave, game, 7) == OK && autosave_wait(autosave) == OK && autosave_get_n_saves(autosave) == 1 &&
+					  autosave_get_n_failed(autosave) == 0 && autosave_get_max_pause(autosave) > 0 && read_save(game, SAVE_FILE, &mark) == 121 &&
+					  mark == 7);
+	autosave_destroy(autosave);
+	game_destroy(game);
+	remove_saves();
+}
+
+void test2_autosave_start()
+{
+	Game *game = test_game_create();
+	Autosave *autosave = autosave_create(SAVE_FILE, 0, 0, 1);
+	FILE *f = NULL;
+
+	remove_saves();
+	autosave_start(autosave, game, 0);
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "m s");
+	autosave_wait(autosave);
+	f = fopen(SAVE_FILE ".tmp", "rb");
+	PRINT_TEST_RESULT(read_save(game, SAVE_FILE, NULL) == 11 && player_get_location(game_get_player_at(game, 0)) == 122 && f == NULL);
+	if (f)
+	{
+		fclose(f);
+	}
+	autosave_destroy(autosave);
+	game_destroy(game);
+	remove_saves();
+}
+
+void test3_autosave_start()
+{
+	Game *game = test_game_create(), *copy = test_game_create();
+	Autosave *autosave = autosave_create(SAVE_FILE, 0, 0, 1);
+	Snapshot *snapshot = NULL;
+	FILE *f = NULL;
+	Bool restored = FALSE;
+
+	remove_saves();
+	test_game_play(game, 0, "t Grain");
+	test_game_play(game, 0, "m s");
+	autosave_start(autosave, game, 0);
+	autosave_wait(autosave);
+	if ((f = fopen(SAVE_FILE, "rb")) != NULL)
+	{
+		snapshot = snapshot_read(f, copy, NULL);
+		restored = snapshot && game_read_undo(copy, f) == OK && snapshot_restore(snapshot, copy) == OK ? TRUE : FALSE;
+		fclose(f);
+	}
+	test_game_play(game, 0, "u");
+	test_game_play(copy, 0, "u");
+	PRINT_TEST_RESULT(restored == TRUE && game_get_n_undo(copy) == 1 && player_get_location(game_get_player_at(copy, 0)) == 11 &&
+					  player_has_object(game_get_player_at(copy, 0), 21) == TRUE && game_compute_hash(copy) == game_compute_hash(game) &&
+					  game_write_undo(game, NULL) == ERROR && game_read_undo(copy, NULL) == ERROR);
+	snapshot_destroy(snapshot);
+	autosave_destroy(autosave);
+	game_destroy(game);
+	game_destroy(copy);
+	remove_saves();
+}
+
+void test1_autosave_tick()
+{
+	Game *game = test_game_create();
+	Autosave *autosave = autosave_create(SAVE_FILE, 3, 0, 1);
+	int saves[3];
+
+	remove_saves();
+	autosave_tick(autosave, game, 1);
+	autosave_tick(autosave, game, 2);
+	autosave_wait(autosave);
+	saves[0] = autosave_get_n_saves(autosave);
+	autosave_tick(autosave, game, 3);
+	autosave_wait(autosave);
+	saves[1] = autosave_get_n_saves(autosave);
+	autosave_tick(autosave, game, 4);
+	autosave_tick(autosave, game, 5);
+	autosave_wait(autosave);
+	saves[2] = autosave_get_n_saves(autosave);
+	PRINT_TEST_RESULT(saves[0] == 0 && saves[1] == 1 && saves[2] == 1);
+	autosave_destroy(autosave);
+	game_destroy(game);
+	remove_saves();
+}
+
+void test2_autosave_tick()
+{
+	Game *game = test_game_create();
+	Autosave *autosave = autosave_create(SAVE_FILE, 1, 0, 3);
+	long marks[3] = {0, 0, 0};
+	FILE *f = NULL;
+	int i;
+
+	remove_saves();
+	for (i = 1; i <= 4; i++)
+	{
+		autosave_tick(autosave, game, i);
+		autosave_wait(autosave);
+	}
+	read_save(game, SAVE_FILE, &marks[0]);
+	read_save(game, SAVE_FILE ".1", &marks[1]);
+	read_save(game, SAVE_FILE ".2", &marks[2]);
+	f = fopen(SAVE_FILE ".3", "rb");
+	PRINT_TEST_RESULT(autosave_get_n_saves(autosave) == 4 && marks[0] == 4 && marks[1] == 3 && marks[2] == 2 && f == NULL);
+	if (f)
+	{
+		fclose(f);
+	}
+	autosave_destroy(autosave);
+	game_destroy(game);
+	remove_saves();
+}
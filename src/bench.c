@@ -0,0 +1,1081 @@
+/**
+ * @brief Microbenchmarks for the core modules
+ *
+ * Every benchmark is repeated with a growing number of operations until it
+ * runs for at least BENCH_MIN_NS, and then one CSV line is printed with the
+ * name, the number of operations, the nanoseconds per operation and the
+ * operations per second. Painting uses the null screen backend.
+ *
+ * With -scale, a single world is loaded and its load time, memory and turn
+ * latency are printed instead, see "make bench_scale". With -threads, the
+ * load time of a world is printed for a growing number of threads. With
+ * -paged, a world is paged with a memory budget while the player walks it.
+ * With -npc, the characters of a world act for a number of ticks. With
+ * -agents, the bulk updates of the agent store are compared with the same
+ * scans over Character objects. With -pheromone, the pheromone fields of a
+ * world diffuse for a number of steps. With -sessions, many sessions of a
+ * world loaded once are created and compared with loading it for each one.
+ *
+ * @file bench.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "agents.h"
+#include "character.h"
+#include "command.h"
+#include "game.h"
+#include "game_actions.h"
+#include "game_reader.h"
+#include "graphic_engine.h"
+#include "npc.h"
+#include "pheromone.h"
+#include "region.h"
+#include "set.h"
+#include "snapshot.h"
+#include "space.h"
+#include "stats.h"
+
+/**
+ * @brief Minimum time measured by each benchmark, in nanoseconds
+ */
+#define BENCH_MIN_NS 200000000UL
+
+/**
+ * @brief Maximum number of operations of a single run
+ */
+#define BENCH_MAX_OPS (1L << 30)
+
+/**
+ * @brief Runs n operations and returns the nanoseconds they took
+ */
+typedef unsigned long (*BenchBody)(long n);
+
+/**
+ * @brief A named benchmark
+ */
+typedef struct
+{
+	const char *name; /*!< Name printed in the report */
+	BenchBody body;	  /*!< Function that runs the operations */
+} Bench;
+
+/**
+ * @brief Keeps the compiler from dropping the results of the operations
+ */
+static volatile long bench_sink = 0;
+
+/**
+ * @brief Data file of the world used by the game benchmarks
+ */
+static char *bench_file = NULL;
+
+/**
+ * @brief Game shared by the game benchmarks
+ */
+static Game *bench_game = NULL;
+
+/**
+ * @brief Graphic engine used by the paint benchmark
+ */
+static Graphic_engine *bench_gengine = NULL;
+
+/**
+ * @brief Benchmarks set_add on a set that grows up to MAX_IDS ids
+ */
+static unsigned long bench_set_add(long n)
+{
+	Set *set = set_create();
+	unsigned long t, total = 0;
+	long done = 0;
+	int j, k;
+
+	while (done < n)
+	{
+		k = (n - done < MAX_IDS) ? (int)(n - done) : MAX_IDS;
+		t = stats_now();
+		for (j = 0; j < k; j++)
+		{
+			bench_sink += set_add(set, j + 1);
+		}
+		total += stats_now() - t;
+		for (j = 0; j < k; j++)
+		{
+			set_del(set, j + 1);
+		}
+		done += k;
+	}
+
+	set_destroy(set);
+	return total;
+}
+
+/**
+ * @brief Benchmarks set_del on a set that shrinks from MAX_IDS ids
+ */
+static unsigned long bench_set_del(long n)
+{
+	Set *set = set_create();
+	unsigned long t, total = 0;
+	long done = 0;
+	int j, k;
+
+	while (done < n)
+	{
+		k = (n - done < MAX_IDS) ? (int)(n - done) : MAX_IDS;
+		for (j = 0; j < k; j++)
+		{
+			set_add(set, j + 1);
+		}
+		t = stats_now();
+		for (j = 0; j < k; j++)
+		{
+			bench_sink += set_del(set, j + 1);
+		}
+		total += stats_now() - t;
+		done += k;
+	}
+
+	set_destroy(set);
+	return total;
+}
+
+/**
+ * @brief Benchmarks space_add_character followed by space_del_character
+ */
+static unsigned long bench_space_characters(long n)
+{
+	Space *space = space_create(1);
+	Character *characters[MAX_IDS];
+	unsigned long t;
+	long i;
+	int j;
+
+	for (j = 0; j < MAX_IDS; j++)
+	{
+		characters[j] = character_create(j + 1);
+	}
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		j = (int)(i % MAX_IDS);
+		bench_sink += space_add_character(space, characters[j]);
+		if (j == MAX_IDS - 1)
+		{
+			for (j = 0; j < MAX_IDS; j++)
+			{
+				bench_sink += space_del_character(space, characters[j]);
+			}
+		}
+	}
+	t = stats_now() - t;
+
+	for (j = 0; j < MAX_IDS; j++)
+	{
+		character_destroy(characters[j]);
+	}
+	space_destroy(space);
+
+	return t;
+}
+
+/**
+ * @brief Benchmarks space_get_object on a space holding 10 objects
+ */
+static unsigned long bench_space_get_object(long n)
+{
+	Space *space = space_create(1);
+	unsigned long t;
+	long i;
+	int j;
+
+	for (j = 0; j < 10; j++)
+	{
+		set_add(space_get_object_locations(space), j + 1);
+	}
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		bench_sink += space_get_object(space, (Id)(i % 20) + 1);
+	}
+	t = stats_now() - t;
+
+	space_destroy(space);
+	return t;
+}
+
+/**
+ * @brief Benchmarks game_get_space over every space of the world
+ */
+static unsigned long bench_game_get_space(long n)
+{
+	int n_spaces = *game_get_n_spaces(bench_game);
+	unsigned long t;
+	long i;
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		bench_sink += (long)game_get_space(bench_game, game_get_space_id_at(bench_game, (int)(i % n_spaces))) & 1;
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Benchmarks a walk over every space of the world reading their ids and discovered flags
+ */
+static unsigned long bench_space_traversal(long n)
+{
+	Space **spaces = game_get_spaces(bench_game);
+	int n_spaces = *game_get_n_spaces(bench_game), j = 0;
+	unsigned long t;
+	long i;
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		bench_sink += space_get_id(spaces[j]) + space_is_discovered(spaces[j]);
+		if (++j == n_spaces)
+		{
+			j = 0;
+		}
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Benchmarks game_get_connection over every space and direction of the world
+ */
+static unsigned long bench_game_get_connection(long n)
+{
+	int n_spaces = *game_get_n_spaces(bench_game);
+	unsigned long t;
+	long i;
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		bench_sink += game_get_connection(bench_game, game_get_space_id_at(bench_game, (int)((i >> 2) % n_spaces)), (Direction)(i & 3));
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Benchmarks game_find_character over every character of the world
+ */
+static unsigned long bench_game_find_character(long n)
+{
+	int n_characters = *game_get_n_characters(bench_game);
+	Character **characters = game_get_character_array(bench_game);
+	unsigned long t;
+	long i;
+
+	if (n_characters <= 0)
+	{
+		return 0;
+	}
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		bench_sink += game_find_character(bench_game, character_get_id(characters[i % n_characters]));
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Benchmarks command_parse_input with a mix of commands
+ */
+static unsigned long bench_command_parse(long n)
+{
+	char *lines[] = {"m s\n", "take Leaf\n", "attack\n", "chat Ant\n", "xyzzy\n", "recruit Paquito\n"};
+	char input[64];
+	Command *command = command_create();
+	unsigned long t;
+	long i;
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		strcpy(input, lines[i % 6]);
+		command_parse_input(command, input);
+		bench_sink += command_get_code(command);
+	}
+	t = stats_now() - t;
+
+	command_destroy(command);
+	return t;
+}
+
+/**
+ * @brief Benchmarks loading and destroying the whole world
+ */
+static unsigned long bench_load(long n)
+{
+	Game *game = NULL;
+	unsigned long t;
+	long i;
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		game = NULL;
+		if (game_create_from_file(&game, bench_file) == OK)
+		{
+			bench_sink += *game_get_n_spaces(game);
+		}
+		game_destroy(game);
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Benchmarks painting the game with the null screen backend
+ */
+static unsigned long bench_paint(long n)
+{
+	unsigned long t;
+	long i;
+
+	t = stats_now();
+	for (i = 0; i < n; i++)
+	{
+		graphic_engine_paint_game(bench_gengine, bench_game);
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Characters compared with the agent store
+ */
+static Character **bench_characters = NULL;
+
+/**
+ * @brief Agent store with the same ants as bench_characters
+ */
+static Agents *bench_agents = NULL;
+
+/**
+ * @brief Number of ants of bench_characters and bench_agents
+ */
+static int bench_n_agents = 0;
+
+/**
+ * @brief Hurts the hostile characters, one operation per character scanned
+ */
+static unsigned long bench_characters_damage(long n)
+{
+	unsigned long t = stats_now();
+	long i;
+
+	for (i = 0; i < n; i++)
+	{
+		if (character_get_friendly(bench_characters[i % bench_n_agents]) == FALSE)
+		{
+			character_set_health(bench_characters[i % bench_n_agents], character_get_health(bench_characters[i % bench_n_agents]) - 1);
+		}
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Hurts the hostile ants of a space, one operation per ant scanned
+ */
+static unsigned long bench_agents_damage(long n)
+{
+	unsigned long t = stats_now();
+	long done;
+
+	for (done = 0; done < n; done += bench_n_agents)
+	{
+		bench_sink += agents_damage(bench_agents, done % 7, 1);
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Makes the friendly characters without leader follow one, one operation per character scanned
+ */
+static unsigned long bench_characters_recruit(long n)
+{
+	Character *character = NULL;
+	unsigned long t = stats_now();
+	long i;
+
+	for (i = 0; i < n; i++)
+	{
+		character = bench_characters[i % bench_n_agents];
+		if (character_get_friendly(character) == TRUE && character_get_following(character) == NO_ID)
+		{
+			character_set_following(character, 1);
+		}
+		else if (character_get_following(character) == 1)
+		{
+			character_set_following(character, NO_ID);
+		}
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Recruits and abandons the ants of a space, one operation per ant scanned
+ */
+static unsigned long bench_agents_recruit(long n)
+{
+	unsigned long t = stats_now();
+	long done;
+
+	for (done = 0; done < n; done += 2 * (long)bench_n_agents)
+	{
+		bench_sink += agents_recruit(bench_agents, 1, done % 7);
+		bench_sink += agents_abandon(bench_agents, 1);
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Moves the followers of a leader, one operation per ant scanned
+ */
+static unsigned long bench_agents_follow(long n)
+{
+	unsigned long t = stats_now();
+	long done;
+
+	for (done = 0; done < n; done += bench_n_agents)
+	{
+		bench_sink += agents_follow(bench_agents, 1, done % 7);
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Moves the ants of a space to another one, one operation per ant scanned
+ */
+static unsigned long bench_agents_move(long n)
+{
+	unsigned long t = stats_now();
+	long done;
+
+	for (done = 0; done < n; done += bench_n_agents)
+	{
+		bench_sink += agents_move(bench_agents, done % 7, (done + 1) % 7);
+	}
+	return stats_now() - t;
+}
+
+/**
+ * @brief Runs a benchmark until it is long enough to be measured and prints its results
+ *
+ * @param bench The benchmark
+ */
+static void bench_run(Bench *bench)
+{
+	long n = 1;
+	unsigned long ns;
+	double scale;
+
+	for (;;)
+	{
+		ns = bench->body(n);
+		if (ns >= BENCH_MIN_NS || n >= BENCH_MAX_OPS)
+		{
+			break;
+		}
+
+		/* Aim a bit over the minimum time, growing at most 100 times per step */
+		scale = ns > 0 ? 1.2 * BENCH_MIN_NS / ns : 100.0;
+		if (scale > 100.0)
+		{
+			scale = 100.0;
+		}
+		if (scale < 2.0)
+		{
+			scale = 2.0;
+		}
+		n = (long)(n * scale);
+		if (n > BENCH_MAX_OPS)
+		{
+			n = BENCH_MAX_OPS;
+		}
+	}
+
+	printf("%s,%ld,%.2f,%.0f\n", bench->name, n, ns > 0 ? (double)ns / n : 0.0, ns > 0 ? n * 1e9 / ns : 0.0);
+	fflush(stdout);
+}
+
+/**
+ * @brief Reads the resident memory of the process
+ *
+ * @return The resident set size in KB, 0 if it is not available
+ */
+static long bench_rss_kb()
+{
+	FILE *f = NULL;
+	char line[128];
+	long kb = 0;
+
+	if (!(f = fopen("/proc/self/status", "r")))
+	{
+		return 0;
+	}
+
+	while (fgets(line, sizeof(line), f))
+	{
+		if (strncmp(line, "VmRSS:", 6) == 0)
+		{
+			kb = atol(line + 6);
+			break;
+		}
+	}
+
+	fclose(f);
+	return kb;
+}
+
+/**
+ * @brief Measures how a world scales: load time, memory and latency of a turn
+ *
+ * A turn is one move command (the directions are tried in turns) followed
+ * by a paint, as the game loop does it.
+ *
+ * @param file The world data file
+ * @return 0 if the world could be measured, 1 otherwise
+ */
+static int bench_scale(char *file)
+{
+	char *moves[] = {"m e", "m s", "m w", "m n", "m s", "m e"};
+	char input[16];
+	Game *game = NULL;
+	Command *command = NULL;
+	unsigned long t, load_ns, turn_ns = 0;
+	long rss_before, rss_after, turns = 0;
+
+	rss_before = bench_rss_kb();
+	t = stats_now();
+	if (game_create_from_file(&game, file) == ERROR)
+	{
+		fprintf(stderr, "Error while loading %s.\n", file);
+		game_destroy(game);
+		return 1;
+	}
+	load_ns = stats_now() - t;
+	rss_after = bench_rss_kb();
+
+	/* The game owns the command of the player, like in the game loop */
+	command = game_get_last_command(game);
+	if ((bench_gengine = graphic_engine_create()) == NULL)
+	{
+		game_destroy(game);
+		return 1;
+	}
+
+	/* Turns run for at least BENCH_MIN_NS, with a minimum of 10 */
+	while (turns < 10 || turn_ns < BENCH_MIN_NS)
+	{
+		strcpy(input, moves[turns % 6]);
+		t = stats_now();
+		command_parse_input(command, input);
+		game_actions_update(game, command);
+		graphic_engine_paint_game(bench_gengine, game);
+		turn_ns += stats_now() - t;
+		turns++;
+	}
+
+	printf("spaces,links,objects,characters,load_ms,rss_kb,turn_ns\n");
+	printf("%d,%d,%d,%d,%.3f,%ld,%.0f\n", *game_get_n_spaces(game), *game_get_n_links(game), *game_get_n_objects(game), *game_get_n_characters(game),
+		   load_ns / 1e6, rss_after - rss_before, (double)turn_ns / turns);
+
+	graphic_engine_destroy(bench_gengine);
+	game_destroy(game);
+	return 0;
+}
+
+/**
+ * @brief Measures the load time of a world with 1, 2, 4... threads
+ *
+ * @param file The world data file
+ * @param max_threads The maximum number of threads
+ * @return 0 if the world could be loaded, 1 otherwise
+ */
+static int bench_threads(char *file, int max_threads)
+{
+	Game *game = NULL;
+	unsigned long t, best, base = 0;
+	int threads, i;
+
+	printf("threads,load_ms,speedup\n");
+	for (threads = 1; threads <= max_threads; threads *= 2)
+	{
+		/* The best of three runs, the first one also warms the page cache */
+		best = 0;
+		for (i = 0; i < 3; i++)
+		{
+			game = NULL;
+			if (game_create(&game) == ERROR)
+			{
+				return 1;
+			}
+			t = stats_now();
+			if (game_load_world(game, file, threads) == ERROR)
+			{
+				fprintf(stderr, "Error while loading %s.\n", file);
+				game_destroy(game);
+				return 1;
+			}
+			t = stats_now() - t;
+			game_destroy(game);
+			best = (i == 0 || t < best) ? t : best;
+		}
+
+		base = (threads == 1) ? best : base;
+		printf("%d,%.3f,%.2f\n", threads, best / 1e6, (double)base / best);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Measures a paged world while the player walks it
+ *
+ * The player moves for a number of turns, trying the directions in turns,
+ * and the regions are evicted after every turn as the game loop does.
+ *
+ * @param file The world data file
+ * @param megabytes The memory budget
+ * @return 0 if the world could be measured, 1 otherwise
+ */
+static int bench_paged(char *file, long megabytes)
+{
+	char *moves[] = {"m e", "m s", "m e", "m n", "m s", "m w"};
+	char input[16];
+	Game *game = NULL;
+	Command *command = NULL;
+	unsigned long t, open_ns, turn_ns = 0;
+	long turns, rss_before, peak_bytes = 0;
+
+	rss_before = bench_rss_kb();
+	t = stats_now();
+	if (game_create_paged(&game, file, megabytes * 1024 * 1024) == ERROR)
+	{
+		fprintf(stderr, "Error while loading %s.\n", file);
+		game_destroy(game);
+		return 1;
+	}
+	open_ns = stats_now() - t;
+
+	command = game_get_last_command(game);
+	for (turns = 0; turns < 10000; turns++)
+	{
+		strcpy(input, moves[(turns / 7) % 6]);
+		t = stats_now();
+		command_parse_input(command, input);
+		game_actions_update(game, command);
+		game_evict_regions(game);
+		turn_ns += stats_now() - t;
+		if (region_get_resident_bytes(game_get_regions(game)) > peak_bytes)
+		{
+			peak_bytes = region_get_resident_bytes(game_get_regions(game));
+		}
+	}
+
+	printf("budget_mb,open_ms,turns,region_loads,peak_resident_kb,rss_kb,turn_ns\n");
+	printf("%ld,%.3f,%ld,%ld,%ld,%ld,%.0f\n", megabytes, open_ns / 1e6, turns, region_get_n_loads(game_get_regions(game)), peak_bytes / 1024,
+		   bench_rss_kb() - rss_before, (double)turn_ns / turns);
+
+	game_destroy(game);
+	return 0;
+}
+
+/**
+ * @brief Measures the ticks of the characters of a world
+ *
+ * The ticks run once without a time budget and once with a budget, which
+ * leaves late characters for the following ticks.
+ *
+ * @param file The world data file
+ * @param ticks The number of ticks of each run
+ * @return 0 if the world could be measured, 1 otherwise
+ */
+static int bench_npc(char *file, long ticks)
+{
+	long budgets[] = {0, 100000};
+	NpcScheduler *npcs = NULL;
+	Game *game = NULL;
+	unsigned long t, tick_ns, total_ns, max_ns;
+	long steps, i;
+	int run;
+
+	if (game_create_from_file(&game, file) == ERROR)
+	{
+		fprintf(stderr, "Error while loading %s.\n", file);
+		game_destroy(game);
+		return 1;
+	}
+
+	printf("characters,budget_ns,ticks,steps_per_tick,tick_ns,max_tick_ns,step_ns,late\n");
+	for (run = 0; run < 2; run++)
+	{
+		if (!(npcs = npc_create(game, budgets[run], 1)))
+		{
+			game_destroy(game);
+			return 1;
+		}
+
+		steps = 0;
+		total_ns = max_ns = 0;
+		for (i = 0; i < ticks; i++)
+		{
+			t = stats_now();
+			steps += npc_tick(npcs);
+			tick_ns = stats_now() - t;
+			total_ns += tick_ns;
+			max_ns = tick_ns > max_ns ? tick_ns : max_ns;
+		}
+
+		printf("%d,%ld,%ld,%.1f,%.0f,%lu,%.1f,%d\n", *game_get_n_characters(game), budgets[run], ticks, (double)steps / ticks, (double)total_ns / ticks,
+			   max_ns, steps ? (double)total_ns / steps : 0.0, npc_get_n_late(npcs));
+		npc_destroy(npcs);
+	}
+
+	game_destroy(game);
+	return 0;
+}
+
+/**
+ * @brief Diffuses the pheromone fields of a world and prints the steps per second
+ *
+ * Food is left in one space of every thousand and danger in one of every
+ * ten thousand before the steps, so the amounts are not all zero.
+ *
+ * @param file The world file
+ * @param steps The number of steps
+ * @return 0 if the world could be loaded, 1 otherwise
+ */
+static int bench_pheromone(char *file, long steps)
+{
+	Pheromones *pheromones = NULL;
+	unsigned long t;
+	long i;
+	int n_spaces;
+
+	/* Read without the game, a world of a million spaces and links does not fit in memory as objects */
+	if (!(pheromones = pheromone_create_from_file(file, 0.2, 0.01)))
+	{
+		fprintf(stderr, "Error while loading %s.\n", file);
+		return 1;
+	}
+
+	/* The generated spaces have the ids 1 to n_spaces */
+	n_spaces = pheromone_get_n_spaces(pheromones);
+	for (i = 1; i <= n_spaces; i += 1000)
+	{
+		pheromone_deposit(pheromones, PHEROMONE_FOOD, i, 100);
+		if (i % 10000 == 1)
+		{
+			pheromone_deposit(pheromones, PHEROMONE_DANGER, i, 100);
+		}
+	}
+
+	t = stats_now();
+	for (i = 0; i < steps; i++)
+	{
+		pheromone_step(pheromones);
+	}
+	t = stats_now() - t;
+
+	printf("spaces,links,steps,step_ns,steps_per_s,food\n");
+	printf("%d,%d,%ld,%.0f,%.1f,%.3f\n", n_spaces, pheromone_get_n_links(pheromones), steps, steps ? (double)t / steps : 0.0,
+		   t ? steps * 1e9 / t : 0.0, pheromone_total(pheromones, PHEROMONE_FOOD));
+	pheromone_destroy(pheromones);
+	return 0;
+}
+
+/**
+ * @brief Saves and restores the state of a world and prints the branches per second
+ *
+ * A branch is what a look-ahead search does for every command it tries:
+ * the state is saved, the command runs, and the state is restored. The
+ * command is a move of the first player, so a space and the player change.
+ *
+ * @param file The world data file
+ * @param branches The number of branches
+ * @return 0 if the world could be measured, 1 otherwise
+ */
+static int bench_snapshot(char *file, long branches)
+{
+	Game *game = NULL;
+	Snapshot *snapshot = NULL;
+	Command *command = NULL;
+	char input[WORD_SIZE];
+	unsigned long t, save_ns = 0, restore_ns = 0;
+	long i;
+
+	if (game_create_from_file(&game, file) == ERROR || !(snapshot = snapshot_create(game)))
+	{
+		fprintf(stderr, "Error while loading %s.\n", file);
+		game_destroy(game);
+		return 1;
+	}
+
+	command = game_get_last_command(game);
+	for (i = 0; i < branches; i++)
+	{
+		t = stats_now();
+		snapshot_save(snapshot, game);
+		save_ns += stats_now() - t;
+
+		strcpy(input, i % 2 ? "m n" : "m s");
+		command_parse_input(command, input);
+		game_actions_update(game, command);
+		game_drop_undo(game);
+
+		t = stats_now();
+		snapshot_restore(snapshot, game);
+		restore_ns += stats_now() - t;
+	}
+
+	printf("spaces,objects,characters,links,bytes,save_ns,restore_ns,branches_per_s\n");
+	printf("%d,%d,%d,%d,%ld,%.0f,%.0f,%.0f\n", *game_get_n_spaces(game), *game_get_n_objects(game), *game_get_n_characters(game),
+		   *game_get_n_links(game), snapshot_get_size(snapshot), branches ? (double)save_ns / branches : 0.0,
+		   branches ? (double)restore_ns / branches : 0.0, save_ns + restore_ns ? branches * 1e9 / (save_ns + restore_ns) : 0.0);
+	snapshot_destroy(snapshot);
+	game_destroy(game);
+	return 0;
+}
+
+/**
+ * @brief Creates many sessions of a world loaded once and compares them with loading it
+ *
+ * Each session then plays one move, entering it after the one before.
+ *
+ * @param file The world data file
+ * @param n The number of sessions
+ * @return 0 if the world could be measured, 1 otherwise
+ */
+static int bench_sessions(char *file, int n)
+{
+	Game *world = NULL, *game = NULL, **sessions = NULL;
+	Command *command = NULL;
+	char input[WORD_SIZE];
+	unsigned long t, load_ns, create_ns, enter_ns = 0;
+	long rss_before, rss_after;
+	int i, created = 0;
+
+	t = stats_now();
+	if (n <= 0 || game_create_from_file(&world, file) == ERROR || !(sessions = (Game **)calloc(n, sizeof(Game *))))
+	{
+		fprintf(stderr, "Error while loading %s.\n", file);
+		game_destroy(world);
+		return 1;
+	}
+	load_ns = stats_now() - t;
+
+	/* A second load is measured, the first one also pays for the first pages of the process */
+	t = stats_now();
+	if (game_create_from_file(&game, file) == OK)
+	{
+		load_ns = stats_now() - t;
+	}
+	game_destroy(game);
+
+	rss_before = bench_rss_kb();
+	t = stats_now();
+	for (created = 0; created < n && game_create_session(&sessions[created], world) == OK; created++)
+		;
+	create_ns = stats_now() - t;
+	rss_after = bench_rss_kb();
+
+	for (i = 0; i < created; i++)
+	{
+		t = stats_now();
+		game_enter(sessions[i]);
+		enter_ns += stats_now() - t;
+		command = game_get_last_command(sessions[i]);
+		strcpy(input, i % 2 ? "m n" : "m s");
+		command_parse_input(command, input);
+		game_actions_update(sessions[i], command);
+	}
+
+	printf("spaces,sessions,load_us,create_us,enter_us,kb_per_session\n");
+	printf("%d,%d,%.1f,%.2f,%.2f,%.2f\n", *game_get_n_spaces(world), created, load_ns / 1e3, created ? create_ns / 1e3 / created : 0.0,
+		   created ? enter_ns / 1e3 / created : 0.0, created ? (double)(rss_after - rss_before) / created : 0.0);
+
+	for (i = 0; i < created; i++)
+	{
+		game_destroy(sessions[i]);
+	}
+	free(sessions);
+	game_destroy(world);
+	return created == n ? 0 : 1;
+}
+
+/**
+ * @brief Compares the bulk updates of the agent store with scans over characters
+ *
+ * The same ants, in seven spaces and half of them friendly, are created as
+ * Character objects and in an agent store. An operation is one ant scanned.
+ *
+ * @param n The number of ants
+ * @return 0 if the ants could be created, 1 otherwise
+ */
+static int bench_agents_all(int n)
+{
+	Bench benches[] = {
+		{"characters_damage", bench_characters_damage},
+		{"agents_damage", bench_agents_damage},
+		{"characters_recruit", bench_characters_recruit},
+		{"agents_recruit", bench_agents_recruit},
+		{"agents_follow", bench_agents_follow},
+		{"agents_move", bench_agents_move}};
+	int i, status = 0, n_benches = sizeof(benches) / sizeof(benches[0]);
+
+	if (n <= 0 || !(bench_characters = (Character **)calloc(n, sizeof(Character *))) || !(bench_agents = agents_create()) ||
+		agents_reserve(bench_agents, n) == ERROR)
+	{
+		status = 1;
+		n = 0;
+	}
+
+	for (bench_n_agents = 0; bench_n_agents < n; bench_n_agents++)
+	{
+		i = bench_n_agents;
+		if (!(bench_characters[i] = character_create(i + 1)) || agents_add(bench_agents, i + 1, i % 7, 1000000, i % 2 ? TRUE : FALSE) < 0)
+		{
+			status = 1;
+			break;
+		}
+		character_set_health(bench_characters[i], 1000000);
+		character_set_friendly(bench_characters[i], i % 2 ? TRUE : FALSE);
+	}
+
+	if (status == 0)
+	{
+		printf("benchmark,ops,ns_per_op,ops_per_s\n");
+		for (i = 0; i < n_benches; i++)
+		{
+			bench_run(&benches[i]);
+		}
+	}
+
+	for (i = 0; bench_characters && i < n; i++)
+	{
+		character_destroy(bench_characters[i]);
+	}
+	free(bench_characters);
+	agents_destroy(bench_agents);
+	return status;
+}
+
+/**
+ * @brief Main function of the benchmarks
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The world data file and, optionally, a text that the names of the benchmarks to run must contain.
+ *             With -scale as first argument, the world file to measure.
+ * @return 0 if the benchmarks ran, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	Bench benches[] = {
+		{"set_add", bench_set_add},
+		{"set_del", bench_set_del},
+		{"space_add_del_character", bench_space_characters},
+		{"space_get_object", bench_space_get_object},
+		{"game_get_space", bench_game_get_space},
+		{"space_traversal", bench_space_traversal},
+		{"game_get_connection", bench_game_get_connection},
+		{"game_find_character", bench_game_find_character},
+		{"command_parse_input", bench_command_parse},
+		{"game_create_from_file", bench_load},
+		{"graphic_engine_paint_game", bench_paint}};
+	int i, n_benches = sizeof(benches) / sizeof(benches[0]);
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Use: %s <game_data_file> [filter]\n", argv[0]);
+		fprintf(stderr, "     %s -scale <game_data_file>\n", argv[0]);
+		fprintf(stderr, "     %s -threads <game_data_file> [max_threads]\n", argv[0]);
+		fprintf(stderr, "     %s -paged <game_data_file> [megabytes]\n", argv[0]);
+		fprintf(stderr, "     %s -npc <game_data_file> [ticks]\n", argv[0]);
+		fprintf(stderr, "     %s -agents [ants]\n", argv[0]);
+		fprintf(stderr, "     %s -pheromone <game_data_file> [steps]\n", argv[0]);
+		fprintf(stderr, "     %s -snapshot <game_data_file> [branches]\n", argv[0]);
+		fprintf(stderr, "     %s -sessions <game_data_file> [sessions]\n", argv[0]);
+		return 1;
+	}
+
+	if (strcmp(argv[1], "-scale") == 0)
+	{
+		return argc < 3 ? 1 : bench_scale(argv[2]);
+	}
+
+	if (strcmp(argv[1], "-threads") == 0)
+	{
+		return argc < 3 ? 1 : bench_threads(argv[2], argc > 3 ? atoi(argv[3]) : 16);
+	}
+
+	if (strcmp(argv[1], "-paged") == 0)
+	{
+		return argc < 3 ? 1 : bench_paged(argv[2], argc > 3 ? atol(argv[3]) : 1);
+	}
+
+	if (strcmp(argv[1], "-pheromone") == 0)
+	{
+		return argc < 3 ? 1 : bench_pheromone(argv[2], argc > 3 ? atol(argv[3]) : 100);
+	}
+
+	if (strcmp(argv[1], "-snapshot") == 0)
+	{
+		return argc < 3 ? 1 : bench_snapshot(argv[2], argc > 3 ? atol(argv[3]) : 100000);
+	}
+
+	if (strcmp(argv[1], "-sessions") == 0)
+	{
+		return argc < 3 ? 1 : bench_sessions(argv[2], argc > 3 ? atoi(argv[3]) : 10000);
+	}
+
+	if (strcmp(argv[1], "-agents") == 0)
+	{
+		return bench_agents_all(argc > 2 ? atoi(argv[2]) : 100000);
+	}
+
+	if (strcmp(argv[1], "-npc") == 0)
+	{
+		return argc < 3 ? 1 : bench_npc(argv[2], argc > 3 ? atol(argv[3]) : 1000);
+	}
+
+	bench_file = argv[1];
+	if (game_create_from_file(&bench_game, bench_file) == ERROR)
+	{
+		fprintf(stderr, "Error while loading %s.\n", bench_file);
+		game_destroy(bench_game);
+		return 1;
+	}
+
+	if ((bench_gengine = graphic_engine_create()) == NULL)
+	{
+		fprintf(stderr, "Error while initializing graphic engine.\n");
+		game_destroy(bench_game);
+		return 1;
+	}
+
+	printf("benchmark,ops,ns_per_op,ops_per_s\n");
+	for (i = 0; i < n_benches; i++)
+	{
+		if (argc < 3 || strstr(benches[i].name, argv[2]) != NULL)
+		{
+			bench_run(&benches[i]);
+		}
+	}
+
+	graphic_engine_destroy(bench_gengine);
+	game_destroy(bench_game);
+	return 0;
+}
@@ -26,6 +26,7 @@ struct _Character
 	Bool friendly;					/*!< Whether character is friendly */
 	char message[MESSAGE_SIZE + 1]; /*!< Character's message */
 	Id following;					/*!< Character's following id */
+	Character *next_follower;		/*!< Next character in the party of the player it follows */
 };
 
 Character *character_create(Id id)
@@ -51,6 +52,7 @@ Character *character_create(Id id)
 	newCharacter->friendly = TRUE;
 	newCharacter->message[0] = '\0';
 	newCharacter->following = NO_ID;
+	newCharacter->next_follower = NULL;
 
 	return newCharacter;
 }
@@ -214,6 +216,26 @@ Status character_set_following(Character *character, Id following)
 	return OK;
 }
 
+Character *character_get_next_follower(Character *character)
+{
+	if (!character)
+	{
+		return NULL;
+	}
+	return character->next_follower;
+}
+
+Status character_set_next_follower(Character *character, Character *next)
+{
+	if (!character)
+	{
+		return ERROR;
+	}
+
+	character->next_follower = next;
+	return OK;
+}
+
 Status character_print(Character *character)
 {
 	if (!character)
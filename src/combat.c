@@ -0,0 +1,109 @@
+/**
+ * @brief It implements the resolution of the fights between a player and its enemies
+ *
+ * @file combat.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "combat.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief Tosses a coin with a xorshift generator
+ *
+ * @param rng A pointer to the state of the generator
+ * @return 0 or 1, from a high bit, the low ones of xorshift are the weakest
+ */
+static int combat_coin(unsigned long *rng)
+{
+	if (*rng == 0)
+	{
+		*rng = 1;
+	}
+	*rng ^= *rng << 13;
+	*rng ^= *rng >> 7;
+	*rng ^= *rng << 17;
+	return (int)((*rng >> 20) & 1);
+}
+
+/**
+ * @brief Takes the damage of a blow from a combatant, health never goes below 0
+ */
+static int combat_hit(Combatant *target, int damage)
+{
+	target->health = target->health > damage ? target->health - damage : 0;
+	return target->health;
+}
+
+int combat_round(Combatant *player, Combatant *enemies, int n_enemies, unsigned long *rng, CombatBlow *blows)
+{
+	CombatBlow blow;
+	int i, alive = 0;
+
+	if (!player || (!enemies && n_enemies > 0) || n_enemies < 0 || !rng)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < n_enemies; i++)
+	{
+		blow.hit = COMBAT_NO_HIT;
+		blow.health = enemies[i].health;
+		if (player->health > 0 && enemies[i].health > 0)
+		{
+			if (combat_coin(rng) == 0)
+			{
+				blow.hit = COMBAT_ENEMY_HIT;
+				blow.health = combat_hit(&enemies[i], player->damage);
+			}
+			else
+			{
+				blow.hit = COMBAT_PLAYER_HIT;
+				blow.health = combat_hit(player, enemies[i].damage);
+			}
+		}
+		if (blows)
+		{
+			blows[i] = blow;
+		}
+		if (enemies[i].health > 0)
+		{
+			alive++;
+		}
+	}
+
+	return alive;
+}
+
+Status combat_encounter(Combatant *player, Combatant *enemies, int n_enemies, unsigned long *rng, CombatOutcome *outcome)
+{
+	int health, alive = 0, i;
+
+	if (!player || (!enemies && n_enemies > 0) || n_enemies < 0 || !rng || !outcome)
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n_enemies; i++)
+	{
+		if (enemies[i].health > 0)
+		{
+			alive++;
+		}
+	}
+
+	health = player->health;
+	outcome->rounds = 0;
+	while (alive > 0 && player->health > 0 && outcome->rounds < COMBAT_MAX_ROUNDS)
+	{
+		alive = combat_round(player, enemies, n_enemies, rng, NULL);
+		outcome->rounds++;
+	}
+	outcome->won = (alive == 0 && player->health > 0) ? TRUE : FALSE;
+	outcome->damage = health - player->health;
+
+	return OK;
+}
@@ -0,0 +1,204 @@
+/**
+ * @brief It simulates fights to tune the health of the characters of a world
+ *
+ * Loads a world file and fights, many times, every player against every
+ * hostile character alone, with the rules of the attack command. For each
+ * pair it prints the rate of fights won by the player, the health it loses
+ * on average and the rounds they last, and then the same for enemies with
+ * a sweep of health values, so the #c: records can be tuned from the table.
+ * The fights of a row are split among threads, each one with its own seed.
+ *
+ * @file combat_sim.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "character.h"
+#include "combat.h"
+#include "game.h"
+#include "player.h"
+#include "stats.h"
+
+/**
+ * @brief Fights of each row, if none is given
+ */
+#define SIM_ENCOUNTERS 1000000L
+
+/**
+ * @brief Threads, if none is given
+ */
+#define SIM_THREADS 4
+
+/**
+ * @brief Maximum number of threads
+ */
+#define SIM_MAX_THREADS 64
+
+/**
+ * @brief Rows of the sweep, with the health of the enemy growing by one blow in each
+ */
+#define SIM_SWEEP_ROWS 10
+
+/**
+ * @brief The fights run by a thread and their totals
+ */
+typedef struct
+{
+	int player_health; /*!< Health of the player at the start */
+	int enemy_health;  /*!< Health of the enemy at the start */
+	long encounters;   /*!< Number of fights */
+	unsigned long rng; /*!< State of the generator of the thread */
+	long wins;		   /*!< Fights won by the player */
+	long damage;	   /*!< Health lost by the player in all of them */
+	long rounds;	   /*!< Rounds of all of them */
+} SimChunk;
+
+/**
+ * @brief Runs the fights of a thread
+ *
+ * @param arg A pointer to the chunk
+ * @return NULL
+ */
+static void *sim_run_chunk(void *arg)
+{
+	SimChunk *chunk = (SimChunk *)arg;
+	Combatant player, enemy;
+	CombatOutcome outcome;
+	long i;
+
+	chunk->wins = chunk->damage = chunk->rounds = 0;
+	for (i = 0; i < chunk->encounters; i++)
+	{
+		player.health = chunk->player_health;
+		player.damage = COMBAT_DAMAGE;
+		enemy.health = chunk->enemy_health;
+		enemy.damage = COMBAT_DAMAGE;
+		combat_encounter(&player, &enemy, 1, &chunk->rng, &outcome);
+		chunk->wins += outcome.won == TRUE ? 1 : 0;
+		chunk->damage += outcome.damage;
+		chunk->rounds += outcome.rounds;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Fights a player against an enemy and prints a row of the table
+ *
+ * @param name The name of the enemy
+ * @param player_health The health of the player
+ * @param enemy_health The health of the enemy
+ * @param encounters The number of fights
+ * @param n_threads The number of threads
+ */
+static void sim_print_row(const char *name, int player_health, int enemy_health, long encounters, int n_threads)
+{
+	SimChunk chunks[SIM_MAX_THREADS];
+	pthread_t threads[SIM_MAX_THREADS];
+	Bool started[SIM_MAX_THREADS];
+	long wins = 0, damage = 0, rounds = 0;
+	int i;
+
+	for (i = 0; i < n_threads; i++)
+	{
+		chunks[i].player_health = player_health;
+		chunks[i].enemy_health = enemy_health;
+		chunks[i].encounters = encounters / n_threads + (i < encounters % n_threads ? 1 : 0);
+		chunks[i].rng = 2654435761UL * (unsigned long)(i + 1);
+		started[i] = (i > 0 && pthread_create(&threads[i], NULL, sim_run_chunk, &chunks[i]) == 0) ? TRUE : FALSE;
+	}
+	for (i = 0; i < n_threads; i++)
+	{
+		if (started[i] == TRUE)
+		{
+			pthread_join(threads[i], NULL);
+		}
+		else
+		{
+			sim_run_chunk(&chunks[i]);
+		}
+		wins += chunks[i].wins;
+		damage += chunks[i].damage;
+		rounds += chunks[i].rounds;
+	}
+
+	printf("  %-16s %6d %7.2f%% %8.2f %7.2f\n", name, enemy_health, 100.0 * wins / encounters, (double)damage / encounters,
+		   (double)rounds / encounters);
+}
+
+int main(int argc, char *argv[])
+{
+	Game *game = NULL;
+	Player *player = NULL;
+	Character **characters = NULL;
+	long encounters = SIM_ENCOUNTERS, n_rows = 0;
+	int n_threads = SIM_THREADS, n_characters, i, j, health;
+	unsigned long t;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Use: %s <game_data_file> [encounters] [threads]\n", argv[0]);
+		return 1;
+	}
+	if (argc > 2)
+	{
+		encounters = atol(argv[2]);
+	}
+	if (argc > 3)
+	{
+		n_threads = atoi(argv[3]);
+	}
+	if (encounters < 1 || n_threads < 1 || n_threads > SIM_MAX_THREADS)
+	{
+		fprintf(stderr, "Error: the encounters must be at least 1 and the threads from 1 to %d.\n", SIM_MAX_THREADS);
+		return 1;
+	}
+
+	if (game_create_from_file(&game, argv[1]) == ERROR)
+	{
+		fprintf(stderr, "Error while loading %s.\n", argv[1]);
+		return 1;
+	}
+	if (game_get_n_players(game) < 1)
+	{
+		fprintf(stderr, "Error: %s has no players.\n", argv[1]);
+		game_destroy(game);
+		return 1;
+	}
+
+	characters = game_get_character_array(game);
+	n_characters = *game_get_n_characters(game);
+	t = stats_now();
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		player = game_get_player_at(game, i);
+		printf("%s (health %d) against:\n", player_get_name(player), player_get_health(player));
+		printf("  %-16s %6s %8s %8s %7s\n", "enemy", "health", "won", "damage", "rounds");
+		for (j = 0; j < n_characters; j++)
+		{
+			if (character_get_friendly(characters[j]) == FALSE)
+			{
+				sim_print_row(character_get_name(characters[j]), player_get_health(player), character_get_health(characters[j]), encounters, n_threads);
+				n_rows++;
+			}
+		}
+		for (j = 1; j <= SIM_SWEEP_ROWS; j++)
+		{
+			health = j * COMBAT_DAMAGE;
+			sim_print_row("(sweep)", player_get_health(player), health, encounters, n_threads);
+			n_rows++;
+		}
+	}
+	t = stats_now() - t;
+
+	printf("%ld encounters in %.3f s, %.0f per second with %d threads\n", n_rows * encounters, t / 1e9, n_rows * encounters / (t / 1e9),
+		   n_threads);
+	game_destroy(game);
+
+	return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @brief It tests the resolution of the fights
+ *
+ * @file combat_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "combat.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 7
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_combat_round();
+
+/**
+ * @brief Test that each living enemy trades one blow and the dead ones none.
+ */
+void test2_combat_round();
+
+/**
+ * @brief Test that health stops at 0 and a dead player gives no more blows.
+ */
+void test3_combat_round();
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_combat_encounter();
+
+/**
+ * @brief Test that a fight ends with a side dead and the same seed gives the same fight.
+ */
+void test2_combat_encounter();
+
+/**
+ * @brief Test that a fight without damage stops at the limit of rounds.
+ */
+void test3_combat_encounter();
+
+/**
+ * @brief Test that an even fight is won about half of the times.
+ */
+void test4_combat_encounter();
+
+/**
+ * @brief Main function for combat unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Combat:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_combat_round();
+	if (all || test == 2)
+		test2_combat_round();
+	if (all || test == 3)
+		test3_combat_round();
+	if (all || test == 4)
+		test1_combat_encounter();
+	if (all || test == 5)
+		test2_combat_encounter();
+	if (all || test == 6)
+		test3_combat_encounter();
+	if (all || test == 7)
+		test4_combat_encounter();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It sets the health and the damage of a combatant
+ */
+static void combatant_set(Combatant *combatant, int health, int damage)
+{
+	combatant->health = health;
+	combatant->damage = damage;
+}
+
+void test1_combat_round()
+{
+	Combatant player, enemy;
+	unsigned long rng = 1;
+
+	combatant_set(&player, 10, 10);
+	combatant_set(&enemy, 10, 10);
+	PRINT_TEST_RESULT(combat_round(NULL, &enemy, 1, &rng, NULL) == -1 && combat_round(&player, NULL, 1, &rng, NULL) == -1 &&
+					  combat_round(&player, &enemy, -1, &rng, NULL) == -1 && combat_round(&player, &enemy, 1, NULL, NULL) == -1 &&
+					  combat_round(&player, NULL, 0, &rng, NULL) == 0 && player.health == 10 && enemy.health == 10);
+}
+
+void test2_combat_round()
+{
+	Combatant player, enemies[4];
+	CombatBlow blows[4];
+	unsigned long rng = 12345;
+	int alive, i, hit = 0;
+	Bool right = TRUE;
+
+	combatant_set(&player, 100, 10);
+	for (i = 0; i < 4; i++)
+	{
+		combatant_set(&enemies[i], 30, 10);
+	}
+	enemies[2].health = 0;
+	alive = combat_round(&player, enemies, 4, &rng, blows);
+
+	for (i = 0; i < 4; i++)
+	{
+		if (blows[i].hit == COMBAT_ENEMY_HIT)
+		{
+			right = (right == TRUE && enemies[i].health == 20 && blows[i].health == 20) ? TRUE : FALSE;
+		}
+		else if (blows[i].hit == COMBAT_PLAYER_HIT)
+		{
+			right = (right == TRUE && enemies[i].health == 30) ? TRUE : FALSE;
+			hit++;
+		}
+	}
+	PRINT_TEST_RESULT(right == TRUE && alive == 3 && blows[2].hit == COMBAT_NO_HIT && blows[2].health == 0 && blows[0].hit != COMBAT_NO_HIT &&
+					  blows[3].hit != COMBAT_NO_HIT && player.health == 100 - 10 * hit);
+}
+
+void test3_combat_round()
+{
+	Combatant player, enemies[8];
+	CombatBlow blows[8];
+	unsigned long rng = 0;
+	int i, j = -1;
+	Bool right = TRUE;
+
+	combatant_set(&player, 5, 10);
+	for (i = 0; i < 8; i++)
+	{
+		combatant_set(&enemies[i], 5, 10);
+	}
+	combat_round(&player, enemies, 8, &rng, blows);
+
+	/* The first enemy that hits the player kills it, nothing happens after it */
+	for (i = 0; i < 8; i++)
+	{
+		if (j >= 0 && blows[i].hit != COMBAT_NO_HIT)
+		{
+			right = FALSE;
+		}
+		if (blows[i].hit == COMBAT_PLAYER_HIT)
+		{
+			j = i;
+			right = (right == TRUE && blows[i].health == 0) ? TRUE : FALSE;
+		}
+		if (blows[i].hit == COMBAT_ENEMY_HIT && (blows[i].health != 0 || enemies[i].health != 0))
+		{
+			right = FALSE;
+		}
+	}
+	PRINT_TEST_RESULT(right == TRUE && rng != 0 && (j == -1 || player.health == 0) && (j >= 0 || player.health == 5));
+}
+
+void test1_combat_encounter()
+{
+	Combatant player, enemy;
+	CombatOutcome outcome;
+	unsigned long rng = 1;
+
+	combatant_set(&player, 10, 10);
+	combatant_set(&enemy, 10, 10);
+	PRINT_TEST_RESULT(combat_encounter(NULL, &enemy, 1, &rng, &outcome) == ERROR && combat_encounter(&player, &enemy, 1, NULL, &outcome) == ERROR &&
+					  combat_encounter(&player, &enemy, 1, &rng, NULL) == ERROR && combat_encounter(&player, NULL, 0, &rng, &outcome) == OK &&
+					  outcome.won == TRUE && outcome.rounds == 0 && outcome.damage == 0);
+}
+
+void test2_combat_encounter()
+{
+	Combatant player, enemies[3], again, enemies_again[3];
+	CombatOutcome outcome, outcome_again;
+	unsigned long rng = 99, rng_again = 99;
+	int i;
+
+	combatant_set(&player, 50, 10);
+	for (i = 0; i < 3; i++)
+	{
+		combatant_set(&enemies[i], 20, 10);
+	}
+	again = player;
+	memcpy(enemies_again, enemies, sizeof(enemies));
+	combat_encounter(&player, enemies, 3, &rng, &outcome);
+	combat_encounter(&again, enemies_again, 3, &rng_again, &outcome_again);
+
+	PRINT_TEST_RESULT(outcome.rounds > 0 && outcome.damage == 50 - player.health &&
+					  (outcome.won == TRUE ? enemies[0].health + enemies[1].health + enemies[2].health == 0 && player.health > 0 : player.health == 0) &&
+					  outcome.won == outcome_again.won && outcome.rounds == outcome_again.rounds && outcome.damage == outcome_again.damage &&
+					  rng == rng_again && memcmp(enemies, enemies_again, sizeof(enemies)) == 0);
+}
+
+void test3_combat_encounter()
+{
+	Combatant player, enemy;
+	CombatOutcome outcome;
+	unsigned long rng = 7;
+
+	combatant_set(&player, 10, 0);
+	combatant_set(&enemy, 10, 0);
+	PRINT_TEST_RESULT(combat_encounter(&player, &enemy, 1, &rng, &outcome) == OK && outcome.won == FALSE && outcome.rounds == COMBAT_MAX_ROUNDS &&
+					  outcome.damage == 0);
+}
+
+void test4_combat_encounter()
+{
+	Combatant player, enemy;
+	CombatOutcome outcome;
+	unsigned long rng = 2026;
+	int i, wins = 0;
+
+	for (i = 0; i < 10000; i++)
+	{
+		combatant_set(&player, 30, COMBAT_DAMAGE);
+		combatant_set(&enemy, 30, COMBAT_DAMAGE);
+		combat_encounter(&player, &enemy, 1, &rng, &outcome);
+		wins += outcome.won == TRUE ? 1 : 0;
+	}
+	PRINT_TEST_RESULT(wins > 4700 && wins < 5300);
+}
@@ -9,6 +9,7 @@
  */
 
 #include "command.h"
+#include "stats.h"
 
 /**
  * @brief Defines length of the command
@@ -23,7 +24,7 @@
 /**
  * @brief Defines database for commands
  */
-char *cmd_to_str[N_CMD][N_CMDT] = {{"", "No command"}, {"", "Unknown"}, {"e", "Exit"}, {"t", "Take"}, {"d", "Drop"}, {"a", "Attack"}, {"c", "Chat"}, {"m", "Move"}, {"i", "Inspect"}, {"r", "Recruit"}, {"ab", "Abandon"}};
+char *cmd_to_str[N_CMD][N_CMDT] = {{"", "No command"}, {"", "Unknown"}, {"e", "Exit"}, {"t", "Take"}, {"d", "Drop"}, {"a", "Attack"}, {"c", "Chat"}, {"m", "Move"}, {"i", "Inspect"}, {"r", "Recruit"}, {"ab", "Abandon"}, {"st", "Stats"}, {"u", "Undo"}};
 
 /**
  * @brief Private implementation of command datatype
@@ -87,56 +88,74 @@ CommandCode command_get_code(Command *command)
 
 Status command_get_user_input(Command *command)
 {
-	char input[CMD_LENGHT] = "", *token = NULL;
+	char input[CMD_LENGHT] = "";
+	unsigned long stats_t = 0;
+	char *read;
+
+	if (!command)
+	{
+		return ERROR;
+	}
+
+	STATS_START(stats_t);
+	read = fgets(input, CMD_LENGHT, stdin);
+	STATS_STOP(STATS_SLOT_INPUT, stats_t);
+
+	if (read)
+	{
+		return command_parse_input(command, input);
+	}
+	return command_set_code(command, EXIT);
+}
+
+Status command_parse_input(Command *command, char *input)
+{
+	char *token = NULL;
 	int i = UNKNOWN - NO_CMD + 1;
 	CommandCode cmd;
 
-	if (!command)
+	if (!command || !input)
 	{
 		return ERROR;
 	}
 
-	if (fgets(input, CMD_LENGHT, stdin))
+	token = strtok(input, " \n");
+	if (!token)
+	{
+		return command_set_code(command, UNKNOWN);
+	}
+
+	cmd = UNKNOWN;
+	while (cmd == UNKNOWN && i < N_CMD)
 	{
-		token = strtok(input, " \n");
-		if (!token)
+		if (!strcasecmp(token, cmd_to_str[i][CMDS]) || !strcasecmp(token, cmd_to_str[i][CMDL]))
 		{
-			return command_set_code(command, UNKNOWN);
+			cmd = i + NO_CMD;
 		}
-
-		cmd = UNKNOWN;
-		while (cmd == UNKNOWN && i < N_CMD)
+		else
 		{
-			if (!strcasecmp(token, cmd_to_str[i][CMDS]) || !strcasecmp(token, cmd_to_str[i][CMDL]))
-			{
-				cmd = i + NO_CMD;
-			}
-			else
-			{
-				i++;
-			}
+			i++;
 		}
+	}
 
-		command_set_code(command, cmd);
+	command_set_code(command, cmd);
 
-		if (cmd == TAKE || cmd == DROP || cmd == MOVE || cmd == INSPECT || cmd == RECRUIT || cmd == ABANDON || cmd == CHAT)
+	if (cmd == TAKE || cmd == DROP || cmd == MOVE || cmd == INSPECT || cmd == RECRUIT || cmd == ABANDON || cmd == CHAT)
+	{
+		token = strtok(NULL, "\n");
+		if (token)
 		{
-			token = strtok(NULL, "\n");
-			if (token)
-			{
-				while (*token == ' ')
-					token++;
-				command_set_arg(command, token);
-			}
-			else
-			{
-				command_set_arg(command, "");
-			}
+			while (*token == ' ')
+				token++;
+			command_set_arg(command, token);
+		}
+		else
+		{
+			command_set_arg(command, "");
 		}
-
-		return OK;
 	}
-	return command_set_code(command, EXIT);
+
+	return OK;
 }
 
 const char *command_get_arg(Command *command)
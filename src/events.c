@@ -0,0 +1,242 @@
+/**
+ * @brief It implements the bus of the events of the game
+ *
+ * @file events.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "events.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief A subscriber of a bus
+ */
+typedef struct
+{
+	unsigned long mask;	  /*!< Types of event it wants */
+	EventHandler handler; /*!< Function that receives the events */
+	void *data;			  /*!< Data given to the function */
+} EventSubscriber;
+
+/**
+ * @brief Private implementation of the bus
+ *
+ * The batch being dispatched is swapped with an empty one first, so the
+ * subscribers can publish without moving the events they are reading.
+ */
+struct _EventBus
+{
+	EventSubscriber subscribers[EVENT_MAX_SUBSCRIBERS]; /*!< Subscribers */
+	int n_subscribers;									/*!< Number of subscribers */
+	unsigned long mask;									/*!< Types wanted by some subscriber */
+	Event *events;										/*!< Events of the current batch */
+	int n_events;										/*!< Number of events of the batch */
+	int max_events;										/*!< Capacity of the events array */
+	Event *spare;										/*!< Array given to the next batch when this one is dispatched */
+	int max_spare;										/*!< Capacity of the spare array */
+};
+
+/**
+ * @brief Names of the types of event
+ */
+static const char *event_names[EVENT_TYPES] = {"player_moved", "object_taken", "object_dropped", "health_changed", "character_recruited",
+											   "character_abandoned", "character_moved", "link_opened", "link_closed"};
+
+EventBus *event_bus_create()
+{
+	EventBus *bus = NULL;
+
+	if (!(bus = (EventBus *)calloc(1, sizeof(EventBus))))
+	{
+		return NULL;
+	}
+
+	return bus;
+}
+
+void event_bus_destroy(EventBus *bus)
+{
+	if (!bus)
+	{
+		return;
+	}
+
+	free(bus->events);
+	free(bus->spare);
+	free(bus);
+}
+
+Status event_bus_subscribe(EventBus *bus, unsigned long mask, EventHandler handler, void *data)
+{
+	if (!bus || !handler || bus->n_subscribers >= EVENT_MAX_SUBSCRIBERS)
+	{
+		return ERROR;
+	}
+
+	bus->subscribers[bus->n_subscribers].mask = mask & EVENT_ALL;
+	bus->subscribers[bus->n_subscribers].handler = handler;
+	bus->subscribers[bus->n_subscribers].data = data;
+	bus->n_subscribers++;
+	bus->mask |= mask & EVENT_ALL;
+
+	return OK;
+}
+
+Bool event_bus_wants(EventBus *bus, EventType type)
+{
+	if (!bus || type < 0 || type >= EVENT_TYPES)
+	{
+		return FALSE;
+	}
+
+	return (bus->mask & EVENT_MASK(type)) ? TRUE : FALSE;
+}
+
+Status event_bus_publish(EventBus *bus, const Event *event)
+{
+	Event *grown = NULL;
+	int capacity;
+
+	if (!bus || !event || event->type < 0 || event->type >= EVENT_TYPES)
+	{
+		return ERROR;
+	}
+
+	if (!(bus->mask & EVENT_MASK(event->type)))
+	{
+		return OK;
+	}
+
+	if (bus->n_events == bus->max_events)
+	{
+		capacity = bus->max_events > 0 ? bus->max_events * 2 : 16;
+		if (!(grown = (Event *)realloc(bus->events, capacity * sizeof(Event))))
+		{
+			return ERROR;
+		}
+		bus->events = grown;
+		bus->max_events = capacity;
+	}
+
+	bus->events[bus->n_events++] = *event;
+	return OK;
+}
+
+int event_bus_get_count(EventBus *bus)
+{
+	if (!bus)
+	{
+		return -1;
+	}
+
+	return bus->n_events;
+}
+
+const Event *event_bus_get_event(EventBus *bus, int position)
+{
+	if (!bus || position < 0 || position >= bus->n_events)
+	{
+		return NULL;
+	}
+
+	return &bus->events[position];
+}
+
+int event_bus_dispatch(EventBus *bus)
+{
+	Event *events = NULL;
+	unsigned long present = 0;
+	int i, n, max;
+
+	if (!bus)
+	{
+		return -1;
+	}
+
+	if (bus->n_events == 0)
+	{
+		return 0;
+	}
+
+	/* The batch leaves the bus, the next one starts in the spare array */
+	events = bus->events;
+	n = bus->n_events;
+	max = bus->max_events;
+	bus->events = bus->spare;
+	bus->max_events = bus->max_spare;
+	bus->n_events = 0;
+	bus->spare = NULL;
+	bus->max_spare = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		present |= EVENT_MASK(events[i].type);
+	}
+
+	for (i = 0; i < bus->n_subscribers; i++)
+	{
+		if (bus->subscribers[i].mask & present)
+		{
+			bus->subscribers[i].handler(events, n, bus->subscribers[i].data);
+		}
+	}
+
+	/* The array of the batch is kept for a later one */
+	if (!bus->spare)
+	{
+		bus->spare = events;
+		bus->max_spare = max;
+	}
+	else
+	{
+		free(events);
+	}
+
+	return n;
+}
+
+EventBus *event_bus_fork(EventBus *bus)
+{
+	EventBus *child = NULL;
+
+	if (!bus || !(child = event_bus_create()))
+	{
+		return NULL;
+	}
+
+	child->mask = bus->mask;
+	return child;
+}
+
+Status event_bus_join(EventBus *bus, EventBus *child)
+{
+	Status status = OK;
+	int i;
+
+	if (!bus || !child)
+	{
+		event_bus_destroy(child);
+		return ERROR;
+	}
+
+	for (i = 0; i < child->n_events && status == OK; i++)
+	{
+		status = event_bus_publish(bus, &child->events[i]);
+	}
+
+	event_bus_destroy(child);
+	return status;
+}
+
+const char *event_type_name(EventType type)
+{
+	if (type < 0 || type >= EVENT_TYPES)
+	{
+		return "?";
+	}
+
+	return event_names[type];
+}
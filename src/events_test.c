@@ -0,0 +1,283 @@
+/**
+ * @brief It tests the bus of the events of the game
+ *
+ * @file events_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "events.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 8
+
+/**
+ * @brief What a test subscriber saw
+ */
+typedef struct
+{
+	int calls;		 /*!< Number of batches received */
+	int n_events;	 /*!< Number of events of the last batch */
+	Id subjects[16]; /*!< Subjects of the last batch */
+	EventBus *bus;	 /*!< Bus where it publishes while it reads, NULL to only read */
+} Seen;
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_event_bus_subscribe();
+
+/**
+ * @brief Test that there are no more subscribers than the maximum.
+ */
+void test2_event_bus_subscribe();
+
+/**
+ * @brief Test that only the types wanted by some subscriber are kept.
+ */
+void test1_event_bus_publish();
+
+/**
+ * @brief Test that each subscriber gets the batch once, in order, and the bus is emptied.
+ */
+void test1_event_bus_dispatch();
+
+/**
+ * @brief Test that a subscriber is not called for a batch without its types.
+ */
+void test2_event_bus_dispatch();
+
+/**
+ * @brief Test that events published while dispatching go to the next batch.
+ */
+void test3_event_bus_dispatch();
+
+/**
+ * @brief Test that forks keep the wanted types and are joined in order.
+ */
+void test1_event_bus_join();
+
+/**
+ * @brief Test the names of the types.
+ */
+void test1_event_type_name();
+
+/**
+ * @brief Main function for events unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Events:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_event_bus_subscribe();
+	if (all || test == 2)
+		test2_event_bus_subscribe();
+	if (all || test == 3)
+		test1_event_bus_publish();
+	if (all || test == 4)
+		test1_event_bus_dispatch();
+	if (all || test == 5)
+		test2_event_bus_dispatch();
+	if (all || test == 6)
+		test3_event_bus_dispatch();
+	if (all || test == 7)
+		test1_event_bus_join();
+	if (all || test == 8)
+		test1_event_type_name();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief Subscriber that stores what it sees, and publishes a move for each batch if it has a bus
+ */
+static void seen_handler(const Event *events, int n_events, void *data)
+{
+	Seen *seen = (Seen *)data;
+	Event event = {EVENT_CHARACTER_MOVED, 0, 99, 1, 2, 0};
+	int i;
+
+	seen->calls++;
+	seen->n_events = n_events;
+	for (i = 0; i < n_events && i < 16; i++)
+	{
+		seen->subjects[i] = events[i].subject;
+	}
+	if (seen->bus)
+	{
+		event_bus_publish(seen->bus, &event);
+	}
+}
+
+/**
+ * @brief It publishes an event with only a type and a subject
+ */
+static Status publish(EventBus *bus, EventType type, Id subject)
+{
+	Event event;
+
+	event.type = type;
+	event.turn = 0;
+	event.subject = subject;
+	event.from = NO_ID;
+	event.to = NO_ID;
+	event.value = 0;
+	return event_bus_publish(bus, &event);
+}
+
+void test1_event_bus_subscribe()
+{
+	EventBus *bus = event_bus_create();
+	Seen seen;
+
+	memset(&seen, 0, sizeof(Seen));
+	PRINT_TEST_RESULT(event_bus_subscribe(NULL, EVENT_ALL, seen_handler, &seen) == ERROR && event_bus_subscribe(bus, EVENT_ALL, NULL, &seen) == ERROR &&
+					  event_bus_publish(bus, NULL) == ERROR && event_bus_dispatch(NULL) == -1 && event_bus_get_count(NULL) == -1 &&
+					  publish(bus, EVENT_TYPES, 1) == ERROR && event_bus_wants(bus, EVENT_PLAYER_MOVED) == FALSE);
+	event_bus_destroy(bus);
+}
+
+void test2_event_bus_subscribe()
+{
+	EventBus *bus = event_bus_create();
+	Seen seen;
+	int i;
+
+	memset(&seen, 0, sizeof(Seen));
+	for (i = 0; i < EVENT_MAX_SUBSCRIBERS; i++)
+	{
+		event_bus_subscribe(bus, EVENT_ALL, seen_handler, &seen);
+	}
+	publish(bus, EVENT_PLAYER_MOVED, 1);
+	PRINT_TEST_RESULT(event_bus_subscribe(bus, EVENT_ALL, seen_handler, &seen) == ERROR && event_bus_dispatch(bus) == 1 && seen.calls == EVENT_MAX_SUBSCRIBERS);
+	event_bus_destroy(bus);
+}
+
+void test1_event_bus_publish()
+{
+	EventBus *bus = event_bus_create();
+	Seen seen;
+
+	memset(&seen, 0, sizeof(Seen));
+	publish(bus, EVENT_PLAYER_MOVED, 1);
+	event_bus_subscribe(bus, EVENT_MASK(EVENT_OBJECT_TAKEN) | EVENT_MASK(EVENT_LINK_OPENED), seen_handler, &seen);
+	publish(bus, EVENT_PLAYER_MOVED, 2);
+	publish(bus, EVENT_OBJECT_TAKEN, 3);
+	publish(bus, EVENT_LINK_OPENED, 4);
+	PRINT_TEST_RESULT(event_bus_get_count(bus) == 2 && event_bus_get_event(bus, 0)->subject == 3 && event_bus_get_event(bus, 1)->subject == 4 &&
+					  event_bus_get_event(bus, 2) == NULL && event_bus_wants(bus, EVENT_LINK_OPENED) == TRUE && seen.calls == 0);
+	event_bus_destroy(bus);
+}
+
+void test1_event_bus_dispatch()
+{
+	EventBus *bus = event_bus_create();
+	Seen first, second;
+	int i, n;
+
+	memset(&first, 0, sizeof(Seen));
+	memset(&second, 0, sizeof(Seen));
+	event_bus_subscribe(bus, EVENT_ALL, seen_handler, &first);
+	event_bus_subscribe(bus, EVENT_MASK(EVENT_HEALTH_CHANGED), seen_handler, &second);
+	for (i = 0; i < 10; i++)
+	{
+		publish(bus, i % 2 ? EVENT_HEALTH_CHANGED : EVENT_PLAYER_MOVED, i);
+	}
+	n = event_bus_dispatch(bus);
+	PRINT_TEST_RESULT(n == 10 && first.calls == 1 && second.calls == 1 && first.n_events == 10 && first.subjects[0] == 0 && first.subjects[9] == 9 &&
+					  event_bus_get_count(bus) == 0 && event_bus_dispatch(bus) == 0 && first.calls == 1);
+	event_bus_destroy(bus);
+}
+
+void test2_event_bus_dispatch()
+{
+	EventBus *bus = event_bus_create();
+	Seen movers, fighters;
+
+	memset(&movers, 0, sizeof(Seen));
+	memset(&fighters, 0, sizeof(Seen));
+	event_bus_subscribe(bus, EVENT_MASK(EVENT_PLAYER_MOVED), seen_handler, &movers);
+	event_bus_subscribe(bus, EVENT_MASK(EVENT_HEALTH_CHANGED), seen_handler, &fighters);
+	publish(bus, EVENT_PLAYER_MOVED, 1);
+	event_bus_dispatch(bus);
+	PRINT_TEST_RESULT(movers.calls == 1 && fighters.calls == 0);
+	event_bus_destroy(bus);
+}
+
+void test3_event_bus_dispatch()
+{
+	EventBus *bus = event_bus_create();
+	Seen seen;
+	int i;
+
+	memset(&seen, 0, sizeof(Seen));
+	seen.bus = bus;
+	event_bus_subscribe(bus, EVENT_ALL, seen_handler, &seen);
+	for (i = 0; i < 40; i++)
+	{
+		publish(bus, EVENT_PLAYER_MOVED, i);
+	}
+	event_bus_dispatch(bus);
+	PRINT_TEST_RESULT(seen.n_events == 40 && event_bus_get_count(bus) == 1 && event_bus_get_event(bus, 0)->subject == 99 && event_bus_dispatch(bus) == 1 &&
+					  seen.calls == 2 && seen.subjects[0] == 99);
+	event_bus_destroy(bus);
+}
+
+void test1_event_bus_join()
+{
+	EventBus *bus = event_bus_create(), *a = NULL, *b = NULL;
+	Seen seen;
+
+	memset(&seen, 0, sizeof(Seen));
+	event_bus_subscribe(bus, EVENT_MASK(EVENT_OBJECT_TAKEN), seen_handler, &seen);
+	a = event_bus_fork(bus);
+	b = event_bus_fork(bus);
+	publish(b, EVENT_OBJECT_TAKEN, 3);
+	publish(a, EVENT_OBJECT_TAKEN, 1);
+	publish(a, EVENT_PLAYER_MOVED, 9);
+	publish(a, EVENT_OBJECT_TAKEN, 2);
+	publish(bus, EVENT_OBJECT_TAKEN, 0);
+	PRINT_TEST_RESULT(event_bus_get_count(a) == 2 && event_bus_join(bus, a) == OK && event_bus_join(bus, b) == OK && event_bus_dispatch(bus) == 4 &&
+					  seen.subjects[0] == 0 && seen.subjects[1] == 1 && seen.subjects[2] == 2 && seen.subjects[3] == 3 && event_bus_join(bus, NULL) == ERROR);
+	event_bus_destroy(bus);
+}
+
+void test1_event_type_name()
+{
+	PRINT_TEST_RESULT(strcmp(event_type_name(EVENT_PLAYER_MOVED), "player_moved") == 0 && strcmp(event_type_name(EVENT_LINK_CLOSED), "link_closed") == 0 &&
+					  strcmp(event_type_name(EVENT_TYPES), "?") == 0);
+}
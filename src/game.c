@@ -10,8 +10,11 @@
 
 #include "game.h"
 #include "game_reader.h"
+#include "image.h"
+#include "region.h"
+#include "snapshot.h"
+#include "zobrist.h"
 #include "character.h"
-#include "time.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +29,48 @@ struct _InterfaceData
 	char last_message[MESSAGE_SIZE + 1]; /**< Last message of a specific player */
 };
 
+/**
+ * @brief An entry of the index of the links by origin
+ */
+typedef struct
+{
+	Id origin;	   /**< Id of the origin space of the link */
+	int direction; /**< Direction of the link */
+	int position;  /**< Position of the link in the links array */
+} LinkEntry;
+
+/**
+ * @brief An entry of the hash indexes of the game, from an id to where it is
+ */
+typedef struct
+{
+	Id id;		/**< Id of the space or character, NO_ID if the entry is free */
+	long value; /**< Position of the space in the spaces array, or id of the space of the character */
+} IdEntry;
+
+/**
+ * @brief Hash indexes of the spaces and characters by id
+ *
+ * A game shares them with its shadows and sessions, like its arrays. Every
+ * entry is checked against the arrays when it is read, so one left behind by
+ * a change made outside of the game is never trusted, and only games that are
+ * not shadows write them, since shadows run in parallel.
+ */
+typedef struct
+{
+	IdEntry *spaces;	 /**< Position of each space in the spaces array */
+	int space_size;		 /**< Entries of spaces, a power of two, 0 if there is no table */
+	int n_spaces;		 /**< Number of spaces indexed, the first ones of the spaces array */
+	IdEntry *characters; /**< Space where each character was last found */
+	int character_size;	 /**< Entries of characters, a power of two, 0 if there is no table */
+	int n_characters;	 /**< Number of entries of characters in use */
+} GameIndex;
+
+/**
+ * @brief Smallest number of entries of a hash index
+ */
+#define GAME_INDEX_MIN 16
+
 /**
  * @brief Private implementation of game module
  */
@@ -33,20 +78,77 @@ struct _Game
 {
 	Player *players[MAX_PLAYERS];			  /**< Array of pointers to the players */
 	InterfaceData *interfaces[MAX_PLAYERS];	  /**< Array of pointers to the interfaces of each player */
-	Space *spaces[MAX_SPACES];				  /**< Array of spaces in the game. */
-	Object *objects[MAX_OBJECTS];			  /**< Array of objects in the game. */
-	Character *characters[MAX_CHARACTERS];	  /**< Array of characters in the game. */
-	Link *links[MAX_LINKS];					  /**< Array of links in the game */
+	Space **spaces;							  /**< Array of spaces in the game. */
+	Object **objects;						  /**< Array of objects in the game. */
+	Character **characters;					  /**< Array of characters in the game. */
+	Link **links;							  /**< Array of links in the game */
 	int n_spaces;							  /**< Number of spaces in the game. */
 	int n_objects;							  /**< Number of objects in the game. */
 	int n_characters;						  /**< Number of characters in the game. */
 	int n_links;							  /**< Number of links in the game. */
+	int max_spaces;							  /**< Capacity of the spaces array */
+	int max_objects;						  /**< Capacity of the objects array */
+	int max_characters;						  /**< Capacity of the characters array */
+	int max_links;							  /**< Capacity of the links array */
 	int n_players;							  /**< Number of players in the game */
 	Bool finished;							  /**< Whether the game is finished or not. */
 	char temporal_feedback[MESSAGE_SIZE + 1]; /**< Temporal feedback message. */
 	int turn;								  /**< The position of the active player in the players array */
+	RegionCache *regions;					  /**< Regions of a paged world, NULL if the whole world is loaded */
+	Bool feedback_changed;					  /**< Whether the temporal feedback was set, read when a shadow is merged */
+	EventBus *events;						  /**< Events published in the current turn */
+	Snapshot **undo;						  /**< Ring of the states before the last commands, NULL in shadows */
+	int undo_top;							  /**< Position of the ring where the next state is saved */
+	int n_undo;								  /**< Number of states that can be undone */
+	unsigned long hash;						  /**< Zobrist hash of the state, in a shadow only of the changes made in it */
+	LinkEntry *link_index;					  /**< Links sorted by origin and direction, NULL if they are not indexed */
+	int n_link_index;						  /**< Number of links in the index, it is only used while it is n_links */
+	GameIndex *index;						  /**< Spaces and characters by id, shared with the shadows and sessions */
+	Game *world;							  /**< World whose entities a session shares, NULL if it owns them */
+	Snapshot *overlay;						  /**< State of a session while another one is in the entities, of a world the state it was loaded with */
+	Game *active;							  /**< Session of a world whose state is in the entities, NULL if none */
 };
 
+/**
+ * @brief Makes room in one of the pointer arrays of the game
+ *
+ * The capacity is doubled until it holds n pointers, and the new positions are set to NULL.
+ *
+ * @param array The array, it may be NULL
+ * @param capacity A pointer to the capacity of the array, updated on success
+ * @param n The number of pointers the array must hold
+ * @return The new array, NULL if there was not enough memory (the old one is still valid)
+ */
+static void *game_grow_array(void *array, int *capacity, int n)
+{
+	void **new_array = NULL;
+	int new_capacity = *capacity > 0 ? *capacity : 1;
+	int i;
+
+	if (array != NULL && n <= *capacity)
+	{
+		return array;
+	}
+
+	while (new_capacity < n)
+	{
+		new_capacity *= 2;
+	}
+
+	if (!(new_array = (void **)realloc(array, new_capacity * sizeof(void *))))
+	{
+		return NULL;
+	}
+
+	for (i = (array != NULL ? *capacity : 0); i < new_capacity; i++)
+	{
+		new_array[i] = NULL;
+	}
+
+	*capacity = new_capacity;
+	return new_array;
+}
+
 InterfaceData *game_create_interface()
 {
 	InterfaceData *new_interface = NULL;
@@ -74,593 +176,1727 @@ Status game_create(Game **game)
 		}
 	}
 
-	/*Initialize seed for random numbers*/
-	srand(time(NULL));
+	/*Initialize entity arrays, they grow as the world is loaded*/
+	(*game)->spaces = NULL;
+	(*game)->objects = NULL;
+	(*game)->characters = NULL;
+	(*game)->links = NULL;
+	(*game)->max_spaces = 0;
+	(*game)->max_objects = 0;
+	(*game)->max_characters = 0;
+	(*game)->max_links = 0;
 
-	/*Initialize character array*/
+	(*game)->n_spaces = 0;
+	(*game)->n_objects = 0;
 	(*game)->n_characters = 0;
-	for (i = 0; i < MAX_CHARACTERS; i++)
+	(*game)->n_links = 0;
+	(*game)->n_players = 0;
+	(*game)->regions = NULL;
+	(*game)->link_index = NULL;
+	(*game)->n_link_index = 0;
+	if (!((*game)->index = (GameIndex *)calloc(1, sizeof(GameIndex))))
 	{
-		(*game)->characters[i] = NULL;
+		return ERROR;
 	}
+	(*game)->world = NULL;
+	(*game)->overlay = NULL;
+	(*game)->active = NULL;
 
-	for (i = 0; i < MAX_SPACES; i++)
+	if (!((*game)->events = event_bus_create()))
 	{
-		(*game)->spaces[i] = NULL;
+		return ERROR;
 	}
 
-	(*game)->n_spaces = 0;
-	(*game)->n_objects = 0;
-	(*game)->n_links = 0;
-	(*game)->n_players = 0;
+	(*game)->hash = 0;
+	(*game)->undo_top = 0;
+	(*game)->n_undo = 0;
+	if (!((*game)->undo = (Snapshot **)calloc(GAME_UNDO_DEPTH, sizeof(Snapshot *))))
+	{
+		return ERROR;
+	}
 
-	for (i = 0; i < MAX_PLAYERS; i++)
+	if (game_reserve_spaces(*game, MAX_SPACES) == ERROR || game_reserve_objects(*game, MAX_OBJECTS) == ERROR ||
+		game_reserve_characters(*game, MAX_CHARACTERS) == ERROR || game_reserve_links(*game, MAX_LINKS) == ERROR)
 	{
-		(*game)->players[i] = NULL;
+		return ERROR;
 	}
 
 	for (i = 0; i < MAX_PLAYERS; i++)
 	{
-		(*game)->interfaces[i] = NULL;
+		(*game)->players[i] = NULL;
 	}
 
-	for (i = 0; i < MAX_OBJECTS; i++)
+	for (i = 0; i < MAX_PLAYERS; i++)
 	{
-		(*game)->objects[i] = NULL;
-	}
-	/*(*game)->object[0] = object_create(NO_ID);
-	if ((*game)->object[0] == NULL) {
-	  return ERROR;
+		(*game)->interfaces[i] = NULL;
 	}
-	(*game)->n_objects++;*/
 
 	(*game)->finished = FALSE;
 
-	for (i = 0; i < MAX_LINKS; i++)
-	{
-		(*game)->links[i] = NULL;
-	}
-
 	(*game)->temporal_feedback[0] = '\0';
+	(*game)->feedback_changed = FALSE;
 	(*game)->turn = 0;
 
 	return OK;
 }
 
-Status game_create_from_file(Game **game, char *filename)
+/**
+ * @brief Compares two entries of the index of the links, by origin, direction and position
+ */
+static int game_compare_links(const void *a, const void *b)
 {
-	if (game_create(game) == ERROR)
-	{
-		fprintf(stderr, "Error: Failed to create game structure.\n");
-		return ERROR;
-	}
+	const LinkEntry *x = (const LinkEntry *)a, *y = (const LinkEntry *)b;
 
-	if (game_load_spaces(*game, filename) == ERROR)
+	if (x->origin != y->origin)
 	{
-		fprintf(stderr, "Error: Failed to load spaces from file.\n");
-		return ERROR;
+		return x->origin < y->origin ? -1 : 1;
 	}
-
-	if (game_load_players(*game, filename) == ERROR)
+	if (x->direction != y->direction)
 	{
-		fprintf(stderr, "Error: Failed to load players from file.\n");
-		return ERROR;
+		return x->direction - y->direction;
 	}
 
-	if (game_load_objects(*game, filename) == ERROR)
+	return x->position - y->position;
+}
+
+/**
+ * @brief Sorts the links by origin, so the links out of a space are found without reading the others
+ *
+ * The links of the same origin and direction keep the order of the file, so
+ * the first one is still the one that is used. Without memory for the index
+ * the links are searched one by one.
+ *
+ * @param game A pointer to the game
+ */
+static void game_index_links(Game *game)
+{
+	int i;
+
+	free(game->link_index);
+	game->n_link_index = 0;
+	if (!(game->link_index = (LinkEntry *)malloc((game->n_links + 1) * sizeof(LinkEntry))))
 	{
-		fprintf(stderr, "Error: Failed to load objects from file.\n");
-		return ERROR;
+		return;
 	}
 
-	if (game_load_links(*game, filename) == ERROR)
+	for (i = 0; i < game->n_links; i++)
 	{
-		fprintf(stderr, "Error: Failed to load links from file.\n");
-		return ERROR;
+		game->link_index[i].origin = link_get_origin(game->links[i]);
+		game->link_index[i].direction = (int)link_get_direction(game->links[i]);
+		game->link_index[i].position = i;
 	}
+	qsort(game->link_index, game->n_links, sizeof(LinkEntry), game_compare_links);
+	game->n_link_index = game->n_links;
+}
+
+/**
+ * @brief Finds the entry of an id in a hash index
+ *
+ * @param table The entries, linearly probed
+ * @param size The number of entries, a power of two
+ * @param id The id
+ * @return The entry of the id, or the free entry where it would go, NULL if there is no table
+ */
+static IdEntry *game_index_find(IdEntry *table, int size, Id id)
+{
+	unsigned long i;
 
-	if (game_load_characters(*game, filename) == ERROR)
+	if (!table || size <= 0)
 	{
-		fprintf(stderr, "Error: Failed to load characters from file.\n");
-		return ERROR;
+		return NULL;
 	}
 
-	/* The player is located in the first space */
-	game_set_player_location(*game, player_get_location(game_get_player_at(*game, game_get_turn(*game))));
-	/*game_set_object_location(*game, game_get_space_id_at(*game, 0), 0);*/
-
-	object_set_description((*game)->objects[0], "A magic wand");
-	object_set_description((*game)->objects[1], "A book of magic.");
-	object_set_description((*game)->objects[2], "A magic potion.");
-	object_set_description((*game)->objects[3], "A magic ring.");
+	for (i = ((unsigned long)id * 2654435761UL) & (size - 1); table[i].id != NO_ID && table[i].id != id; i = (i + 1) & (size - 1))
+		;
 
-	return OK;
+	return &table[i];
 }
 
-Status game_destroy(Game *game)
+/**
+ * @brief Makes an empty hash index with room for n ids, at most half full
+ *
+ * @param table A pointer to the entries, which are freed and replaced
+ * @param size A pointer to the number of entries
+ * @param n The number of ids
+ * @return OK if it was made, ERROR if there was not enough memory (there is no table then)
+ */
+static Status game_index_reset(IdEntry **table, int *size, int n)
 {
-	int i = 0;
+	int i;
 
-	if (!game)
+	free(*table);
+	*table = NULL;
+	for (*size = GAME_INDEX_MIN; *size < 2 * n; *size *= 2)
+		;
+
+	if (!(*table = (IdEntry *)malloc(*size * sizeof(IdEntry))))
 	{
+		*size = 0;
 		return ERROR;
 	}
 
-	for (i = 0; i < game->n_spaces; i++)
+	for (i = 0; i < *size; i++)
 	{
-		if (game->spaces[i] != NULL)
-		{
-			space_destroy(game->spaces[i]);
-			game->spaces[i] = NULL;
-		}
+		(*table)[i].id = NO_ID;
 	}
 
-	/*Checks all character array and frees as needed*/
-	for (i = 0; i < MAX_CHARACTERS; i++)
+	return OK;
+}
+
+/**
+ * @brief Adds to the index the spaces added to the end of the array since it was built
+ *
+ * A space whose id is already there is left out, as the first one is the one found.
+ * The index is built again when it would be more than half full.
+ *
+ * @param game A pointer to the game
+ * @param again Whether the spaces were moved or removed, so the whole index is built again
+ */
+static void game_index_spaces(Game *game, Bool again)
+{
+	GameIndex *index = game->index;
+	IdEntry *entry = NULL;
+	int i;
+
+	if (again == TRUE || 2 * game->n_spaces > index->space_size || game->n_spaces < index->n_spaces)
 	{
-		if (game->characters[i] != NULL)
+		index->n_spaces = 0;
+		if (game_index_reset(&index->spaces, &index->space_size, game->n_spaces) == ERROR)
 		{
-			character_destroy(game->characters[i]);
-			game->characters[i] = NULL;
+			return;
 		}
 	}
 
-	for (i = 0; i < MAX_PLAYERS; i++)
+	for (i = index->n_spaces; i < game->n_spaces; i++)
 	{
-		if (game->players[i] != NULL)
+		if ((entry = game_index_find(index->spaces, index->space_size, space_get_id(game->spaces[i]))) && entry->id == NO_ID)
 		{
-			player_destroy(game->players[i]);
-			game->players[i] = NULL;
+			entry->id = space_get_id(game->spaces[i]);
+			entry->value = i;
 		}
 	}
+	index->n_spaces = game->n_spaces;
+}
 
-	for (i = 0; i < MAX_PLAYERS; i++)
+/**
+ * @brief Remembers the space where a character is
+ *
+ * Shadows do not write it, since they run in parallel.
+ *
+ * @param game A pointer to the game
+ * @param id The id of the character
+ * @param location The id of its space
+ */
+static void game_index_character(Game *game, Id id, Id location)
+{
+	GameIndex *index = game->index;
+	IdEntry *old = NULL, *entry = NULL;
+	int i, old_size;
+
+	if (!game->undo || id == NO_ID)
 	{
-		if (game->interfaces[i] != NULL)
-		{
-			command_destroy(game->interfaces[i]->last_cmd);
-			free(game->interfaces[i]);
-			game->interfaces[i] = NULL;
-		}
+		return;
 	}
 
-	for (i = 0; i < game->n_objects; i++)
+	/* The entries already in use are kept when the table grows */
+	if (2 * (index->n_characters + 1) > index->character_size)
 	{
-		if (game->objects[i] != NULL)
+		old = index->characters;
+		old_size = index->character_size;
+		index->characters = NULL;
+		index->n_characters = 0;
+		if (game_index_reset(&index->characters, &index->character_size, game->n_characters > old_size ? game->n_characters : old_size) == ERROR)
 		{
-			object_destroy(game->objects[i]);
-			game->objects[i] = NULL;
+			free(old);
+			return;
 		}
-	}
-
-	for (i = 0; i < game->n_links; i++)
-	{
-		if (game->links[i] != NULL)
+		for (i = 0; i < old_size; i++)
 		{
-			link_destroy(game->links[i]);
-			game->links[i] = NULL;
+			if (old[i].id != NO_ID)
+			{
+				*game_index_find(index->characters, index->character_size, old[i].id) = old[i];
+				index->n_characters++;
+			}
 		}
+		free(old);
 	}
 
-	free(game);
-	game = NULL;
-	return OK;
+	entry = game_index_find(index->characters, index->character_size, id);
+	if (entry->id == NO_ID)
+	{
+		entry->id = id;
+		index->n_characters++;
+	}
+	entry->value = location;
 }
 
-Space *game_get_space(Game *game, Id id)
+/**
+ * @brief Sets up the game once its world is loaded
+ *
+ * @param game A pointer to the game
+ */
+static void game_finish_load(Game *game)
 {
-	int i = 0;
+	char *descriptions[] = {"A magic wand", "A book of magic.", "A magic potion.", "A magic ring."};
+	int i;
 
-	if (id == NO_ID)
+	/* The player is located in the first space */
+	game_set_player_location(game, player_get_location(game_get_player_at(game, game_get_turn(game))));
+	/*game_set_object_location(game, game_get_space_id_at(game, 0), 0);*/
+
+	for (i = 0; i < game->n_objects && i < 4; i++)
 	{
-		return NULL;
+		object_set_description(game->objects[i], descriptions[i]);
 	}
 
-	for (i = 0; i < game->n_spaces; i++)
+	/* A world loaded from an image comes with its links indexed */
+	if (!game->regions && !(game->link_index && game->n_link_index == game->n_links))
 	{
-		if (id == space_get_id(game->spaces[i]))
-		{
-			return game->spaces[i];
-		}
+		game_index_links(game);
 	}
-
-	return NULL;
+	if (!game->regions)
+	{
+		game_index_spaces(game, FALSE);
+	}
+	game->hash = game_compute_hash(game);
 }
 
-Id game_get_player_location(Game *game)
+/**
+ * @brief Loads the world of an image written by anthill_compile
+ *
+ * @param game A pointer to the game
+ * @param filename The name of the image file
+ * @return OK if the world was loaded, ERROR otherwise
+ */
+static Status game_load_image(Game *game, char *filename)
 {
+	Image *image = image_open(filename);
+	Status status = image ? image_load(image, game) : ERROR;
 
-	Id location = player_get_location(game->players[game->turn]);
-
-	return location;
+	image_close(image);
+	return status;
 }
 
-Status game_set_player_location(Game *game, Id id)
+Status game_create_from_file(Game **game, char *filename)
 {
-	if (id == NO_ID)
+	if (game_create(game) == ERROR)
 	{
+		fprintf(stderr, "Error: Failed to create game structure.\n");
 		return ERROR;
 	}
 
-	*(player_get_location_pointer(game->players[game->turn])) = id;
+	if ((image_check(filename) == TRUE ? game_load_image(*game, filename) : game_load_world(*game, filename, 0)) == ERROR)
+	{
+		fprintf(stderr, "Error: Failed to load the world from file.\n");
+		return ERROR;
+	}
 
+	game_finish_load(*game);
 	return OK;
 }
 
-Id game_get_object_location(Game *game, int position)
+Status game_create_paged(Game **game, char *filename, long budget)
 {
-	int i = 0;
-
-	if (game == NULL || position < 0 || position >= MAX_OBJECTS || game->objects[position] == NULL)
+	if (game_create(game) == ERROR)
 	{
-		return NO_ID;
+		fprintf(stderr, "Error: Failed to create game structure.\n");
+		return ERROR;
 	}
 
-	for (i = 0; i < game->n_spaces; i++)
+	/* The regions are read from the text of the world, an image is loaded whole */
+	if (image_check(filename) == TRUE || !((*game)->regions = region_cache_open(filename, budget)) ||
+		region_cache_load_entities((*game)->regions, *game) == ERROR)
 	{
-
-		if (game->spaces[i] != NULL && (space_get_id(game->spaces[i]) == object_get_location(game->objects[position])))
-		{
-			return object_get_location(game->objects[position]);
-		}
+		fprintf(stderr, "Error: Failed to load the world from file.\n");
+		return ERROR;
 	}
 
-	return NO_ID;
+	game_finish_load(*game);
+	return OK;
 }
 
-Status game_set_object_location(Game *game, Id id, int position)
+int game_evict_regions(Game *game)
 {
-	if (position < 0 || position >= MAX_OBJECTS || game == NULL)
+	if (!game)
 	{
-		return ERROR;
+		return 0;
 	}
 
-	*(object_get_location_pointer(game->objects[position])) = id;
+	return region_evict(game->regions, game);
+}
 
-	if (game->n_objects == position)
+struct _RegionCache *game_get_regions(Game *game)
+{
+	if (!game)
 	{
-		game->n_objects++;
+		return NULL;
 	}
 
-	space_set_object(game_get_space(game, id), TRUE);
-
-	return OK;
-}
-
-Command *game_get_last_command(Game *game)
-{
-	return game->interfaces[game->turn]->last_cmd;
+	return game->regions;
 }
 
-Status game_set_last_command(Game *game, Command *command)
+Game *game_create_shadow(Game *game, int turn)
 {
-	game->interfaces[game->turn]->last_cmd = command;
-
-	return OK;
-}
+	Game *shadow = NULL;
 
-Bool game_get_finished(Game *game)
-{
-	return game->finished;
-}
+	if (!game || game->regions || turn < 0 || turn >= game->n_players || game_enter(game) == ERROR ||
+		!(shadow = (Game *)malloc(sizeof(Game))))
+	{
+		return NULL;
+	}
 
-Status game_set_finished(Game *game, Bool finished)
-{
-	game->finished = finished;
+	/* Same entities and arrays, only the active player, the feedback and the events are its own */
+	*shadow = *game;
+	shadow->turn = turn;
+	shadow->feedback_changed = FALSE;
+	shadow->undo = NULL;
+	shadow->n_undo = 0;
+	shadow->hash = 0;
+	shadow->overlay = NULL;
+	if (!(shadow->events = event_bus_fork(game->events)))
+	{
+		free(shadow);
+		return NULL;
+	}
 
-	return OK;
+	return shadow;
 }
 
-void game_print(Game *game)
+Status game_merge_shadow(Game *game, Game *shadow)
 {
-	int i = 0;
-
-	printf("\n\n-------------\n\n");
+	Status status;
 
-	printf("=> Spaces: \n");
-	for (i = 0; i < game->n_spaces; i++)
+	if (!game || !shadow)
 	{
-		space_print(game->spaces[i]);
+		return ERROR;
 	}
 
-	for (i = 0; i < game->n_objects; i++)
+	if (shadow->feedback_changed == TRUE)
 	{
-		printf("=> Object location: %d\n", (int)object_get_id(game->objects[i]));
+		strcpy(game->temporal_feedback, shadow->temporal_feedback);
 	}
+	game->turn = shadow->turn;
+	game->hash ^= shadow->hash;
+	status = event_bus_join(game->events, shadow->events);
+	free(shadow);
+
+	return status;
 }
 
-/*ADDITIONAL FUNCTIONS*/
+Status game_create_session(Game **session, Game *world)
+{
+	Game *new_session = NULL;
+	int i;
+
+	if (!session || !world || world->regions || world->world)
+	{
+		return ERROR;
+	}
+
+	/* The entities hold the loaded state until the first session is entered */
+	if (!world->overlay && !(world->overlay = snapshot_create(world)))
+	{
+		return ERROR;
+	}
+
+	if (!(new_session = (Game *)malloc(sizeof(Game))))
+	{
+		return ERROR;
+	}
+
+	/* Same entities and arrays, the rest is its own */
+	*new_session = *world;
+	new_session->world = world;
+	new_session->active = NULL;
+	new_session->events = NULL;
+	new_session->undo = NULL;
+	new_session->undo_top = 0;
+	new_session->n_undo = 0;
+	new_session->finished = FALSE;
+	new_session->temporal_feedback[0] = '\0';
+	new_session->feedback_changed = FALSE;
+	new_session->turn = 0;
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		new_session->interfaces[i] = NULL;
+	}
+
+	if (!(new_session->overlay = snapshot_copy(world->overlay)) || !(new_session->events = event_bus_create()) ||
+		!(new_session->undo = (Snapshot **)calloc(GAME_UNDO_DEPTH, sizeof(Snapshot *))))
+	{
+		game_destroy(new_session);
+		return ERROR;
+	}
+	for (i = 0; i < world->n_players; i++)
+	{
+		if (!(new_session->interfaces[i] = game_create_interface()))
+		{
+			game_destroy(new_session);
+			return ERROR;
+		}
+	}
+
+	*session = new_session;
+	return OK;
+}
+
+Status game_enter(Game *game)
+{
+	Game *world = NULL;
+
+	if (!game)
+	{
+		return ERROR;
+	}
+
+	/* A shadow plays whatever its session put in the entities */
+	world = game->world;
+	if (!world || !game->overlay || world->active == game)
+	{
+		return OK;
+	}
+
+	if (world->active && snapshot_save(world->active->overlay, world->active) == ERROR)
+	{
+		return ERROR;
+	}
+
+	world->active = NULL;
+	if (snapshot_restore(game->overlay, game) == ERROR)
+	{
+		return ERROR;
+	}
+
+	world->active = game;
+	return OK;
+}
+
+Game *game_get_world(Game *game)
+{
+	if (!game)
+	{
+		return NULL;
+	}
+
+	return game->world;
+}
+
+/**
+ * @brief Frees what a session owns, and puts the loaded state back in its world if it was the active session
+ *
+ * @param game A pointer to the session
+ */
+static void game_destroy_session(Game *game)
+{
+	int i;
+
+	if (game->world->active == game)
+	{
+		snapshot_restore(game->world->overlay, game->world);
+		game->world->active = NULL;
+	}
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		if (game->interfaces[i] != NULL)
+		{
+			command_destroy(game->interfaces[i]->last_cmd);
+			free(game->interfaces[i]);
+		}
+	}
+
+	event_bus_destroy(game->events);
+	for (i = 0; game->undo && i < GAME_UNDO_DEPTH; i++)
+	{
+		snapshot_destroy(game->undo[i]);
+	}
+	free(game->undo);
+	snapshot_destroy(game->overlay);
+	free(game);
+}
+
+Status game_destroy(Game *game)
+{
+	int i = 0;
+
+	if (!game)
+	{
+		return ERROR;
+	}
+
+	if (game->world)
+	{
+		game_destroy_session(game);
+		return OK;
+	}
+
+	region_cache_close(game->regions);
+	game->regions = NULL;
+
+	for (i = 0; i < game->n_spaces; i++)
+	{
+		if (game->spaces[i] != NULL)
+		{
+			space_destroy(game->spaces[i]);
+			game->spaces[i] = NULL;
+		}
+	}
+
+	/*Checks all character array and frees as needed*/
+	for (i = 0; i < game->n_characters; i++)
+	{
+		if (game->characters[i] != NULL)
+		{
+			character_destroy(game->characters[i]);
+			game->characters[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		if (game->players[i] != NULL)
+		{
+			player_destroy(game->players[i]);
+			game->players[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		if (game->interfaces[i] != NULL)
+		{
+			command_destroy(game->interfaces[i]->last_cmd);
+			free(game->interfaces[i]);
+			game->interfaces[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < game->n_objects; i++)
+	{
+		if (game->objects[i] != NULL)
+		{
+			object_destroy(game->objects[i]);
+			game->objects[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < game->n_links; i++)
+	{
+		if (game->links[i] != NULL)
+		{
+			link_destroy(game->links[i]);
+			game->links[i] = NULL;
+		}
+	}
+
+	free(game->spaces);
+	free(game->objects);
+	free(game->characters);
+	free(game->links);
+	free(game->link_index);
+	if (game->index)
+	{
+		free(game->index->spaces);
+		free(game->index->characters);
+		free(game->index);
+	}
+	event_bus_destroy(game->events);
+	for (i = 0; game->undo && i < GAME_UNDO_DEPTH; i++)
+	{
+		snapshot_destroy(game->undo[i]);
+	}
+	free(game->undo);
+	snapshot_destroy(game->overlay);
+	free(game);
+	game = NULL;
+	return OK;
+}
+
+Space *game_get_space(Game *game, Id id)
+{
+	GameIndex *index = game->index;
+	IdEntry *entry = NULL;
+	int i = 0;
+
+	if (id == NO_ID)
+	{
+		return NULL;
+	}
+
+	if (game->regions)
+	{
+		return region_get_space(game->regions, game, id);
+	}
+
+	/* Spaces added since the index was built are added to it, except by a shadow */
+	if (index->n_spaces != game->n_spaces && game->undo)
+	{
+		game_index_spaces(game, FALSE);
+	}
+
+	if (index->n_spaces == game->n_spaces && (entry = game_index_find(index->spaces, index->space_size, id)) != NULL)
+	{
+		if (entry->id == NO_ID)
+		{
+			return NULL;
+		}
+		i = (int)entry->value;
+		if (i < game->n_spaces && game->spaces[i] && space_get_id(game->spaces[i]) == id)
+		{
+			return game->spaces[i];
+		}
+		/* The spaces were moved without game_refresh, this time they are searched one by one */
+		if (game->undo)
+		{
+			game_index_spaces(game, TRUE);
+		}
+	}
+
+	for (i = 0; i < game->n_spaces; i++)
+	{
+		if (id == space_get_id(game->spaces[i]))
+		{
+			return game->spaces[i];
+		}
+	}
+
+	return NULL;
+}
+
+Id game_get_player_location(Game *game)
+{
+
+	Id location = player_get_location(game->players[game->turn]);
+
+	return location;
+}
+
+Status game_set_player_location(Game *game, Id id)
+{
+	if (id == NO_ID)
+	{
+		return ERROR;
+	}
+
+	game_hash_change(game, ZOBRIST_PLAYER_AT, player_get_id(game->players[game->turn]), player_get_location(game->players[game->turn]), id);
+	*(player_get_location_pointer(game->players[game->turn])) = id;
+
+	return OK;
+}
+
+Id game_get_object_location(Game *game, int position)
+{
+	Id location = NO_ID;
+
+	if (game == NULL || position < 0 || position >= game->n_objects || game->objects[position] == NULL)
+	{
+		return NO_ID;
+	}
+
+	location = object_get_location(game->objects[position]);
+	if (game->regions)
+	{
+		/* Painting asks for every object, which must not load their regions */
+		return region_has_space(game->regions, location) == TRUE ? location : NO_ID;
+	}
+
+	if (game_get_space(game, location) == NULL)
+	{
+		return NO_ID;
+	}
+
+	return location;
+}
+
+Status game_set_object_location(Game *game, Id id, int position)
+{
+	if (game == NULL || position < 0 || position >= game->n_objects)
+	{
+		return ERROR;
+	}
+
+	game_hash_change(game, ZOBRIST_OBJECT_AT, object_get_id(game->objects[position]), object_get_location(game->objects[position]), id);
+	*(object_get_location_pointer(game->objects[position])) = id;
+
+	space_set_object(game_get_space(game, id), TRUE);
+
+	return OK;
+}
+
+Command *game_get_last_command(Game *game)
+{
+	return game->interfaces[game->turn]->last_cmd;
+}
+
+Status game_set_last_command(Game *game, Command *command)
+{
+	game->interfaces[game->turn]->last_cmd = command;
+
+	return OK;
+}
+
+Bool game_get_finished(Game *game)
+{
+	return game->finished;
+}
+
+Status game_set_finished(Game *game, Bool finished)
+{
+	game->finished = finished;
+
+	return OK;
+}
+
+void game_print(Game *game)
+{
+	int i = 0;
+
+	printf("\n\n-------------\n\n");
+
+	printf("=> Spaces: \n");
+	for (i = 0; i < game->n_spaces; i++)
+	{
+		space_print(game->spaces[i]);
+	}
+
+	for (i = 0; i < game->n_objects; i++)
+	{
+		printf("=> Object location: %d\n", (int)object_get_id(game->objects[i]));
+	}
+}
+
+/*ADDITIONAL FUNCTIONS*/
+
+int *game_get_n_spaces(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+	return &(game->n_spaces);
+}
+
+Space **game_get_spaces(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+	return game->spaces;
+}
+
+int *game_get_n_objects(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+	return &(game->n_objects);
+}
+
+Object **game_get_objects(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+	return game->objects;
+}
+
+Character **game_get_character_array(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+	return game->characters;
+}
+
+Status game_set_last_message(Game *game, const char *message)
+{
+	if (!game || !message)
+	{
+		return ERROR;
+	}
+	strncpy(game->interfaces[game->turn]->last_message, message, MESSAGE_SIZE);
+	game->interfaces[game->turn]->last_message[MESSAGE_SIZE] = '\0';
+	return OK;
+}
+
+const char *game_get_last_message(Game *game)
+{
+	if (!game)
+	{
+		return NULL;
+	}
+	return game->interfaces[game->turn]->last_message;
+}
+
+const char *game_get_temporal_feedback(Game *game)
+{
+	if (!game)
+	{
+		return NULL;
+	}
+	return game->temporal_feedback;
+}
+
+Status game_set_temporal_feedback(Game *game, const char *feedback)
+{
+	if (!game || !feedback)
+	{
+		return ERROR;
+	}
+	strncpy(game->temporal_feedback, feedback, MESSAGE_SIZE - 1);
+	game->temporal_feedback[MESSAGE_SIZE - 1] = '\0';
+	game->feedback_changed = TRUE;
+	return OK;
+}
+
+Object *game_get_object_by_id(Game *game, Id id)
+{
+	int i;
+
+	if (!game || id == NO_ID)
+	{
+		return NULL;
+	}
+
+	for (i = 0; i < *(game_get_n_objects(game)); i++)
+	{
+		if (object_get_id(game->objects[i]) == id)
+		{
+			return game->objects[i];
+		}
+	}
+
+	return NULL;
+}
+
+Link **game_get_links(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+
+	return game->links;
+}
+
+int *game_get_n_links(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+
+	return &game->n_links;
+}
+
+/**
+ * @brief Finds the link that leaves a space in a direction
+ *
+ * @param game A pointer to the game
+ * @param id_orig The id of the origin space
+ * @param dir The direction
+ * @return The first such link, NULL if there is none
+ */
+static Link *game_find_link(Game *game, Id id_orig, Direction dir)
+{
+	int i, low = 0, high;
+
+	if (game->regions)
+	{
+		return region_get_link(game->regions, game, id_orig, dir);
+	}
+
+	/* Links added after the world was loaded are not in the index */
+	if (game->link_index && game->n_link_index == game->n_links)
+	{
+		high = game->n_link_index;
+		while (low < high)
+		{
+			i = low + (high - low) / 2;
+			if (game->link_index[i].origin < id_orig)
+			{
+				low = i + 1;
+			}
+			else
+			{
+				high = i;
+			}
+		}
+		for (i = low; i < game->n_link_index && game->link_index[i].origin == id_orig; i++)
+		{
+			if (game->link_index[i].direction == (int)dir)
+			{
+				return game->links[game->link_index[i].position];
+			}
+		}
+		return NULL;
+	}
+
+	for (i = 0; i < game->n_links; i++)
+	{
+		if (link_get_origin(game->links[i]) == id_orig && link_get_direction(game->links[i]) == dir)
+		{
+			return game->links[i];
+		}
+	}
+
+	return NULL;
+}
+
+Id game_get_connection(Game *game, Id id_orig, Direction dir)
+{
+	Link *link = NULL;
+
+	if (game == NULL || id_orig == NO_ID || dir == NONE)
+	{
+		return NO_ID;
+	}
+
+	if (!(link = game_find_link(game, id_orig, dir)))
+	{
+		return NO_ID;
+	}
+
+	return link_get_destination(link);
+}
+
+Bool game_connection_is_open(Game *game, Id id_orig, Direction dir)
+{
+	Link *link = NULL;
+
+	if (game == NULL || id_orig == NO_ID || dir == NONE)
+	{
+		return FALSE;
+	}
+
+	if (!(link = game_find_link(game, id_orig, dir)))
+	{
+		return FALSE;
+	}
+
+	return link_get_open(link);
+}
+
+int *game_get_n_characters(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+
+	return &game->n_characters;
+}
+
+const int game_get_turn(Game *game)
+{
+	if (game == NULL)
+	{
+		return -1;
+	}
+
+	return game->turn;
+}
+
+Status game_set_turn(Game *game, int turn_n)
+{
+	if (game == NULL || turn_n < 0)
+	{
+		return ERROR;
+	}
+
+	game->turn = turn_n;
+	return OK;
+}
+
+Player **game_get_players(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+
+	return game->players;
+}
+
+const int game_get_n_players(Game *game)
+{
+	if (game == NULL)
+	{
+		return -1;
+	}
+
+	return game->n_players;
+}
+
+Status game_set_n_players(Game *game, int n_players)
+{
+	if (game == NULL || n_players < 0)
+	{
+		return ERROR;
+	}
+
+	game->n_players = n_players;
+	return OK;
+}
+
+InterfaceData **game_get_interfaces(Game *game)
+{
+	if (game == NULL)
+	{
+		return NULL;
+	}
+
+	return game->interfaces;
+}
+
+Player *game_get_player_at(Game *game, int position)
+{
+	if (game == NULL || position < 0)
+	{
+		return NULL;
+	}
+
+	return game->players[position];
+}
+
+Id game_find_character(Game *game, Id id)
+{
+	int i, j, n;
+	Set *current_chars = NULL;
+	Space **spaces_p = NULL;
+	IdEntry *entry = NULL;
+
+	if (!game || id == NO_ID)
+	{
+		return NO_ID;
+	}
+
+	/* The space where it was last found is checked first, a paged world must not load it */
+	if (!game->regions && (entry = game_index_find(game->index->characters, game->index->character_size, id)) && entry->id == id &&
+		space_has_character(game_get_space(game, entry->value), id) == TRUE)
+	{
+		return entry->value;
+	}
+
+	spaces_p = game_get_spaces(game);
+
+	for (i = 0; i < game->n_spaces; i++)
+	{
+		current_chars = space_get_characters(spaces_p[i]);
+		n = set_get_count(current_chars);
+
+		for (j = 0; j < n; j++)
+		{
+			if (id == set_get_id_at(current_chars, j))
+			{
+				game_index_character(game, id, space_get_id(spaces_p[i]));
+				return space_get_id(spaces_p[i]);
+			}
+		}
+	}
+
+	return NO_ID;
+}
+
+Status game_change_character_location(Game *game, Character *char_p, Id new_location)
+{
+	Id old_location;
+
+	if (!game || !char_p || new_location < 0 || new_location == NO_ID)
+	{
+		return ERROR;
+	}
+
+	old_location = game_find_character(game, character_get_id(char_p));
+	space_del_character(game_get_space(game, old_location), char_p);
+
+	if (space_add_character(game_get_space(game, new_location), char_p) == ERROR)
+	{
+		game_hash_change(game, ZOBRIST_CHARACTER_AT, character_get_id(char_p), old_location, NO_ID);
+		return ERROR;
+	}
+	game_hash_change(game, ZOBRIST_CHARACTER_AT, character_get_id(char_p), old_location, new_location);
+	game_index_character(game, character_get_id(char_p), new_location);
+
+	return game_publish_event(game, EVENT_CHARACTER_MOVED, character_get_id(char_p), old_location, new_location, 0);
+}
+
+EventBus *game_get_events(Game *game)
+{
+	if (!game)
+	{
+		return NULL;
+	}
+
+	return game->events;
+}
+
+Status game_publish_event(Game *game, EventType type, Id subject, Id from, Id to, int value)
+{
+	Event event;
+
+	if (!game)
+	{
+		return ERROR;
+	}
+
+	/* Most events have no subscriber, they are dropped before filling the struct */
+	if (event_bus_wants(game->events, type) == FALSE)
+	{
+		return OK;
+	}
+
+	event.type = type;
+	event.turn = game->turn;
+	event.subject = subject;
+	event.from = from;
+	event.to = to;
+	event.value = value;
+	return event_bus_publish(game->events, &event);
+}
+
+Status game_set_link_open(Game *game, Id id_orig, Direction dir, Bool open)
+{
+	Link *link = NULL;
+	Bool was_open;
+
+	if (!game || id_orig == NO_ID || dir == NONE || !(link = game_find_link(game, id_orig, dir)))
+	{
+		return ERROR;
+	}
+
+	was_open = link_get_open(link);
+	if (link_set_open(link, open) == ERROR)
+	{
+		return ERROR;
+	}
+	game_hash_change(game, ZOBRIST_LINK_OPEN, link_get_id(link), was_open, open);
+
+	return game_publish_event(game, open == TRUE ? EVENT_LINK_OPENED : EVENT_LINK_CLOSED, link_get_id(link), id_orig, link_get_destination(link), (int)dir);
+}
+
+Status game_set_space_discovered(Game *game, Id id, Bool discovered)
+{
+	Space *space = NULL;
+	Bool was_discovered;
+
+	if (!game || !(space = game_get_space(game, id)))
+	{
+		return ERROR;
+	}
+
+	was_discovered = space_is_discovered(space);
+	if (space_set_discovered(space, discovered) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return game_hash_change(game, ZOBRIST_DISCOVERED, id, was_discovered, discovered);
+}
+
+Status game_set_player_health(Game *game, int position, int health)
+{
+	Player *player = NULL;
+	int old_health;
+
+	if (!game || position < 0 || position >= game->n_players || !(player = game->players[position]))
+	{
+		return ERROR;
+	}
+
+	old_health = player_get_health(player);
+	if (player_set_health(player, health) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return game_hash_change(game, ZOBRIST_PLAYER_HEALTH, player_get_id(player), old_health, player_get_health(player));
+}
+
+Status game_add_player_object(Game *game, int position, Id id)
+{
+	Player *player = NULL;
+
+	if (!game || position < 0 || position >= game->n_players || !(player = game->players[position]) || player_add_object(player, id) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return game_hash_change(game, ZOBRIST_CARRIED_BY, id, NO_ID, player_get_id(player));
+}
 
-int *game_get_n_spaces(Game *game)
+Status game_del_player_object(Game *game, int position, Id id)
 {
-	if (game == NULL)
+	Player *player = NULL;
+
+	if (!game || position < 0 || position >= game->n_players || !(player = game->players[position]) || player_del_object(player, id) == ERROR)
 	{
-		return NULL;
+		return ERROR;
 	}
-	return &(game->n_spaces);
+
+	return game_hash_change(game, ZOBRIST_CARRIED_BY, id, player_get_id(player), NO_ID);
 }
 
-Space **game_get_spaces(Game *game)
+Status game_set_character_health(Game *game, Character *character, int health)
 {
-	if (game == NULL)
+	int old_health;
+
+	if (!game || !character)
 	{
-		return NULL;
+		return ERROR;
 	}
-	return game->spaces;
+
+	old_health = character_get_health(character);
+	if (character_set_health(character, health) == ERROR)
+	{
+		return ERROR;
+	}
+
+	return game_hash_change(game, ZOBRIST_CHARACTER_HEALTH, character_get_id(character), old_health, character_get_health(character));
 }
 
-int *game_get_n_objects(Game *game)
+/**
+ * @brief Finds a player by its id
+ *
+ * @return The player, NULL if no player has that id
+ */
+static Player *game_find_player(Game *game, Id id)
 {
-	if (game == NULL)
+	int i;
+
+	for (i = 0; id != NO_ID && i < game->n_players; i++)
 	{
-		return NULL;
+		if (player_get_id(game->players[i]) == id)
+		{
+			return game->players[i];
+		}
 	}
-	return &(game->n_objects);
+
+	return NULL;
 }
 
-Object **game_get_objects(Game *game)
+Status game_set_character_following(Game *game, Character *character, Id following)
 {
-	if (game == NULL)
+	Id old_following, new_following;
+	Status status;
+
+	if (!game || !character)
 	{
-		return NULL;
+		return ERROR;
 	}
-	return game->objects;
+
+	/* An unfriendly character is left following no one */
+	old_following = character_get_following(character);
+	status = character_set_following(character, following);
+	new_following = character_get_following(character);
+	if (new_following == old_following)
+	{
+		return status;
+	}
+
+	player_del_follower(game_find_player(game, old_following), character);
+	player_add_follower(game_find_player(game, new_following), character);
+	game_hash_change(game, ZOBRIST_FOLLOWS, character_get_id(character), old_following, new_following);
+	return status;
 }
 
-Character **game_get_character_array(Game *game)
+Status game_set_character_friendly(Game *game, Character *character, Bool friendly)
 {
-	if (game == NULL)
+	Status status;
+
+	if (!game || !character)
 	{
-		return NULL;
+		return ERROR;
 	}
-	return game->characters;
+
+	/* A character turned hostile stops following */
+	if ((status = character_set_friendly(character, friendly)) == OK && friendly == FALSE)
+	{
+		game_set_character_following(game, character, NO_ID);
+	}
+	space_update_occupant(game_get_space(game, game_find_character(game, character_get_id(character))), character);
+	return status;
 }
 
-Status game_set_last_message(Game *game, const char *message)
+Status game_move_party(Game *game, Player *player, Id from, Id to)
 {
-	if (!game || !message)
+	Space *from_space = NULL, *to_space = NULL;
+	Character *follower = NULL;
+	Id id;
+	Status status = OK;
+
+	if (!game || !player || !(from_space = game_get_space(game, from)) || !(to_space = game_get_space(game, to)))
 	{
 		return ERROR;
 	}
-	strncpy(game->interfaces[game->turn]->last_message, message, MESSAGE_SIZE);
-	game->interfaces[game->turn]->last_message[MESSAGE_SIZE] = '\0';
-	return OK;
+
+	for (follower = player_get_followers(player); follower; follower = character_get_next_follower(follower))
+	{
+		/* Followers left in another space stay there */
+		id = character_get_id(follower);
+		if (space_has_character(from_space, id) == FALSE)
+		{
+			continue;
+		}
+
+		space_del_character(from_space, follower);
+		if (space_add_character(to_space, follower) == ERROR)
+		{
+			game_hash_change(game, ZOBRIST_CHARACTER_AT, id, from, NO_ID);
+			status = ERROR;
+			continue;
+		}
+		game_hash_change(game, ZOBRIST_CHARACTER_AT, id, from, to);
+		game_publish_event(game, EVENT_CHARACTER_MOVED, id, from, to, 0);
+	}
+
+	return status;
 }
 
-const char *game_get_last_message(Game *game)
+Status game_hash_change(Game *game, ZobristKind kind, Id subject, Id old_value, Id new_value)
 {
 	if (!game)
 	{
-		return NULL;
+		return ERROR;
 	}
-	return game->interfaces[game->turn]->last_message;
+
+	if (!game->regions)
+	{
+		game->hash ^= zobrist_change(kind, subject, old_value, new_value);
+	}
+
+	return OK;
 }
 
-const char *game_get_temporal_feedback(Game *game)
+unsigned long game_get_hash(Game *game)
 {
 	if (!game)
 	{
-		return NULL;
+		return 0;
 	}
-	return game->temporal_feedback;
+
+	return game->hash;
 }
 
-Status game_set_temporal_feedback(Game *game, const char *feedback)
+Status game_set_hash(Game *game, unsigned long hash)
 {
-	if (!game || !feedback)
+	if (!game)
 	{
 		return ERROR;
 	}
-	strncpy(game->temporal_feedback, feedback, MESSAGE_SIZE - 1);
-	game->temporal_feedback[MESSAGE_SIZE - 1] = '\0';
+
+	game->hash = hash;
 	return OK;
 }
 
-Object *game_get_object_by_id(Game *game, Id id)
+unsigned long game_compute_hash(Game *game)
 {
-	int i;
+	unsigned long hash = 0;
+	Set *set = NULL;
+	Id id;
+	int i, j, n;
 
-	if (!game || id == NO_ID)
+	if (!game || game->regions)
 	{
-		return NULL;
+		return 0;
 	}
 
-	for (i = 0; i < *(game_get_n_objects(game)); i++)
+	/* Objects are carried by nobody and characters are nowhere until a set says otherwise */
+	for (i = 0; i < game->n_objects; i++)
 	{
-		if (object_get_id(game->objects[i]) == id)
-		{
-			return game->objects[i];
-		}
+		id = object_get_id(game->objects[i]);
+		hash ^= zobrist_key(ZOBRIST_OBJECT_AT, id, object_get_location(game->objects[i])) ^ zobrist_key(ZOBRIST_CARRIED_BY, id, NO_ID);
 	}
 
-	return NULL;
-}
+	for (i = 0; i < game->n_characters; i++)
+	{
+		id = character_get_id(game->characters[i]);
+		hash ^= zobrist_key(ZOBRIST_CHARACTER_AT, id, NO_ID) ^ zobrist_key(ZOBRIST_CHARACTER_HEALTH, id, character_get_health(game->characters[i])) ^
+				zobrist_key(ZOBRIST_FOLLOWS, id, character_get_following(game->characters[i]));
+	}
 
-Link **game_get_links(Game *game)
-{
-	if (game == NULL)
+	for (i = 0; i < game->n_players; i++)
 	{
-		return NULL;
+		id = player_get_id(game->players[i]);
+		hash ^= zobrist_key(ZOBRIST_PLAYER_AT, id, player_get_location(game->players[i])) ^
+				zobrist_key(ZOBRIST_PLAYER_HEALTH, id, player_get_health(game->players[i]));
+		set = inventory_get_objects(player_get_inventory(game->players[i]));
+		n = set_get_count(set);
+		for (j = 0; j < n; j++)
+		{
+			hash ^= zobrist_change(ZOBRIST_CARRIED_BY, set_get_id_at(set, j), NO_ID, id);
+		}
 	}
 
-	return game->links;
-}
+	for (i = 0; i < game->n_spaces; i++)
+	{
+		id = space_get_id(game->spaces[i]);
+		hash ^= zobrist_key(ZOBRIST_DISCOVERED, id, space_is_discovered(game->spaces[i]));
+		set = space_get_characters(game->spaces[i]);
+		n = set_get_count(set);
+		for (j = 0; j < n; j++)
+		{
+			hash ^= zobrist_change(ZOBRIST_CHARACTER_AT, set_get_id_at(set, j), NO_ID, id);
+		}
+	}
 
-int *game_get_n_links(Game *game)
-{
-	if (game == NULL)
+	for (i = 0; i < game->n_links; i++)
 	{
-		return NULL;
+		hash ^= zobrist_key(ZOBRIST_LINK_OPEN, link_get_id(game->links[i]), link_get_open(game->links[i]));
 	}
 
-	return &game->n_links;
+	return hash;
 }
 
-Id game_get_connection(Game *game, Id id_orig, Direction dir)
+Status game_save_undo(Game *game)
 {
-	int i;
+	Snapshot **slot = NULL;
 
-	if (game == NULL || id_orig == NO_ID || dir == NONE)
+	if (!game || !game->undo || game->regions)
 	{
-		return NO_ID;
+		return ERROR;
 	}
 
-	for (i = 0; i < game->n_links; i++)
+	/* When the ring is full the oldest state is overwritten, reusing its memory */
+	slot = &game->undo[game->undo_top];
+	if (!*slot)
 	{
-		if (link_get_origin(game->links[i]) == id_orig && link_get_direction(game->links[i]) == dir)
+		if (!(*slot = snapshot_create(game)))
+		{
+			return ERROR;
+		}
+	}
+	else if (snapshot_save(*slot, game) == ERROR)
+	{
+		/* The oldest state was half overwritten */
+		if (game->n_undo == GAME_UNDO_DEPTH)
 		{
-			return link_get_destination(game->links[i]);
+			game->n_undo--;
 		}
+		return ERROR;
 	}
 
-	return NO_ID;
+	game->undo_top = (game->undo_top + 1) % GAME_UNDO_DEPTH;
+	if (game->n_undo < GAME_UNDO_DEPTH)
+	{
+		game->n_undo++;
+	}
+
+	return OK;
 }
 
-Bool game_connection_is_open(Game *game, Id id_orig, Direction dir)
+Status game_push_undo(Game *game, Snapshot *snapshot)
 {
-	int i;
+	if (!game || !game->undo || !snapshot)
+	{
+		snapshot_destroy(snapshot);
+		return ERROR;
+	}
 
-	if (game == NULL || id_orig == NO_ID || dir == NONE)
+	snapshot_destroy(game->undo[game->undo_top]);
+	game->undo[game->undo_top] = snapshot;
+	game->undo_top = (game->undo_top + 1) % GAME_UNDO_DEPTH;
+	if (game->n_undo < GAME_UNDO_DEPTH)
 	{
-		return FALSE;
+		game->n_undo++;
 	}
 
-	for (i = 0; i < game->n_links; i++)
+	return OK;
+}
+
+Status game_drop_undo(Game *game)
+{
+	if (!game || game->n_undo == 0)
 	{
-		if (link_get_origin(game->links[i]) == id_orig && link_get_direction(game->links[i]) == dir)
-		{
-			return link_get_open(game->links[i]);
-		}
+		return ERROR;
 	}
 
-	return FALSE;
+	game->undo_top = (game->undo_top + GAME_UNDO_DEPTH - 1) % GAME_UNDO_DEPTH;
+	game->n_undo--;
+	return OK;
 }
 
-int *game_get_n_characters(Game *game)
+Status game_undo(Game *game)
 {
-	if (game == NULL)
+	if (game_drop_undo(game) == ERROR)
 	{
-		return NULL;
+		return ERROR;
 	}
 
-	return &game->n_characters;
+	return snapshot_restore(game->undo[game->undo_top], game);
 }
 
-const int game_get_turn(Game *game)
+int game_get_n_undo(Game *game)
 {
-	if (game == NULL)
+	if (!game)
 	{
 		return -1;
 	}
 
-	return game->turn;
+	return game->n_undo;
 }
 
-Status game_set_turn(Game *game, int turn_n)
+Status game_write_undo(Game *game, FILE *f)
 {
-	if (game == NULL || turn_n < 0)
+	int i;
+
+	if (!game || !game->undo || !f || fwrite(&game->n_undo, sizeof(int), 1, f) != 1)
 	{
 		return ERROR;
 	}
 
-	game->turn = turn_n;
+	/* Oldest first, so reading them back in order rebuilds the ring */
+	for (i = game->n_undo; i > 0; i--)
+	{
+		if (snapshot_write(game->undo[(game->undo_top + GAME_UNDO_DEPTH - i) % GAME_UNDO_DEPTH], f, 0) == ERROR)
+		{
+			return ERROR;
+		}
+	}
+
 	return OK;
 }
 
-Player **game_get_players(Game *game)
+Status game_read_undo(Game *game, FILE *f)
 {
-	if (game == NULL)
+	Snapshot *states[GAME_UNDO_DEPTH];
+	int n = 0, i, n_read;
+
+	if (!game || !game->undo || !f || fread(&n, sizeof(int), 1, f) != 1 || n < 0 || n > GAME_UNDO_DEPTH)
 	{
-		return NULL;
+		return ERROR;
 	}
 
-	return game->players;
-}
-
-const int game_get_n_players(Game *game)
-{
-	if (game == NULL)
+	/* Every state is read before the ring is touched, so a bad file leaves it as it was */
+	for (n_read = 0; n_read < n && (states[n_read] = snapshot_read(f, game, NULL)) != NULL; n_read++)
+		;
+	if (n_read < n)
 	{
-		return -1;
+		for (i = 0; i < n_read; i++)
+		{
+			snapshot_destroy(states[i]);
+		}
+		return ERROR;
 	}
 
-	return game->n_players;
+	for (i = 0; i < GAME_UNDO_DEPTH; i++)
+	{
+		snapshot_destroy(game->undo[i]);
+		game->undo[i] = i < n ? states[i] : NULL;
+	}
+	game->undo_top = n % GAME_UNDO_DEPTH;
+	game->n_undo = n;
+	return OK;
 }
 
-Status game_set_n_players(Game *game, int n_players)
+Status game_reserve_spaces(Game *game, int n)
 {
-	if (game == NULL || n_players < 0)
+	Space **spaces = NULL;
+
+	if (game == NULL || n < 0 || !(spaces = (Space **)game_grow_array(game->spaces, &game->max_spaces, n)))
 	{
 		return ERROR;
 	}
 
-	game->n_players = n_players;
+	game->spaces = spaces;
 	return OK;
 }
 
-InterfaceData **game_get_interfaces(Game *game)
+Status game_reserve_objects(Game *game, int n)
 {
-	if (game == NULL)
+	Object **objects = NULL;
+
+	if (game == NULL || n < 0 || !(objects = (Object **)game_grow_array(game->objects, &game->max_objects, n)))
 	{
-		return NULL;
+		return ERROR;
 	}
 
-	return game->interfaces;
+	game->objects = objects;
+	return OK;
 }
 
-Player *game_get_player_at(Game *game, int position)
+Status game_reserve_characters(Game *game, int n)
 {
-	if (game == NULL || position < 0)
+	Character **characters = NULL;
+
+	if (game == NULL || n < 0 || !(characters = (Character **)game_grow_array(game->characters, &game->max_characters, n)))
 	{
-		return NULL;
+		return ERROR;
 	}
 
-	return game->players[position];
+	game->characters = characters;
+	return OK;
 }
 
-Id game_find_character(Game *game, Id id)
+Status game_reserve_links(Game *game, int n)
 {
-	int i, j, n;
-	Set *current_chars = NULL;
-	Space **spaces_p = NULL;
+	Link **links = NULL;
 
-	if (!game || id == NO_ID)
+	if (game == NULL || n < 0 || !(links = (Link **)game_grow_array(game->links, &game->max_links, n)))
 	{
-		return NO_ID;
+		return ERROR;
 	}
 
-	spaces_p = game_get_spaces(game);
+	game->links = links;
+	return OK;
+}
 
-	for (i = 0; i < game->n_spaces; i++)
+Status game_refresh(Game *game)
+{
+	if (!game || game->regions || game->world)
 	{
-		current_chars = space_get_characters(spaces_p[i]);
-		n = set_get_count(current_chars);
-
-		for (j = 0; j < n; j++)
-		{
-			if (id == set_get_id_at(current_chars, j))
-			{
-				return space_get_id(spaces_p[i]);
-			}
-		}
+		return ERROR;
 	}
 
-	return NO_ID;
+	game_index_links(game);
+	game_index_spaces(game, TRUE);
+	game->hash = game_compute_hash(game);
+	game->undo_top = 0;
+	game->n_undo = 0;
+	return OK;
 }
 
-Status game_change_character_location(Game *game, Character *char_p, Id new_location)
+Status game_set_link_index(Game *game, const int *order, int n)
 {
-	Id old_location;
+	int i;
 
-	if (!game || !char_p || new_location < 0 || new_location == NO_ID)
+	if (!game || !order || game->regions || n != game->n_links)
 	{
 		return ERROR;
 	}
 
-	old_location = game_find_character(game, character_get_id(char_p));
-	space_del_character(game_get_space(game, old_location), char_p);
+	free(game->link_index);
+	game->n_link_index = 0;
+	if (!(game->link_index = (LinkEntry *)malloc((n + 1) * sizeof(LinkEntry))))
+	{
+		return ERROR;
+	}
 
-	space_add_character(game_get_space(game, new_location), char_p);
+	/* Strictly sorted entries of valid positions are every link once */
+	for (i = 0; i < n; i++)
+	{
+		if (order[i] < 0 || order[i] >= n)
+		{
+			break;
+		}
+		game->link_index[i].origin = link_get_origin(game->links[order[i]]);
+		game->link_index[i].direction = (int)link_get_direction(game->links[order[i]]);
+		game->link_index[i].position = order[i];
+		if (i > 0 && game_compare_links(&game->link_index[i - 1], &game->link_index[i]) >= 0)
+		{
+			break;
+		}
+	}
+	if (i < n)
+	{
+		game_index_links(game);
+		return ERROR;
+	}
 
+	game->n_link_index = n;
 	return OK;
-}
\ No newline at end of file
+}
@@ -9,11 +9,18 @@
  */
 
 #include "game_actions.h"
+#include "combat.h"
+#include "stats.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief Enemies resolved at once by an attack, so the table of combatants fits in the stack
+ */
+#define ATTACK_BATCH 64
+
 /**
    Private functions
 */
@@ -97,6 +104,26 @@ Status game_actions_recruit(Game *game);
  * @param game A pointer to the game structure.
  */
 Status game_actions_abandon(Game *game);
+
+/**
+ * @brief Handles the "stats" command.
+ *
+ * @param game A pointer to the game structure.
+ */
+Status game_actions_stats(Game *game);
+
+/**
+ * @brief Handles the "undo" command.
+ *
+ * @param game A pointer to the game structure.
+ */
+Status game_actions_undo(Game *game);
+
+Bool game_actions_changes_state(CommandCode cmd)
+{
+	return (cmd == TAKE || cmd == DROP || cmd == ATTACK || cmd == MOVE || cmd == RECRUIT || cmd == ABANDON) ? TRUE : FALSE;
+}
+
 /**
    Game actions implementation
 */
@@ -104,12 +131,24 @@ Status game_actions_abandon(Game *game);
 Status game_actions_update(Game *game, Command *command)
 {
 	CommandCode cmd;
-	Status status = OK;
+	Status status = OK, saved = ERROR;
+	unsigned long stats_t = 0;
 
+	STATS_START(stats_t);
+	if (game_enter(game) == ERROR)
+	{
+		return ERROR;
+	}
 	game_set_last_command(game, command);
 
 	cmd = command_get_code(command);
 
+	/* The state before a command that can change it is saved, so the command can be undone */
+	if (game_actions_changes_state(cmd) == TRUE)
+	{
+		saved = game_save_undo(game);
+	}
+
 	switch (cmd)
 	{
 	case UNKNOWN:
@@ -154,12 +193,27 @@ Status game_actions_update(Game *game, Command *command)
 		status = game_actions_abandon(game);
 		break;
 
+	case STATS:
+		status = game_actions_stats(game);
+		break;
+
+	case UNDO:
+		status = game_actions_undo(game);
+		break;
+
 	default:
 		status = ERROR;
 		break;
 	}
 
+	/* A command that failed changed nothing, undoing it would do nothing */
+	if (saved == OK && status == ERROR)
+	{
+		game_drop_undo(game);
+	}
+
 	command_set_status(command, status);
+	STATS_STOP(stats_slot_for_command(cmd), stats_t);
 	return status;
 }
 
@@ -197,9 +251,11 @@ Status game_actions_take(Game *game)
 		if (object_id == player_location_id &&
 			strcasecmp(object_get_name(game_get_objects(game)[i]), obj_name) == 0)
 		{
-			if (player_add_object(game_get_player_at(game, game_get_turn(game)), object_get_id(game_get_objects(game)[i])) == OK)
+			if (game_add_player_object(game, game_get_turn(game), object_get_id(game_get_objects(game)[i])) == OK)
 			{
 				game_set_object_location(game, NO_ID, i);
+				game_publish_event(game, EVENT_OBJECT_TAKEN, object_get_id(game_get_objects(game)[i]), player_location_id,
+								   player_get_id(game_get_player_at(game, game_get_turn(game))), 0);
 				return OK;
 			}
 			else
@@ -248,10 +304,12 @@ Status game_actions_drop(Game *game)
 		if (strcasecmp(object_get_name(object), obj_name) == 0 &&
 			player_has_object(game_get_player_at(game, game_get_turn(game)), object_get_id(object)) == TRUE)
 		{
-			if (player_del_object(game_get_player_at(game, game_get_turn(game)), object_get_id(object)) == OK)
+			if (game_del_player_object(game, game_get_turn(game), object_get_id(object)) == OK)
 			{
 				if (game_set_object_location(game, player_location_id, i) == OK)
 				{
+					game_publish_event(game, EVENT_OBJECT_DROPPED, object_get_id(object), player_get_id(game_get_player_at(game, game_get_turn(game))),
+									   player_location_id, 0);
 					return OK;
 				}
 				else
@@ -272,91 +330,95 @@ Status game_actions_drop(Game *game)
 Status game_actions_attack(Game *game)
 {
 	Id player_location_id = NO_ID;
-	Id character_location_id = NO_ID;
+	Space *player_space = NULL;
 	Player *player = NULL;
-	Character **character_array = NULL;
-	int i, random;
+	Character *enemy = NULL;
+	Combatant fighter, enemies[ATTACK_BATCH];
+	CombatBlow blows[ATTACK_BATCH];
+	unsigned long rng;
+	int i, j, n, n_enemies;
 	char temp[WORD_SIZE];
-	Bool enemy_found = FALSE;
 
 	player = game_get_player_at(game, game_get_turn(game));
-	if (!(character_array = game_get_character_array(game)))
+	player_location_id = game_get_player_location(game);
+	if (player_location_id == NO_ID || !(player_space = game_get_space(game, player_location_id)))
 	{
 		return ERROR;
 	}
 
-	player_location_id = game_get_player_location(game);
-	if (player_location_id == NO_ID)
+	/* Only the hostile characters of the space fight */
+	if ((n_enemies = space_get_n_occupants(player_space, FALSE)) <= 0)
+	{
+		return ERROR;
+	}
+
+	/* A dead player cannot fight */
+	if (player_get_health(player) <= 0)
 	{
+		game_set_temporal_feedback(game, "Player is dead");
 		return ERROR;
 	}
 
-	for (i = 0; i < MAX_CHARACTERS; i++)
+	/* A single rand() seeds the whole round, so the attacks still follow the order of rand() */
+	rng = (unsigned long)rand() + 1;
+	fighter.health = player_get_health(player);
+	fighter.damage = COMBAT_DAMAGE;
+	for (i = 0; i < n_enemies; i += n)
 	{
-		character_location_id = game_find_character(game, character_get_id(character_array[i]));
-		if (character_location_id == player_location_id)
+		n = n_enemies - i < ATTACK_BATCH ? n_enemies - i : ATTACK_BATCH;
+		for (j = 0; j < n; j++)
 		{
-			if (character_get_friendly(character_array[i]) == FALSE)
-			{
-				enemy_found = TRUE;
-				random = rand() % 2;
+			enemies[j].health = character_get_health(space_get_occupant_at(player_space, FALSE, i + j));
+			enemies[j].damage = COMBAT_DAMAGE;
+		}
+		combat_round(&fighter, enemies, n, &rng, blows);
 
-				if (random == 0)
+		/* The messages are written once the blows are resolved */
+		for (j = 0; j < n; j++)
+		{
+			enemy = space_get_occupant_at(player_space, FALSE, i + j);
+			if (blows[j].hit == COMBAT_ENEMY_HIT)
+			{
+				game_set_character_health(game, enemy, blows[j].health);
+				game_publish_event(game, EVENT_HEALTH_CHANGED, character_get_id(enemy), player_location_id, NO_ID, blows[j].health);
+				if (blows[j].health > 0)
 				{
-					character_set_health(character_array[i], character_get_health(character_array[i]) - 10);
-					strcpy(temp, character_get_name(character_array[i]));
-					if (character_get_health(character_array[i]) > 0)
-					{
-						strcat(temp, " - 10");
-						game_set_temporal_feedback(game, temp);
-					}
-					else
-					{
-						strcat(temp, " is dead");
-						game_set_temporal_feedback(game, temp);
-					}
+					sprintf(temp, "%s - %d", character_get_name(enemy), fighter.damage);
 				}
 				else
 				{
-					if (character_get_health(character_array[i]) > 0)
-					{
-						player_set_health(player, player_get_health(player) - 10);
-						game_set_temporal_feedback(game, "Player - 10");
-					}
-					else
-					{
-						strcpy(temp, character_get_name(character_array[i]));
-						strcat(temp, " is dead");
-						game_set_temporal_feedback(game, temp);
-					}
+					sprintf(temp, "%s is dead", character_get_name(enemy));
 				}
+				game_set_temporal_feedback(game, temp);
+			}
+			else if (blows[j].hit == COMBAT_PLAYER_HIT)
+			{
+				game_set_player_health(game, game_get_turn(game), blows[j].health);
+				game_publish_event(game, EVENT_HEALTH_CHANGED, player_get_id(player), player_location_id, NO_ID, blows[j].health);
+				sprintf(temp, "Player - %d", enemies[j].damage);
+				game_set_temporal_feedback(game, temp);
+			}
+			else if (enemies[j].health <= 0)
+			{
+				sprintf(temp, "%s is dead", character_get_name(enemy));
+				game_set_temporal_feedback(game, temp);
 			}
 		}
 	}
 
-	if (!enemy_found)
-	{
-		return ERROR;
-	}
-
 	return OK;
 }
 
 Status game_actions_chat(Game *game)
 {
 	Id player_location_id = NO_ID;
-	Id character_location_id = NO_ID;
-	Character **character_array = NULL;
+	Space *player_space = NULL;
+	Character *ally = NULL;
 	int i;
 	const char *message = NULL;
 	const char *character_name = NULL;
 	Command *cmd = NULL;
 
-	if (!(character_array = game_get_character_array(game)))
-	{
-		return ERROR;
-	}
-
 	cmd = game_get_last_command(game);
 	if (!cmd)
 	{
@@ -370,24 +432,22 @@ Status game_actions_chat(Game *game)
 	}
 
 	player_location_id = game_get_player_location(game);
-	if (player_location_id == NO_ID)
+	if (player_location_id == NO_ID || !(player_space = game_get_space(game, player_location_id)))
 	{
 		return ERROR;
 	}
 
-	for (i = 0; i < MAX_CHARACTERS; i++)
+	/* Only the friendly characters of the space talk */
+	for (i = 0; i < space_get_n_occupants(player_space, TRUE); i++)
 	{
-		character_location_id = game_find_character(game, character_get_id(character_array[i]));
-		if (character_location_id == player_location_id && strcasecmp(character_get_name(character_array[i]), character_name) == 0)
+		ally = space_get_occupant_at(player_space, TRUE, i);
+		if (strcasecmp(character_get_name(ally), character_name) == 0)
 		{
-			if (character_get_friendly(character_array[i]) == TRUE)
+			message = character_get_message(ally);
+			if (message)
 			{
-				message = character_get_message(character_array[i]);
-				if (message)
-				{
-					game_set_last_message(game, message);
-					return OK;
-				}
+				game_set_last_message(game, message);
+				return OK;
 			}
 		}
 	}
@@ -402,10 +462,8 @@ Status game_actions_move(Game *game)
 	Direction dir;
 	Id id_act, id_new;
 	Id player_id = NO_ID;
-	Id character_location_id = NO_ID;
-	Character **character_array = NULL;
+	Player *player = NULL;
 	Bool is_open = FALSE;
-	int i;
 
 	if (game == NULL)
 	{
@@ -430,17 +488,13 @@ Status game_actions_move(Game *game)
 		return ERROR;
 	}
 
-	player_id = player_get_id(game_get_player_at(game, game_get_turn(game)));
+	player = game_get_player_at(game, game_get_turn(game));
+	player_id = player_get_id(player);
 	if (player_id == NO_ID)
 	{
 		return ERROR;
 	}
 
-	if (!(character_array = game_get_character_array(game)))
-	{
-		return ERROR;
-	}
-
 	if (strcasecmp(arg, "N") == 0 || strcasecmp(arg, "NORTH") == 0)
 	{
 		dir = N;
@@ -468,7 +522,8 @@ Status game_actions_move(Game *game)
 	if (id_new != NO_ID && is_open == TRUE)
 	{
 		game_set_player_location(game, id_new);
-		space_set_discovered(game_get_space(game, id_new), TRUE);
+		game_publish_event(game, EVENT_PLAYER_MOVED, player_id, id_act, id_new, 0);
+		game_set_space_discovered(game, id_new, TRUE);
 		game_set_temporal_feedback(game, " ");
 	}
 	else if (id_new != NO_ID && is_open == FALSE)
@@ -482,13 +537,10 @@ Status game_actions_move(Game *game)
 		return OK;
 	}
 
-	for (i = 0; i < *game_get_n_characters(game); i++)
+	/* The followers in the space left go along */
+	if (player_get_followers(player) != NULL)
 	{
-		character_location_id = game_find_character(game, character_get_id(character_array[i]));
-		if (character_location_id == id_act && character_get_following(character_array[i]) == player_id)
-		{
-			game_change_character_location(game, character_array[i], id_new);
-		}
+		game_move_party(game, player, id_act, id_new);
 	}
 
 	return OK;
@@ -564,8 +616,8 @@ Status game_actions_recruit(Game *game)
 {
 	Id player_location = NO_ID;
 	Id player_id = NO_ID;
-	Id character_location_id = NO_ID;
-	Character **character_array = NULL;
+	Space *player_space = NULL;
+	Character *ally = NULL;
 	const char *character_name = NULL;
 	Command *cmd = NULL;
 	int i;
@@ -582,13 +634,8 @@ Status game_actions_recruit(Game *game)
 		return ERROR;
 	}
 
-	if (!(character_array = game_get_character_array(game)))
-	{
-		return ERROR;
-	}
-
 	player_location = game_get_player_location(game);
-	if (player_location == NO_ID)
+	if (player_location == NO_ID || !(player_space = game_get_space(game, player_location)))
 	{
 		return ERROR;
 	}
@@ -598,15 +645,15 @@ Status game_actions_recruit(Game *game)
 		return ERROR;
 	}
 
-	for (i = 0; i < MAX_CHARACTERS; i++)
+	/* Only the friendly characters of the space can be recruited */
+	for (i = 0; i < space_get_n_occupants(player_space, TRUE); i++)
 	{
-		character_location_id = game_find_character(game, character_get_id(character_array[i]));
-		if (character_location_id == player_location &&
-			strcasecmp(character_get_name(character_array[i]), character_name) == 0 &&
-			character_get_friendly(character_array[i]) == TRUE)
+		ally = space_get_occupant_at(player_space, TRUE, i);
+		if (strcasecmp(character_get_name(ally), character_name) == 0)
 		{
-			if (character_set_following(character_array[i], player_id) == OK)
+			if (game_set_character_following(game, ally, player_id) == OK)
 			{
+				game_publish_event(game, EVENT_CHARACTER_RECRUITED, character_get_id(ally), NO_ID, player_id, 0);
 				game_set_temporal_feedback(game, "Character recruited successfully!");
 				return OK;
 			}
@@ -620,11 +667,11 @@ Status game_actions_abandon(Game *game)
 {
 	Id player_location = NO_ID;
 	Id player_id = NO_ID;
-	Id character_location_id = NO_ID;
-	Character **character_array = NULL;
+	Player *player = NULL;
+	Space *player_space = NULL;
+	Character *follower = NULL;
 	const char *character_name = NULL;
 	Command *cmd = NULL;
-	int i;
 	Bool character_found = FALSE;
 
 	cmd = game_get_last_command(game);
@@ -640,33 +687,29 @@ Status game_actions_abandon(Game *game)
 		return ERROR;
 	}
 
-	if (!(character_array = game_get_character_array(game)))
-	{
-		return ERROR;
-	}
-
 	player_location = game_get_player_location(game);
-	if (player_location == NO_ID)
+	if (player_location == NO_ID || !(player_space = game_get_space(game, player_location)))
 	{
 		return ERROR;
 	}
 
-	player_id = player_get_id(game_get_player_at(game, game_get_turn(game)));
+	player = game_get_player_at(game, game_get_turn(game));
+	player_id = player_get_id(player);
 	if (player_id == NO_ID)
 	{
 		return ERROR;
 	}
 
-	for (i = 0; i < MAX_CHARACTERS; i++)
+	/* Only the party of the player is walked */
+	for (follower = player_get_followers(player); follower; follower = character_get_next_follower(follower))
 	{
-		character_location_id = game_find_character(game, character_get_id(character_array[i]));
-		if (character_location_id == player_location &&
-			strcasecmp(character_get_name(character_array[i]), character_name) == 0 &&
-			character_get_following(character_array[i]) == player_id)
+		if (space_has_character(player_space, character_get_id(follower)) == TRUE &&
+			strcasecmp(character_get_name(follower), character_name) == 0)
 		{
 
-			if (character_set_following(character_array[i], NO_ID) == OK)
+			if (game_set_character_following(game, follower, NO_ID) == OK)
 			{
+				game_publish_event(game, EVENT_CHARACTER_ABANDONED, character_get_id(follower), player_id, NO_ID, 0);
 				game_set_temporal_feedback(game, "Character abandoned successfully!");
 				character_found = TRUE;
 				break;
@@ -687,3 +730,38 @@ Status game_actions_abandon(Game *game)
 
 	return OK;
 }
+
+Status game_actions_stats(Game *game)
+{
+	char summary[MESSAGE_SIZE];
+
+	if (!game)
+	{
+		return ERROR;
+	}
+
+	if (stats_summary(summary, MESSAGE_SIZE) == ERROR)
+	{
+		return ERROR;
+	}
+
+	game_set_last_message(game, summary);
+	return OK;
+}
+
+Status game_actions_undo(Game *game)
+{
+	if (!game)
+	{
+		return ERROR;
+	}
+
+	if (game_undo(game) == ERROR)
+	{
+		game_set_temporal_feedback(game, "There is nothing to undo.");
+		return ERROR;
+	}
+
+	game_set_temporal_feedback(game, "The last action was undone.");
+	return OK;
+}
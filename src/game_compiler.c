@@ -0,0 +1,70 @@
+/**
+ * @brief It compiles a world file into an image before it is shipped
+ *
+ * Checks every reference and limit of a world file and writes it as an
+ * image (see image.h), which the game loads instead of the world file. The
+ * errors and warnings are printed with their lines, and the exit status is 0
+ * only when the image was written, so it can check worlds in a script.
+ *
+ * @file game_compiler.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "image.h"
+#include "stats.h"
+
+int main(int argc, char *argv[])
+{
+	ImageReport report;
+	char *image = NULL;
+	unsigned long t;
+	Status status;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Use: %s <game_data_file> [image_file]\n", argv[0]);
+		return 1;
+	}
+
+	/* The image is written next to the world file unless it is given */
+	if (argc > 2)
+	{
+		image = argv[2];
+	}
+	else if ((image = (char *)malloc(strlen(argv[1]) + 5)) != NULL)
+	{
+		sprintf(image, "%s.img", argv[1]);
+	}
+	else
+	{
+		return 1;
+	}
+
+	t = stats_now();
+	status = image_compile(argv[1], image, &report);
+	t = stats_now() - t;
+
+	printf("%s: %d spaces, %d links, %d objects, %d players, %d characters\n", argv[1], report.n[IMAGE_SPACE], report.n[IMAGE_LINK],
+		   report.n[IMAGE_OBJECT], report.n[IMAGE_PLAYER], report.n[IMAGE_CHARACTER]);
+	printf("%d errors, %d warnings, %d spaces can not be reached\n", report.n_errors, report.n_warnings, report.n_unreachable);
+	if (status == OK)
+	{
+		printf("wrote %s, %ld bytes, in %.3f ms\n", image, report.size, t / 1e6);
+	}
+	else
+	{
+		fprintf(stderr, "Error: %s was not written.\n", image);
+	}
+
+	if (argc <= 2)
+	{
+		free(image);
+	}
+	return status == OK ? 0 : 1;
+}
@@ -8,12 +8,21 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
+#include "autosave.h"
 #include "command.h"
 #include "game.h"
 #include "game_actions.h"
 #include "graphic_engine.h"
 #include "game_reader.h"
+#include "journal.h"
+#include "npc.h"
+#include "reload.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "turns.h"
 
 /**
  * @brief Initializes the game loop.
@@ -21,18 +30,30 @@
  * @param game A pointer to the game structure to be initialized.
  * @param gengine A pointer to the graphic engine to be initialized.
  * @param file_name The name of the file containing the game data.
+ * @param budget Memory budget in bytes to page the spaces of the world, 0 to load the whole world.
+ * @param autosave The saver of the game, NULL if it is not saved.
+ * @param journal Where the journal of the commands is stored, NULL not to keep one. A journal left by
+ *                a game that was not closed is recovered: its last save is restored and the commands
+ *                written after it are applied again.
  * @return 0 if initialization is successful, 1 otherwise.
  */
-int game_loop_init(Game **game, Graphic_engine **gengine, char *file_name);
+int game_loop_init(Game **game, Graphic_engine **gengine, char *file_name, long budget, Autosave *autosave, Journal **journal);
 
 /**
  * @brief Runs the main game loop.
  *
  * @param game The game structure.
  * @param gengine The graphic engine used to render the game.
+ * @param log "-l" to write the commands and their events to log.txt, NULL otherwise.
+ * @param n_threads 0 to run each command when it is typed, otherwise the commands of a round
+ *                  are queued and resolved together with up to n_threads threads.
+ * @param npc_ticks Number of ticks the characters act after each round, 0 to leave them still.
+ * @param autosave The saver of the game after each round, NULL not to save it.
+ * @param journal The journal every command is written to before it is applied, NULL not to keep one.
+ * @param reload The watcher of the data file whose changes are applied after each round, NULL not to watch it.
  * @return 0 if the game loop runs successfully, 1 otherwise.
  */
-int game_loop_run(Game *game, Graphic_engine *gengine, char *log);
+int game_loop_run(Game *game, Graphic_engine *gengine, char *log, int n_threads, int npc_ticks, Autosave *autosave, Journal *journal, Reload *reload);
 
 /**
  * @brief Cleans up resources used by the game loop.
@@ -42,6 +63,24 @@ int game_loop_run(Game *game, Graphic_engine *gengine, char *log);
  */
 void game_loop_cleanup(Game *game, Graphic_engine *gengine);
 
+/**
+ * @brief Writes the events of a turn to the log.
+ *
+ * @param events The events of the turn.
+ * @param n_events The number of events.
+ * @param data The log file.
+ */
+static void game_loop_log_events(const Event *events, int n_events, void *data)
+{
+    int i;
+
+    for (i = 0; i < n_events; i++)
+    {
+        fprintf((FILE *)data, "Player %d: EVENT %s %ld %ld %ld %d\n", events[i].turn + 1, event_type_name(events[i].type), events[i].subject,
+                events[i].from, events[i].to, events[i].value);
+    }
+}
+
 /**
  * @brief Main function of the game.
  *
@@ -53,32 +92,210 @@ int main(int argc, char *argv[])
 {
     Game *game = NULL;
     Graphic_engine *gengine = NULL;
+    Autosave *autosave = NULL;
+    Journal *journal = NULL;
+    Reload *reload = NULL;
+    Bool watch = FALSE;
+    char *log = NULL, *save = NULL;
+    long budget = 0, save_seconds = 0;
+    int i, n_threads = 0, npc_ticks = 0, save_turns = 0, save_keep = AUTOSAVE_KEEP, status = 0;
 
     if (argc < 2)
     {
-        fprintf(stderr, "Use: %s <game_data_file>\n", argv[0]);
+        fprintf(stderr, "Use: %s <game_data_file> [-l] [-m megabytes] [-t threads] [-n ticks] [-a turns] [-as seconds] [-ak files] [-w]\n", argv[0]);
         return 1;
     }
 
-    if (game_loop_init(&game, &gengine, argv[1]) != 0)
+    /* -m pages the world with that memory budget instead of loading it whole,
+       -t resolves the commands of each round together,
+       -n lets the characters act for that many ticks after each round,
+       -a and -as save the game to <game_data_file>.save in the background every that many rounds or seconds,
+       and keep the commands since the last save in <game_data_file>.journal to recover the game if it stops,
+       -ak keeps that many saves, the last one and the ones before it,
+       -w watches <game_data_file> and applies its changes to the game while it runs */
+    for (i = 2; i < argc; i++)
     {
-        game_loop_cleanup(game, gengine);
-        return 1;
+        if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+        {
+            budget = atol(argv[++i]) * 1024 * 1024;
+        }
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            n_threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            npc_ticks = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+        {
+            save_turns = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-as") == 0 && i + 1 < argc)
+        {
+            save_seconds = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-ak") == 0 && i + 1 < argc)
+        {
+            save_keep = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-w") == 0)
+        {
+            watch = TRUE;
+        }
+        else
+        {
+            log = argv[i];
+        }
     }
 
-    if (game_loop_run(game, gengine, argv[2]) != 0)
+    if ((save_turns > 0 || save_seconds > 0) && (save = (char *)malloc(strlen(argv[1]) + 6)) != NULL)
     {
+        sprintf(save, "%s.save", argv[1]);
+        if (budget > 0 || !(autosave = autosave_create(save, save_turns, save_seconds, save_keep)))
+        {
+            fprintf(stderr, "Warning: the game can not be saved.\n");
+        }
+        else if (npc_ticks > 0)
+        {
+            fprintf(stderr, "Warning: the moves of the characters can not be replayed, the game is saved without a journal.\n");
+        }
+        else if (watch == TRUE)
+        {
+            fprintf(stderr, "Warning: the changes of the data file can not be replayed, the game is saved without a journal.\n");
+        }
+        free(save);
+    }
+
+    /* Seeded once here and not when a game is created, since the watcher loads games on its own thread */
+    srand(time(NULL));
+    if (game_loop_init(&game, &gengine, argv[1], budget, autosave, autosave && npc_ticks == 0 && watch == FALSE ? &journal : NULL) != 0)
+    {
+        autosave_destroy(autosave);
         game_loop_cleanup(game, gengine);
         return 1;
     }
 
+    if (watch == TRUE && (budget > 0 || !(reload = reload_create(argv[1]))))
+    {
+        fprintf(stderr, "Warning: the data file can not be watched.\n");
+    }
+
+    if (game_loop_run(game, gengine, log, n_threads, npc_ticks, autosave, journal, reload) != 0)
+    {
+        status = 1;
+    }
+    reload_destroy(reload);
+
+    /* The last save is finished before the game it was forked from is freed,
+       and the journal is only removed when the game was closed as it should */
+    autosave_destroy(autosave);
+    if (status == 0)
+    {
+        journal_close(journal);
+    }
+    else
+    {
+        journal_destroy(journal);
+    }
     game_loop_cleanup(game, gengine);
-    return 0;
+    return status;
+}
+
+/**
+ * @brief Opens the journal of the game, recovering the game if the journal was left by a game that stopped.
+ *
+ * @param game The game, just loaded from its file.
+ * @param file_name The name of the file containing the game data.
+ * @param autosave The saver of the game.
+ * @param journal Where the journal is stored.
+ * @return 0 if the journal is open, 1 otherwise.
+ */
+static int game_loop_open_journal(Game *game, char *file_name, Autosave *autosave, Journal **journal)
+{
+    Snapshot *snapshot = NULL;
+    const char *save = NULL;
+    char *name = NULL;
+    FILE *f = NULL;
+    long mark = -1, read_mark, n = -1;
+    unsigned long t;
+    int age;
+
+    if (!(name = (char *)malloc(strlen(file_name) + 9)))
+    {
+        return 1;
+    }
+    sprintf(name, "%s.journal", file_name);
+
+    if ((*journal = journal_open(name, JOURNAL_BATCH)) != NULL)
+    {
+        /* The newest save that holds the records dropped from the journal is restored, or the world as loaded
+           if none was dropped, and the commands written after it are applied again */
+        t = stats_now();
+        for (age = 0; mark < 0 && (save = autosave_get_file(autosave, age)) != NULL; age++)
+        {
+            if ((f = fopen(save, "rb")) != NULL)
+            {
+                snapshot = snapshot_read(f, game, &read_mark);
+                if (snapshot && read_mark >= journal_get_base(*journal) && game_read_undo(game, f) == OK &&
+                    snapshot_restore(snapshot, game) == OK)
+                {
+                    mark = read_mark;
+                }
+                snapshot_destroy(snapshot);
+                fclose(f);
+            }
+        }
+        if (mark < 0 && journal_get_base(*journal) == 0)
+        {
+            mark = 0;
+        }
+        if (mark >= 0)
+        {
+            n = journal_replay(*journal, game, mark);
+        }
+        if (n < 0)
+        {
+            fprintf(stderr, "Error: the game can not be recovered from %s.\n", name);
+        }
+        else
+        {
+            fprintf(stderr, "Recovered %ld commands of %s in %.3f ms.\n", n, name, (stats_now() - t) / 1e6);
+        }
+    }
+    else if (autosave_start(autosave, game, 0) == OK && autosave_wait(autosave) == OK)
+    {
+        /* The first save is on disk before the journal, so a journal is never recovered with the save of another game */
+        if ((*journal = journal_create(name, JOURNAL_BATCH)) != NULL)
+        {
+            n = 0;
+        }
+    }
+    if (n < 0)
+    {
+        fprintf(stderr, "Error while opening the journal %s.\n", name);
+        journal_destroy(*journal);
+        *journal = NULL;
+    }
+
+    free(name);
+    return n < 0 ? 1 : 0;
 }
 
-int game_loop_init(Game **game, Graphic_engine **gengine, char *file_name)
+int game_loop_init(Game **game, Graphic_engine **gengine, char *file_name, long budget, Autosave *autosave, Journal **journal)
 {
-    if (game_create_from_file(game, file_name) == ERROR)
+    Status status;
+
+    if (budget > 0)
+    {
+        status = game_create_paged(game, file_name, budget);
+    }
+    else
+    {
+        status = game_create_from_file(game, file_name);
+    }
+
+    if (status == ERROR)
     {
         fprintf(stderr, "Error while initializing game.\n");
         if (*game)
@@ -89,6 +306,13 @@ int game_loop_init(Game **game, Graphic_engine **gengine, char *file_name)
         return 1;
     }
 
+    if (journal && game_loop_open_journal(*game, file_name, autosave, journal) != 0)
+    {
+        game_destroy(*game);
+        *game = NULL;
+        return 1;
+    }
+
     if ((*gengine = graphic_engine_create()) == NULL)
     {
         fprintf(stderr, "Error while initializing graphic engine.\n");
@@ -103,11 +327,16 @@ int game_loop_init(Game **game, Graphic_engine **gengine, char *file_name)
     return 0;
 }
 
-int game_loop_run(Game *game, Graphic_engine *gengine, char *log)
+int game_loop_run(Game *game, Graphic_engine *gengine, char *log, int n_threads, int npc_ticks, Autosave *autosave, Journal *journal, Reload *reload)
 {
+    NpcScheduler *npcs = NULL;
     Command *last_cmd = NULL;
+    Command *queued[MAX_PLAYERS];
     Status cmd_status;
-    int turn;
+    int turn, players[MAX_PLAYERS], n_queued, i, applied;
+    ReloadDiff diff;
+    long rounds = 0;
+    unsigned int seed, seeds[MAX_PLAYERS];
     FILE *f = NULL;
 
     if (!gengine)
@@ -126,16 +355,24 @@ int game_loop_run(Game *game, Graphic_engine *gengine, char *log)
             {
                 return -1;
             }
+            event_bus_subscribe(game_get_events(game), EVENT_ALL, game_loop_log_events, f);
         }
     }
 
+    if (npc_ticks > 0 && !(npcs = npc_create(game, NPC_TICK_BUDGET_NS, (unsigned long)time(NULL))))
+    {
+        fprintf(stderr, "Warning: the characters can not act in a paged world.\n");
+    }
+
     while ((command_get_code(game_get_last_command(game)) != EXIT) && (game_get_finished(game) == FALSE))
     {
+        n_queued = 0;
         for (turn = 0; turn < game_get_n_players(game); turn++)
         {
             game_set_turn(game, turn);
             last_cmd = game_get_last_command(game);
             graphic_engine_paint_game(gengine, game);
+            printf("prompt:> ");
             command_get_user_input(last_cmd);
             if (f != NULL)
             {
@@ -173,6 +410,22 @@ int game_loop_run(Game *game, Graphic_engine *gengine, char *log)
                     fprintf(f, "Player %d: INSPECT\n", game_get_turn(game) + 1);
                     break;
 
+                case RECRUIT:
+                    fprintf(f, "Player %d: RECRUIT\n", game_get_turn(game) + 1);
+                    break;
+
+                case ABANDON:
+                    fprintf(f, "Player %d: ABANDON\n", game_get_turn(game) + 1);
+                    break;
+
+                case STATS:
+                    fprintf(f, "Player %d: STATS\n", game_get_turn(game) + 1);
+                    break;
+
+                case UNDO:
+                    fprintf(f, "Player %d: UNDO\n", game_get_turn(game) + 1);
+                    break;
+
                 default:
                     break;
                 }
@@ -183,14 +436,87 @@ int game_loop_run(Game *game, Graphic_engine *gengine, char *log)
             {
                 break;
             }
+            if (n_threads > 0)
+            {
+                players[n_queued] = turn;
+                queued[n_queued++] = last_cmd;
+                continue;
+            }
+            /* The command is written before it is applied, with a seed for its random numbers to apply it again */
+            if (journal)
+            {
+                seed = (unsigned int)rand() + 1;
+                srand(seed);
+                journal_append(journal, turn, last_cmd, seed);
+            }
             cmd_status = game_actions_update(game, game_get_last_command(game));
             command_set_status(game_get_last_command(game), cmd_status);
+            event_bus_dispatch(game_get_events(game));
+            game_evict_regions(game);
             if (player_get_health(game_get_player_at(game, game_get_turn(game))) <= 0)
             {
                 game_set_finished(game, TRUE);
             }
         }
+
+        if (n_queued > 0)
+        {
+            /* The round is resolved as if its commands were applied in order, each after its own seed, so it is replayed that way */
+            for (i = 0; journal && i < n_queued; i++)
+            {
+                seeds[i] = (unsigned int)rand() + 1;
+                journal_append(journal, players[i], queued[i], seeds[i]);
+            }
+            turns_resolve(game, players, queued, n_queued, journal ? seeds : NULL, n_threads);
+            event_bus_dispatch(game_get_events(game));
+            game_evict_regions(game);
+            for (i = 0; i < n_queued; i++)
+            {
+                if (player_get_health(game_get_player_at(game, players[i])) <= 0)
+                {
+                    game_set_finished(game, TRUE);
+                }
+            }
+            /* The player that typed exit stays active, so that the loop ends */
+            if (turn < game_get_n_players(game))
+            {
+                game_set_turn(game, turn);
+            }
+        }
+
+        if (npcs && command_get_code(game_get_last_command(game)) != EXIT)
+        {
+            for (i = 0; i < npc_ticks; i++)
+            {
+                npc_tick(npcs);
+            }
+            event_bus_dispatch(game_get_events(game));
+        }
+
+        rounds++;
+        if (autosave && command_get_code(game_get_last_command(game)) != EXIT)
+        {
+            autosave_tick(autosave, game, journal ? journal_get_last(journal) : rounds);
+        }
+        /* The commands held by a save on disk are not needed to recover the game any more */
+        if (journal && autosave_get_last_mark(autosave) > journal_get_base(journal))
+        {
+            journal_compact(journal, autosave_get_last_mark(autosave));
+        }
+        /* The changes of the data file are applied between rounds, and the characters are scheduled again */
+        if (reload && command_get_code(game_get_last_command(game)) != EXIT && (applied = reload_apply(reload, game, &diff)) != 0)
+        {
+            fprintf(stderr, "Reloaded the world%s: %d added, %d changed, %d removed, %d kept, %.3f ms after the file was written (parsed in %.3f ms, applied in %.3f ms).\n",
+                    applied < 0 ? " in part" : "", diff.added, diff.changed, diff.removed, diff.kept, diff.latency / 1e6, diff.parse / 1e6, diff.apply / 1e6);
+            event_bus_dispatch(game_get_events(game));
+            if (npcs)
+            {
+                npc_destroy(npcs);
+                npcs = npc_create(game, NPC_TICK_BUDGET_NS, (unsigned long)time(NULL));
+            }
+        }
     }
+    npc_destroy(npcs);
     if (f != NULL)
     {
         fclose(f);
@@ -211,4 +537,7 @@ void game_loop_cleanup(Game *game, Graphic_engine *gengine)
         graphic_engine_destroy(gengine);
         gengine = NULL;
     }
+
+    /* The screen is released at this point, so the report is left on the terminal */
+    stats_print(stdout);
 }
\ No newline at end of file
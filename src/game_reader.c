@@ -1,105 +1,294 @@
 /**
  * @brief Implementation of game reader
  *
+ * Every loader parses its records with the same functions. game_load_world
+ * parses all of them at once, splitting big files into chunks that are parsed
+ * by several threads.
+ *
  * @file game_reader.c
  * @version 0
  * @date 27-01-2025
  */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include "game_reader.h"
+#include "record.h"
 #include "space.h"
+#include "stats.h"
+#include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
-Status game_load_spaces(Game *game, char *filename)
+/**
+ * @brief Maximum number of threads used by game_load_world
+ */
+#define LOAD_MAX_THREADS 64
+
+/**
+ * @brief Minimum size in bytes of the chunk parsed by each thread
+ *
+ * Smaller files are parsed by fewer threads, a thread is not worth it for
+ * less than this.
+ */
+#define LOAD_MIN_CHUNK (1L << 20)
+
+/**
+ * @brief Types of records, in the order in which they are added to the game
+ */
+typedef enum
 {
-	FILE *file = NULL;
-	char line[WORD_SIZE] = "";
-	char name[WORD_SIZE] = "";
-	char *toks = NULL;
-	Id id = NO_ID;
-	char gdesc[GDESC_ROWS][GDESC_COLS + 1];
-	Space *space = NULL;
-	Status status = OK;
+	LOAD_SPACE,		/*!< #s: records */
+	LOAD_PLAYER,	/*!< #p: records */
+	LOAD_OBJECT,	/*!< #o: records */
+	LOAD_LINK,		/*!< #l: records */
+	LOAD_CHARACTER, /*!< #c: records */
+	LOAD_N_TYPES	/*!< Number of types */
+} LoadType;
+
+/**
+ * @brief Tags of the records of each type
+ */
+static char *load_tags[LOAD_N_TYPES] = {"#s:", "#p:", "#o:", "#l:", "#c:"};
+
+/**
+ * @brief An entity parsed but not added to the game yet
+ */
+typedef struct
+{
+	LoadType type;	/*!< Type of the entity */
+	void *entity;	/*!< The entity, NULL once the game owns it */
+	Id location;	/*!< Location of players and characters */
+} LoadEntity;
+
+/**
+ * @brief Chunk of a file and the entities parsed from it by one thread
+ */
+typedef struct
+{
+	Record *record;		  /*!< Scanner of the chunk */
+	LoadEntity *entities; /*!< Entities in the order of the file */
+	int n_entities;		  /*!< Number of entities */
+	int max_entities;	  /*!< Capacity of entities */
+	Status status;		  /*!< ERROR if the chunk could not be parsed */
+} LoadChunk;
+
+Status game_reader_parse_space(Record *record, Space **space)
+{
+	Field *field = NULL;
+	char *name = NULL;
+	long id;
 	int i;
 
-	if (!filename)
+	if (record_get_long(record, 0, "space id", &id) == ERROR || !(name = record_get_string(record, 1, WORD_SIZE, "space name")))
 	{
 		return ERROR;
 	}
 
-	file = fopen(filename, "r");
-	if (file == NULL)
+	/* Missing rows of the graphic description are left blank */
+	for (i = 0; i < GDESC_ROWS; i++)
+	{
+		if (record_get_field(record, 2 + i) && !record_get_string(record, 2 + i, GDESC_COLS, "space graphic description"))
+		{
+			return ERROR;
+		}
+	}
+
+#ifdef DEBUG
+	printf("Leído: %ld|%s\n", id, name);
+#endif
+	if (!(*space = space_create(id)))
 	{
+		record_error(record, 0, "could not create space");
 		return ERROR;
 	}
 
-	while (fgets(line, WORD_SIZE, file))
+	space_set_name(*space, name);
+	for (i = 0; i < GDESC_ROWS; i++)
 	{
-		if (strncmp("#s:", line, 3) == 0)
-		{
-			toks = strtok(line + 3, "|");
-			id = atol(toks);
-			toks = strtok(NULL, "|");
-			strcpy(name, toks);
+		field = record_get_field(record, 2 + i);
+		space_set_gdesc_at(*space, field ? field->ptr : "", i);
+	}
 
-			for (i = 0; i < GDESC_ROWS; i++)
-			{
-				toks = strtok(NULL, "|\n");
+	return OK;
+}
 
-				if (toks == NULL)
-				{
-					gdesc[i][0] = '\0';
-				}
-				else
-				{
-					strcpy(gdesc[i], toks);
-				}
-			}
+Status game_reader_parse_object(Record *record, Object **object)
+{
+	char *name = NULL;
+	long id, location;
 
+	if (record_get_long(record, 0, "object id", &id) == ERROR || !(name = record_get_string(record, 1, WORD_SIZE, "object name")) ||
+		record_get_long(record, 2, "object location", &location) == ERROR)
+	{
+		return ERROR;
+	}
 #ifdef DEBUG
-			printf("Leído: %ld|%s|%ld|%ld|%ld|%ld\n", id, name, north, east, south, west);
-			printf("Gdesc:\n");
-			for (i = 0; i < GDESC_ROWS; i++)
-			{
-				printf("[%s]\n", gdesc[i]);
-			}
+	printf("Leído: %ld|%s|%ld\n", id, name, location);
 #endif
-			space = space_create(id);
-			if (space != NULL)
-			{
-				space_set_name(space, name);
+	if (!(*object = object_create(id)))
+	{
+		record_error(record, 0, "could not create object");
+		return ERROR;
+	}
 
-				for (i = 0; i < GDESC_ROWS; i++)
-				{
-					space_set_gdesc_at(space, gdesc[i], i);
-				}
+	object_set_name(*object, name);
+	object_set_location(*object, location);
 
-				game_add_space(game, space);
-			}
-		}
+	return OK;
+}
+
+Status game_reader_parse_link(Record *record, Link **link)
+{
+	char *name = NULL;
+	long id, orig, dest;
+	int dir, is_open;
+
+	if (record_get_long(record, 0, "link id", &id) == ERROR || !(name = record_get_string(record, 1, WORD_SIZE, "link name")) ||
+		record_get_long(record, 2, "link origin", &orig) == ERROR || record_get_long(record, 3, "link destination", &dest) == ERROR ||
+		record_get_int(record, 4, "link direction", N, W, &dir) == ERROR || record_get_int(record, 5, "link open state", FALSE, TRUE, &is_open) == ERROR)
+	{
+		return ERROR;
 	}
 
-	if (ferror(file))
+	if (!(*link = link_create(id)))
 	{
-		status = ERROR;
+		record_error(record, 0, "could not create link");
+		return ERROR;
 	}
 
-	fclose(file);
+	link_set_name(*link, name);
+	link_set_origin(*link, orig);
+	link_set_destination(*link, dest);
+	link_set_direction(*link, (Direction)dir);
+	link_set_open(*link, (Bool)is_open);
+
+	return OK;
+}
+
+Status game_reader_parse_player(Record *record, Player **player, Id *location)
+{
+	char *name = NULL, *toks = NULL, gdesc[PLAYER_GDESC_COLUMS + 1];
+	int backpack_size, health_points;
+	long id;
+	Inventory *inventory_p = NULL;
+
+	if (record_get_long(record, 0, "player id", &id) == ERROR || !(name = record_get_string(record, 1, WORD_SIZE, "player name")) ||
+		!(toks = record_get_string(record, 2, PLAYER_GDESC_COLUMS, "player graphic description")) ||
+		record_get_long(record, 3, "player location", location) == ERROR ||
+		record_get_int(record, 4, "player health points", 0, INT_MAX, &health_points) == ERROR ||
+		record_get_int(record, 5, "player backpack size", 0, INT_MAX, &backpack_size) == ERROR)
+	{
+		return ERROR;
+	}
+
+	/* player_set_gdesc pads its argument, so it gets its own buffer */
+	strcpy(gdesc, toks);
+
+	if (!(*player = player_create(id)))
+	{
+		record_error(record, 0, "could not create player");
+		return ERROR;
+	}
+
+	if (!(inventory_p = inventory_create(backpack_size)))
+	{
+		record_error(record, 5, "could not create inventory");
+		player_destroy(*player);
+		*player = NULL;
+		return ERROR;
+	}
+
+	player_set_name(*player, name);
+	player_set_gdesc(*player, gdesc);
+	player_set_location(*player, *location);
+	player_set_health(*player, health_points);
+	player_set_inventory(*player, inventory_p);
+
+	return OK;
+}
+
+Status game_reader_parse_character(Record *record, Character **character, Id *location)
+{
+	char *name = NULL, *gdesc = NULL, *message = "";
+	long id;
+	int health, friendly;
+
+	if (record_get_long(record, 0, "character id", &id) == ERROR || !(name = record_get_string(record, 1, WORD_SIZE, "character name")) ||
+		!(gdesc = record_get_string(record, 2, GDESC_SIZE - 1, "character graphic description")) ||
+		record_get_long(record, 3, "character location", location) == ERROR ||
+		record_get_int(record, 4, "character health", INT_MIN, INT_MAX, &health) == ERROR ||
+		record_get_int(record, 5, "character friendliness", FALSE, TRUE, &friendly) == ERROR)
+	{
+		return ERROR;
+	}
+
+	/* Only friendly characters talk, the message is optional */
+	if (friendly == TRUE && record_get_field(record, 6) && !(message = record_get_string(record, 6, MESSAGE_SIZE, "character message")))
+	{
+		return ERROR;
+	}
+
+	if (!(*character = character_create(id)))
+	{
+		record_error(record, 0, "could not create character");
+		return ERROR;
+	}
+
+	character_set_name(*character, name);
+	character_set_gdesc(*character, gdesc);
+	character_set_health(*character, health);
+	character_set_friendly(*character, (Bool)friendly);
+	character_set_message(*character, message);
+
+	return OK;
+}
+
+Status game_load_spaces(Game *game, char *filename)
+{
+	Record *record = NULL;
+	Space *space = NULL;
+	Status status = OK;
+	int n_fields;
+
+	if (!game || !filename || !(record = record_open(filename)))
+	{
+		return ERROR;
+	}
+
+	while ((n_fields = record_next(record, "#s:")) != 0)
+	{
+		if (n_fields < 0 || game_reader_parse_space(record, &space) == ERROR)
+		{
+			status = ERROR;
+			break;
+		}
+
+		if (game_add_space(game, space) == ERROR)
+		{
+			space_destroy(space);
+		}
+	}
+
+	record_close(record);
 	return status;
 }
 
 Status game_add_space(Game *game, Space *space)
 {
 	int *numSpaces = game_get_n_spaces(game);
-	Space **spacePointer = game_get_spaces(game);
+	Space **spacePointer = NULL;
 
-	if ((space == NULL) || (*numSpaces >= MAX_SPACES) || (spacePointer == NULL) || numSpaces == NULL)
+	if ((space == NULL) || numSpaces == NULL || game_reserve_spaces(game, *numSpaces + 1) == ERROR)
 	{
 		return ERROR;
 	}
 
+	spacePointer = game_get_spaces(game);
+
 	spacePointer[*numSpaces] = space;
 	(*numSpaces)++;
 
@@ -121,73 +310,48 @@ Id game_get_space_id_at(Game *game, int position)
 
 Status game_load_objects(Game *game, char *filename)
 {
-	FILE *file = NULL;
-	char line[WORD_SIZE] = "";
-	char name[WORD_SIZE] = "";
-	char *toks = NULL;
-	Id id = NO_ID, location = NO_ID;
+	Record *record = NULL;
 	Object *object = NULL;
 	Status status = OK;
+	int n_fields;
 
-	if (!filename)
-	{
-		return ERROR;
-	}
-
-	file = fopen(filename, "r");
-	if (file == NULL)
+	if (!game || !filename || !(record = record_open(filename)))
 	{
 		return ERROR;
 	}
 
-	while (fgets(line, WORD_SIZE, file))
+	while ((n_fields = record_next(record, "#o:")) != 0)
 	{
-		if (strncmp("#o:", line, 3) == 0)
+		if (n_fields < 0 || game_reader_parse_object(record, &object) == ERROR)
 		{
-			toks = strtok(line + 3, "|");
-			id = atol(toks);
-			toks = strtok(NULL, "|");
-			strcpy(name, toks);
-			toks = strtok(NULL, "|");
-			location = atol(toks);
-#ifdef DEBUG
-			printf("Leído: %ld|%s|%ld\n", id, name, location);
-#endif
-			object = object_create(id);
-			if (object != NULL)
-			{
-				object_set_name(object, name);
-				object_set_location(object, location);
-
-				if (game_add_objects(game, object) == ERROR)
-				{
-					object_destroy(object);
-					fprintf(stderr, "Error while adding object to game.\n");
-				}
-			}
+			status = ERROR;
+			break;
 		}
-	}
 
-	if (ferror(file))
-	{
-		status = ERROR;
+		if (game_add_objects(game, object) == ERROR)
+		{
+			object_destroy(object);
+			fprintf(stderr, "Error while adding object to game.\n");
+		}
 	}
 
-	fclose(file);
+	record_close(record);
 	return status;
 }
 
 Status game_add_objects(Game *game, Object *object)
 {
 	int *numObjects = game_get_n_objects(game);
-	Object **objectPointer = game_get_objects(game);
+	Object **objectPointer = NULL;
 
-	if ((object == NULL) || (*numObjects >= MAX_OBJECTS) || (objectPointer == NULL))
+	if ((object == NULL) || numObjects == NULL || game_reserve_objects(game, *numObjects + 1) == ERROR)
 	{
 		fprintf(stderr, "Error while adding object to game.\n");
 		return ERROR;
 	}
 
+	objectPointer = game_get_objects(game);
+
 	objectPointer[*numObjects] = object;
 	(*numObjects)++;
 
@@ -197,13 +361,15 @@ Status game_add_objects(Game *game, Object *object)
 Status game_add_link(Game *game, Link *link)
 {
 	int *n_links = game_get_n_links(game);
-	Link **links_p = game_get_links(game);
+	Link **links_p = NULL;
 
-	if (game == NULL || link == NULL || *n_links == MAX_LINKS || n_links == NULL || links_p == NULL)
+	if (game == NULL || link == NULL || n_links == NULL || game_reserve_links(game, *n_links + 1) == ERROR)
 	{
 		return ERROR;
 	}
 
+	links_p = game_get_links(game);
+
 	links_p[*n_links] = link;
 	(*n_links)++;
 	return OK;
@@ -211,12 +377,10 @@ Status game_add_link(Game *game, Link *link)
 
 Status game_load_players(Game *game, char *filename)
 {
-	FILE *f = NULL;
-	char line[WORD_SIZE], name[WORD_SIZE], gdesc[PLAYER_GDESC_COLUMS], *toks = NULL;
-	int backpack_size, health_points;
-	Id id, location;
+	Record *record = NULL;
 	Player *player_p = NULL;
-	Inventory *inventory_p = NULL;
+	Id location;
+	int n_fields;
 
 	if (game == NULL || filename == NULL)
 	{
@@ -224,236 +388,434 @@ Status game_load_players(Game *game, char *filename)
 		return ERROR;
 	}
 
-	f = fopen(filename, "r");
-	if (!f)
+	if (!(record = record_open(filename)))
 	{
 		fprintf(stderr, "Error: Could not open file %s.\n", filename);
 		return ERROR;
 	}
 
-	while (fgets(line, WORD_SIZE, f))
+	while ((n_fields = record_next(record, "#p:")) != 0)
 	{
-		if (strncmp(line, "#p:", 3) == 0)
+		if (n_fields < 0 || game_reader_parse_player(record, &player_p, &location) == ERROR)
 		{
-			toks = strtok(line + 3, "|");
-			if (!toks)
-			{
-				fprintf(stderr, "Error: Missing player ID.\n");
-				fclose(f);
-				return ERROR;
-			}
-			id = atol(toks);
-
-			toks = strtok(NULL, "|");
-			if (!toks)
-			{
-				fprintf(stderr, "Error: Missing player name.\n");
-				fclose(f);
-				return ERROR;
-			}
-			strcpy(name, toks);
-
-			toks = strtok(NULL, "|");
-			if (!toks)
-			{
-				fprintf(stderr, "Error: Missing player graphic description.\n");
-				fclose(f);
-				return ERROR;
-			}
-			strcpy(gdesc, toks);
-
-			toks = strtok(NULL, "|");
-			if (!toks)
-			{
-				fprintf(stderr, "Error: Missing player location.\n");
-				fclose(f);
-				return ERROR;
-			}
-			location = atol(toks);
-
-			toks = strtok(NULL, "|");
-			if (!toks)
-			{
-				fprintf(stderr, "Error: Missing player health points.\n");
-				fclose(f);
-				return ERROR;
-			}
-			health_points = (int)atol(toks);
-
-			toks = strtok(NULL, "|\n");
-			if (!toks)
-			{
-				fprintf(stderr, "Error: Missing player backpack size.\n");
-				fclose(f);
-				return ERROR;
-			}
-			backpack_size = (int)atol(toks);
-
-			player_p = player_create(id);
-			if (!player_p)
-			{
-				fprintf(stderr, "Error: Could not create player.\n");
-				fclose(f);
-				return ERROR;
-			}
-
-			inventory_p = inventory_create(backpack_size);
-			if (!inventory_p)
-			{
-				fprintf(stderr, "Error: Could not create inventory.\n");
-				player_destroy(player_p);
-				fclose(f);
-				return ERROR;
-			}
+			record_close(record);
+			return ERROR;
+		}
 
-			player_set_name(player_p, name);
-			player_set_gdesc(player_p, gdesc);
-			player_set_location(player_p, location);
-			space_set_discovered(game_get_space(game, location), TRUE);
-			player_set_health(player_p, health_points);
-			player_set_inventory(player_p, inventory_p);
+		space_set_discovered(game_get_space(game, location), TRUE);
 
-			if (game_add_player(game, player_p) == ERROR)
-			{
-				fprintf(stderr, "Error: Could not add player to game.\n");
-				player_destroy(player_p);
-				fclose(f);
-				return ERROR;
-			}
+		if (game_add_player(game, player_p) == ERROR)
+		{
+			record_error(record, -1, "could not add player to game");
+			player_destroy(player_p);
+			record_close(record);
+			return ERROR;
 		}
 	}
 
-	fclose(f);
+	record_close(record);
 	return OK;
 }
 
 Status game_load_links(Game *game, char *filename)
 {
-	char line[WORD_SIZE], name[WORD_SIZE], *toks;
+	Record *record = NULL;
 	Link *link_p = NULL;
-	Id id, orig, dest;
-	Direction dir;
-	Bool is_open = FALSE;
-	FILE *f = NULL;
+	int n_fields;
 
 	if (game == NULL || filename == NULL)
 	{
 		return ERROR;
 	}
 
-	if (!(f = fopen(filename, "r")))
+	if (!(record = record_open(filename)))
 	{
 		return ERROR;
 	}
 
-	while (fgets(line, WORD_SIZE, f))
+	while ((n_fields = record_next(record, "#l:")) != 0)
 	{
-		if (strncmp(line, "#l:", 3) == 0)
+		if (n_fields < 0 || game_reader_parse_link(record, &link_p) == ERROR)
 		{
-			toks = strtok(line + 3, "|");
-			id = atol(toks);
-			toks = strtok(NULL, "|");
-			strcpy(name, toks);
-			toks = strtok(NULL, "|");
-			orig = atol(toks);
-			toks = strtok(NULL, "|");
-			dest = atol(toks);
-			toks = strtok(NULL, "|");
-			dir = atol(toks);
-			toks = strtok(NULL, "|\n");
-			is_open = atol(toks);
-
-			link_p = link_create(id);
-
-			if (link_p != NULL)
-			{
-				link_set_name(link_p, name);
-				link_set_origin(link_p, orig);
-				link_set_destination(link_p, dest);
-				link_set_direction(link_p, dir);
-				link_set_open(link_p, is_open);
-
-				game_add_link(game, link_p);
-			}
-			else
-			{
-				return ERROR;
-			}
+			record_close(record);
+			return ERROR;
 		}
+
+		game_add_link(game, link_p);
 	}
 
-	fclose(f);
+	record_close(record);
 	return OK;
 }
 
 Status game_load_characters(Game *game, char *filename)
 {
-	FILE *f = NULL;
-	char line[WORD_SIZE], name[WORD_SIZE], gdesc[WORD_SIZE], message[MESSAGE_SIZE], *toks = NULL;
-	Id id = 0, position = 0;
-	int health = 0;
-	Bool friendly = FALSE;
+	Record *record = NULL;
 	Character *char_p = NULL;
+	Id position;
+	int n_fields;
 
 	if (game == NULL || filename == NULL)
 	{
 		return ERROR;
 	}
 
-	if (!(f = fopen(filename, "r")))
+	if (!(record = record_open(filename)))
 	{
 		return ERROR;
 	}
 
-	while (fgets(line, WORD_SIZE, f))
+	while ((n_fields = record_next(record, "#c:")) != 0)
+	{
+		if (n_fields < 0 || game_reader_parse_character(record, &char_p, &position) == ERROR)
+		{
+			record_close(record);
+			return ERROR;
+		}
+
+		game_add_character(game, char_p, position);
+	}
+
+	record_close(record);
+	return OK;
+}
+
+/**
+ * @brief Destroys an entity that the game does not own
+ *
+ * @param loaded A pointer to the entity
+ */
+static void game_reader_destroy_entity(LoadEntity *loaded)
+{
+	switch (loaded->type)
+	{
+	case LOAD_SPACE:
+		space_destroy((Space *)loaded->entity);
+		break;
+	case LOAD_PLAYER:
+		player_destroy((Player *)loaded->entity);
+		break;
+	case LOAD_OBJECT:
+		object_destroy((Object *)loaded->entity);
+		break;
+	case LOAD_LINK:
+		link_destroy((Link *)loaded->entity);
+		break;
+	default:
+		character_destroy((Character *)loaded->entity);
+		break;
+	}
+	loaded->entity = NULL;
+}
+
+/**
+ * @brief Parses every record of a chunk into its own buffer of entities
+ *
+ * It does not touch the game, so several chunks can be parsed at the same time.
+ *
+ * @param arg A pointer to the LoadChunk
+ * @return NULL
+ */
+static void *game_reader_parse_chunk(void *arg)
+{
+	LoadChunk *chunk = (LoadChunk *)arg;
+	LoadEntity *loaded = NULL, *grown = NULL;
+	Space *space = NULL;
+	Player *player = NULL;
+	Object *object = NULL;
+	Link *link = NULL;
+	Character *character = NULL;
+	Status status = OK;
+	int type, n_fields;
+
+	while (status == OK && (n_fields = record_next_of(chunk->record, load_tags, LOAD_N_TYPES, &type)) != 0)
 	{
-		if (strncmp(line, "#c:", 3) == 0)
+		if (n_fields < 0)
+		{
+			status = ERROR;
+			break;
+		}
+
+		if (chunk->n_entities == chunk->max_entities)
 		{
-			toks = strtok(line + 3, "|");
-			id = atol(toks);
-			toks = strtok(NULL, "|");
-			strcpy(name, toks);
-			toks = strtok(NULL, "|");
-			strcpy(gdesc, toks);
-			toks = strtok(NULL, "|");
-			position = atol(toks);
-			toks = strtok(NULL, "|");
-			health = atol(toks);
-			toks = strtok(NULL, "|\n");
-			friendly = atol(toks);
-
-			char_p = character_create(id);
-			if (char_p == NULL)
+			if (!(grown = (LoadEntity *)realloc(chunk->entities, (chunk->max_entities * 2 + 64) * sizeof(LoadEntity))))
 			{
-				fclose(f);
-				return ERROR;
+				status = ERROR;
+				break;
 			}
+			chunk->entities = grown;
+			chunk->max_entities = chunk->max_entities * 2 + 64;
+		}
+
+		loaded = &chunk->entities[chunk->n_entities];
+		loaded->type = (LoadType)type;
+		loaded->entity = NULL;
+		loaded->location = NO_ID;
+
+		switch (loaded->type)
+		{
+		case LOAD_SPACE:
+			status = game_reader_parse_space(chunk->record, &space);
+			loaded->entity = space;
+			break;
+		case LOAD_PLAYER:
+			status = game_reader_parse_player(chunk->record, &player, &loaded->location);
+			loaded->entity = player;
+			break;
+		case LOAD_OBJECT:
+			status = game_reader_parse_object(chunk->record, &object);
+			loaded->entity = object;
+			break;
+		case LOAD_LINK:
+			status = game_reader_parse_link(chunk->record, &link);
+			loaded->entity = link;
+			break;
+		default:
+			status = game_reader_parse_character(chunk->record, &character, &loaded->location);
+			loaded->entity = character;
+			break;
+		}
+
+		if (status == OK)
+		{
+			chunk->n_entities++;
+		}
+	}
+
+	chunk->status = status;
+	return NULL;
+}
+
+/**
+ * @brief Compares two spaces by id, for qsort
+ */
+static int game_reader_compare_spaces(const void *a, const void *b)
+{
+	Id id_a = space_get_id(*(Space *const *)a), id_b = space_get_id(*(Space *const *)b);
+
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Finds a space in an array sorted by id
+ *
+ * @param sorted The spaces sorted by id
+ * @param n The number of spaces
+ * @param id The id of the space
+ * @return The space, NULL if there is no space with that id
+ */
+static Space *game_reader_find_space(Space **sorted, int n, Id id)
+{
+	int low = 0, high = n - 1, mid;
+	Id mid_id;
+
+	while (low <= high)
+	{
+		mid = low + (high - low) / 2;
+		mid_id = space_get_id(sorted[mid]);
+		if (mid_id == id)
+		{
+			return sorted[mid];
+		}
+		else if (mid_id < id)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
 
-			character_set_name(char_p, name);
-			character_set_gdesc(char_p, gdesc);
-			character_set_health(char_p, health);
-			character_set_friendly(char_p, friendly);
+	return NULL;
+}
 
-			if (friendly == TRUE)
+/**
+ * @brief Adds the parsed entities to the game
+ *
+ * Types are added in the order of the individual loaders, and each type in
+ * the order of the file, so the game is the same whatever the number of
+ * chunks. Locations are resolved at the end through an index of the spaces.
+ *
+ * @param game A pointer to the game
+ * @param chunks The parsed chunks, in the order of the file
+ * @param n_chunks The number of chunks
+ * @return OK if everything was added, ERROR otherwise
+ */
+static Status game_reader_merge(Game *game, LoadChunk *chunks, int n_chunks)
+{
+	Space **sorted = NULL, *space = NULL;
+	Character **characters = NULL;
+	LoadEntity *loaded = NULL;
+	int *n_characters = game_get_n_characters(game);
+	int type, i, j, n_spaces = 0, n_players;
+	Status status = OK;
+
+	for (type = 0; type < LOAD_N_TYPES && status == OK; type++)
+	{
+		/* Players and characters need every space to find their locations */
+		if (type == LOAD_PLAYER)
+		{
+			n_spaces = *game_get_n_spaces(game);
+			if (!(sorted = (Space **)malloc((n_spaces + 1) * sizeof(Space *))))
+			{
+				return ERROR;
+			}
+			memcpy(sorted, game_get_spaces(game), n_spaces * sizeof(Space *));
+			qsort(sorted, n_spaces, sizeof(Space *), game_reader_compare_spaces);
+		}
+
+		for (i = 0; i < n_chunks && status == OK; i++)
+		{
+			for (j = 0; j < chunks[i].n_entities && status == OK; j++)
 			{
-				toks = strtok(NULL, "|\n");
-				if (toks != NULL)
+				loaded = &chunks[i].entities[j];
+				if (loaded->type != (LoadType)type)
 				{
-					strcpy(message, toks);
-					character_set_message(char_p, message);
+					continue;
+				}
+
+				switch (loaded->type)
+				{
+				case LOAD_SPACE:
+					if (game_add_space(game, (Space *)loaded->entity) == OK)
+					{
+						loaded->entity = NULL;
+					}
+					break;
+				case LOAD_PLAYER:
+					n_players = game_get_n_players(game);
+					if (game_add_player(game, (Player *)loaded->entity) == ERROR)
+					{
+						fprintf(stderr, "Error: Could not add player to game.\n");
+						status = ERROR;
+					}
+					if (game_get_n_players(game) > n_players)
+					{
+						loaded->entity = NULL;
+						space_set_discovered(game_reader_find_space(sorted, n_spaces, loaded->location), TRUE);
+					}
+					break;
+				case LOAD_OBJECT:
+					if (game_add_objects(game, (Object *)loaded->entity) == OK)
+					{
+						loaded->entity = NULL;
+					}
+					break;
+				case LOAD_LINK:
+					if (game_add_link(game, (Link *)loaded->entity) == OK)
+					{
+						loaded->entity = NULL;
+					}
+					break;
+				default:
+					/* Same as game_add_character, without its linear search of the space */
+					if (loaded->location < 0 || game_reserve_characters(game, *n_characters + 1) == ERROR)
+					{
+						break;
+					}
+					characters = game_get_character_array(game);
+					characters[(*n_characters)++] = (Character *)loaded->entity;
+					if ((space = game_reader_find_space(sorted, n_spaces, loaded->location)) != NULL)
+					{
+						space_add_character(space, (Character *)loaded->entity);
+					}
+					loaded->entity = NULL;
+					break;
 				}
 			}
-			else
+		}
+	}
+
+	free(sorted);
+	return status;
+}
+
+Status game_load_world(Game *game, char *filename, int n_threads)
+{
+	Record *record = NULL, *records[LOAD_MAX_THREADS];
+	LoadChunk *chunks = NULL;
+	pthread_t threads[LOAD_MAX_THREADS];
+	Bool started[LOAD_MAX_THREADS];
+	unsigned long stats_t = 0;
+	Status status = OK;
+	int i, j, n_chunks;
+	long n_cores;
+
+	if (!game || !filename || !(record = record_open(filename)))
+	{
+		return ERROR;
+	}
+
+	if (n_threads <= 0)
+	{
+		n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+		n_threads = n_cores > 0 ? (int)n_cores : 1;
+	}
+	if (n_threads > LOAD_MAX_THREADS)
+	{
+		n_threads = LOAD_MAX_THREADS;
+	}
+
+	if ((n_chunks = record_split(record, n_threads, LOAD_MIN_CHUNK, records)) == 0 || !(chunks = (LoadChunk *)calloc(n_chunks, sizeof(LoadChunk))))
+	{
+		for (i = 0; i < n_chunks; i++)
+		{
+			record_close(records[i]);
+		}
+		record_close(record);
+		return ERROR;
+	}
+
+	/* The first chunk is parsed by this thread, and any chunk whose thread could not be started too */
+	STATS_START(stats_t);
+	for (i = 0; i < n_chunks; i++)
+	{
+		chunks[i].record = records[i];
+		chunks[i].status = OK;
+		started[i] = (i > 0 && pthread_create(&threads[i], NULL, game_reader_parse_chunk, &chunks[i]) == 0) ? TRUE : FALSE;
+	}
+	for (i = 0; i < n_chunks; i++)
+	{
+		if (started[i] == TRUE)
+		{
+			pthread_join(threads[i], NULL);
+		}
+		else
+		{
+			game_reader_parse_chunk(&chunks[i]);
+		}
+
+		if (chunks[i].status == ERROR)
+		{
+			status = ERROR;
+		}
+	}
+	STATS_STOP(STATS_SLOT_LOAD_PARSE, stats_t);
+
+	STATS_START(stats_t);
+	if (status == OK)
+	{
+		status = game_reader_merge(game, chunks, n_chunks);
+	}
+	STATS_STOP(STATS_SLOT_LOAD_MERGE, stats_t);
+
+	for (i = 0; i < n_chunks; i++)
+	{
+		for (j = 0; j < chunks[i].n_entities; j++)
+		{
+			if (chunks[i].entities[j].entity)
 			{
-				character_set_message(char_p, "");
+				game_reader_destroy_entity(&chunks[i].entities[j]);
 			}
-
-			game_add_character(game, char_p, position);
 		}
+		free(chunks[i].entities);
+		record_close(records[i]);
 	}
+	free(chunks);
+	record_close(record);
 
-	fclose(f);
-	return OK;
+	return status;
 }
 
 Status game_add_player(Game *game, Player *player)
@@ -469,7 +831,7 @@ Status game_add_player(Game *game, Player *player)
 
 	players_array = game_get_players(game);
 	interfaces_array = game_get_interfaces(game);
-	if (players_array == NULL || n_players < 0)
+	if (players_array == NULL || n_players < 0 || n_players >= MAX_PLAYERS)
 	{
 		return ERROR;
 	}
@@ -489,14 +851,16 @@ Status game_add_player(Game *game, Player *player)
 Status game_add_character(Game *game, Character *char_p, Id location)
 {
 	int *n_characters = game_get_n_characters(game);
-	Character **characters_p = game_get_character_array(game);
+	Character **characters_p = NULL;
 	Space *current_space = NULL;
 
-	if (game == NULL || char_p == NULL || *n_characters == MAX_CHARACTERS || *n_characters < 0 || location < 0)
+	if (game == NULL || char_p == NULL || n_characters == NULL || *n_characters < 0 || location < 0 || game_reserve_characters(game, *n_characters + 1) == ERROR)
 	{
 		return ERROR;
 	}
 
+	characters_p = game_get_character_array(game);
+
 	characters_p[*n_characters] = char_p;
 	(*n_characters)++;
 	current_space = game_get_space(game, location);
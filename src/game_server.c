@@ -0,0 +1,120 @@
+/**
+ * @brief It runs the game server
+ *
+ * Loads a world and serves its players over a local TCP port or a Unix
+ * socket (see server.h), in one game or in several sessions of the world,
+ * until every game is finished or the server is stopped with SIGINT or
+ * SIGTERM.
+ *
+ * @file game_server.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "graphic_engine.h"
+#include "server.h"
+#include "stats.h"
+
+/**
+ * @brief Set by SIGINT and SIGTERM to stop the server
+ */
+static volatile sig_atomic_t server_stop = 0;
+
+/**
+ * @brief Stops the server at the end of the current event
+ */
+static void server_handle_signal(int sig)
+{
+	(void)sig;
+	server_stop = 1;
+}
+
+/**
+ * @brief Main function of the server.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The world file, the address and optionally "-m megabytes" to page the world and "-s sessions" to play it in sessions.
+ * @return 0 if the server ran successfully, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	Game *game = NULL;
+	Graphic_engine *gengine = NULL;
+	Server *server = NULL;
+	long budget = 0;
+	int listen_fd = -1, result = 0, n_sessions = 0, i;
+
+	if (argc < 3)
+	{
+		fprintf(stderr, "Use: %s <game_data_file> <port | unix:path> [-m megabytes] [-s sessions]\n", argv[0]);
+		return 1;
+	}
+
+	for (i = 3; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "-m") == 0)
+		{
+			budget = atol(argv[i + 1]) * 1024 * 1024;
+		}
+		else if (strcmp(argv[i], "-s") == 0)
+		{
+			n_sessions = atoi(argv[i + 1]);
+		}
+	}
+
+	srand(time(NULL));
+	if ((budget > 0 ? game_create_paged(&game, argv[1], budget) : game_create_from_file(&game, argv[1])) == ERROR)
+	{
+		fprintf(stderr, "Error while initializing game.\n");
+		game_destroy(game);
+		return 1;
+	}
+
+	if ((gengine = graphic_engine_create()) == NULL || (listen_fd = server_listen(argv[2])) < 0 ||
+		(server = server_create(game, gengine, listen_fd, n_sessions)) == NULL)
+	{
+		fprintf(stderr, "Error while initializing server.\n");
+		if (listen_fd >= 0)
+		{
+			close(listen_fd);
+		}
+		graphic_engine_destroy(gengine);
+		game_destroy(game);
+		return 1;
+	}
+
+	/* A client that goes away makes write fail instead of killing the server */
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, server_handle_signal);
+	signal(SIGTERM, server_handle_signal);
+	while (server_is_finished(server) == FALSE && !server_stop)
+	{
+		if (server_poll(server, -1) < 0)
+		{
+			result = 1;
+			break;
+		}
+	}
+
+	server_destroy(server);
+	close(listen_fd);
+	if (strncmp(argv[2], "unix:", 5) == 0)
+	{
+		unlink(argv[2] + 5);
+	}
+	graphic_engine_destroy(gengine);
+	game_destroy(game);
+	stats_print(stdout);
+	return result;
+}
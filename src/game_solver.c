@@ -0,0 +1,84 @@
+/**
+ * @brief It checks that a world can be solved before it is shipped
+ *
+ * Loads a world file and prints, for every player, the shortest commands
+ * that take it to the goal space, and for every object the shortest ones
+ * that take it, or that it cannot be reached. The exit status is 0 only
+ * when every goal is reached, so it can check generated worlds in a script.
+ *
+ * @file game_solver.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "game.h"
+#include "solver.h"
+#include "stats.h"
+
+/**
+ * @brief States explored for each player before giving up, if none is given
+ */
+#define SOLVER_MAX_STATES 10000000L
+
+int main(int argc, char *argv[])
+{
+	Game *game = NULL;
+	Solver *solver = NULL;
+	Id goal = SOLVER_GOAL_SPACE;
+	long max_states = SOLVER_MAX_STATES;
+	unsigned long t;
+	int missing;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Use: %s <game_data_file> [goal_space] [max_states]\n", argv[0]);
+		return 1;
+	}
+	if (argc > 2)
+	{
+		goal = atol(argv[2]);
+	}
+	if (argc > 3)
+	{
+		max_states = atol(argv[3]);
+	}
+
+	if (game_create_from_file(&game, argv[1]) == ERROR)
+	{
+		fprintf(stderr, "Error while loading %s.\n", argv[1]);
+		return 1;
+	}
+	if (!game_get_space(game, goal))
+	{
+		fprintf(stderr, "Error: %s has no space %ld.\n", argv[1], goal);
+		game_destroy(game);
+		return 1;
+	}
+	if (!(solver = solver_create(game, goal, max_states)))
+	{
+		fprintf(stderr, "Error while creating the solver.\n");
+		game_destroy(game);
+		return 1;
+	}
+
+	t = stats_now();
+	if (solver_run(solver) == ERROR)
+	{
+		fprintf(stderr, "Error while searching %s.\n", argv[1]);
+		solver_destroy(solver);
+		game_destroy(game);
+		return 1;
+	}
+	t = stats_now() - t;
+
+	missing = solver_print(stdout, solver);
+	printf("searched in %.3f s\n", t / 1e9);
+	solver_destroy(solver);
+	game_destroy(game);
+
+	return missing ? 1 : 0;
+}
@@ -0,0 +1,284 @@
+/**
+ * @brief It tests the game module
+ *
+ * @file game_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "command.h"
+#include "game.h"
+#include "game_actions.h"
+#include "game_reader.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 7
+
+/**
+ * @brief Spaces added to the anthill to grow the index of the spaces
+ */
+#define MANY_SPACES 1000
+
+/**
+ * @brief Test that every space is found by its id.
+ */
+void test1_game_get_space();
+
+/**
+ * @brief Test that the spaces added after the world was loaded are found.
+ */
+void test2_game_get_space();
+
+/**
+ * @brief Test that the spaces moved and removed outside of the game are found after game_refresh.
+ */
+void test3_game_get_space();
+
+/**
+ * @brief Test that a character is found after it moves, also when it is moved outside of the game.
+ */
+void test1_game_find_character();
+
+/**
+ * @brief Test that two sessions played in turns without game_enter keep apart, and game_enter gives back each one.
+ */
+void test1_game_enter();
+
+/**
+ * @brief Test that a shadow is made of the state of its own session.
+ */
+void test2_game_enter();
+
+/**
+ * @brief Test that a dead player cannot attack, and is told so.
+ */
+void test1_game_attack();
+
+/**
+ * @brief Main function for game unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Game:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_game_get_space();
+	if (all || test == 2)
+		test2_game_get_space();
+	if (all || test == 3)
+		test3_game_get_space();
+	if (all || test == 4)
+		test1_game_find_character();
+	if (all || test == 5)
+		test1_game_enter();
+	if (all || test == 6)
+		test2_game_enter();
+	if (all || test == 7)
+		test1_game_attack();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+void test1_game_get_space()
+{
+	Game *game = NULL;
+	Bool found = TRUE;
+	int i;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	for (i = 0; i < *game_get_n_spaces(game); i++)
+	{
+		if (game_get_space(game, game_get_space_id_at(game, i)) != game_get_spaces(game)[i])
+		{
+			found = FALSE;
+		}
+	}
+	PRINT_TEST_RESULT(found == TRUE && *game_get_n_spaces(game) == 10 && game_get_space(game, 99) == NULL && game_get_space(game, NO_ID) == NULL);
+	game_destroy(game);
+}
+
+void test2_game_get_space()
+{
+	Game *game = NULL;
+	Space *space = NULL;
+	Bool found = TRUE;
+	int i;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	for (i = 0; i < MANY_SPACES; i++)
+	{
+		game_add_space(game, space_create(1000 + i));
+		/* Looked up as it grows, so the index is extended and built again */
+		if (game_get_space(game, 1000 + i / 2) == NULL)
+		{
+			found = FALSE;
+		}
+	}
+	for (i = 0; i < MANY_SPACES; i++)
+	{
+		if (!(space = game_get_space(game, 1000 + i)) || space_get_id(space) != 1000 + i)
+		{
+			found = FALSE;
+		}
+	}
+	PRINT_TEST_RESULT(found == TRUE && space_get_id(game_get_space(game, 11)) == 11 && game_get_space(game, 1000 + MANY_SPACES) == NULL);
+	game_destroy(game);
+}
+
+void test3_game_get_space()
+{
+	Game *game = NULL;
+	Space **spaces = NULL, *removed = NULL;
+	int *n_spaces = NULL, i;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	spaces = game_get_spaces(game);
+	n_spaces = game_get_n_spaces(game);
+	game_get_space(game, 14);
+	/* The first space is taken out and the others move down, as a reload does */
+	removed = spaces[0];
+	for (i = 1; i < *n_spaces; i++)
+	{
+		spaces[i - 1] = spaces[i];
+	}
+	(*n_spaces)--;
+	space_destroy(removed);
+	game_refresh(game);
+	PRINT_TEST_RESULT(game_get_space(game, 11) == NULL && game_get_space(game, 14) == spaces[*n_spaces - 1] && game_get_space(game, 121) == spaces[0]);
+	game_destroy(game);
+}
+
+void test1_game_find_character()
+{
+	Game *game = NULL;
+	Character *spider = NULL;
+	Id before, moved, outside;
+	int i;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	for (i = 0; i < *game_get_n_characters(game); i++)
+	{
+		if (character_get_id(game_get_character_array(game)[i]) == 3)
+		{
+			spider = game_get_character_array(game)[i];
+		}
+	}
+	before = game_find_character(game, 3);
+	game_change_character_location(game, spider, 124);
+	moved = game_find_character(game, 3);
+	/* Moved without the game, the space where it was last found no longer has it */
+	space_del_character(game_get_space(game, 124), spider);
+	space_add_character(game_get_space(game, 13), spider);
+	outside = game_find_character(game, 3);
+	PRINT_TEST_RESULT(spider != NULL && before == 123 && moved == 124 && outside == 13 && game_find_character(game, 3) == 13 &&
+					  game_find_character(game, 99) == NO_ID && game_find_character(NULL, 3) == NO_ID);
+	game_destroy(game);
+}
+
+/**
+ * @brief It runs a command line of the active player
+ */
+static Status play(Game *game, const char *line)
+{
+	char input[WORD_SIZE];
+
+	strcpy(input, line);
+	game_set_turn(game, 0);
+	command_parse_input(game_get_last_command(game), input);
+	return game_actions_update(game, game_get_last_command(game));
+}
+
+void test1_game_enter()
+{
+	Game *world = NULL, *first = NULL, *second = NULL;
+	Player *ant = NULL;
+	unsigned long first_hash, second_hash;
+	Bool first_ok, second_ok;
+
+	game_create_from_file(&world, "resources/anthill.dat");
+	game_create_session(&first, world);
+	game_create_session(&second, world);
+	ant = game_get_player_at(world, 0);
+
+	play(first, "t Grain");
+	play(second, "m s");
+	play(first, "m s");
+	play(second, "m s");
+	first_hash = game_get_hash(first);
+	second_hash = game_get_hash(second);
+
+	game_enter(first);
+	first_ok = player_get_location(ant) == 121 && player_has_object(ant, 21) == TRUE && game_compute_hash(first) == first_hash ? TRUE : FALSE;
+	game_enter(second);
+	second_ok = player_get_location(ant) == 122 && player_has_object(ant, 21) == FALSE && game_compute_hash(second) == second_hash ? TRUE : FALSE;
+	PRINT_TEST_RESULT(first_ok == TRUE && second_ok == TRUE && first_hash != second_hash && game_get_n_undo(first) == 2 && game_get_n_undo(second) == 2);
+	game_destroy(first);
+	game_destroy(second);
+	game_destroy(world);
+}
+
+void test2_game_enter()
+{
+	Game *world = NULL, *first = NULL, *second = NULL, *shadow = NULL;
+	Id location;
+
+	game_create_from_file(&world, "resources/anthill.dat");
+	game_create_session(&first, world);
+	game_create_session(&second, world);
+	play(second, "m s");
+	shadow = game_create_shadow(first, 0);
+	location = player_get_location(game_get_player_at(shadow, 0));
+	game_merge_shadow(first, shadow);
+	game_enter(second);
+	PRINT_TEST_RESULT(location == 11 && player_get_location(game_get_player_at(second, 0)) == 121);
+	game_destroy(first);
+	game_destroy(second);
+	game_destroy(world);
+}
+
+void test1_game_attack()
+{
+	Game *game = NULL;
+	Status status;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	game_set_player_location(game, 123);
+	game_set_player_health(game, 0, 0);
+	status = play(game, "a");
+	PRINT_TEST_RESULT(status == ERROR && strcmp(game_get_temporal_feedback(game), "Player is dead") == 0 &&
+					  character_get_health(space_get_occupant_at(game_get_space(game, 123), FALSE, 0)) == 10 && game_get_n_undo(game) == 0);
+	game_destroy(game);
+}
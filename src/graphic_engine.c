@@ -18,6 +18,7 @@
 #include "space.h"
 #include "types.h"
 #include "game.h"
+#include "stats.h"
 
 /**
  * @brief Defines map width
@@ -135,8 +136,10 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 	Id obj_id;
 	Object *current_obj;
 	Space *space = NULL;
-	
+	unsigned long stats_t = 0;
 
+	STATS_START(stats_t);
+	game_enter(game);
 	screen_area_clear(ge->map);
 
 	for (i = 0; i < game_get_n_players(game); i++)
@@ -190,7 +193,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		characters = game_get_character_array(game);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_back)
 				{
@@ -258,7 +261,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		characters = game_get_character_array(game);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_act)
 				{
@@ -510,7 +513,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		characters = game_get_character_array(game);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_left)
 				{
@@ -525,7 +528,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		space = game_get_space(game, id_act);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_act)
 				{
@@ -540,7 +543,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		space = game_get_space(game, id_right);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_right)
 				{
@@ -696,7 +699,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		characters = game_get_character_array(game);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_act)
 				{
@@ -711,7 +714,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		space = game_get_space(game, id_left);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_left)
 				{
@@ -821,7 +824,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		characters = game_get_character_array(game);
 		if (space && space_is_discovered(space) == TRUE)
 		{
-			for (i = 0; i < MAX_CHARACTERS; i++)
+			for (i = 0; i < *game_get_n_characters(game); i++)
 			{
 				if (game_find_character(game, character_get_id(characters[i])) == id_next)
 				{
@@ -922,7 +925,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 	sprintf(str, "  Objects:");
 	screen_area_puts(ge->descript, str);
 
-	for (i = 0; i < MAX_OBJECTS; i++)
+	for (i = 0; i < game_n_objects; i++)
 	{
 
 		obj_loc = game_get_object_location(game, i);
@@ -970,7 +973,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 	screen_area_clear(ge->help);
 	sprintf(str, " The commands you can use are:");
 	screen_area_puts(ge->help, str);
-	sprintf(str, " move or m (north or n, south or s, east or e, west or w), take or t, drop or d, attack or a, exit or e, chat or c,       inspect or i, recruit or r, abandon or ab");
+	sprintf(str, " move or m (north or n, south or s, east or e, west or w), take or t, drop or d, attack or a, exit or e, chat or c,       inspect or i, recruit or r, abandon or ab, stats or st, undo or u");
 	screen_area_puts(ge->help, str);
 
 	screen_area_clear(ge->feedback);
@@ -1005,7 +1008,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		characters = game_get_character_array(game);
 		player_location = game_get_player_location(game);
 
-		for (i = 0; i < MAX_CHARACTERS; i++)
+		for (i = 0; i < *game_get_n_characters(game); i++)
 		{
 			if (characters[i] != NULL && game_find_character(game, character_get_id(characters[i])) == player_location)
 			{
@@ -1025,7 +1028,12 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game)
 		sprintf(str, " Description: %s", message);
 		screen_area_puts(ge->feedback, str);
 	}
+	else if (message && last_cmd == STATS)
+	{
+		sprintf(str, " %.*s", (int)sizeof(str) - 2, message);
+		screen_area_puts(ge->feedback, str);
+	}
 
 	screen_paint(game_get_turn(game));
-	printf("prompt:> ");
+	STATS_STOP(STATS_SLOT_PAINT, stats_t);
 }
\ No newline at end of file
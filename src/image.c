@@ -0,0 +1,1292 @@
+/**
+ * @brief It implements the compiled images of the world files
+ *
+ * @file image.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "image.h"
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game_reader.h"
+#include "record.h"
+
+/**
+ * @brief First bytes of an image file, the last digits are the version
+ */
+static const char image_magic[8] = "AHIMG01";
+
+/**
+ * @brief Tags of the records of each kind, in the order of ImageKind
+ */
+static char *image_tags[IMAGE_KINDS] = {"#s:", "#l:", "#o:", "#p:", "#c:"};
+
+/**
+ * @brief Names of the kinds, used in the errors
+ */
+static char *image_kind_names[IMAGE_KINDS] = {"space", "link", "object", "player", "character"};
+
+/**
+ * @brief Header of an image file
+ *
+ * It is followed by the spaces, links, objects, players, characters and
+ * names, then by the adjacency and the reachability, and last by the strings.
+ */
+typedef struct
+{
+	char magic[8];			/*!< image_magic */
+	long size;				/*!< Size of the whole image */
+	unsigned long checksum; /*!< Checksum of everything after the header */
+	long n[IMAGE_KINDS];	/*!< Number of entities of each kind */
+	long n_names;			/*!< Number of ImageName */
+	long n_strings;			/*!< Size of the strings, each one ended by '\0' */
+} ImageHeader;
+
+/**
+ * @brief A space of an image
+ */
+typedef struct
+{
+	Id id;					/*!< Id of the space */
+	long name;				/*!< Offset of its name in the strings */
+	long gdesc[GDESC_ROWS]; /*!< Offsets of the rows of its graphic description */
+	int first_link;			/*!< Position in the adjacency of its first link */
+	int n_links;			/*!< Number of links that leave it */
+} ImageSpace;
+
+/**
+ * @brief A link of an image
+ */
+typedef struct
+{
+	Id id;			 /*!< Id of the link */
+	long name;		 /*!< Offset of its name */
+	int origin;		 /*!< Slot of its origin space */
+	int destination; /*!< Slot of its destination space */
+	int direction;	 /*!< Direction it leaves its origin */
+	int open;		 /*!< Whether it is open */
+} ImageLink;
+
+/**
+ * @brief An object of an image
+ */
+typedef struct
+{
+	Id id;		  /*!< Id of the object */
+	long name;	  /*!< Offset of its name */
+	int location; /*!< Slot of its space */
+} ImageObject;
+
+/**
+ * @brief A player of an image
+ */
+typedef struct
+{
+	Id id;		  /*!< Id of the player */
+	long name;	  /*!< Offset of its name */
+	long gdesc;	  /*!< Offset of its graphic description */
+	int location; /*!< Slot of its space */
+	int health;	  /*!< Its health points */
+	int backpack; /*!< Size of its inventory */
+} ImagePlayer;
+
+/**
+ * @brief A character of an image
+ */
+typedef struct
+{
+	Id id;		  /*!< Id of the character */
+	long name;	  /*!< Offset of its name */
+	long gdesc;	  /*!< Offset of its graphic description */
+	long message; /*!< Offset of its message */
+	int location; /*!< Slot of its space */
+	int health;	  /*!< Its health */
+	int friendly; /*!< Whether it is friendly */
+} ImageCharacter;
+
+/**
+ * @brief An entry of the index of the names, sorted by name without case, kind and slot
+ */
+typedef struct
+{
+	long name; /*!< Offset of the name */
+	int kind;  /*!< IMAGE_OBJECT or IMAGE_CHARACTER */
+	int slot;  /*!< Slot of the entity */
+} ImageName;
+
+/**
+ * @brief Private implementation of the image
+ */
+struct _Image
+{
+	char *data;					/*!< The whole file */
+	ImageHeader *header;		/*!< Its header, at the start of data */
+	ImageSpace *spaces;			/*!< Spaces, in the order of the file */
+	ImageLink *links;			/*!< Links, in the order of the file */
+	ImageObject *objects;		/*!< Objects, in the order of the file */
+	ImagePlayer *players;		/*!< Players, in the order of the file */
+	ImageCharacter *characters; /*!< Characters, in the order of the file */
+	ImageName *names;			/*!< Index of the names */
+	int *adjacency;				/*!< Slots of the links sorted by the id of their origin, direction and slot */
+	Bool *reachable;			/*!< Whether each space can be reached */
+	char *strings;				/*!< Every string of the world */
+};
+
+/**
+ * @brief An entity parsed by the compiler
+ */
+typedef struct
+{
+	void *entity; /*!< The entity */
+	int line;	  /*!< Line of its record */
+	Id location;  /*!< Location of players and characters */
+	int backpack; /*!< Size of the inventory of players */
+} ImageSource;
+
+/**
+ * @brief An entity found by its id
+ */
+typedef struct
+{
+	Id id;	  /*!< Id of the entity */
+	int slot; /*!< Its slot */
+} ImageEntry;
+
+/**
+ * @brief An entry of the index of the names while it is sorted
+ */
+typedef struct
+{
+	const char *text; /*!< The name */
+	ImageName name;	  /*!< The entry written */
+} ImageSortName;
+
+/**
+ * @brief State of a compilation
+ */
+typedef struct
+{
+	char *world;					   /*!< Name of the world file */
+	ImageSource *sources[IMAGE_KINDS]; /*!< Entities parsed of each kind */
+	int n[IMAGE_KINDS];				   /*!< Number of them */
+	int max[IMAGE_KINDS];			   /*!< Capacity of sources */
+	ImageEntry *index[IMAGE_KINDS];	   /*!< Entities of each kind sorted by id and slot */
+	ImageReport report;				   /*!< What was found */
+	char *strings;					   /*!< Strings of the image */
+	long n_strings;					   /*!< Size of the strings */
+	long max_strings;				   /*!< Capacity of strings */
+} ImageBuild;
+
+/**
+ * @brief Prints an error or a warning of a world file
+ *
+ * @param build The compilation
+ * @param error TRUE for an error, FALSE for a warning
+ * @param line The line of the record, 0 for the whole file
+ * @param format The message, as for printf
+ */
+static void image_complain(ImageBuild *build, Bool error, int line, const char *format, ...)
+{
+	va_list args;
+
+	if (error == TRUE)
+	{
+		build->report.n_errors++;
+	}
+	else
+	{
+		build->report.n_warnings++;
+	}
+
+	if (line > 0)
+	{
+		fprintf(stderr, "%s: %s:%d: ", error == TRUE ? "Error" : "Warning", build->world, line);
+	}
+	else
+	{
+		fprintf(stderr, "%s: %s: ", error == TRUE ? "Error" : "Warning", build->world);
+	}
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fprintf(stderr, ".\n");
+}
+
+/**
+ * @brief Compares two entries by id and slot, for qsort
+ */
+static int image_compare_entries(const void *a, const void *b)
+{
+	const ImageEntry *x = (const ImageEntry *)a, *y = (const ImageEntry *)b;
+
+	if (x->id != y->id)
+	{
+		return x->id < y->id ? -1 : 1;
+	}
+
+	return x->slot - y->slot;
+}
+
+/**
+ * @brief Compares two texts without case
+ */
+static int image_compare_text(const char *a, const char *b)
+{
+	while (*a && tolower((unsigned char)*a) == tolower((unsigned char)*b))
+	{
+		a++;
+		b++;
+	}
+
+	return tolower((unsigned char)*a) - tolower((unsigned char)*b);
+}
+
+/**
+ * @brief Compares two names by text without case, kind and slot, for qsort
+ */
+static int image_compare_names(const void *a, const void *b)
+{
+	const ImageSortName *x = (const ImageSortName *)a, *y = (const ImageSortName *)b;
+	int cmp = image_compare_text(x->text, y->text);
+
+	if (cmp != 0)
+	{
+		return cmp;
+	}
+	if (x->name.kind != y->name.kind)
+	{
+		return x->name.kind - y->name.kind;
+	}
+
+	return x->name.slot - y->name.slot;
+}
+
+/**
+ * @brief Finds the slot of an entity of a kind by its id
+ *
+ * @return The slot of the first one of the file with that id, -1 if there is none
+ */
+static int image_find_slot(ImageBuild *build, ImageKind kind, Id id)
+{
+	ImageEntry *index = build->index[kind];
+	int low = 0, high = build->n[kind], mid;
+
+	while (low < high)
+	{
+		mid = low + (high - low) / 2;
+		if (index[mid].id < id)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return (low < build->n[kind] && index[low].id == id) ? index[low].slot : -1;
+}
+
+/**
+ * @brief Gets the id of an entity parsed
+ */
+static Id image_source_id(ImageKind kind, ImageSource *source)
+{
+	switch (kind)
+	{
+	case IMAGE_SPACE:
+		return space_get_id((Space *)source->entity);
+	case IMAGE_LINK:
+		return link_get_id((Link *)source->entity);
+	case IMAGE_OBJECT:
+		return object_get_id((Object *)source->entity);
+	case IMAGE_PLAYER:
+		return player_get_id((Player *)source->entity);
+	default:
+		return character_get_id((Character *)source->entity);
+	}
+}
+
+/**
+ * @brief Frees an entity parsed
+ */
+static void image_source_destroy(ImageKind kind, ImageSource *source)
+{
+	switch (kind)
+	{
+	case IMAGE_SPACE:
+		space_destroy((Space *)source->entity);
+		break;
+	case IMAGE_LINK:
+		link_destroy((Link *)source->entity);
+		break;
+	case IMAGE_OBJECT:
+		object_destroy((Object *)source->entity);
+		break;
+	case IMAGE_PLAYER:
+		player_destroy((Player *)source->entity);
+		break;
+	default:
+		character_destroy((Character *)source->entity);
+		break;
+	}
+}
+
+/**
+ * @brief Parses the current record of a scanner and keeps its entity, counting it as an error if it is not valid
+ *
+ * @return OK if it was parsed, valid or not, ERROR if there was not enough memory
+ */
+static Status image_parse(ImageBuild *build, Record *record, ImageKind kind)
+{
+	ImageSource *source = NULL, *grown = NULL;
+	Space *space = NULL;
+	Link *link = NULL;
+	Object *object = NULL;
+	Player *player = NULL;
+	Character *character = NULL;
+	Status status;
+
+	if (build->n[kind] == build->max[kind])
+	{
+		if (!(grown = (ImageSource *)realloc(build->sources[kind], (build->max[kind] * 2 + 64) * sizeof(ImageSource))))
+		{
+			return ERROR;
+		}
+		build->sources[kind] = grown;
+		build->max[kind] = build->max[kind] * 2 + 64;
+	}
+
+	source = &build->sources[kind][build->n[kind]];
+	source->line = record_get_line(record);
+	source->location = NO_ID;
+	source->backpack = 0;
+	switch (kind)
+	{
+	case IMAGE_SPACE:
+		status = game_reader_parse_space(record, &space);
+		source->entity = space;
+		break;
+	case IMAGE_LINK:
+		status = game_reader_parse_link(record, &link);
+		source->entity = link;
+		break;
+	case IMAGE_OBJECT:
+		status = game_reader_parse_object(record, &object);
+		source->entity = object;
+		break;
+	case IMAGE_PLAYER:
+		/* The inventory does not tell its size, so it is read again from the record */
+		if ((status = game_reader_parse_player(record, &player, &source->location)) == OK)
+		{
+			record_get_int(record, 5, "player backpack size", 0, INT_MAX, &source->backpack);
+		}
+		source->entity = player;
+		break;
+	default:
+		status = game_reader_parse_character(record, &character, &source->location);
+		source->entity = character;
+		break;
+	}
+
+	if (status == OK)
+	{
+		build->n[kind]++;
+	}
+	else
+	{
+		build->report.n_errors++;
+	}
+	return OK;
+}
+
+/**
+ * @brief Indexes the entities of every kind by id, reporting the ids used twice and the negative ones
+ *
+ * @return OK if they were indexed, ERROR if there was not enough memory
+ */
+static Status image_index(ImageBuild *build)
+{
+	ImageEntry *index = NULL;
+	int kind, i;
+
+	for (kind = 0; kind < IMAGE_KINDS; kind++)
+	{
+		if (!(index = build->index[kind] = (ImageEntry *)malloc((build->n[kind] + 1) * sizeof(ImageEntry))))
+		{
+			return ERROR;
+		}
+		for (i = 0; i < build->n[kind]; i++)
+		{
+			index[i].id = image_source_id((ImageKind)kind, &build->sources[kind][i]);
+			index[i].slot = i;
+			if (index[i].id < 0)
+			{
+				image_complain(build, TRUE, build->sources[kind][i].line, "%s id %ld is negative", image_kind_names[kind], index[i].id);
+			}
+		}
+		qsort(index, build->n[kind], sizeof(ImageEntry), image_compare_entries);
+		for (i = 1; i < build->n[kind]; i++)
+		{
+			if (index[i].id == index[i - 1].id)
+			{
+				image_complain(build, TRUE, build->sources[kind][index[i].slot].line, "%s id %ld is already used at line %d", image_kind_names[kind],
+							   index[i].id, build->sources[kind][index[i - 1].slot].line);
+			}
+		}
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Finds the space an entity refers to, reporting it if it does not exist
+ *
+ * @return The slot of the space, -1 if there is none
+ */
+static int image_resolve(ImageBuild *build, ImageKind kind, int slot, char *what, Id id)
+{
+	int found = image_find_slot(build, IMAGE_SPACE, id);
+
+	if (found < 0)
+	{
+		image_complain(build, TRUE, build->sources[kind][slot].line, "%s of %s %ld is %ld, which is not a space", what, image_kind_names[kind],
+					   image_source_id(kind, &build->sources[kind][slot]), id);
+	}
+
+	return found;
+}
+
+/**
+ * @brief Adds a string to the strings of the image
+ *
+ * @return Its offset, -1 if there was not enough memory
+ */
+static long image_add_string(ImageBuild *build, const char *text)
+{
+	long len, offset;
+	char *grown = NULL;
+
+	text = text ? text : "";
+	len = (long)strlen(text) + 1;
+	if (build->n_strings + len > build->max_strings)
+	{
+		if (!(grown = (char *)realloc(build->strings, build->max_strings * 2 + len + 4096)))
+		{
+			return -1;
+		}
+		build->strings = grown;
+		build->max_strings = build->max_strings * 2 + len + 4096;
+	}
+
+	offset = build->n_strings;
+	memcpy(build->strings + offset, text, len);
+	build->n_strings += len;
+	return offset;
+}
+
+/**
+ * @brief Computes the checksum of a block of bytes
+ */
+static unsigned long image_checksum(const char *data, long size)
+{
+	unsigned long sum = 0xCBF29CE484222325UL;
+	long i;
+
+	for (i = 0; i < size; i++)
+	{
+		sum = (sum ^ (unsigned char)data[i]) * 0x100000001B3UL;
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Gets the offsets of the sections of an image from its counts
+ *
+ * @param header The header, with the counts
+ * @param offsets Where the offsets of the 9 sections and the size of the image are stored
+ */
+static void image_layout(ImageHeader *header, long offsets[10])
+{
+	long sizes[9];
+	int i;
+
+	sizes[0] = header->n[IMAGE_SPACE] * (long)sizeof(ImageSpace);
+	sizes[1] = header->n[IMAGE_LINK] * (long)sizeof(ImageLink);
+	sizes[2] = header->n[IMAGE_OBJECT] * (long)sizeof(ImageObject);
+	sizes[3] = header->n[IMAGE_PLAYER] * (long)sizeof(ImagePlayer);
+	sizes[4] = header->n[IMAGE_CHARACTER] * (long)sizeof(ImageCharacter);
+	sizes[5] = header->n_names * (long)sizeof(ImageName);
+	sizes[6] = header->n[IMAGE_LINK] * (long)sizeof(int);
+	sizes[7] = header->n[IMAGE_SPACE] * (long)sizeof(Bool);
+	sizes[8] = header->n_strings;
+
+	/* The sections with longs come first, and every section is a multiple of the size of a long until the strings */
+	offsets[0] = sizeof(ImageHeader);
+	for (i = 0; i < 9; i++)
+	{
+		offsets[i + 1] = offsets[i] + (sizes[i] + (long)sizeof(long) - 1) / (long)sizeof(long) * (long)sizeof(long);
+	}
+}
+
+/**
+ * @brief Sets the pointers of an image to the sections of its data
+ */
+static void image_point(Image *image, long offsets[10])
+{
+	image->header = (ImageHeader *)image->data;
+	image->spaces = (ImageSpace *)(image->data + offsets[0]);
+	image->links = (ImageLink *)(image->data + offsets[1]);
+	image->objects = (ImageObject *)(image->data + offsets[2]);
+	image->players = (ImagePlayer *)(image->data + offsets[3]);
+	image->characters = (ImageCharacter *)(image->data + offsets[4]);
+	image->names = (ImageName *)(image->data + offsets[5]);
+	image->adjacency = (int *)(image->data + offsets[6]);
+	image->reachable = (Bool *)(image->data + offsets[7]);
+	image->strings = image->data + offsets[8];
+}
+
+/**
+ * @brief Sorts the links by the id of their origin, direction and slot, as game_index_links does
+ *
+ * The first link of each space in each direction is the one the game uses,
+ * the others are reported.
+ *
+ * @return OK if they were sorted, ERROR if there was not enough memory
+ */
+static Status image_adjacency(ImageBuild *build, Image *image)
+{
+	ImageEntry *order = NULL;
+	ImageLink *links = image->links;
+	int n = build->n[IMAGE_LINK], i, k;
+
+	/* The entries are sorted by origin id, direction and slot, packed in the id and the slot */
+	if (!(order = (ImageEntry *)malloc((n + 1) * sizeof(ImageEntry))))
+	{
+		return ERROR;
+	}
+	for (i = 0; i < n; i++)
+	{
+		order[i].id = image->spaces[links[i].origin].id * 4 + links[i].direction;
+		order[i].slot = i;
+	}
+	qsort(order, n, sizeof(ImageEntry), image_compare_entries);
+
+	for (i = 0; i < n; i++)
+	{
+		image->adjacency[i] = order[i].slot;
+		k = links[order[i].slot].origin;
+		if (image->spaces[k].n_links++ == 0)
+		{
+			image->spaces[k].first_link = i;
+		}
+		if (i > 0 && order[i].id == order[i - 1].id)
+		{
+			image_complain(build, FALSE, build->sources[IMAGE_LINK][order[i].slot].line, "link %ld is never used, link %ld leaves space %ld in the same direction",
+						   links[order[i].slot].id, links[order[i - 1].slot].id, image->spaces[k].id);
+		}
+	}
+
+	free(order);
+	return OK;
+}
+
+/**
+ * @brief Marks the spaces that can be reached through open links from where the players start
+ *
+ * @return OK if they were marked, ERROR if there was not enough memory
+ */
+static Status image_reach(ImageBuild *build, Image *image)
+{
+	ImageLink *link = NULL;
+	int *queue = NULL, n_queue = 0, i, j, k;
+
+	if (!(queue = (int *)malloc((build->n[IMAGE_SPACE] + 1) * sizeof(int))))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < build->n[IMAGE_PLAYER]; i++)
+	{
+		k = image->players[i].location;
+		if (image->reachable[k] == FALSE)
+		{
+			image->reachable[k] = TRUE;
+			queue[n_queue++] = k;
+		}
+	}
+
+	/* Breadth first, the queue holds every space once */
+	for (i = 0; i < n_queue; i++)
+	{
+		for (j = 0; j < image->spaces[queue[i]].n_links; j++)
+		{
+			link = &image->links[image->adjacency[image->spaces[queue[i]].first_link + j]];
+			if (link->open == TRUE && image->reachable[link->destination] == FALSE)
+			{
+				image->reachable[link->destination] = TRUE;
+				queue[n_queue++] = link->destination;
+			}
+		}
+	}
+	free(queue);
+
+	for (i = 0; i < build->n[IMAGE_SPACE]; i++)
+	{
+		if (image->reachable[i] == FALSE)
+		{
+			build->report.n_unreachable++;
+			image_complain(build, FALSE, build->sources[IMAGE_SPACE][i].line, "space %ld can not be reached from where the players start",
+						   image->spaces[i].id);
+		}
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Sorts the names of the objects and characters, reporting the names used twice
+ *
+ * @return OK if they were sorted, ERROR if there was not enough memory
+ */
+static Status image_names(ImageBuild *build, Image *image)
+{
+	ImageSortName *sorted = NULL;
+	int kinds[2] = {IMAGE_OBJECT, IMAGE_CHARACTER}, n = 0, i, k, slot;
+
+	if (!(sorted = (ImageSortName *)malloc((image->header->n_names + 1) * sizeof(ImageSortName))))
+	{
+		return ERROR;
+	}
+
+	for (k = 0; k < 2; k++)
+	{
+		for (slot = 0; slot < build->n[kinds[k]]; slot++, n++)
+		{
+			sorted[n].name.name = kinds[k] == IMAGE_OBJECT ? image->objects[slot].name : image->characters[slot].name;
+			sorted[n].name.kind = kinds[k];
+			sorted[n].name.slot = slot;
+			sorted[n].text = build->strings + sorted[n].name.name;
+		}
+	}
+	qsort(sorted, n, sizeof(ImageSortName), image_compare_names);
+
+	for (i = 0; i < n; i++)
+	{
+		image->names[i] = sorted[i].name;
+		if (i > 0 && sorted[i].name.kind == sorted[i - 1].name.kind && image_compare_text(sorted[i].text, sorted[i - 1].text) == 0)
+		{
+			image_complain(build, FALSE, build->sources[sorted[i].name.kind][sorted[i].name.slot].line,
+						   "the %s name %s is also used at line %d, the commands only find the first one", image_kind_names[sorted[i].name.kind],
+						   sorted[i].text, build->sources[sorted[i].name.kind][sorted[i - 1].name.slot].line);
+		}
+	}
+
+	free(sorted);
+	return OK;
+}
+
+/**
+ * @brief Converts the entities parsed into the records of the image, resolving their references
+ *
+ * @return OK if they were converted, ERROR if there was not enough memory
+ */
+static Status image_convert(ImageBuild *build, Image *image)
+{
+	Space *space = NULL;
+	Link *link = NULL;
+	Object *object = NULL;
+	Player *player = NULL;
+	Character *character = NULL;
+	ImageSource *source = NULL;
+	long failed = 0;
+	int i, j;
+
+	for (i = 0; i < build->n[IMAGE_SPACE]; i++)
+	{
+		space = (Space *)build->sources[IMAGE_SPACE][i].entity;
+		image->spaces[i].id = space_get_id(space);
+		failed |= image->spaces[i].name = image_add_string(build, space_get_name(space));
+		for (j = 0; j < GDESC_ROWS; j++)
+		{
+			failed |= image->spaces[i].gdesc[j] = image_add_string(build, space_get_gdesc_at(space, j));
+		}
+		image->spaces[i].first_link = 0;
+		image->spaces[i].n_links = 0;
+		image->reachable[i] = FALSE;
+	}
+
+	for (i = 0; i < build->n[IMAGE_LINK]; i++)
+	{
+		link = (Link *)build->sources[IMAGE_LINK][i].entity;
+		image->links[i].id = link_get_id(link);
+		failed |= image->links[i].name = image_add_string(build, link_get_name(link));
+		image->links[i].origin = image_resolve(build, IMAGE_LINK, i, "the origin", link_get_origin(link));
+		image->links[i].destination = image_resolve(build, IMAGE_LINK, i, "the destination", link_get_destination(link));
+		image->links[i].direction = (int)link_get_direction(link);
+		image->links[i].open = (int)link_get_open(link);
+	}
+
+	for (i = 0; i < build->n[IMAGE_OBJECT]; i++)
+	{
+		object = (Object *)build->sources[IMAGE_OBJECT][i].entity;
+		image->objects[i].id = object_get_id(object);
+		failed |= image->objects[i].name = image_add_string(build, object_get_name(object));
+		image->objects[i].location = image_resolve(build, IMAGE_OBJECT, i, "the location", object_get_location(object));
+	}
+
+	for (i = 0; i < build->n[IMAGE_PLAYER]; i++)
+	{
+		source = &build->sources[IMAGE_PLAYER][i];
+		player = (Player *)source->entity;
+		image->players[i].id = player_get_id(player);
+		failed |= image->players[i].name = image_add_string(build, player_get_name(player));
+		failed |= image->players[i].gdesc = image_add_string(build, player_get_gdesc(player));
+		image->players[i].location = image_resolve(build, IMAGE_PLAYER, i, "the location", source->location);
+		image->players[i].health = player_get_health(player);
+		image->players[i].backpack = source->backpack;
+		if (i == MAX_PLAYERS)
+		{
+			image_complain(build, TRUE, source->line, "a world has at most %d players", MAX_PLAYERS);
+		}
+	}
+	if (build->n[IMAGE_PLAYER] == 0)
+	{
+		image_complain(build, TRUE, 0, "the world has no players");
+	}
+
+	for (i = 0; i < build->n[IMAGE_CHARACTER]; i++)
+	{
+		source = &build->sources[IMAGE_CHARACTER][i];
+		character = (Character *)source->entity;
+		image->characters[i].id = character_get_id(character);
+		failed |= image->characters[i].name = image_add_string(build, character_get_name(character));
+		failed |= image->characters[i].gdesc = image_add_string(build, character_get_gdesc(character));
+		failed |= image->characters[i].message = image_add_string(build, character_get_message(character));
+		image->characters[i].location = image_resolve(build, IMAGE_CHARACTER, i, "the location", source->location);
+		image->characters[i].health = character_get_health(character);
+		image->characters[i].friendly = (int)character_get_friendly(character);
+	}
+
+	return failed < 0 ? ERROR : OK;
+}
+
+/**
+ * @brief Reads every record of a world file
+ *
+ * @return OK if the file was read, ERROR if it could not be read or there was not enough memory
+ */
+static Status image_read_world(ImageBuild *build)
+{
+	Record *record = NULL;
+	int kind = 0, n_fields;
+	Status status = OK;
+
+	if (!(record = record_open(build->world)))
+	{
+		image_complain(build, TRUE, 0, "the file can not be read");
+		return ERROR;
+	}
+
+	/* Every record is checked, so all the errors of the file are reported at once */
+	while (status == OK && (n_fields = record_next_of(record, image_tags, IMAGE_KINDS, &kind)) != 0)
+	{
+		if (n_fields < 0)
+		{
+			build->report.n_errors++;
+		}
+		else
+		{
+			status = image_parse(build, record, (ImageKind)kind);
+		}
+	}
+
+	record_close(record);
+	return status;
+}
+
+/**
+ * @brief Writes an image to its file
+ */
+static Status image_write(Image *image, char *filename)
+{
+	FILE *f = NULL;
+	Status status = OK;
+
+	if (!(f = fopen(filename, "wb")))
+	{
+		return ERROR;
+	}
+
+	if (fwrite(image->data, 1, image->header->size, f) != (size_t)image->header->size)
+	{
+		status = ERROR;
+	}
+	if (fclose(f) != 0)
+	{
+		status = ERROR;
+	}
+	if (status == ERROR)
+	{
+		remove(filename);
+	}
+
+	return status;
+}
+
+Status image_compile(char *world, char *image_file, ImageReport *report)
+{
+	ImageBuild build;
+	ImageHeader header;
+	Image image;
+	long offsets[10];
+	int kind, i;
+	Status status = OK;
+
+	if (!world || !image_file)
+	{
+		return ERROR;
+	}
+
+	memset(&build, 0, sizeof(ImageBuild));
+	memset(&image, 0, sizeof(Image));
+	build.world = world;
+	if (image_read_world(&build) == ERROR || image_index(&build) == ERROR)
+	{
+		status = ERROR;
+	}
+
+	/* The strings are added while the records are converted, so the records are built apart and copied into the image at the end */
+	if (status == OK)
+	{
+		memset(&header, 0, sizeof(ImageHeader));
+		for (kind = 0; kind < IMAGE_KINDS; kind++)
+		{
+			header.n[kind] = build.n[kind];
+		}
+		header.n_names = build.n[IMAGE_OBJECT] + build.n[IMAGE_CHARACTER];
+		image_layout(&header, offsets);
+		if (!(image.data = (char *)calloc(1, offsets[8])))
+		{
+			status = ERROR;
+		}
+	}
+	if (status == OK)
+	{
+		image_point(&image, offsets);
+		*image.header = header;
+		status = image_convert(&build, &image);
+	}
+	if (status == OK && build.report.n_errors == 0)
+	{
+		status = (image_adjacency(&build, &image) == OK && image_reach(&build, &image) == OK && image_names(&build, &image) == OK) ? OK : ERROR;
+	}
+
+	/* Without errors the strings go at the end and the image is written */
+	if (status == OK && build.report.n_errors == 0)
+	{
+		header = *image.header;
+		header.n_strings = build.n_strings;
+		image_layout(&header, offsets);
+		if (!(image.data = (char *)realloc(image.data, offsets[9])))
+		{
+			status = ERROR;
+		}
+		else
+		{
+			image_point(&image, offsets);
+			memcpy(image.strings, build.strings, build.n_strings);
+			memset(image.strings + build.n_strings, 0, offsets[9] - offsets[8] - build.n_strings);
+			memcpy(image.header->magic, image_magic, sizeof(image_magic));
+			image.header->n_strings = build.n_strings;
+			image.header->size = offsets[9];
+			image.header->checksum = image_checksum(image.data + sizeof(ImageHeader), offsets[9] - (long)sizeof(ImageHeader));
+			if ((status = image_write(&image, image_file)) == OK)
+			{
+				build.report.size = offsets[9];
+			}
+		}
+	}
+
+	for (kind = 0; kind < IMAGE_KINDS; kind++)
+	{
+		build.report.n[kind] = build.n[kind];
+		for (i = 0; i < build.n[kind]; i++)
+		{
+			image_source_destroy((ImageKind)kind, &build.sources[kind][i]);
+		}
+		free(build.sources[kind]);
+		free(build.index[kind]);
+	}
+	free(build.strings);
+	free(image.data);
+
+	if (report)
+	{
+		*report = build.report;
+	}
+	return (status == OK && build.report.n_errors == 0) ? OK : ERROR;
+}
+
+Bool image_check(char *filename)
+{
+	char magic[sizeof(image_magic)];
+	FILE *f = NULL;
+	Bool is_image = FALSE;
+
+	if (!filename || !(f = fopen(filename, "rb")))
+	{
+		return FALSE;
+	}
+
+	if (fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, image_magic, sizeof(magic)) == 0)
+	{
+		is_image = TRUE;
+	}
+	fclose(f);
+	return is_image;
+}
+
+/**
+ * @brief Tells whether an offset is a string of the image no longer than a maximum
+ */
+static Bool image_string_ok(Image *image, long offset, long max_len)
+{
+	long left = image->header->n_strings - offset;
+
+	return (offset >= 0 && left > 0 && memchr(image->strings + offset, '\0', left < max_len + 1 ? left : max_len + 1) != NULL) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Tells whether a slot is a space of the image
+ */
+static Bool image_slot_ok(Image *image, int slot)
+{
+	return (slot >= 0 && slot < image->header->n[IMAGE_SPACE]) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Checks that every reference of an image is inside it, so it can be loaded without checking anything
+ *
+ * @return OK if it is consistent, ERROR otherwise
+ */
+static Status image_validate(Image *image)
+{
+	ImageHeader *header = image->header;
+	long n_links = header->n[IMAGE_LINK];
+	int i, j;
+
+	for (i = 0; i < header->n[IMAGE_SPACE]; i++)
+	{
+		if (image_string_ok(image, image->spaces[i].name, WORD_SIZE) == FALSE || image->spaces[i].first_link < 0 || image->spaces[i].n_links < 0 ||
+			image->spaces[i].first_link + (long)image->spaces[i].n_links > n_links)
+		{
+			return ERROR;
+		}
+		for (j = 0; j < GDESC_ROWS; j++)
+		{
+			if (image_string_ok(image, image->spaces[i].gdesc[j], GDESC_COLS) == FALSE)
+			{
+				return ERROR;
+			}
+		}
+	}
+
+	for (i = 0; i < n_links; i++)
+	{
+		if (image_string_ok(image, image->links[i].name, WORD_SIZE) == FALSE || image_slot_ok(image, image->links[i].origin) == FALSE ||
+			image_slot_ok(image, image->links[i].destination) == FALSE || image->links[i].direction < N || image->links[i].direction > W ||
+			(image->links[i].open != FALSE && image->links[i].open != TRUE) || image->adjacency[i] < 0 || image->adjacency[i] >= n_links)
+		{
+			return ERROR;
+		}
+	}
+
+	for (i = 0; i < header->n[IMAGE_OBJECT]; i++)
+	{
+		if (image_string_ok(image, image->objects[i].name, WORD_SIZE) == FALSE || image_slot_ok(image, image->objects[i].location) == FALSE)
+		{
+			return ERROR;
+		}
+	}
+
+	if (header->n[IMAGE_PLAYER] > MAX_PLAYERS)
+	{
+		return ERROR;
+	}
+	for (i = 0; i < header->n[IMAGE_PLAYER]; i++)
+	{
+		if (image_string_ok(image, image->players[i].name, WORD_SIZE) == FALSE ||
+			image_string_ok(image, image->players[i].gdesc, PLAYER_GDESC_COLUMS) == FALSE ||
+			image_slot_ok(image, image->players[i].location) == FALSE || image->players[i].health < 0 || image->players[i].backpack < 0)
+		{
+			return ERROR;
+		}
+	}
+
+	for (i = 0; i < header->n[IMAGE_CHARACTER]; i++)
+	{
+		if (image_string_ok(image, image->characters[i].name, WORD_SIZE) == FALSE ||
+			image_string_ok(image, image->characters[i].gdesc, GDESC_SIZE - 1) == FALSE ||
+			image_string_ok(image, image->characters[i].message, MESSAGE_SIZE) == FALSE ||
+			image_slot_ok(image, image->characters[i].location) == FALSE ||
+			(image->characters[i].friendly != FALSE && image->characters[i].friendly != TRUE))
+		{
+			return ERROR;
+		}
+	}
+
+	for (i = 0; i < header->n_names; i++)
+	{
+		if (image_string_ok(image, image->names[i].name, WORD_SIZE) == FALSE ||
+			(image->names[i].kind != IMAGE_OBJECT && image->names[i].kind != IMAGE_CHARACTER) || image->names[i].slot < 0 ||
+			image->names[i].slot >= header->n[image->names[i].kind])
+		{
+			return ERROR;
+		}
+	}
+
+	return OK;
+}
+
+Image *image_open(char *filename)
+{
+	Image *image = NULL;
+	ImageHeader header;
+	FILE *f = NULL;
+	long offsets[10], size;
+	int kind;
+	Status status = OK;
+
+	if (!filename || !(f = fopen(filename, "rb")))
+	{
+		return NULL;
+	}
+
+	/* The counts give the size of every section, which must add up to the size of the file */
+	if (fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < (long)sizeof(ImageHeader) || fseek(f, 0, SEEK_SET) != 0 ||
+		fread(&header, sizeof(ImageHeader), 1, f) != 1 || memcmp(header.magic, image_magic, sizeof(image_magic)) != 0 || header.size != size ||
+		header.n_names < 0 || header.n_names > size || header.n_strings < 0 || header.n_strings > size)
+	{
+		status = ERROR;
+	}
+	for (kind = 0; status == OK && kind < IMAGE_KINDS; kind++)
+	{
+		if (header.n[kind] < 0 || header.n[kind] > size)
+		{
+			status = ERROR;
+		}
+	}
+	if (status == OK)
+	{
+		image_layout(&header, offsets);
+	}
+	if (status == ERROR || offsets[9] != size || !(image = (Image *)calloc(1, sizeof(Image))) || !(image->data = (char *)malloc(size)))
+	{
+		fclose(f);
+		image_close(image);
+		return NULL;
+	}
+
+	memcpy(image->data, &header, sizeof(ImageHeader));
+	if (fread(image->data + sizeof(ImageHeader), 1, size - sizeof(ImageHeader), f) != (size_t)(size - sizeof(ImageHeader)))
+	{
+		status = ERROR;
+	}
+	fclose(f);
+
+	image_point(image, offsets);
+	if (status == ERROR || image->header->checksum != image_checksum(image->data + sizeof(ImageHeader), size - (long)sizeof(ImageHeader)) ||
+		image_validate(image) == ERROR)
+	{
+		image_close(image);
+		return NULL;
+	}
+
+	return image;
+}
+
+void image_close(Image *image)
+{
+	if (!image)
+	{
+		return;
+	}
+
+	free(image->data);
+	free(image);
+}
+
+Status image_load(Image *image, Game *game)
+{
+	ImageHeader *header = NULL;
+	Space *space = NULL, **spaces = NULL;
+	Link *link = NULL;
+	Object *object = NULL;
+	Player *player = NULL;
+	Inventory *inventory = NULL;
+	Character *character = NULL, **characters = NULL;
+	int *n_characters = NULL, i, j;
+	char gdesc[PLAYER_GDESC_COLUMS + 1];
+
+	if (!image || !game || game_get_regions(game) || *game_get_n_spaces(game) != 0 || *game_get_n_links(game) != 0 ||
+		*game_get_n_objects(game) != 0 || *game_get_n_characters(game) != 0 || game_get_n_players(game) != 0)
+	{
+		return ERROR;
+	}
+
+	header = image->header;
+	if (game_reserve_spaces(game, header->n[IMAGE_SPACE]) == ERROR || game_reserve_links(game, header->n[IMAGE_LINK]) == ERROR ||
+		game_reserve_objects(game, header->n[IMAGE_OBJECT]) == ERROR || game_reserve_characters(game, header->n[IMAGE_CHARACTER]) == ERROR)
+	{
+		return ERROR;
+	}
+
+	/* The kinds are added in the order of game_load_world, and every slot is the position of its entity in the game */
+	for (i = 0; i < header->n[IMAGE_SPACE]; i++)
+	{
+		if (!(space = space_create(image->spaces[i].id)) || game_add_space(game, space) == ERROR)
+		{
+			space_destroy(space);
+			return ERROR;
+		}
+		space_set_name(space, image->strings + image->spaces[i].name);
+		for (j = 0; j < GDESC_ROWS; j++)
+		{
+			space_set_gdesc_at(space, image->strings + image->spaces[i].gdesc[j], j);
+		}
+	}
+	spaces = game_get_spaces(game);
+
+	for (i = 0; i < header->n[IMAGE_PLAYER]; i++)
+	{
+		if (!(player = player_create(image->players[i].id)) || !(inventory = inventory_create(image->players[i].backpack)))
+		{
+			player_destroy(player);
+			return ERROR;
+		}
+		/* player_set_gdesc pads its argument, so it gets its own buffer */
+		strcpy(gdesc, image->strings + image->players[i].gdesc);
+		player_set_name(player, image->strings + image->players[i].name);
+		player_set_gdesc(player, gdesc);
+		player_set_location(player, image->spaces[image->players[i].location].id);
+		player_set_health(player, image->players[i].health);
+		player_set_inventory(player, inventory);
+		if (game_add_player(game, player) == ERROR)
+		{
+			if (game_get_n_players(game) <= i)
+			{
+				player_destroy(player);
+			}
+			return ERROR;
+		}
+		space_set_discovered(spaces[image->players[i].location], TRUE);
+	}
+
+	for (i = 0; i < header->n[IMAGE_OBJECT]; i++)
+	{
+		if (!(object = object_create(image->objects[i].id)) || game_add_objects(game, object) == ERROR)
+		{
+			object_destroy(object);
+			return ERROR;
+		}
+		object_set_name(object, image->strings + image->objects[i].name);
+		object_set_location(object, image->spaces[image->objects[i].location].id);
+	}
+
+	for (i = 0; i < header->n[IMAGE_LINK]; i++)
+	{
+		if (!(link = link_create(image->links[i].id)) || game_add_link(game, link) == ERROR)
+		{
+			link_destroy(link);
+			return ERROR;
+		}
+		link_set_name(link, image->strings + image->links[i].name);
+		link_set_origin(link, image->spaces[image->links[i].origin].id);
+		link_set_destination(link, image->spaces[image->links[i].destination].id);
+		link_set_direction(link, (Direction)image->links[i].direction);
+		link_set_open(link, (Bool)image->links[i].open);
+	}
+
+	/* Same as game_add_character, with the space found by its slot */
+	n_characters = game_get_n_characters(game);
+	characters = game_get_character_array(game);
+	for (i = 0; i < header->n[IMAGE_CHARACTER]; i++)
+	{
+		if (!(character = character_create(image->characters[i].id)))
+		{
+			return ERROR;
+		}
+		character_set_name(character, image->strings + image->characters[i].name);
+		character_set_gdesc(character, image->strings + image->characters[i].gdesc);
+		character_set_health(character, image->characters[i].health);
+		character_set_friendly(character, (Bool)image->characters[i].friendly);
+		character_set_message(character, image->strings + image->characters[i].message);
+		characters[(*n_characters)++] = character;
+		space_add_character(spaces[image->characters[i].location], character);
+	}
+
+	return game_set_link_index(game, image->adjacency, header->n[IMAGE_LINK]);
+}
+
+int image_get_n(Image *image, ImageKind kind)
+{
+	if (!image || kind < 0 || kind >= IMAGE_KINDS)
+	{
+		return -1;
+	}
+
+	return (int)image->header->n[kind];
+}
+
+int image_find_name(Image *image, ImageKind kind, const char *name)
+{
+	long low = 0, high, mid;
+	int cmp;
+
+	if (!image || !name || (kind != IMAGE_OBJECT && kind != IMAGE_CHARACTER))
+	{
+		return -1;
+	}
+
+	/* The first entry not before the name and the kind */
+	high = image->header->n_names;
+	while (low < high)
+	{
+		mid = low + (high - low) / 2;
+		cmp = image_compare_text(image->strings + image->names[mid].name, name);
+		if (cmp < 0 || (cmp == 0 && image->names[mid].kind < (int)kind))
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	if (low < image->header->n_names && image->names[low].kind == (int)kind && image_compare_text(image->strings + image->names[low].name, name) == 0)
+	{
+		return image->names[low].slot;
+	}
+
+	return -1;
+}
+
+Bool image_is_reachable(Image *image, int slot)
+{
+	if (!image || image_slot_ok(image, slot) == FALSE)
+	{
+		return FALSE;
+	}
+
+	return image->reachable[slot];
+}
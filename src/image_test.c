@@ -0,0 +1,245 @@
+/**
+ * @brief It tests the compiled images of the world files
+ *
+ * @file image_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "image.h"
+#include "game_actions.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 5
+
+/**
+ * @brief Files of the tests, in the directory they are run from
+ */
+#define BROKEN_FILE "image_test.dat"
+#define IMAGE_FILE "image_test.img"
+
+/**
+ * @brief Test that invalid arguments and worlds with errors are rejected.
+ */
+void test1_image_compile();
+
+/**
+ * @brief Test that the anthill is compiled and its image is recognised.
+ */
+void test2_image_compile();
+
+/**
+ * @brief Test that a damaged image is not read.
+ */
+void test1_image_open();
+
+/**
+ * @brief Test that a game loaded from an image is the one loaded from its world file.
+ */
+void test1_image_load();
+
+/**
+ * @brief Test that names are found without case and spaces without a way to them are known.
+ */
+void test1_image_find_name();
+
+/**
+ * @brief Main function for image unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Image:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_image_compile();
+	if (all || test == 2)
+		test2_image_compile();
+	if (all || test == 3)
+		test1_image_open();
+	if (all || test == 4)
+		test1_image_load();
+	if (all || test == 5)
+		test1_image_find_name();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It runs a command of the first player
+ */
+static void play(Game *game, const char *input)
+{
+	char buffer[WORD_SIZE];
+	Command *command = game_get_last_command(game);
+
+	strcpy(buffer, input);
+	command_parse_input(command, buffer);
+	game_set_turn(game, 0);
+	game_actions_update(game, command);
+}
+
+/**
+ * @brief It tells whether a file exists
+ */
+static Bool exists(const char *filename)
+{
+	FILE *f = fopen(filename, "rb");
+
+	if (!f)
+	{
+		return FALSE;
+	}
+	fclose(f);
+	return TRUE;
+}
+
+void test1_image_compile()
+{
+	ImageReport report;
+	FILE *f = fopen(BROKEN_FILE, "w");
+	Status status = ERROR;
+
+	remove(IMAGE_FILE);
+	if (f)
+	{
+		/* A link to a space that does not exist, an object nowhere and a space twice */
+		fputs("#p:1|ant|m0^|11|5|3|\n#s:11|Entry|\n#s:12|Hole|\n#s:12|Hole|\n#o:21|Grain|99\n#l:200|Entry|11|13|1|1|\n", f);
+		fclose(f);
+		status = image_compile(BROKEN_FILE, IMAGE_FILE, &report);
+	}
+	PRINT_TEST_RESULT(image_compile(NULL, IMAGE_FILE, NULL) == ERROR && image_compile(BROKEN_FILE, NULL, NULL) == ERROR &&
+					  image_compile("image_test.missing", IMAGE_FILE, NULL) == ERROR && status == ERROR && report.n_errors == 3 &&
+					  report.size == 0 && exists(IMAGE_FILE) == FALSE);
+	remove(BROKEN_FILE);
+}
+
+void test2_image_compile()
+{
+	ImageReport report;
+	Status status;
+
+	status = image_compile("resources/anthill.dat", IMAGE_FILE, &report);
+	PRINT_TEST_RESULT(status == OK && report.n[IMAGE_SPACE] == 10 && report.n[IMAGE_LINK] == 17 && report.n[IMAGE_OBJECT] == 4 &&
+					  report.n[IMAGE_PLAYER] == 2 && report.n[IMAGE_CHARACTER] == 3 && report.n_errors == 0 && report.n_unreachable == 1 &&
+					  report.size > 0 && image_check(IMAGE_FILE) == TRUE && image_check("resources/anthill.dat") == FALSE && image_check(NULL) == FALSE);
+	remove(IMAGE_FILE);
+}
+
+void test1_image_open()
+{
+	Image *whole = NULL, *damaged = NULL, *cut = NULL;
+	char *bytes = NULL;
+	long size = 0;
+	FILE *f = NULL;
+
+	image_compile("resources/anthill.dat", IMAGE_FILE, NULL);
+	whole = image_open(IMAGE_FILE);
+	if ((f = fopen(IMAGE_FILE, "rb")) != NULL)
+	{
+		fseek(f, 0, SEEK_END);
+		size = ftell(f);
+		rewind(f);
+		if ((bytes = (char *)malloc(size)) != NULL && fread(bytes, 1, size, f) != (size_t)size)
+		{
+			size = 0;
+		}
+		fclose(f);
+	}
+
+	/* One byte changed in the middle, and then the end missing */
+	if (bytes && size > 0 && (f = fopen(IMAGE_FILE, "wb")) != NULL)
+	{
+		bytes[size / 2] ^= 1;
+		fwrite(bytes, 1, size, f);
+		fclose(f);
+		damaged = image_open(IMAGE_FILE);
+		bytes[size / 2] ^= 1;
+	}
+	if (bytes && size > 0 && (f = fopen(IMAGE_FILE, "wb")) != NULL)
+	{
+		fwrite(bytes, 1, size - 8, f);
+		fclose(f);
+		cut = image_open(IMAGE_FILE);
+	}
+
+	PRINT_TEST_RESULT(whole != NULL && size > 0 && damaged == NULL && cut == NULL && image_open(NULL) == NULL &&
+					  image_open("resources/anthill.dat") == NULL && image_get_n(whole, IMAGE_LINK) == 17 && image_get_n(NULL, IMAGE_LINK) == -1);
+	image_close(whole);
+	image_close(damaged);
+	image_close(cut);
+	free(bytes);
+	remove(IMAGE_FILE);
+}
+
+void test1_image_load()
+{
+	const char *commands[] = {"m s", "t Leaf", "m s", "m e", "d Leaf", NULL};
+	Game *text = NULL, *compiled = NULL;
+	Status status;
+	Bool same;
+	int i;
+
+	image_compile("resources/anthill.dat", IMAGE_FILE, NULL);
+	game_create_from_file(&text, "resources/anthill.dat");
+	status = game_create_from_file(&compiled, IMAGE_FILE);
+	same = status == OK && game_get_hash(text) == game_get_hash(compiled) && *game_get_n_spaces(text) == *game_get_n_spaces(compiled) &&
+		   *game_get_n_links(text) == *game_get_n_links(compiled) && *game_get_n_objects(text) == *game_get_n_objects(compiled) &&
+		   *game_get_n_characters(text) == *game_get_n_characters(compiled) && game_get_connection(compiled, 122, E) == 125 &&
+		   game_connection_is_open(compiled, 123, S) == FALSE && game_get_hash(compiled) == game_compute_hash(compiled);
+	for (i = 0; same == TRUE && commands[i]; i++)
+	{
+		play(text, commands[i]);
+		play(compiled, commands[i]);
+		same = game_get_hash(text) == game_get_hash(compiled) ? TRUE : FALSE;
+	}
+	PRINT_TEST_RESULT(same == TRUE);
+	game_destroy(text);
+	game_destroy(compiled);
+	remove(IMAGE_FILE);
+}
+
+void test1_image_find_name()
+{
+	Image *image = NULL;
+
+	image_compile("resources/anthill.dat", IMAGE_FILE, NULL);
+	image = image_open(IMAGE_FILE);
+	PRINT_TEST_RESULT(image != NULL && image_find_name(image, IMAGE_OBJECT, "leaf") == 2 && image_find_name(image, IMAGE_CHARACTER, "SPIDER") == 0 &&
+					  image_find_name(image, IMAGE_OBJECT, "Spider") == -1 && image_find_name(image, IMAGE_SPACE, "Entry") == -1 &&
+					  image_is_reachable(image, 8) == TRUE && image_is_reachable(image, 9) == FALSE && image_is_reachable(image, 10) == FALSE);
+	image_close(image);
+	remove(IMAGE_FILE);
+}
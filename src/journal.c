@@ -0,0 +1,393 @@
+/**
+ * @brief It implements the journal of the commands applied to a game
+ *
+ * @file journal.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "journal.h"
+#include "game_actions.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Room for a line of the journal
+ */
+#define JOURNAL_LINE_SIZE WORD_SIZE
+
+/**
+ * @brief A record of the journal
+ */
+typedef struct
+{
+	long seq;			  /*!< Number of the record, one more than the one before */
+	int turn;			  /*!< Player that typed the command */
+	CommandCode code;	  /*!< Code of the command */
+	unsigned int seed;	  /*!< Seed given to srand() before it, 0 if none */
+	char *arg;			  /*!< Argument of the command, in the line read */
+} JournalRecord;
+
+/**
+ * @brief Private implementation of the journal
+ */
+struct _Journal
+{
+	char *path;	  /*!< Name of the file */
+	char *tmp;	  /*!< Name of the file written by journal_compact */
+	FILE *f;	  /*!< File, open for appending */
+	long base;	  /*!< Number of the last record dropped */
+	long last;	  /*!< Number of the last record */
+	int batch;	  /*!< Records written between syncs */
+	int unsynced; /*!< Records written since the last sync */
+};
+
+/**
+ * @brief Allocates a journal without a file
+ */
+static Journal *journal_alloc(const char *path, int batch)
+{
+	Journal *journal = NULL;
+
+	if (!path || batch < 1 || !(journal = (Journal *)calloc(1, sizeof(Journal))))
+	{
+		return NULL;
+	}
+
+	journal->path = (char *)malloc(strlen(path) + 1);
+	journal->tmp = (char *)malloc(strlen(path) + 5);
+	if (!journal->path || !journal->tmp)
+	{
+		journal_destroy(journal);
+		return NULL;
+	}
+
+	strcpy(journal->path, path);
+	sprintf(journal->tmp, "%s.tmp", path);
+	journal->batch = batch;
+	return journal;
+}
+
+/**
+ * @brief Parses a line of the journal, which is changed
+ *
+ * @return TRUE if it is a whole record, FALSE otherwise
+ */
+static Bool journal_parse(char *line, JournalRecord *record)
+{
+	int code, n = 0;
+	size_t len = strlen(line);
+
+	/* A line without its end was cut by a crash */
+	if (len == 0 || line[len - 1] != '\n' ||
+		sscanf(line, "%ld %d %d %u %n", &record->seq, &record->turn, &code, &record->seed, &n) != 4 || n == 0 || record->turn < 0 ||
+		record->turn >= MAX_PLAYERS)
+	{
+		return FALSE;
+	}
+
+	line[len - 1] = '\0';
+	record->code = (CommandCode)code;
+	record->arg = line + n;
+	return TRUE;
+}
+
+/**
+ * @brief Reads the header of the journal
+ *
+ * @return TRUE if the file starts with a header, FALSE otherwise
+ */
+static Bool journal_read_header(FILE *f, long *base)
+{
+	char line[JOURNAL_LINE_SIZE];
+
+	return (fgets(line, sizeof(line), f) && sscanf(line, "#journal %ld", base) == 1 && *base >= 0) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Writes the header of the journal and syncs it
+ */
+static Status journal_write_header(FILE *f, long base)
+{
+	return (fprintf(f, "#journal %ld\n", base) > 0 && fflush(f) == 0 && fsync(fileno(f)) == 0) ? OK : ERROR;
+}
+
+Journal *journal_create(const char *path, int batch)
+{
+	Journal *journal = NULL;
+
+	if (!(journal = journal_alloc(path, batch)))
+	{
+		return NULL;
+	}
+
+	if (!(journal->f = fopen(path, "wb")) || journal_write_header(journal->f, 0) == ERROR)
+	{
+		journal_destroy(journal);
+		return NULL;
+	}
+
+	return journal;
+}
+
+Journal *journal_open(const char *path, int batch)
+{
+	Journal *journal = NULL;
+	JournalRecord record;
+	FILE *f = NULL;
+	char line[JOURNAL_LINE_SIZE];
+	long good = 0;
+	Bool torn = FALSE;
+
+	if (!(journal = journal_alloc(path, batch)))
+	{
+		return NULL;
+	}
+
+	if (!(f = fopen(path, "r+b")) || journal_read_header(f, &journal->base) == FALSE)
+	{
+		if (f)
+		{
+			fclose(f);
+		}
+		journal_destroy(journal);
+		return NULL;
+	}
+
+	/* The records are kept up to the first one that is not whole */
+	journal->last = journal->base;
+	good = ftell(f);
+	while (torn == FALSE && fgets(line, sizeof(line), f))
+	{
+		if (journal_parse(line, &record) == TRUE && record.seq == journal->last + 1)
+		{
+			journal->last = record.seq;
+			good = ftell(f);
+		}
+		else
+		{
+			torn = TRUE;
+		}
+	}
+	if (!feof(f))
+	{
+		torn = TRUE;
+	}
+	if (torn == TRUE && (fflush(f) != 0 || ftruncate(fileno(f), good) != 0))
+	{
+		good = -1;
+	}
+	fclose(f);
+
+	if (good < 0 || !(journal->f = fopen(path, "ab")))
+	{
+		journal_destroy(journal);
+		return NULL;
+	}
+
+	return journal;
+}
+
+void journal_destroy(Journal *journal)
+{
+	if (!journal)
+	{
+		return;
+	}
+
+	if (journal->f)
+	{
+		journal_sync(journal);
+		fclose(journal->f);
+	}
+	free(journal->path);
+	free(journal->tmp);
+	free(journal);
+}
+
+Status journal_close(Journal *journal)
+{
+	Status status;
+
+	if (!journal)
+	{
+		return ERROR;
+	}
+
+	status = remove(journal->path) == 0 ? OK : ERROR;
+	journal_destroy(journal);
+	return status;
+}
+
+Status journal_append(Journal *journal, int turn, Command *command, unsigned int seed)
+{
+	if (!journal || !journal->f || !command || turn < 0 || turn >= MAX_PLAYERS)
+	{
+		return ERROR;
+	}
+
+	/* Flushed at once, so the record survives the end of the process, and synced in batches */
+	if (fprintf(journal->f, "%ld %d %d %u %s\n", journal->last + 1, turn, (int)command_get_code(command), seed, command_get_arg(command)) < 0 ||
+		fflush(journal->f) != 0)
+	{
+		return ERROR;
+	}
+
+	journal->last++;
+	if (++journal->unsynced >= journal->batch)
+	{
+		return journal_sync(journal);
+	}
+
+	return OK;
+}
+
+Status journal_sync(Journal *journal)
+{
+	if (!journal || !journal->f)
+	{
+		return ERROR;
+	}
+
+	if (fflush(journal->f) != 0 || fsync(fileno(journal->f)) != 0)
+	{
+		return ERROR;
+	}
+
+	journal->unsynced = 0;
+	return OK;
+}
+
+long journal_replay(Journal *journal, Game *game, long mark)
+{
+	JournalRecord record;
+	Command *command = NULL;
+	FILE *f = NULL;
+	char line[JOURNAL_LINE_SIZE];
+	long base, n = 0;
+
+	if (!journal || !game || mark < journal->base)
+	{
+		return -1;
+	}
+
+	if (!(f = fopen(journal->path, "rb")) || journal_read_header(f, &base) == FALSE)
+	{
+		if (f)
+		{
+			fclose(f);
+		}
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f) && journal_parse(line, &record) == TRUE && record.seq <= journal->last)
+	{
+		if (record.seq <= mark)
+		{
+			continue;
+		}
+
+		/* The command is applied as the game loop did, as the last command of its player and with the same random numbers */
+		game_set_turn(game, record.turn);
+		command = game_get_last_command(game);
+		command_set_code(command, record.code);
+		command_set_arg(command, record.arg);
+		if (record.seed != 0)
+		{
+			srand(record.seed);
+		}
+		command_set_status(command, game_actions_update(game, command));
+		event_bus_dispatch(game_get_events(game));
+		n++;
+	}
+	fclose(f);
+
+	/* A save newer than the records synced goes on from its own number */
+	if (mark > journal->last)
+	{
+		journal->last = mark;
+	}
+
+	return n;
+}
+
+Status journal_compact(Journal *journal, long mark)
+{
+	JournalRecord record;
+	FILE *f = NULL, *out = NULL;
+	char line[JOURNAL_LINE_SIZE], copy[JOURNAL_LINE_SIZE];
+	long base;
+	Status status = OK;
+
+	if (!journal || !journal->f || mark > journal->last)
+	{
+		return ERROR;
+	}
+	if (mark <= journal->base)
+	{
+		return OK;
+	}
+
+	/* The records after the mark are written to a new file that is renamed over the journal */
+	if (journal_sync(journal) == ERROR || !(f = fopen(journal->path, "rb")) || journal_read_header(f, &base) == FALSE ||
+		!(out = fopen(journal->tmp, "wb")) || fprintf(out, "#journal %ld\n", mark) < 0)
+	{
+		status = ERROR;
+	}
+	while (status == OK && fgets(line, sizeof(line), f))
+	{
+		strcpy(copy, line);
+		if (journal_parse(line, &record) == TRUE && record.seq > mark && fputs(copy, out) == EOF)
+		{
+			status = ERROR;
+		}
+	}
+	if (f)
+	{
+		fclose(f);
+	}
+	if (out && (fflush(out) != 0 || fsync(fileno(out)) != 0))
+	{
+		status = ERROR;
+	}
+	if (out && fclose(out) != 0)
+	{
+		status = ERROR;
+	}
+	if (status == ERROR || rename(journal->tmp, journal->path) != 0)
+	{
+		remove(journal->tmp);
+		return ERROR;
+	}
+
+	fclose(journal->f);
+	journal->base = mark;
+	journal->unsynced = 0;
+	return (journal->f = fopen(journal->path, "ab")) != NULL ? OK : ERROR;
+}
+
+long journal_get_last(Journal *journal)
+{
+	if (!journal)
+	{
+		return -1;
+	}
+
+	return journal->last;
+}
+
+long journal_get_base(Journal *journal)
+{
+	if (!journal)
+	{
+		return -1;
+	}
+
+	return journal->base;
+}
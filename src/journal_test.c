@@ -0,0 +1,302 @@
+/**
+ * @brief It tests the journal of the commands applied to a game
+ *
+ * @file journal_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "journal.h"
+#include "game_actions.h"
+#include "turns.h"
+#include "test.h"
+#include "test_game.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 6
+
+/**
+ * @brief Journal file of the tests, in the directory they are run from
+ */
+#define JOURNAL_FILE "journal_test.journal"
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_journal_create();
+
+/**
+ * @brief Test that the records written are found when the journal is opened again.
+ */
+void test1_journal_open();
+
+/**
+ * @brief Test that a last record cut by a crash is dropped and the next one takes its number.
+ */
+void test2_journal_open();
+
+/**
+ * @brief Test that applying the records again gives the same game, attacks included.
+ */
+void test1_journal_replay();
+
+/**
+ * @brief Test that a round resolved in parallel is replayed as it was played, attacks and undo states included.
+ */
+void test2_journal_replay();
+
+/**
+ * @brief Test that the records held by a save are dropped and the others are kept.
+ */
+void test1_journal_compact();
+
+/**
+ * @brief Main function for journal unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Journal:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_journal_create();
+	if (all || test == 2)
+		test1_journal_open();
+	if (all || test == 3)
+		test2_journal_open();
+	if (all || test == 4)
+		test1_journal_replay();
+	if (all || test == 5)
+		test1_journal_compact();
+	if (all || test == 6)
+		test2_journal_replay();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It writes a command of the first player and applies it as the game loop does
+ */
+static void play(Game *game, Journal *journal, const char *input, unsigned int seed)
+{
+	Command *command = test_game_command(game, 0, input);
+
+	if (seed != 0)
+	{
+		srand(seed);
+	}
+	journal_append(journal, 0, command, seed);
+	game_actions_update(game, command);
+}
+
+/**
+ * @brief It writes the commands of a round and resolves them together as the game loop does with -t
+ *
+ * @return The number of groups the round was split in
+ */
+static int play_round(Game *game, Journal *journal, int n, int *players, char **inputs)
+{
+	Command *commands[MAX_PLAYERS], *own[MAX_PLAYERS];
+	unsigned int seeds[MAX_PLAYERS];
+	char buffer[WORD_SIZE];
+	int groups[MAX_PLAYERS], n_groups, i;
+
+	/* The game keeps its own commands, the round runs on new ones */
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		game_set_turn(game, i);
+		own[i] = game_get_last_command(game);
+	}
+	for (i = 0; i < n; i++)
+	{
+		commands[i] = command_create();
+		strcpy(buffer, inputs[i]);
+		command_parse_input(commands[i], buffer);
+		seeds[i] = (unsigned int)rand() + 1;
+		journal_append(journal, players[i], commands[i], seeds[i]);
+	}
+	n_groups = turns_plan(game, players, commands, n, groups);
+	turns_resolve(game, players, commands, n, seeds, 2);
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		game_set_turn(game, i);
+		game_set_last_command(game, own[i]);
+	}
+	for (i = 0; i < n; i++)
+	{
+		command_destroy(commands[i]);
+	}
+
+	return n_groups;
+}
+
+void test1_journal_create()
+{
+	Journal *journal = journal_create(JOURNAL_FILE, 1);
+	Command *command = command_create();
+
+	PRINT_TEST_RESULT(journal && journal_create(NULL, 1) == NULL && journal_create(JOURNAL_FILE ".x", 0) == NULL &&
+					  journal_append(NULL, 0, command, 0) == ERROR && journal_append(journal, 0, NULL, 0) == ERROR &&
+					  journal_append(journal, MAX_PLAYERS, command, 0) == ERROR && journal_replay(NULL, NULL, 0) == -1 &&
+					  journal_compact(journal, 1) == ERROR && journal_get_last(journal) == 0 && journal_get_last(NULL) == -1 &&
+					  journal_get_base(NULL) == -1 && journal_close(NULL) == ERROR);
+	journal_close(journal);
+	command_destroy(command);
+}
+
+void test1_journal_open()
+{
+	Game *game = test_game_create();
+	Journal *journal = journal_create(JOURNAL_FILE, 2);
+	FILE *f = NULL;
+	long last;
+
+	play(game, journal, "m s", 0);
+	play(game, journal, "m s", 0);
+	play(game, journal, "t Leaf", 0);
+	journal_destroy(journal);
+	journal = journal_open(JOURNAL_FILE, 2);
+	last = journal_get_last(journal);
+	journal_close(journal);
+	f = fopen(JOURNAL_FILE, "rb");
+	PRINT_TEST_RESULT(last == 3 && journal_open(JOURNAL_FILE, 2) == NULL && f == NULL);
+	if (f)
+	{
+		fclose(f);
+	}
+	game_destroy(game);
+}
+
+void test2_journal_open()
+{
+	Game *game = test_game_create();
+	Journal *journal = journal_create(JOURNAL_FILE, 1);
+	FILE *f = NULL;
+	long last[2] = {0, 0};
+
+	play(game, journal, "m s", 0);
+	journal_destroy(journal);
+	if ((f = fopen(JOURNAL_FILE, "ab")) != NULL)
+	{
+		fputs("2 0 7 0 s", f);
+		fclose(f);
+	}
+	journal = journal_open(JOURNAL_FILE, 1);
+	last[0] = journal_get_last(journal);
+	play(game, journal, "m s", 0);
+	journal_destroy(journal);
+	journal = journal_open(JOURNAL_FILE, 1);
+	last[1] = journal_get_last(journal);
+	PRINT_TEST_RESULT(last[0] == 1 && last[1] == 2);
+	journal_close(journal);
+	game_destroy(game);
+}
+
+void test1_journal_replay()
+{
+	Game *game = test_game_create(), *copy = test_game_create();
+	Journal *journal = journal_create(JOURNAL_FILE, JOURNAL_BATCH);
+	long n;
+
+	play(game, journal, "m s", 0);
+	play(game, journal, "m s", 0);
+	play(game, journal, "m s", 0);
+	play(game, journal, "a Spider", 5);
+	play(game, journal, "a Spider", 0);
+	play(game, journal, "a Spider", 11);
+	journal_destroy(journal);
+	journal = journal_open(JOURNAL_FILE, JOURNAL_BATCH);
+	srand(1);
+	n = journal_replay(journal, copy, 0);
+	PRINT_TEST_RESULT(n == 6 && game_get_hash(copy) == game_get_hash(game) &&
+					  player_get_health(game_get_player_at(copy, 0)) == player_get_health(game_get_player_at(game, 0)) &&
+					  player_get_location(game_get_player_at(copy, 0)) == 123);
+	journal_close(journal);
+	game_destroy(game);
+	game_destroy(copy);
+}
+
+void test1_journal_compact()
+{
+	Game *game = test_game_create(), *copy = test_game_create();
+	Journal *journal = journal_create(JOURNAL_FILE, JOURNAL_BATCH);
+	Status status;
+	long n[2];
+
+	play(game, journal, "m s", 0);
+	/* The copy is the save taken after the first record */
+	play(copy, NULL, "m s", 0);
+	play(game, journal, "m s", 0);
+	play(game, journal, "m s", 0);
+	status = journal_compact(journal, 1);
+	journal_destroy(journal);
+	journal = journal_open(JOURNAL_FILE, JOURNAL_BATCH);
+	n[0] = journal_replay(journal, copy, 0);
+	n[1] = journal_replay(journal, copy, 1);
+	PRINT_TEST_RESULT(status == OK && journal_get_base(journal) == 1 && journal_get_last(journal) == 3 && n[0] == -1 && n[1] == 2 &&
+					  game_get_hash(copy) == game_get_hash(game));
+	journal_close(journal);
+	game_destroy(game);
+	game_destroy(copy);
+}
+
+void test2_journal_replay()
+{
+	Game *game = test_game_create(), *copy = test_game_create();
+	Journal *journal = journal_create(JOURNAL_FILE, JOURNAL_BATCH);
+	int walk[1] = {1}, players[3] = {1, 0, 1}, n_groups, n_undo;
+	char *step[1] = {"m s"}, *inputs[3] = {"a Spider", "i Grain", "a Spider"};
+	unsigned long hash[2];
+	long n;
+
+	/* The worm fights the Spider while the ant, far from it, looks at what it has around */
+	srand(7);
+	play_round(game, journal, 1, walk, step);
+	n_groups = play_round(game, journal, 3, players, inputs);
+	journal_destroy(journal);
+	journal = journal_open(JOURNAL_FILE, JOURNAL_BATCH);
+	srand(1);
+	n = journal_replay(journal, copy, 0);
+	hash[0] = game_get_hash(game);
+	hash[1] = game_get_hash(copy);
+	n_undo = game_get_n_undo(copy);
+	game_undo(game);
+	game_undo(copy);
+	PRINT_TEST_RESULT(n == 4 && n_groups == 2 && hash[0] == hash[1] && n_undo == 3 && game_get_n_undo(game) == 2 && game_get_n_undo(copy) == 2 &&
+					  player_get_health(game_get_player_at(copy, 1)) == player_get_health(game_get_player_at(game, 1)) &&
+					  game_get_hash(copy) == game_get_hash(game));
+	journal_close(journal);
+	game_destroy(game);
+	game_destroy(copy);
+}
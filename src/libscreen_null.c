@@ -0,0 +1,201 @@
+/**
+ * @brief It implements a screen backend that never touches the terminal
+ *
+ * Same interface as libscreen, used by the benchmarks so that painting can be
+ * measured without the cost of the terminal. Areas are still written into an
+ * in-memory screen, like the real library does before screen_paint(), and
+ * the server reads that screen to send each player its view.
+ *
+ * @file libscreen_null.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "libscreen_null.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Private implementation of the area datatype
+ */
+struct _Area
+{
+	int x;		/*!< Column of the up-left corner */
+	int y;		/*!< Row of the up-left corner */
+	int width;	/*!< Width of the area */
+	int height; /*!< Height of the area */
+	int cursor; /*!< Row where the next string is written */
+};
+
+/**
+ * @brief In-memory screen
+ */
+static char *null_screen = NULL;
+
+/**
+ * @brief Text of the screen returned by screen_get_text
+ */
+static char *null_text = NULL;
+
+/**
+ * @brief Number of rows of the screen
+ */
+static int null_rows = 0;
+
+/**
+ * @brief Number of columns of the screen
+ */
+static int null_columns = 0;
+
+void screen_init(int rows, int columns)
+{
+	if (rows <= 0 || columns <= 0)
+	{
+		return;
+	}
+
+	free(null_screen);
+	free(null_text);
+	null_text = NULL;
+	null_screen = (char *)malloc(rows * columns);
+	if (!null_screen)
+	{
+		return;
+	}
+
+	null_rows = rows;
+	null_columns = columns;
+	memset(null_screen, ' ', rows * columns);
+}
+
+void screen_destroy()
+{
+	free(null_screen);
+	free(null_text);
+	null_screen = NULL;
+	null_text = NULL;
+	null_rows = 0;
+	null_columns = 0;
+}
+
+void screen_paint(Frame_color color)
+{
+	(void)color;
+}
+
+Area *screen_area_init(int x, int y, int width, int height)
+{
+	Area *area = NULL;
+
+	if (!(area = (Area *)malloc(sizeof(Area))))
+	{
+		return NULL;
+	}
+
+	area->x = x < 0 ? 0 : x;
+	area->y = y < 0 ? 0 : y;
+	area->width = width;
+	area->height = height;
+
+	/* Areas are clipped to the screen so that they can be written without more checks */
+	if (area->x + area->width > null_columns)
+	{
+		area->width = null_columns > area->x ? null_columns - area->x : 0;
+	}
+	area->cursor = 0;
+
+	return area;
+}
+
+void screen_area_destroy(Area *area)
+{
+	free(area);
+}
+
+void screen_area_clear(Area *area)
+{
+	int i;
+
+	if (!area)
+	{
+		return;
+	}
+
+	screen_area_reset_cursor(area);
+	if (!null_screen)
+	{
+		return;
+	}
+
+	for (i = 0; i < area->height && area->y + i < null_rows; i++)
+	{
+		memset(null_screen + (area->y + i) * null_columns + area->x, ' ', area->width);
+	}
+}
+
+void screen_area_reset_cursor(Area *area)
+{
+	if (area)
+	{
+		area->cursor = 0;
+	}
+}
+
+void screen_area_puts(Area *area, char *str)
+{
+	int len;
+
+	if (!area || !str)
+	{
+		return;
+	}
+
+	/* The real screen scrolls, this one just starts again from the top */
+	if (area->cursor >= area->height)
+	{
+		area->cursor = 0;
+	}
+
+	if (null_screen && area->y + area->cursor < null_rows)
+	{
+		len = (int)strlen(str);
+		if (len > area->width)
+		{
+			len = area->width;
+		}
+		memcpy(null_screen + (area->y + area->cursor) * null_columns + area->x, str, len);
+	}
+
+	area->cursor++;
+}
+
+char *screen_get_text(int *len)
+{
+	int i, n, row_len;
+
+	if (!null_screen || !len)
+	{
+		return NULL;
+	}
+
+	if (!null_text && !(null_text = (char *)malloc(null_rows * (null_columns + 1) + 1)))
+	{
+		return NULL;
+	}
+
+	for (i = 0, n = 0; i < null_rows; i++)
+	{
+		for (row_len = null_columns; row_len > 0 && null_screen[i * null_columns + row_len - 1] == ' '; row_len--)
+			;
+		memcpy(null_text + n, null_screen + i * null_columns, row_len);
+		n += row_len;
+		null_text[n++] = '\n';
+	}
+	null_text[n] = '\0';
+
+	*len = n;
+	return null_text;
+}
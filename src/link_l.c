@@ -9,27 +9,41 @@
  */
 
 #include "link_l.h"
+#include "pool.h"
+
+/**
+ * @brief Number of links in each block of the pool
+ */
+#define LINK_BLOCK 4096
 
 /**
  * @brief Private implementation of link datatype
+ *
+ * The name is interned, since every link out of a space usually repeats it,
+ * and the direction and the open flag are single bytes.
  */
 struct _Link
 {
-	Id id;					  /*!< Id of the link*/
-	char name[WORD_SIZE + 1]; /*!< Name of the link*/
-	Id origin;				  /*!< Id of origin of link*/
-	Id destination;			  /*!< Id of destination space*/
-	Direction direction;	  /*!< Direction of the link */
-	Bool open;				  /*!< Is the link opened or not*/
+	Id id;				  /*!< Id of the link*/
+	Id origin;			  /*!< Id of origin of link*/
+	Id destination;		  /*!< Id of destination space*/
+	const char *name;	  /*!< Name of the link, shared with every link with the same name*/
+	signed char direction; /*!< Direction of the link, a Direction */
+	char open;			  /*!< Is the link opened or not, a Bool*/
 };
 
+/**
+ * @brief Pool the links are taken from, so those of a world are packed in the order they are loaded
+ */
+static Pool link_pool = POOL_INITIALIZER(struct _Link, LINK_BLOCK);
+
 Link *link_create(Id id)
 {
 	Link *newLink = NULL;
 	if (id == NO_ID)
 		return NULL; /* Error control */
 
-	newLink = (Link *)malloc(sizeof(Link)); /* Memory allocation */
+	newLink = (Link *)pool_alloc(&link_pool); /* Memory allocation */
 
 	if (newLink == NULL)
 	{
@@ -37,11 +51,11 @@ Link *link_create(Id id)
 	}
 
 	newLink->id = id; /* Initialization of the structure */
-	newLink->name[0] = '\0';
+	newLink->name = "";
 	newLink->origin = NO_ID;
 	newLink->destination = NO_ID;
-	newLink->direction = NONE;
-	newLink->open = TRUE;
+	newLink->direction = (signed char)NONE;
+	newLink->open = (char)TRUE;
 
 	return newLink;
 }
@@ -53,19 +67,32 @@ Status link_destroy(Link *link)
 		return ERROR;
 	}
 
-	free(link);
+	pool_release(&link_pool, link);
 	return OK;
 }
 
+Id link_get_id(Link *link)
+{
+	if (!link)
+	{
+		return NO_ID;
+	}
+
+	return link->id;
+}
+
 Status link_set_name(Link *link, char *name)
 {
+	const char *interned = NULL;
+
 	if (!link || !name)
 		return ERROR;
 
-	if (!strcpy(link->name, name))
+	if (!(interned = pool_intern(name)))
 	{
 		return ERROR;
 	}
+	link->name = interned;
 
 	return OK;
 }
@@ -129,7 +156,7 @@ Status link_set_direction(Link *link, Direction direction)
 		return ERROR;
 	}
 
-	link->direction = direction;
+	link->direction = (signed char)direction;
 	return OK;
 }
 
@@ -140,7 +167,7 @@ Direction link_get_direction(Link *link)
 		return NONE;
 	}
 
-	return link->direction;
+	return (Direction)link->direction;
 }
 
 Status link_set_open(Link *link, Bool open)
@@ -150,7 +177,7 @@ Status link_set_open(Link *link, Bool open)
 		return ERROR;
 	}
 
-	link->open = open;
+	link->open = (char)open;
 	return OK;
 }
 
@@ -161,7 +188,7 @@ Bool link_get_open(Link *link)
 		return FALSE;
 	}
 
-	return link->open;
+	return (Bool)link->open;
 }
 
 void link_print(Link *link)
@@ -0,0 +1,662 @@
+/**
+ * @brief It implements the scheduler of the behaviours of the characters
+ *
+ * @file npc.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "npc.h"
+
+#include <stdlib.h>
+
+#include "character.h"
+#include "link_l.h"
+#include "player.h"
+#include "set.h"
+#include "space.h"
+#include "stats.h"
+
+/**
+ * @brief Number of directions of the exits of a space
+ */
+#define NPC_DIRS 4
+
+/**
+ * @brief Average number of ticks between two steps of a wandering character
+ */
+#define NPC_WANDER_TICKS 8
+
+/**
+ * @brief Ticks between two steps of a character that chases or flees
+ */
+#define NPC_ACTIVE_TICKS 1
+
+/**
+ * @brief Ticks an idle character sleeps before it looks around again
+ */
+#define NPC_IDLE_TICKS 32
+
+/**
+ * @brief A hostile character flees when its health is this fraction of its starting health or less
+ */
+#define NPC_FLEE_FRACTION 3
+
+/**
+ * @brief Number of characters run between two reads of the clock
+ */
+#define NPC_BUDGET_CHECK 16
+
+/**
+ * @brief A character in the scheduler
+ */
+typedef struct
+{
+	Character *character; /*!< The character */
+	int space;			  /*!< Position of its space in the index, -1 if it is unknown */
+	int max_health;		  /*!< Health of the character when it was scheduled */
+	NpcState state;		  /*!< State of its behaviour */
+	long wake;			  /*!< Tick when it runs again */
+} NpcEntry;
+
+/**
+ * @brief A node of the wake queue, with a copy of the wake tick so the heap does not read the entries
+ */
+typedef struct
+{
+	long wake; /*!< Tick when the character runs again */
+	int entry; /*!< Position of the entry of the character */
+} NpcWake;
+
+/**
+ * @brief Private implementation of the scheduler
+ */
+struct _NpcScheduler
+{
+	Game *game;						  /*!< The game of the characters */
+	Space **spaces;					  /*!< Spaces of the game sorted by id */
+	Id *ids;						  /*!< Ids of the sorted spaces, searched without reading the spaces */
+	Link **exits;					  /*!< Link of each space in each direction, NPC_DIRS per space */
+	int *exit_to;					  /*!< Position of the destination of each link, -1 if there is none */
+	int n_spaces;					  /*!< Number of spaces */
+	NpcEntry *entries;				  /*!< Characters, in the order of the game */
+	int *by_id;						  /*!< Positions of the entries sorted by the id of their character */
+	int n_entries;					  /*!< Number of characters */
+	NpcWake *heap;					  /*!< Min-heap of the entries ordered by wake tick */
+	int n_heap;						  /*!< Number of entries in the heap */
+	int players[MAX_PLAYERS];		  /*!< Spaces of the players alive in the current tick */
+	int n_players;					  /*!< Number of players alive */
+	int near[MAX_PLAYERS * (NPC_DIRS + 1)]; /*!< Spaces of the players and the spaces next to them */
+	int n_near;						  /*!< Number of spaces near the players */
+	long tick;						  /*!< Current tick */
+	long budget;					  /*!< Time budget of a tick in nanoseconds, 0 for no limit */
+	unsigned long rng;				  /*!< State of the random generator */
+};
+
+/**
+ * @brief Compares two spaces by id, for qsort
+ */
+static int npc_compare_spaces(const void *a, const void *b)
+{
+	Id id_a = space_get_id(*(Space *const *)a), id_b = space_get_id(*(Space *const *)b);
+
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Entries used by npc_compare_ids, qsort has no argument for them
+ */
+static NpcEntry *npc_sorting = NULL;
+
+/**
+ * @brief Compares two entries by the id of their character, for qsort
+ */
+static int npc_compare_ids(const void *a, const void *b)
+{
+	Id id_a = character_get_id(npc_sorting[*(const int *)a].character), id_b = character_get_id(npc_sorting[*(const int *)b].character);
+
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Next number of a xorshift generator, so the moves do not change the rand() of the attacks
+ *
+ * @param npcs A pointer to the scheduler
+ * @return A pseudo-random number
+ */
+static unsigned long npc_rand(NpcScheduler *npcs)
+{
+	npcs->rng ^= npcs->rng << 13;
+	npcs->rng ^= npcs->rng >> 7;
+	npcs->rng ^= npcs->rng << 17;
+	return npcs->rng & 0xffffffffUL;
+}
+
+/**
+ * @brief Finds a space in the index
+ *
+ * @param npcs A pointer to the scheduler
+ * @param id The id of the space
+ * @return The position of the space, -1 if there is no space with that id
+ */
+static int npc_find_space(NpcScheduler *npcs, Id id)
+{
+	int low = 0, high = npcs->n_spaces - 1, mid;
+
+	while (low <= high)
+	{
+		mid = low + (high - low) / 2;
+		if (npcs->ids[mid] == id)
+		{
+			return mid;
+		}
+		else if (npcs->ids[mid] < id)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Finds a character in the scheduler
+ *
+ * @param npcs A pointer to the scheduler
+ * @param id The id of the character
+ * @return The position of its entry, -1 if it is not in the scheduler
+ */
+static int npc_find_entry(NpcScheduler *npcs, Id id)
+{
+	int low = 0, high = npcs->n_entries - 1, mid;
+	Id mid_id;
+
+	while (low <= high)
+	{
+		mid = low + (high - low) / 2;
+		mid_id = character_get_id(npcs->entries[npcs->by_id[mid]].character);
+		if (mid_id == id)
+		{
+			return npcs->by_id[mid];
+		}
+		else if (mid_id < id)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Tells whether a node must leave the heap before another one
+ */
+static Bool npc_before(NpcWake *a, NpcWake *b)
+{
+	/* Ties are broken by the position, so the order of a tick does not depend on the heap */
+	return (a->wake < b->wake || (a->wake == b->wake && a->entry < b->entry)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Adds an entry to the heap with its wake tick
+ */
+static void npc_push(NpcScheduler *npcs, int entry)
+{
+	NpcWake node;
+	int child = npcs->n_heap++, parent;
+
+	node.wake = npcs->entries[entry].wake;
+	node.entry = entry;
+	while (child > 0 && npc_before(&node, &npcs->heap[parent = (child - 1) / 2]) == TRUE)
+	{
+		npcs->heap[child] = npcs->heap[parent];
+		child = parent;
+	}
+	npcs->heap[child] = node;
+}
+
+/**
+ * @brief Removes the first entry of the heap
+ *
+ * @return The position of the entry
+ */
+static int npc_pop(NpcScheduler *npcs)
+{
+	NpcWake last = npcs->heap[--npcs->n_heap];
+	int first = npcs->heap[0].entry, parent = 0, child;
+
+	while ((child = 2 * parent + 1) < npcs->n_heap)
+	{
+		if (child + 1 < npcs->n_heap && npc_before(&npcs->heap[child + 1], &npcs->heap[child]) == TRUE)
+		{
+			child++;
+		}
+		if (npc_before(&last, &npcs->heap[child]) == TRUE)
+		{
+			break;
+		}
+		npcs->heap[parent] = npcs->heap[child];
+		parent = child;
+	}
+	npcs->heap[parent] = last;
+
+	return first;
+}
+
+/**
+ * @brief Counts the entries of the heap that are due, without visiting the rest
+ */
+static int npc_count_due(NpcScheduler *npcs, int node)
+{
+	if (node >= npcs->n_heap || npcs->heap[node].wake > npcs->tick)
+	{
+		return 0;
+	}
+
+	return 1 + npc_count_due(npcs, 2 * node + 1) + npc_count_due(npcs, 2 * node + 2);
+}
+
+NpcScheduler *npc_create(Game *game, long budget, unsigned long seed)
+{
+	NpcScheduler *npcs = NULL;
+	Character **characters = NULL;
+	Link **links = NULL;
+	Set *in_space = NULL;
+	int i, j, n, position;
+
+	if (!game || budget < 0 || game_get_regions(game) != NULL || !(npcs = (NpcScheduler *)calloc(1, sizeof(NpcScheduler))))
+	{
+		return NULL;
+	}
+
+	npcs->game = game;
+	npcs->budget = budget;
+	npcs->rng = seed ? seed : 1;
+	npcs->n_spaces = *game_get_n_spaces(game);
+	npcs->n_entries = *game_get_n_characters(game);
+	npcs->spaces = (Space **)malloc((npcs->n_spaces + 1) * sizeof(Space *));
+	npcs->ids = (Id *)malloc((npcs->n_spaces + 1) * sizeof(Id));
+	npcs->exits = (Link **)calloc((size_t)npcs->n_spaces * NPC_DIRS + 1, sizeof(Link *));
+	npcs->exit_to = (int *)malloc(((size_t)npcs->n_spaces * NPC_DIRS + 1) * sizeof(int));
+	npcs->entries = (NpcEntry *)malloc((npcs->n_entries + 1) * sizeof(NpcEntry));
+	npcs->by_id = (int *)malloc((npcs->n_entries + 1) * sizeof(int));
+	npcs->heap = (NpcWake *)malloc((npcs->n_entries + 1) * sizeof(NpcWake));
+	if (!npcs->spaces || !npcs->ids || !npcs->exits || !npcs->exit_to || !npcs->entries || !npcs->by_id || !npcs->heap)
+	{
+		npc_destroy(npcs);
+		return NULL;
+	}
+
+	for (i = 0; i < npcs->n_spaces; i++)
+	{
+		npcs->spaces[i] = game_get_spaces(game)[i];
+	}
+	qsort(npcs->spaces, npcs->n_spaces, sizeof(Space *), npc_compare_spaces);
+	for (i = 0; i < npcs->n_spaces; i++)
+	{
+		npcs->ids[i] = space_get_id(npcs->spaces[i]);
+	}
+
+	/* The first link of a space in a direction is the one the game uses. The
+	   destinations are resolved once, only the open state is read in the ticks */
+	links = game_get_links(game);
+	for (i = 0; i < *game_get_n_links(game); i++)
+	{
+		position = npc_find_space(npcs, link_get_origin(links[i]));
+		if (position >= 0 && link_get_direction(links[i]) >= N && link_get_direction(links[i]) <= W &&
+			!npcs->exits[position * NPC_DIRS + link_get_direction(links[i])])
+		{
+			npcs->exits[position * NPC_DIRS + link_get_direction(links[i])] = links[i];
+		}
+	}
+	for (i = 0; i < npcs->n_spaces * NPC_DIRS; i++)
+	{
+		npcs->exit_to[i] = npcs->exits[i] ? npc_find_space(npcs, link_get_destination(npcs->exits[i])) : -1;
+	}
+
+	characters = game_get_character_array(game);
+	for (i = 0; i < npcs->n_entries; i++)
+	{
+		npcs->entries[i].character = characters[i];
+		npcs->entries[i].space = -1;
+		npcs->entries[i].max_health = character_get_health(characters[i]);
+		npcs->entries[i].state = NPC_IDLE;
+		npcs->entries[i].wake = 1;
+		npcs->by_id[i] = i;
+		/* Every entry wakes in the first tick, so the heap in order is already valid */
+		npcs->heap[i].wake = 1;
+		npcs->heap[i].entry = i;
+	}
+	npcs->n_heap = npcs->n_entries;
+	npc_sorting = npcs->entries;
+	qsort(npcs->by_id, npcs->n_entries, sizeof(int), npc_compare_ids);
+
+	/* One pass over the spaces instead of a game_find_character for each character */
+	for (i = 0; i < npcs->n_spaces; i++)
+	{
+		in_space = space_get_characters(npcs->spaces[i]);
+		n = set_get_count(in_space);
+		for (j = 0; j < n; j++)
+		{
+			if ((position = npc_find_entry(npcs, set_get_id_at(in_space, j))) >= 0)
+			{
+				npcs->entries[position].space = i;
+			}
+		}
+	}
+
+	return npcs;
+}
+
+void npc_destroy(NpcScheduler *npcs)
+{
+	if (!npcs)
+	{
+		return;
+	}
+
+	free(npcs->spaces);
+	free(npcs->ids);
+	free(npcs->exits);
+	free(npcs->exit_to);
+	free(npcs->entries);
+	free(npcs->by_id);
+	free(npcs->heap);
+	free(npcs);
+}
+
+/**
+ * @brief Makes sure the space of a character is right, players carry their followers
+ *
+ * @param npcs A pointer to the scheduler
+ * @param entry The entry of the character
+ * @return The position of its space, -1 if it is not in any space
+ */
+static int npc_locate(NpcScheduler *npcs, NpcEntry *entry)
+{
+	Set *in_space = NULL;
+	Id id = character_get_id(entry->character);
+	int i, n;
+
+	if (entry->space >= 0)
+	{
+		in_space = space_get_characters(npcs->spaces[entry->space]);
+		n = set_get_count(in_space);
+		for (i = 0; i < n; i++)
+		{
+			if (set_get_id_at(in_space, i) == id)
+			{
+				return entry->space;
+			}
+		}
+	}
+
+	entry->space = npc_find_space(npcs, game_find_character(npcs->game, id));
+	return entry->space;
+}
+
+/**
+ * @brief Tells whether a space is in a list of spaces
+ */
+static Bool npc_in(int *spaces, int n, int space)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		if (spaces[i] == space)
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/**
+ * @brief Gets the space behind an open exit
+ *
+ * @param npcs A pointer to the scheduler
+ * @param space The position of the space
+ * @param dir The direction of the exit
+ * @return The position of the destination, -1 if the character cannot go that way
+ */
+static int npc_exit(NpcScheduler *npcs, int space, int dir)
+{
+	int destination = npcs->exit_to[space * NPC_DIRS + dir];
+
+	if (destination < 0 || link_get_open(npcs->exits[space * NPC_DIRS + dir]) == FALSE)
+	{
+		return -1;
+	}
+
+	return destination;
+}
+
+/**
+ * @brief Tells whether a space has room for one more character
+ */
+static Bool npc_has_room(NpcScheduler *npcs, int space)
+{
+	return set_get_count(space_get_characters(npcs->spaces[space])) < MAX_IDS ? TRUE : FALSE;
+}
+
+/**
+ * @brief Moves a character to another space
+ */
+static void npc_move(NpcScheduler *npcs, NpcEntry *entry, int destination)
+{
+	space_del_character(npcs->spaces[entry->space], entry->character);
+	space_add_character(npcs->spaces[destination], entry->character);
+	game_hash_change(npcs->game, ZOBRIST_CHARACTER_AT, character_get_id(entry->character), npcs->ids[entry->space], npcs->ids[destination]);
+	game_publish_event(npcs->game, EVENT_CHARACTER_MOVED, character_get_id(entry->character), npcs->ids[entry->space], npcs->ids[destination], 0);
+	entry->space = destination;
+}
+
+/**
+ * @brief Runs a step of the behaviour of a character and sets its next wake tick
+ *
+ * @param npcs A pointer to the scheduler
+ * @param entry The entry of the character
+ */
+static void npc_step(NpcScheduler *npcs, NpcEntry *entry)
+{
+	Character *character = entry->character;
+	Bool here = FALSE, low_health;
+	int space, start, dir, destination, near = -1;
+
+	if (character_get_health(character) <= 0)
+	{
+		entry->state = NPC_DEAD;
+		return;
+	}
+
+	if ((space = npc_locate(npcs, entry)) < 0 || character_get_following(character) != NO_ID)
+	{
+		entry->state = NPC_IDLE;
+		entry->wake = npcs->tick + NPC_IDLE_TICKS;
+		return;
+	}
+
+	/* The exits are tried from a random one, so nobody prefers the north */
+	start = (int)(npc_rand(npcs) % NPC_DIRS);
+
+	/* Far from the players, a hostile character wanders like a friendly one */
+	if (character_get_friendly(character) == FALSE && npc_in(npcs->near, npcs->n_near, space) == TRUE)
+	{
+		here = npc_in(npcs->players, npcs->n_players, space);
+		for (dir = 0; dir < NPC_DIRS && near < 0; dir++)
+		{
+			destination = npc_exit(npcs, space, (start + dir) % NPC_DIRS);
+			if (destination >= 0 && npc_in(npcs->players, npcs->n_players, destination) == TRUE && npc_has_room(npcs, destination) == TRUE)
+			{
+				near = destination;
+			}
+		}
+		low_health = (character_get_health(character) * NPC_FLEE_FRACTION <= entry->max_health) ? TRUE : FALSE;
+
+		if ((here == TRUE || near >= 0) && low_health == TRUE)
+		{
+			entry->state = NPC_FLEE;
+			entry->wake = npcs->tick + NPC_ACTIVE_TICKS;
+			for (dir = 0; dir < NPC_DIRS; dir++)
+			{
+				destination = npc_exit(npcs, space, (start + dir) % NPC_DIRS);
+				if (destination >= 0 && npc_in(npcs->players, npcs->n_players, destination) == FALSE && npc_has_room(npcs, destination) == TRUE)
+				{
+					npc_move(npcs, entry, destination);
+					return;
+				}
+			}
+			return;
+		}
+
+		if (here == TRUE || near >= 0)
+		{
+			entry->state = NPC_CHASE;
+			entry->wake = npcs->tick + NPC_ACTIVE_TICKS;
+			if (here == FALSE)
+			{
+				npc_move(npcs, entry, near);
+			}
+			return;
+		}
+	}
+
+	for (dir = 0; dir < NPC_DIRS; dir++)
+	{
+		if ((destination = npc_exit(npcs, space, (start + dir) % NPC_DIRS)) >= 0 && npc_has_room(npcs, destination) == TRUE)
+		{
+			npc_move(npcs, entry, destination);
+			entry->state = NPC_WANDER;
+			entry->wake = npcs->tick + NPC_WANDER_TICKS / 2 + (long)(npc_rand(npcs) % NPC_WANDER_TICKS);
+			return;
+		}
+	}
+
+	entry->state = NPC_IDLE;
+	entry->wake = npcs->tick + NPC_IDLE_TICKS;
+}
+
+int npc_tick(NpcScheduler *npcs)
+{
+	Player *player = NULL;
+	unsigned long start = 0, stats_t = 0;
+	int i, dir, space, entry, n_run = 0;
+
+	if (!npcs)
+	{
+		return -1;
+	}
+
+	STATS_START(stats_t);
+	npcs->tick++;
+
+	/* Hostile characters only look for the players when they are near one */
+	npcs->n_players = npcs->n_near = 0;
+	for (i = 0; i < game_get_n_players(npcs->game); i++)
+	{
+		player = game_get_player_at(npcs->game, i);
+		if (player && player_get_health(player) > 0 && (space = npc_find_space(npcs, player_get_location(player))) >= 0)
+		{
+			npcs->players[npcs->n_players++] = space;
+			npcs->near[npcs->n_near++] = space;
+			for (dir = 0; dir < NPC_DIRS; dir++)
+			{
+				if (npcs->exit_to[space * NPC_DIRS + dir] >= 0)
+				{
+					npcs->near[npcs->n_near++] = npcs->exit_to[space * NPC_DIRS + dir];
+				}
+			}
+		}
+	}
+
+	if (npcs->budget > 0)
+	{
+		start = stats_now();
+	}
+
+	while (npcs->n_heap > 0 && npcs->heap[0].wake <= npcs->tick)
+	{
+		/* The clock is read every few characters, it costs more than a step */
+		if (npcs->budget > 0 && n_run > 0 && n_run % NPC_BUDGET_CHECK == 0 && stats_now() - start >= (unsigned long)npcs->budget)
+		{
+			break;
+		}
+
+		entry = npc_pop(npcs);
+		npc_step(npcs, &npcs->entries[entry]);
+		if (npcs->entries[entry].state != NPC_DEAD)
+		{
+			npc_push(npcs, entry);
+		}
+		n_run++;
+	}
+
+	STATS_STOP(STATS_SLOT_NPC, stats_t);
+
+	return n_run;
+}
+
+long npc_get_tick(NpcScheduler *npcs)
+{
+	if (!npcs)
+	{
+		return -1;
+	}
+
+	return npcs->tick;
+}
+
+int npc_get_n_scheduled(NpcScheduler *npcs)
+{
+	if (!npcs)
+	{
+		return -1;
+	}
+
+	return npcs->n_heap;
+}
+
+int npc_get_n_late(NpcScheduler *npcs)
+{
+	if (!npcs)
+	{
+		return -1;
+	}
+
+	return npc_count_due(npcs, 0);
+}
+
+NpcState npc_get_state(NpcScheduler *npcs, Id id)
+{
+	int entry;
+
+	if (!npcs || (entry = npc_find_entry(npcs, id)) < 0)
+	{
+		return NPC_DEAD;
+	}
+
+	return npcs->entries[entry].state;
+}
+
+const char *npc_state_name(NpcState state)
+{
+	static const char *names[] = {"idle", "wander", "chase", "flee", "dead"};
+
+	if (state < NPC_IDLE || state > NPC_DEAD)
+	{
+		return "?";
+	}
+
+	return names[state];
+}
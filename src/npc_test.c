@@ -0,0 +1,407 @@
+/**
+ * @brief It tests the scheduler of the behaviours of the characters
+ *
+ * @file npc_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "npc.h"
+#include "character.h"
+#include "game_reader.h"
+#include "record.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 10
+
+/**
+ * @brief Width and height of the grid of the test world
+ */
+#define GRID 4
+
+/**
+ * @brief Space without open exits, next to the grid
+ */
+#define ROOM 17
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_npc_create();
+
+/**
+ * @brief Test that a friendly character wanders to a neighbouring space.
+ */
+void test1_npc_tick();
+
+/**
+ * @brief Test that a character without open exits stays idle.
+ */
+void test2_npc_tick();
+
+/**
+ * @brief Test that a hostile character goes to a player next to it.
+ */
+void test3_npc_tick();
+
+/**
+ * @brief Test that a hostile character with little health flees from a player.
+ */
+void test4_npc_tick();
+
+/**
+ * @brief Test that a character following a player does not move on its own.
+ */
+void test5_npc_tick();
+
+/**
+ * @brief Test that sleeping characters do not run until they wake up.
+ */
+void test6_npc_tick();
+
+/**
+ * @brief Test that a dead character leaves the queue.
+ */
+void test7_npc_tick();
+
+/**
+ * @brief Test that the budget leaves late characters for the next tick.
+ */
+void test8_npc_tick();
+
+/**
+ * @brief Test that the same seed gives the same moves.
+ */
+void test9_npc_tick();
+
+/**
+ * @brief Main function for npc unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Npc:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_npc_create();
+	if (all || test == 2)
+		test1_npc_tick();
+	if (all || test == 3)
+		test2_npc_tick();
+	if (all || test == 4)
+		test3_npc_tick();
+	if (all || test == 5)
+		test4_npc_tick();
+	if (all || test == 6)
+		test5_npc_tick();
+	if (all || test == 7)
+		test6_npc_tick();
+	if (all || test == 8)
+		test7_npc_tick();
+	if (all || test == 9)
+		test8_npc_tick();
+	if (all || test == 10)
+		test9_npc_tick();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It parses a record of the test world and adds it to the game
+ *
+ * @param game A pointer to the game
+ * @param text The record
+ * @return OK if it was added, ERROR otherwise
+ */
+static Status world_add(Game *game, char *text)
+{
+	Record *record = NULL;
+	Space *space = NULL;
+	Link *link = NULL;
+	Player *player = NULL;
+	Character *character = NULL;
+	Status status = ERROR;
+	char *tags[] = {"#s:", "#l:", "#p:", "#c:"};
+	int which = -1;
+	Id location;
+
+	if (!(record = record_open_text("npc_test", text)) || record_next_of(record, tags, 4, &which) <= 0)
+	{
+		record_close(record);
+		return ERROR;
+	}
+
+	switch (which)
+	{
+	case 0:
+		status = game_reader_parse_space(record, &space) == OK ? game_add_space(game, space) : ERROR;
+		break;
+	case 1:
+		status = game_reader_parse_link(record, &link) == OK ? game_add_link(game, link) : ERROR;
+		break;
+	case 2:
+		status = game_reader_parse_player(record, &player, &location) == OK ? game_add_player(game, player) : ERROR;
+		break;
+	default:
+		status = game_reader_parse_character(record, &character, &location) == OK ? game_add_character(game, character, location) : ERROR;
+		break;
+	}
+
+	record_close(record);
+	return status;
+}
+
+/**
+ * @brief It creates a grid of open spaces with a player in the first one, and a room with a closed door
+ *
+ * @param characters The records of the characters of the world, ended by NULL
+ * @return A new game, NULL if there was an error
+ */
+static Game *world_create(char **characters)
+{
+	Game *game = NULL;
+	char text[WORD_SIZE];
+	int x, y, i;
+	Id id, link = 100;
+
+	if (game_create(&game) == ERROR)
+	{
+		return NULL;
+	}
+
+	for (id = 1; id <= ROOM; id++)
+	{
+		sprintf(text, "#s:%ld|Cell %ld|", id, id);
+		world_add(game, text);
+	}
+
+	for (y = 0; y < GRID; y++)
+	{
+		for (x = 0; x < GRID; x++)
+		{
+			id = 1 + y * GRID + x;
+			if (x < GRID - 1)
+			{
+				sprintf(text, "#l:%ld|East|%ld|%ld|%d|1|", link++, id, id + 1, E);
+				world_add(game, text);
+				sprintf(text, "#l:%ld|West|%ld|%ld|%d|1|", link++, id + 1, id, W);
+				world_add(game, text);
+			}
+			if (y < GRID - 1)
+			{
+				sprintf(text, "#l:%ld|South|%ld|%ld|%d|1|", link++, id, id + GRID, S);
+				world_add(game, text);
+				sprintf(text, "#l:%ld|North|%ld|%ld|%d|1|", link++, id + GRID, id, N);
+				world_add(game, text);
+			}
+		}
+	}
+	sprintf(text, "#l:%ld|Door|%d|%d|%d|0|", link++, ROOM, GRID * GRID, W);
+	world_add(game, text);
+
+	world_add(game, "#p:1|Ant|^A>|1|10|3|");
+	for (i = 0; characters[i]; i++)
+	{
+		if (world_add(game, characters[i]) == ERROR)
+		{
+			game_destroy(game);
+			return NULL;
+		}
+	}
+
+	game_set_hash(game, game_compute_hash(game));
+	return game;
+}
+
+/**
+ * @brief Tells whether two spaces of the grid are next to each other
+ */
+static Bool next_to(Id a, Id b)
+{
+	int dx = (int)((a - 1) % GRID) - (int)((b - 1) % GRID), dy = (int)((a - 1) / GRID) - (int)((b - 1) / GRID);
+
+	return (a >= 1 && b >= 1 && a <= GRID * GRID && b <= GRID * GRID && dx * dx + dy * dy == 1) ? TRUE : FALSE;
+}
+
+void test1_npc_create()
+{
+	char *characters[] = {"#c:50|ant|^a|11|5|1|Hi|", NULL};
+	Game *game = world_create(characters);
+
+	PRINT_TEST_RESULT(npc_create(NULL, 0, 1) == NULL && npc_create(game, -1, 1) == NULL && npc_tick(NULL) == -1 &&
+					  npc_get_tick(NULL) == -1 && npc_get_n_scheduled(NULL) == -1 && npc_get_state(NULL, 50) == NPC_DEAD);
+	game_destroy(game);
+}
+
+void test1_npc_tick()
+{
+	char *characters[] = {"#c:50|ant|^a|11|5|1|Hi|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = npc_create(game, 0, 1);
+
+	PRINT_TEST_RESULT(npcs && npc_tick(npcs) == 1 && npc_get_state(npcs, 50) == NPC_WANDER && next_to(game_find_character(game, 50), 11) == TRUE &&
+					  game_get_hash(game) == game_compute_hash(game));
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test2_npc_tick()
+{
+	char *characters[] = {"#c:50|ant|^a|17|5|1|Hi|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = npc_create(game, 0, 1);
+
+	PRINT_TEST_RESULT(npcs && npc_tick(npcs) == 1 && npc_get_state(npcs, 50) == NPC_IDLE && game_find_character(game, 50) == ROOM);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test3_npc_tick()
+{
+	char *characters[] = {"#c:60|spider|/\\|2|9|0|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = npc_create(game, 0, 1);
+
+	PRINT_TEST_RESULT(npcs && npc_tick(npcs) == 1 && npc_get_state(npcs, 60) == NPC_CHASE && game_find_character(game, 60) == 1);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test4_npc_tick()
+{
+	char *characters[] = {"#c:60|spider|/\\|1|9|0|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = npc_create(game, 0, 1);
+
+	/* Hurt after it was scheduled, with a third of its health */
+	character_set_health(game_get_character_array(game)[0], 3);
+	PRINT_TEST_RESULT(npcs && npc_tick(npcs) == 1 && npc_get_state(npcs, 60) == NPC_FLEE && next_to(game_find_character(game, 60), 1) == TRUE);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test5_npc_tick()
+{
+	char *characters[] = {"#c:50|ant|^a|6|5|1|Hi|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = NULL;
+
+	game_set_character_following(game, game_get_character_array(game)[0], 1);
+	npcs = npc_create(game, 0, 1);
+	PRINT_TEST_RESULT(npcs && npc_tick(npcs) == 1 && npc_get_state(npcs, 50) == NPC_IDLE && game_find_character(game, 50) == 6);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test6_npc_tick()
+{
+	char *characters[] = {"#c:50|ant|^a|17|5|1|Hi|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = npc_create(game, 0, 1);
+	int runs = 0, i;
+
+	/* Idle characters sleep for 32 ticks */
+	npc_tick(npcs);
+	for (i = 0; i < 31; i++)
+	{
+		runs += npc_tick(npcs);
+	}
+	PRINT_TEST_RESULT(npcs && runs == 0 && npc_tick(npcs) == 1 && npc_get_tick(npcs) == 33);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test7_npc_tick()
+{
+	char *characters[] = {"#c:50|ant|^a|11|5|1|Hi|", "#c:51|ant|^a|7|5|1|Hi|", NULL};
+	Game *game = world_create(characters);
+	NpcScheduler *npcs = npc_create(game, 0, 1);
+
+	character_set_health(game_get_character_array(game)[1], 0);
+	PRINT_TEST_RESULT(npcs && npc_get_n_scheduled(npcs) == 2 && npc_tick(npcs) == 2 && npc_get_n_scheduled(npcs) == 1 && npc_get_state(npcs, 51) == NPC_DEAD);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test8_npc_tick()
+{
+	char *characters[101], records[100][WORD_SIZE];
+	Game *game = NULL;
+	NpcScheduler *npcs = NULL;
+	int i, runs = 0;
+
+	for (i = 0; i < 100; i++)
+	{
+		sprintf(records[i], "#c:%d|ant|^a|%d|5|1|Hi|", 50 + i, 1 + i % (GRID * GRID));
+		characters[i] = records[i];
+	}
+	characters[100] = NULL;
+	game = world_create(characters);
+
+	/* A budget of 1ns runs the characters up to the first read of the clock */
+	npcs = npc_create(game, 1, 1);
+	if (npcs)
+	{
+		runs = npc_tick(npcs);
+	}
+	PRINT_TEST_RESULT(npcs && runs > 0 && runs < 100 && npc_get_n_late(npcs) == 100 - runs && npc_tick(npcs) > 0);
+	npc_destroy(npcs);
+	game_destroy(game);
+}
+
+void test9_npc_tick()
+{
+	char *characters[] = {"#c:50|ant|^a|11|5|1|Hi|", "#c:51|ant|^a|7|5|1|Hi|", "#c:60|spider|/\\|16|9|0|", NULL};
+	Game *a = world_create(characters), *b = world_create(characters);
+	NpcScheduler *npcs_a = npc_create(a, 0, 7), *npcs_b = npc_create(b, 0, 7);
+	Bool same = (npcs_a && npcs_b) ? TRUE : FALSE;
+	int i;
+
+	for (i = 0; i < 200 && same == TRUE; i++)
+	{
+		npc_tick(npcs_a);
+		npc_tick(npcs_b);
+		if (game_find_character(a, 50) != game_find_character(b, 50) || game_find_character(a, 51) != game_find_character(b, 51) ||
+			game_find_character(a, 60) != game_find_character(b, 60))
+		{
+			same = FALSE;
+		}
+	}
+	PRINT_TEST_RESULT(same == TRUE && npc_get_state(npcs_a, 60) == npc_get_state(npcs_b, 60));
+	npc_destroy(npcs_a);
+	npc_destroy(npcs_b);
+	game_destroy(a);
+	game_destroy(b);
+}
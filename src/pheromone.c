@@ -0,0 +1,501 @@
+/**
+ * @brief It implements the pheromone fields of the spaces
+ *
+ * @file pheromone.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "pheromone.h"
+
+#include <stdlib.h>
+
+#include "link_l.h"
+#include "record.h"
+#include "space.h"
+
+/**
+ * @brief Id of a space and its slot in the game, to find slots by id
+ */
+typedef struct
+{
+	Id id;	  /*!< Id of the space */
+	int slot; /*!< Position of the space in the spaces of the game */
+} PheromoneSlot;
+
+/**
+ * @brief Private implementation of the fields
+ *
+ * Rows of the matrix are destinations and their columns the slots that
+ * share with them, so every row is summed on its own without writes to
+ * other rows. Amounts are floats, twice as many fit in a vector.
+ */
+struct _Pheromones
+{
+	Game *game;						/*!< The game of the spaces, NULL if they were read from a file */
+	PheromoneSlot *slots;			/*!< Spaces sorted by id */
+	int n_spaces;					/*!< Number of spaces */
+	int *row_start;					/*!< First column of each row, n_spaces + 1 */
+	int *columns;					/*!< Slots that share with each row */
+	int n_links;					/*!< Number of columns, the open links */
+	float *share;					/*!< Fraction of its amount that a slot gives to each of its links, after decay */
+	float *retain;					/*!< Fraction of its amount that a slot keeps, after decay */
+	float *fields[PHEROMONE_KINDS]; /*!< Amount of each kind in each slot */
+	float *next;					/*!< Amounts of the step being computed */
+	float *shared;					/*!< Amount that each slot gives to each of its links in the current step */
+	double diffusion;				/*!< Fraction of its amount a space shares in a step */
+	double decay;					/*!< Fraction of every amount lost in a step */
+};
+
+/**
+ * @brief Compares two slots by id, for qsort
+ */
+static int pheromone_compare_slots(const void *a, const void *b)
+{
+	Id id_a = ((const PheromoneSlot *)a)->id, id_b = ((const PheromoneSlot *)b)->id;
+
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Finds the slot of a space
+ *
+ * @param pheromones A pointer to the fields
+ * @param id The id of the space
+ * @return The slot of the space, -1 if there is no space with that id
+ */
+static int pheromone_find_slot(Pheromones *pheromones, Id id)
+{
+	int low = 0, high = pheromones->n_spaces - 1, mid;
+
+	while (low <= high)
+	{
+		mid = low + (high - low) / 2;
+		if (pheromones->slots[mid].id == id)
+		{
+			return pheromones->slots[mid].slot;
+		}
+		else if (pheromones->slots[mid].id < id)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief It allocates empty fields for a number of spaces
+ *
+ * @param n_spaces The number of spaces
+ * @param diffusion The fraction of its amount a space shares in a step
+ * @param decay The fraction of every amount lost in a step
+ * @return New fields without slots or matrix, NULL if there was an error
+ */
+static Pheromones *pheromone_alloc(int n_spaces, double diffusion, double decay)
+{
+	Pheromones *pheromones = NULL;
+	int kind;
+
+	if (n_spaces < 0 || diffusion < 0 || diffusion > 1 || decay < 0 || decay > 1 || !(pheromones = (Pheromones *)calloc(1, sizeof(Pheromones))))
+	{
+		return NULL;
+	}
+
+	pheromones->diffusion = diffusion;
+	pheromones->decay = decay;
+	pheromones->n_spaces = n_spaces;
+	pheromones->slots = (PheromoneSlot *)malloc((n_spaces + 1) * sizeof(PheromoneSlot));
+	pheromones->next = (float *)calloc(n_spaces + 1, sizeof(float));
+	pheromones->shared = (float *)calloc(n_spaces + 1, sizeof(float));
+	for (kind = 0; kind < PHEROMONE_KINDS; kind++)
+	{
+		pheromones->fields[kind] = (float *)calloc(n_spaces + 1, sizeof(float));
+		if (!pheromones->fields[kind])
+		{
+			pheromone_destroy(pheromones);
+			return NULL;
+		}
+	}
+	if (!pheromones->slots || !pheromones->next || !pheromones->shared)
+	{
+		pheromone_destroy(pheromones);
+		return NULL;
+	}
+
+	return pheromones;
+}
+
+/**
+ * @brief It builds the matrix from the open links
+ *
+ * @param pheromones A pointer to the fields, with their slots sorted
+ * @param ends The ids of the origin and the destination of each link, one after the other
+ * @param n The number of links
+ * @return OK if it was built, ERROR otherwise (the old matrix is kept)
+ */
+static Status pheromone_build(Pheromones *pheromones, Id *ends, int n)
+{
+	int *from = NULL, *to = NULL, *row_start = NULL, *columns = NULL, *fill = NULL;
+	float *share = NULL, *retain = NULL;
+	int i, n_links = 0, n_spaces = pheromones->n_spaces;
+	double keep;
+
+	from = (int *)malloc((n + 1) * sizeof(int));
+	to = (int *)malloc((n + 1) * sizeof(int));
+	row_start = (int *)calloc(n_spaces + 1, sizeof(int));
+	fill = (int *)calloc(n_spaces + 1, sizeof(int));
+	share = (float *)malloc((n_spaces + 1) * sizeof(float));
+	retain = (float *)malloc((n_spaces + 1) * sizeof(float));
+	if (!from || !to || !row_start || !fill || !share || !retain)
+	{
+		free(from);
+		free(to);
+		free(row_start);
+		free(fill);
+		free(share);
+		free(retain);
+		return ERROR;
+	}
+
+	/* Links between two different known spaces, fill counts the exits of each slot for now */
+	for (i = 0; i < n; i++)
+	{
+		from[n_links] = pheromone_find_slot(pheromones, ends[2 * i]);
+		to[n_links] = pheromone_find_slot(pheromones, ends[2 * i + 1]);
+		if (from[n_links] < 0 || to[n_links] < 0 || from[n_links] == to[n_links])
+		{
+			continue;
+		}
+		row_start[to[n_links] + 1]++;
+		fill[from[n_links]]++;
+		n_links++;
+	}
+
+	keep = 1 - pheromones->decay;
+	for (i = 0; i < n_spaces; i++)
+	{
+		share[i] = fill[i] ? (float)(keep * pheromones->diffusion / fill[i]) : 0.0f;
+		retain[i] = fill[i] ? (float)(keep * (1 - pheromones->diffusion)) : (float)keep;
+		row_start[i + 1] += row_start[i];
+		fill[i] = row_start[i];
+	}
+
+	if ((columns = (int *)malloc((n_links + 1) * sizeof(int))))
+	{
+		for (i = 0; i < n_links; i++)
+		{
+			columns[fill[to[i]]++] = from[i];
+		}
+	}
+	free(from);
+	free(to);
+	free(fill);
+	if (!columns)
+	{
+		free(row_start);
+		free(share);
+		free(retain);
+		return ERROR;
+	}
+
+	free(pheromones->row_start);
+	free(pheromones->columns);
+	free(pheromones->share);
+	free(pheromones->retain);
+	pheromones->row_start = row_start;
+	pheromones->columns = columns;
+	pheromones->share = share;
+	pheromones->retain = retain;
+	pheromones->n_links = n_links;
+	return OK;
+}
+
+Pheromones *pheromone_create(Game *game, double diffusion, double decay)
+{
+	Pheromones *pheromones = NULL;
+	int i;
+
+	if (!game || game_get_regions(game) != NULL || !(pheromones = pheromone_alloc(*game_get_n_spaces(game), diffusion, decay)))
+	{
+		return NULL;
+	}
+
+	pheromones->game = game;
+	for (i = 0; i < pheromones->n_spaces; i++)
+	{
+		pheromones->slots[i].id = space_get_id(game_get_spaces(game)[i]);
+		pheromones->slots[i].slot = i;
+	}
+	qsort(pheromones->slots, pheromones->n_spaces, sizeof(PheromoneSlot), pheromone_compare_slots);
+
+	if (pheromone_refresh(pheromones) == ERROR)
+	{
+		pheromone_destroy(pheromones);
+		return NULL;
+	}
+
+	return pheromones;
+}
+
+/**
+ * @brief It appends an id to a growing array
+ *
+ * @param ids A pointer to the array, which is replaced when it grows
+ * @param n A pointer to the number of ids, which is increased
+ * @param max A pointer to the capacity of the array
+ * @param id The id
+ * @return OK if it was appended, ERROR otherwise
+ */
+static Status pheromone_append(Id **ids, int *n, int *max, Id id)
+{
+	Id *grown = NULL;
+
+	if (*n == *max)
+	{
+		if (!(grown = (Id *)realloc(*ids, (*max ? *max * 2 : 1024) * sizeof(Id))))
+		{
+			return ERROR;
+		}
+		*ids = grown;
+		*max = *max ? *max * 2 : 1024;
+	}
+
+	(*ids)[(*n)++] = id;
+	return OK;
+}
+
+Pheromones *pheromone_create_from_file(char *filename, double diffusion, double decay)
+{
+	Pheromones *pheromones = NULL;
+	Record *record = NULL;
+	char *tags[] = {"#s:", "#l:"};
+	Id *spaces = NULL, *ends = NULL;
+	long id, origin, destination;
+	int n_spaces = 0, max_spaces = 0, n_ends = 0, max_ends = 0, which, n_fields, open, i;
+	Status status = OK;
+
+	if (!filename || !(record = record_open(filename)))
+	{
+		return NULL;
+	}
+
+	/* Only the ids are read, without creating the spaces and the links */
+	while (status == OK && (n_fields = record_next_of(record, tags, 2, &which)) != 0)
+	{
+		if (n_fields < 0)
+		{
+			status = ERROR;
+		}
+		else if (which == 0)
+		{
+			status = record_get_long(record, 0, "space id", &id) == OK ? pheromone_append(&spaces, &n_spaces, &max_spaces, id) : ERROR;
+		}
+		else if (record_get_long(record, 2, "link origin", &origin) == ERROR || record_get_long(record, 3, "link destination", &destination) == ERROR ||
+				 record_get_int(record, 5, "link open state", FALSE, TRUE, &open) == ERROR)
+		{
+			status = ERROR;
+		}
+		else if (open == TRUE && (pheromone_append(&ends, &n_ends, &max_ends, origin) == ERROR || pheromone_append(&ends, &n_ends, &max_ends, destination) == ERROR))
+		{
+			status = ERROR;
+		}
+	}
+	record_close(record);
+
+	if (status == OK && (pheromones = pheromone_alloc(n_spaces, diffusion, decay)))
+	{
+		for (i = 0; i < n_spaces; i++)
+		{
+			pheromones->slots[i].id = spaces[i];
+			pheromones->slots[i].slot = i;
+		}
+		qsort(pheromones->slots, n_spaces, sizeof(PheromoneSlot), pheromone_compare_slots);
+
+		if (pheromone_build(pheromones, ends, n_ends / 2) == ERROR)
+		{
+			pheromone_destroy(pheromones);
+			pheromones = NULL;
+		}
+	}
+
+	free(spaces);
+	free(ends);
+	return pheromones;
+}
+
+void pheromone_destroy(Pheromones *pheromones)
+{
+	int kind;
+
+	if (!pheromones)
+	{
+		return;
+	}
+
+	for (kind = 0; kind < PHEROMONE_KINDS; kind++)
+	{
+		free(pheromones->fields[kind]);
+	}
+	free(pheromones->slots);
+	free(pheromones->row_start);
+	free(pheromones->columns);
+	free(pheromones->share);
+	free(pheromones->retain);
+	free(pheromones->next);
+	free(pheromones->shared);
+	free(pheromones);
+}
+
+Status pheromone_refresh(Pheromones *pheromones)
+{
+	Link **links = NULL;
+	Id *ends = NULL;
+	int i, n, n_open = 0;
+	Status status;
+
+	if (!pheromones || !pheromones->game)
+	{
+		return ERROR;
+	}
+
+	links = game_get_links(pheromones->game);
+	n = *game_get_n_links(pheromones->game);
+	if (!(ends = (Id *)malloc((2 * n + 1) * sizeof(Id))))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		if (link_get_open(links[i]) == TRUE)
+		{
+			ends[2 * n_open] = link_get_origin(links[i]);
+			ends[2 * n_open + 1] = link_get_destination(links[i]);
+			n_open++;
+		}
+	}
+
+	status = pheromone_build(pheromones, ends, n_open);
+	free(ends);
+	return status;
+}
+
+Status pheromone_deposit(Pheromones *pheromones, PheromoneKind kind, Id space, double amount)
+{
+	float *field = NULL;
+	int slot;
+
+	if (!pheromones || kind < 0 || kind >= PHEROMONE_KINDS || (slot = pheromone_find_slot(pheromones, space)) < 0)
+	{
+		return ERROR;
+	}
+
+	field = pheromones->fields[kind];
+	field[slot] = (field[slot] + amount > 0) ? (float)(field[slot] + amount) : 0.0f;
+	return OK;
+}
+
+double pheromone_get(Pheromones *pheromones, PheromoneKind kind, Id space)
+{
+	int slot;
+
+	if (!pheromones || kind < 0 || kind >= PHEROMONE_KINDS || (slot = pheromone_find_slot(pheromones, space)) < 0)
+	{
+		return -1;
+	}
+
+	return pheromones->fields[kind][slot];
+}
+
+double pheromone_total(Pheromones *pheromones, PheromoneKind kind)
+{
+	double total = 0;
+	int i;
+
+	if (!pheromones || kind < 0 || kind >= PHEROMONE_KINDS)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < pheromones->n_spaces; i++)
+	{
+		total += pheromones->fields[kind][i];
+	}
+
+	return total;
+}
+
+Status pheromone_step(Pheromones *pheromones)
+{
+	const int *row_start, *columns;
+	const float *share, *retain, *field;
+	float *next, *shared;
+	float sum;
+	int kind, i, e, n;
+
+	if (!pheromones)
+	{
+		return ERROR;
+	}
+
+	n = pheromones->n_spaces;
+	row_start = pheromones->row_start;
+	columns = pheromones->columns;
+	share = pheromones->share;
+	retain = pheromones->retain;
+	shared = pheromones->shared;
+	for (kind = 0; kind < PHEROMONE_KINDS; kind++)
+	{
+		field = pheromones->fields[kind];
+		next = pheromones->next;
+
+		/* Dense part, vectorized: what every slot keeps and what it gives to each link */
+		for (i = 0; i < n; i++)
+		{
+			next[i] = field[i] * retain[i];
+			shared[i] = field[i] * share[i];
+		}
+
+		/* Sparse part, a gather per column that stays scalar without AVX2 */
+		for (i = 0; i < n; i++)
+		{
+			sum = 0.0f;
+			for (e = row_start[i]; e < row_start[i + 1]; e++)
+			{
+				sum += shared[columns[e]];
+			}
+			next[i] += sum;
+		}
+
+		pheromones->next = pheromones->fields[kind];
+		pheromones->fields[kind] = next;
+	}
+
+	return OK;
+}
+
+int pheromone_get_n_spaces(Pheromones *pheromones)
+{
+	if (!pheromones)
+	{
+		return -1;
+	}
+
+	return pheromones->n_spaces;
+}
+
+int pheromone_get_n_links(Pheromones *pheromones)
+{
+	if (!pheromones)
+	{
+		return -1;
+	}
+
+	return pheromones->n_links;
+}
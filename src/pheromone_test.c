@@ -0,0 +1,338 @@
+/**
+ * @brief It tests the pheromone fields of the spaces
+ *
+ * @file pheromone_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "pheromone.h"
+#include "game_reader.h"
+#include "link_l.h"
+#include "space.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 9
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_pheromone_create();
+
+/**
+ * @brief Test that the matrix only has the open links between known spaces.
+ */
+void test2_pheromone_create();
+
+/**
+ * @brief Test that deposits are added and never leave a space below 0.
+ */
+void test1_pheromone_deposit();
+
+/**
+ * @brief Test that a space shares its pheromone evenly across its open links.
+ */
+void test1_pheromone_step();
+
+/**
+ * @brief Test that a space without open links keeps its pheromone but for the decay.
+ */
+void test2_pheromone_step();
+
+/**
+ * @brief Test that many steps without decay keep the total amount.
+ */
+void test3_pheromone_step();
+
+/**
+ * @brief Test that the kinds of pheromone do not mix.
+ */
+void test4_pheromone_step();
+
+/**
+ * @brief Test that a refresh after opening a link uses it.
+ */
+void test1_pheromone_refresh();
+
+/**
+ * @brief Test that the fields read from a file match the fields of the loaded game.
+ */
+void test1_pheromone_create_from_file();
+
+/**
+ * @brief Main function for pheromone unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Pheromone:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_pheromone_create();
+	if (all || test == 2)
+		test2_pheromone_create();
+	if (all || test == 3)
+		test1_pheromone_deposit();
+	if (all || test == 4)
+		test1_pheromone_step();
+	if (all || test == 5)
+		test2_pheromone_step();
+	if (all || test == 6)
+		test3_pheromone_step();
+	if (all || test == 7)
+		test4_pheromone_step();
+	if (all || test == 8)
+		test1_pheromone_refresh();
+	if (all || test == 9)
+		test1_pheromone_create_from_file();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It adds a link to the game
+ *
+ * @param game A pointer to the game
+ * @param id The id of the link
+ * @param origin The id of its origin
+ * @param destination The id of its destination
+ * @param open TRUE if it is open
+ */
+static void world_link(Game *game, Id id, Id origin, Id destination, Bool open)
+{
+	Link *link = link_create(id);
+
+	link_set_origin(link, origin);
+	link_set_destination(link, destination);
+	link_set_direction(link, E);
+	link_set_open(link, open);
+	if (game_add_link(game, link) == ERROR)
+	{
+		link_destroy(link);
+	}
+}
+
+/**
+ * @brief It creates spaces 1 to 5: 1 goes to 2 and 3, 2 and 3 go back to 1, 4 has a closed door to 5, and a link leads to no space
+ *
+ * @return A new game, NULL if there was an error
+ */
+static Game *world_create()
+{
+	Game *game = NULL;
+	Space *space = NULL;
+	Id id;
+
+	if (game_create(&game) == ERROR)
+	{
+		return NULL;
+	}
+
+	/* Added backwards so slots and ids do not match */
+	for (id = 5; id >= 1; id--)
+	{
+		space = space_create(id);
+		if (game_add_space(game, space) == ERROR)
+		{
+			space_destroy(space);
+			game_destroy(game);
+			return NULL;
+		}
+	}
+
+	world_link(game, 100, 1, 2, TRUE);
+	world_link(game, 101, 1, 3, TRUE);
+	world_link(game, 102, 2, 1, TRUE);
+	world_link(game, 103, 3, 1, TRUE);
+	world_link(game, 104, 4, 5, FALSE);
+	world_link(game, 105, 5, 99, TRUE);
+	return game;
+}
+
+/**
+ * @brief Tells whether two amounts are equal but for the rounding of floats
+ */
+static Bool near(double a, double b)
+{
+	return fabs(a - b) < 1e-4 ? TRUE : FALSE;
+}
+
+void test1_pheromone_create()
+{
+	Game *game = world_create();
+
+	PRINT_TEST_RESULT(pheromone_create(NULL, 0.5, 0) == NULL && pheromone_create(game, 1.5, 0) == NULL && pheromone_create(game, 0.5, -0.1) == NULL &&
+					  pheromone_step(NULL) == ERROR && pheromone_get(NULL, PHEROMONE_FOOD, 1) == -1 && pheromone_get_n_links(NULL) == -1);
+	game_destroy(game);
+}
+
+void test2_pheromone_create()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.5, 0);
+
+	PRINT_TEST_RESULT(pheromones && pheromone_get_n_links(pheromones) == 4 && pheromone_total(pheromones, PHEROMONE_FOOD) == 0);
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test1_pheromone_deposit()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.5, 0);
+
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 2, 3);
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 2, 4);
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 3, 2);
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 3, -5);
+	PRINT_TEST_RESULT(near(pheromone_get(pheromones, PHEROMONE_FOOD, 2), 7) && pheromone_get(pheromones, PHEROMONE_FOOD, 3) == 0 &&
+					  pheromone_deposit(pheromones, PHEROMONE_FOOD, 99, 1) == ERROR && pheromone_get(pheromones, PHEROMONE_FOOD, 99) == -1 &&
+					  pheromone_deposit(pheromones, PHEROMONE_KINDS, 2, 1) == ERROR);
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test1_pheromone_step()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.5, 0);
+
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 1, 8);
+	pheromone_step(pheromones);
+	PRINT_TEST_RESULT(near(pheromone_get(pheromones, PHEROMONE_FOOD, 1), 4) && near(pheromone_get(pheromones, PHEROMONE_FOOD, 2), 2) &&
+					  near(pheromone_get(pheromones, PHEROMONE_FOOD, 3), 2) && pheromone_get(pheromones, PHEROMONE_FOOD, 4) == 0);
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test2_pheromone_step()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.5, 0.25);
+
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 4, 8);
+	pheromone_step(pheromones);
+	pheromone_step(pheromones);
+	PRINT_TEST_RESULT(near(pheromone_get(pheromones, PHEROMONE_FOOD, 4), 4.5) && pheromone_get(pheromones, PHEROMONE_FOOD, 5) == 0);
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test3_pheromone_step()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.3, 0);
+	int i;
+
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 2, 10);
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 5, 1);
+	for (i = 0; i < 100; i++)
+	{
+		pheromone_step(pheromones);
+	}
+	PRINT_TEST_RESULT(near(pheromone_total(pheromones, PHEROMONE_FOOD), 11) && near(pheromone_get(pheromones, PHEROMONE_FOOD, 1), 5) &&
+					  near(pheromone_get(pheromones, PHEROMONE_FOOD, 2), 2.5) && near(pheromone_get(pheromones, PHEROMONE_FOOD, 5), 1));
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test4_pheromone_step()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.5, 0);
+
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 1, 8);
+	pheromone_deposit(pheromones, PHEROMONE_DANGER, 4, 3);
+	pheromone_step(pheromones);
+	PRINT_TEST_RESULT(near(pheromone_total(pheromones, PHEROMONE_FOOD), 8) && near(pheromone_total(pheromones, PHEROMONE_DANGER), 3) &&
+					  pheromone_get(pheromones, PHEROMONE_DANGER, 1) == 0 && near(pheromone_get(pheromones, PHEROMONE_DANGER, 4), 3));
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test1_pheromone_refresh()
+{
+	Game *game = world_create();
+	Pheromones *pheromones = pheromone_create(game, 0.5, 0);
+	Link **links = game_get_links(game);
+	int i;
+
+	pheromone_deposit(pheromones, PHEROMONE_FOOD, 4, 8);
+	for (i = 0; i < *game_get_n_links(game); i++)
+	{
+		if (link_get_origin(links[i]) == 4)
+		{
+			link_set_open(links[i], TRUE);
+		}
+	}
+	pheromone_step(pheromones);
+	PRINT_TEST_RESULT(near(pheromone_get(pheromones, PHEROMONE_FOOD, 4), 8) && pheromone_refresh(pheromones) == OK &&
+					  pheromone_get_n_links(pheromones) == 5 && pheromone_step(pheromones) == OK &&
+					  near(pheromone_get(pheromones, PHEROMONE_FOOD, 4), 4) && near(pheromone_get(pheromones, PHEROMONE_FOOD, 5), 4));
+	pheromone_destroy(pheromones);
+	game_destroy(game);
+}
+
+void test1_pheromone_create_from_file()
+{
+	Game *game = NULL;
+	Pheromones *loaded = NULL, *read = pheromone_create_from_file("resources/anthill.dat", 0.4, 0.05);
+	Bool same = FALSE;
+	int i;
+
+	if (game_create_from_file(&game, "resources/anthill.dat") == OK && (loaded = pheromone_create(game, 0.4, 0.05)) && read)
+	{
+		pheromone_deposit(loaded, PHEROMONE_FOOD, space_get_id(game_get_spaces(game)[0]), 50);
+		pheromone_deposit(read, PHEROMONE_FOOD, space_get_id(game_get_spaces(game)[0]), 50);
+		for (i = 0; i < 20; i++)
+		{
+			pheromone_step(loaded);
+			pheromone_step(read);
+		}
+		same = pheromone_get_n_links(loaded) == pheromone_get_n_links(read) && pheromone_get_n_links(read) > 0 ? TRUE : FALSE;
+		for (i = 0; i < *game_get_n_spaces(game) && same == TRUE; i++)
+		{
+			if (!near(pheromone_get(loaded, PHEROMONE_FOOD, space_get_id(game_get_spaces(game)[i])),
+					  pheromone_get(read, PHEROMONE_FOOD, space_get_id(game_get_spaces(game)[i]))))
+			{
+				same = FALSE;
+			}
+		}
+	}
+	PRINT_TEST_RESULT(same == TRUE && pheromone_refresh(read) == ERROR && pheromone_create_from_file("missing.dat", 0.4, 0.05) == NULL);
+	pheromone_destroy(loaded);
+	pheromone_destroy(read);
+	game_destroy(game);
+}
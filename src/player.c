@@ -24,7 +24,8 @@ struct _Player
 	Id location;							/*!< Player's location*/
 	Inventory *backpack;					/*!< Player's objects*/
 	int player_health;						/*!< Player's health*/
-	char gdesc_player[PLAYER_GDESC_COLUMS]; /*!< Player's graphical description*/
+	char gdesc_player[PLAYER_GDESC_COLUMS + 1]; /*!< Player's graphical description*/
+	Character *followers;					/*!< First character of the player's party*/
 };
 
 Player *player_create(Id id)
@@ -43,6 +44,7 @@ Player *player_create(Id id)
 	newPlayer->backpack = NULL;
 	newPlayer->player_health = -1;
 	newPlayer->gdesc_player[0] = '\0';
+	newPlayer->followers = NULL;
 
 	return newPlayer;
 }
@@ -249,4 +251,56 @@ Status player_set_inventory(Player *player, Inventory *inv)
 
 	player->backpack = inv;
 	return OK;
-}
\ No newline at end of file
+}
+
+Character *player_get_followers(Player *player)
+{
+	if (player == NULL)
+	{
+		return NULL;
+	}
+
+	return player->followers;
+}
+
+Status player_add_follower(Player *player, Character *character)
+{
+	if (player == NULL || character == NULL)
+	{
+		return ERROR;
+	}
+
+	character_set_next_follower(character, player->followers);
+	player->followers = character;
+	return OK;
+}
+
+Status player_del_follower(Player *player, Character *character)
+{
+	Character *previous = NULL, *current = NULL;
+
+	if (player == NULL || character == NULL)
+	{
+		return ERROR;
+	}
+
+	for (current = player->followers; current != NULL && current != character; current = character_get_next_follower(current))
+	{
+		previous = current;
+	}
+	if (current == NULL)
+	{
+		return ERROR;
+	}
+
+	if (previous == NULL)
+	{
+		player->followers = character_get_next_follower(character);
+	}
+	else
+	{
+		character_set_next_follower(previous, character_get_next_follower(character));
+	}
+	character_set_next_follower(character, NULL);
+	return OK;
+}
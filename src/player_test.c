@@ -17,7 +17,7 @@
 /**
  * @brief Defines maximum number of tests per execution
  */
-#define MAX_TESTS 13
+#define MAX_TESTS 17
 
 /**
  * @brief Test for the creation of a player.
@@ -94,6 +94,16 @@ void test1_player_get_health();
  */
 void test2_player_get_health();
 
+/**
+ * @brief Test for adding followers to the party of a player.
+ */
+void test1_player_add_follower();
+
+/**
+ * @brief Test for taking followers out of the party of a player.
+ */
+void test1_player_del_follower();
+
 /**
  * @brief Main function for PLAYER unit tests.
  */
@@ -143,6 +153,10 @@ int main(int argc, char **argv)
 		test1_player_get_health();
 	if (all || test == 15)
 		test2_player_get_health();
+	if (all || test == 16)
+		test1_player_add_follower();
+	if (all || test == 17)
+		test1_player_del_follower();
 
 	PRINT_PASSED_PERCENTAGE;
 
@@ -248,4 +262,35 @@ void test2_player_get_health()
 {
 	Player *player = NULL;
 	PRINT_TEST_RESULT(player_get_health(player) == -1);
-}
\ No newline at end of file
+}
+
+void test1_player_add_follower()
+{
+	Player *player = player_create(1);
+	Character *first = character_create(10), *second = character_create(20);
+
+	PRINT_TEST_RESULT(player_get_followers(player) == NULL && player_add_follower(player, first) == OK && player_add_follower(player, second) == OK &&
+					  player_get_followers(player) == second && character_get_next_follower(second) == first &&
+					  character_get_next_follower(first) == NULL && player_add_follower(NULL, first) == ERROR && player_add_follower(player, NULL) == ERROR);
+	player_destroy(player);
+	character_destroy(first);
+	character_destroy(second);
+}
+
+void test1_player_del_follower()
+{
+	Player *player = player_create(1);
+	Character *first = character_create(10), *second = character_create(20), *third = character_create(30);
+
+	player_add_follower(player, first);
+	player_add_follower(player, second);
+	player_add_follower(player, third);
+	PRINT_TEST_RESULT(player_del_follower(player, second) == OK && player_get_followers(player) == third && character_get_next_follower(third) == first &&
+					  character_get_next_follower(second) == NULL && player_del_follower(player, second) == ERROR &&
+					  player_del_follower(player, third) == OK && player_get_followers(player) == first && player_del_follower(player, first) == OK &&
+					  player_get_followers(player) == NULL);
+	player_destroy(player);
+	character_destroy(first);
+	character_destroy(second);
+	character_destroy(third);
+}
@@ -0,0 +1,179 @@
+/**
+ * @brief It implements the pools the small records of the world are taken from
+ *
+ * @file pool.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Start of a block, padded so the records after it are aligned for any type
+ */
+typedef union
+{
+	void *next; /*!< Block allocated before this one */
+	long l;		/*!< Alignment of integers */
+	double d;	/*!< Alignment of floating point numbers */
+} PoolHeader;
+
+/**
+ * @brief Table of the interned strings, open addressing with linear probing
+ */
+static char **pool_strings = NULL;
+
+/**
+ * @brief Number of positions of the table of strings, a power of two
+ */
+static unsigned long pool_n_positions = 0;
+
+/**
+ * @brief Number of strings interned
+ */
+static unsigned long pool_n_strings = 0;
+
+/**
+ * @brief Protects the table of strings
+ */
+static pthread_mutex_t pool_strings_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void *pool_alloc(Pool *pool)
+{
+	PoolHeader *block = NULL;
+	void *record = NULL;
+
+	if (!pool)
+	{
+		return NULL;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	if (pool->free)
+	{
+		record = pool->free;
+		memcpy(&pool->free, record, sizeof(void *));
+	}
+	else
+	{
+		if (pool->used == pool->per_block && (block = (PoolHeader *)malloc(sizeof(PoolHeader) + pool->size * pool->per_block)) != NULL)
+		{
+			block->next = pool->blocks;
+			pool->blocks = block;
+			pool->used = 0;
+		}
+		if (pool->used < pool->per_block)
+		{
+			record = (char *)pool->blocks + sizeof(PoolHeader) + pool->size * pool->used++;
+		}
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return record;
+}
+
+void pool_release(Pool *pool, void *record)
+{
+	if (!pool || !record)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	memcpy(record, &pool->free, sizeof(void *));
+	pool->free = record;
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief FNV-1a hash of a string
+ */
+static unsigned long pool_hash(const char *string)
+{
+	unsigned long hash = 2166136261UL;
+
+	while (*string)
+	{
+		hash = (hash ^ (unsigned char)*string++) * 16777619UL;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Finds the position of a string, or the empty one where it would go
+ */
+static unsigned long pool_find(const char *string)
+{
+	unsigned long i = pool_hash(string) & (pool_n_positions - 1);
+
+	while (pool_strings[i] && strcmp(pool_strings[i], string) != 0)
+	{
+		i = (i + 1) & (pool_n_positions - 1);
+	}
+
+	return i;
+}
+
+/**
+ * @brief Doubles the positions of the table of strings
+ *
+ * @return OK if it grew, ERROR if there was not enough memory (the table is not changed)
+ */
+static Status pool_grow_strings()
+{
+	char **old = pool_strings;
+	unsigned long i, n_old = pool_n_positions;
+
+	if (!(pool_strings = (char **)calloc(n_old ? n_old * 2 : 64, sizeof(char *))))
+	{
+		pool_strings = old;
+		return ERROR;
+	}
+
+	pool_n_positions = n_old ? n_old * 2 : 64;
+	for (i = 0; i < n_old; i++)
+	{
+		if (old[i])
+		{
+			pool_strings[pool_find(old[i])] = old[i];
+		}
+	}
+
+	free(old);
+	return OK;
+}
+
+const char *pool_intern(const char *string)
+{
+	char *copy = NULL;
+	unsigned long i;
+
+	if (!string)
+	{
+		return NULL;
+	}
+
+	pthread_mutex_lock(&pool_strings_lock);
+	if ((pool_n_strings + 1) * 4 > pool_n_positions * 3 && pool_grow_strings() == ERROR)
+	{
+		pthread_mutex_unlock(&pool_strings_lock);
+		return NULL;
+	}
+
+	i = pool_find(string);
+	if (!pool_strings[i] && (copy = (char *)malloc(strlen(string) + 1)) != NULL)
+	{
+		strcpy(copy, string);
+		pool_strings[i] = copy;
+		pool_n_strings++;
+	}
+	copy = pool_strings[i];
+	pthread_mutex_unlock(&pool_strings_lock);
+
+	return copy;
+}
@@ -0,0 +1,161 @@
+/**
+ * @brief It tests the pools of records and the interned strings
+ *
+ * @file pool_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pool.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 4
+
+/**
+ * @brief Record used by the tests
+ */
+typedef struct
+{
+	long a; /*!< First field */
+	long b; /*!< Second field */
+} Pair;
+
+/**
+ * @brief Pool of the tests, with small blocks so that they fill up
+ */
+static Pool pair_pool = POOL_INITIALIZER(Pair, 4);
+
+/**
+ * @brief Test that the records of a block are packed and different blocks are used when it is full.
+ */
+void test1_pool_alloc();
+
+/**
+ * @brief Test that a record given back is the next one taken.
+ */
+void test1_pool_release();
+
+/**
+ * @brief Test that equal strings are interned once.
+ */
+void test1_pool_intern();
+
+/**
+ * @brief Test that many strings are kept apart as the table grows.
+ */
+void test2_pool_intern();
+
+/**
+ * @brief Main function for pool unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Pool:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_pool_alloc();
+	if (all || test == 2)
+		test1_pool_release();
+	if (all || test == 3)
+		test1_pool_intern();
+	if (all || test == 4)
+		test2_pool_intern();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+void test1_pool_alloc()
+{
+	Pair *pairs[6];
+	int i;
+
+	for (i = 0; i < 6; i++)
+	{
+		pairs[i] = (Pair *)pool_alloc(&pair_pool);
+		pairs[i]->a = i;
+		pairs[i]->b = -i;
+	}
+
+	PRINT_TEST_RESULT(pool_alloc(NULL) == NULL && pairs[1] == pairs[0] + 1 && pairs[3] == pairs[0] + 3 && pairs[5] == pairs[4] + 1 &&
+					  pairs[2]->a == 2 && pairs[2]->b == -2);
+	for (i = 0; i < 6; i++)
+	{
+		pool_release(&pair_pool, pairs[i]);
+	}
+}
+
+void test1_pool_release()
+{
+	Pair *a = (Pair *)pool_alloc(&pair_pool), *b = (Pair *)pool_alloc(&pair_pool), *c = NULL;
+
+	pool_release(&pair_pool, a);
+	pool_release(&pair_pool, NULL);
+	c = (Pair *)pool_alloc(&pair_pool);
+	PRINT_TEST_RESULT(a != b && c == a);
+	pool_release(&pair_pool, b);
+	pool_release(&pair_pool, c);
+}
+
+void test1_pool_intern()
+{
+	char name[] = "Corridor_1";
+	const char *a = pool_intern(name), *b = NULL;
+
+	name[9] = '2';
+	b = pool_intern(name);
+	PRINT_TEST_RESULT(a && b && a != b && strcmp(a, "Corridor_1") == 0 && strcmp(b, "Corridor_2") == 0 && pool_intern("Corridor_1") == a &&
+					  pool_intern(NULL) == NULL);
+}
+
+void test2_pool_intern()
+{
+	const char *first[1000];
+	char name[32];
+	Bool same = TRUE;
+	int i;
+
+	for (i = 0; i < 1000; i++)
+	{
+		sprintf(name, "Space_%d", i);
+		first[i] = pool_intern(name);
+	}
+	for (i = 0; i < 1000 && same == TRUE; i++)
+	{
+		sprintf(name, "Space_%d", i);
+		same = pool_intern(name) == first[i] && strcmp(first[i], name) == 0 ? TRUE : FALSE;
+	}
+	PRINT_TEST_RESULT(same == TRUE);
+}
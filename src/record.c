@@ -0,0 +1,442 @@
+/**
+ * @brief It implements the record scanner of the data files
+ *
+ * @file record.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "record.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Private implementation of the record scanner
+ */
+struct _Record
+{
+	char *name;						  /*!< Name of the file, used in the errors */
+	char *buffer;					  /*!< Whole text of the file, ended by '\0' */
+	Bool owner;						  /*!< Whether the buffer is freed with the scanner */
+	char *next;						  /*!< Start of the next line to scan */
+	char *end;						  /*!< End of the text to scan */
+	int next_line;					  /*!< Number of the next line to scan */
+	int line;						  /*!< Line of the current record, 0 if there is none */
+	int end_column;					  /*!< Column after the last character of the current record */
+	int n_fields;					  /*!< Number of fields of the current record */
+	Field fields[RECORD_MAX_FIELDS]; /*!< Fields of the current record */
+};
+
+/**
+ * @brief It creates a scanner over a buffer
+ *
+ * @param name The name of the file
+ * @param buffer The text
+ * @param owner TRUE if the buffer was allocated with malloc and belongs to the scanner
+ * @return A new scanner, NULL if there was an error (an owned buffer is freed)
+ */
+static Record *record_create(char *name, char *buffer, Bool owner)
+{
+	Record *record = NULL;
+
+	if (!(record = (Record *)malloc(sizeof(Record))) || !(record->name = (char *)malloc(strlen(name) + 1)))
+	{
+		if (owner == TRUE)
+		{
+			free(buffer);
+		}
+		free(record);
+		return NULL;
+	}
+
+	strcpy(record->name, name);
+	record->buffer = buffer;
+	record->owner = owner;
+	record->next = buffer;
+	record->end = buffer + strlen(buffer);
+	record->next_line = 1;
+	record->line = 0;
+	record->end_column = 0;
+	record->n_fields = 0;
+
+	return record;
+}
+
+Record *record_open(char *filename)
+{
+	FILE *f = NULL;
+	char *buffer = NULL;
+	long size;
+
+	if (!filename || !(f = fopen(filename, "rb")))
+	{
+		return NULL;
+	}
+
+	if (fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 0 || fseek(f, 0, SEEK_SET) != 0)
+	{
+		fclose(f);
+		return NULL;
+	}
+
+	if (!(buffer = (char *)malloc(size + 1)))
+	{
+		fclose(f);
+		return NULL;
+	}
+
+	if (fread(buffer, 1, size, f) != (size_t)size)
+	{
+		free(buffer);
+		fclose(f);
+		return NULL;
+	}
+	buffer[size] = '\0';
+	fclose(f);
+
+	return record_create(filename, buffer, TRUE);
+}
+
+Record *record_open_text(char *name, char *text)
+{
+	char *buffer = NULL;
+
+	if (!name || !text || !(buffer = (char *)malloc(strlen(text) + 1)))
+	{
+		return NULL;
+	}
+
+	strcpy(buffer, text);
+	return record_create(name, buffer, TRUE);
+}
+
+void record_close(Record *record)
+{
+	if (!record)
+	{
+		return;
+	}
+
+	if (record->owner == TRUE)
+	{
+		free(record->buffer);
+	}
+	free(record->name);
+	free(record);
+}
+
+int record_split(Record *record, int n, long min_size, Record **chunks)
+{
+	char *start, *stop, *p;
+	long size;
+	int i, line;
+
+	if (!record || n <= 0 || !chunks)
+	{
+		return 0;
+	}
+
+	size = (long)(record->end - record->next);
+	if (min_size > 0 && size / min_size < n)
+	{
+		n = (int)(size / min_size);
+	}
+	if (n < 1)
+	{
+		n = 1;
+	}
+
+	start = record->next;
+	line = record->next_line;
+	for (i = 0; i < n; i++)
+	{
+		/* Every chunk ends after a whole line */
+		stop = (i == n - 1) ? record->end : record->next + size / n * (i + 1);
+		if (stop < start)
+		{
+			stop = start;
+		}
+		if (stop < record->end && (p = (char *)memchr(stop, '\n', record->end - stop)) != NULL)
+		{
+			stop = p + 1;
+		}
+		else
+		{
+			stop = record->end;
+		}
+
+		if (!(chunks[i] = record_create(record->name, record->buffer, FALSE)))
+		{
+			for (i--; i >= 0; i--)
+			{
+				record_close(chunks[i]);
+			}
+			return 0;
+		}
+		chunks[i]->next = start;
+		chunks[i]->end = stop;
+		chunks[i]->next_line = line;
+
+		/* The first line of the next chunk is needed for its errors */
+		for (p = start; p < stop && (p = (char *)memchr(p, '\n', stop - p)) != NULL; p++)
+		{
+			line++;
+		}
+		start = stop;
+	}
+
+	return n;
+}
+
+int record_next(Record *record, char *tag)
+{
+	return record_next_of(record, &tag, 1, NULL);
+}
+
+int record_next_of(Record *record, char **tags, int n_tags, int *which)
+{
+	char *line, *end, *p;
+	int i, tag_len = 0;
+
+	if (!record || !tags || n_tags <= 0)
+	{
+		return 0;
+	}
+
+	record->line = 0;
+	record->n_fields = 0;
+
+	while (record->next < record->end)
+	{
+		line = record->next;
+		if (!(end = (char *)memchr(line, '\n', record->end - line)))
+		{
+			end = record->end;
+			record->next = end;
+		}
+		else
+		{
+			record->next = end + 1;
+		}
+		record->line = record->next_line++;
+
+		for (i = 0; i < n_tags; i++)
+		{
+			tag_len = (int)strlen(tags[i]);
+			if ((int)(end - line) >= tag_len && strncmp(line, tags[i], tag_len) == 0)
+			{
+				break;
+			}
+		}
+		if (i == n_tags)
+		{
+			continue;
+		}
+		if (which)
+		{
+			*which = i;
+		}
+
+		if (end > line && end[-1] == '\r')
+		{
+			end--;
+		}
+		*end = '\0';
+		record->end_column = (int)(end - line) + 1;
+
+		/* Fields are cut in place, every '|' becomes the end of a string */
+		p = line + tag_len;
+		for (;;)
+		{
+			if (record->n_fields == RECORD_MAX_FIELDS)
+			{
+				record_error(record, -1, "too many fields");
+				return -1;
+			}
+
+			record->fields[record->n_fields].ptr = p;
+			record->fields[record->n_fields].column = (int)(p - line) + 1;
+			while (*p != '|' && *p != '\0')
+			{
+				p++;
+			}
+			record->fields[record->n_fields].len = (int)(p - record->fields[record->n_fields].ptr);
+			record->n_fields++;
+
+			if (*p == '\0')
+			{
+				break;
+			}
+			*p++ = '\0';
+		}
+
+		/* "a|b|" has two fields, not three */
+		if (record->n_fields > 1 && record->fields[record->n_fields - 1].len == 0)
+		{
+			record->n_fields--;
+		}
+
+		return record->n_fields;
+	}
+
+	record->line = 0;
+	return 0;
+}
+
+Field *record_get_field(Record *record, int position)
+{
+	if (!record || record->line == 0 || position < 0 || position >= record->n_fields)
+	{
+		return NULL;
+	}
+
+	return &record->fields[position];
+}
+
+char *record_get_string(Record *record, int position, int max_len, char *what)
+{
+	Field *field = NULL;
+	char message[WORD_SIZE];
+
+	if (!record || !what)
+	{
+		return NULL;
+	}
+
+	if (!(field = record_get_field(record, position)))
+	{
+		sprintf(message, "missing %.100s", what);
+		record_error(record, position, message);
+		return NULL;
+	}
+
+	if (field->len > max_len)
+	{
+		sprintf(message, "%.100s is %d characters long, the maximum is %d", what, field->len, max_len);
+		record_error(record, position, message);
+		return NULL;
+	}
+
+	return field->ptr;
+}
+
+Status record_get_long(Record *record, int position, char *what, long *value)
+{
+	Field *field = NULL;
+	char message[WORD_SIZE];
+	char *p, *end;
+	Bool negative = FALSE, valid;
+	unsigned long n = 0, limit;
+
+	if (!record || !what || !value)
+	{
+		return ERROR;
+	}
+
+	if (!(field = record_get_field(record, position)))
+	{
+		sprintf(message, "missing %.100s", what);
+		record_error(record, position, message);
+		return ERROR;
+	}
+
+	p = field->ptr;
+	end = field->ptr + field->len;
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-') ? TRUE : FALSE;
+		p++;
+	}
+
+	/* The magnitude of LONG_MIN is one more than LONG_MAX */
+	limit = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+	valid = (p < end) ? TRUE : FALSE;
+	for (; valid == TRUE && p < end; p++)
+	{
+		if (*p < '0' || *p > '9' || n > (limit - (unsigned long)(*p - '0')) / 10)
+		{
+			valid = FALSE;
+		}
+		else
+		{
+			n = n * 10 + (unsigned long)(*p - '0');
+		}
+	}
+
+	if (valid == FALSE)
+	{
+		sprintf(message, "invalid %.100s '%.100s'", what, field->ptr);
+		record_error(record, position, message);
+		return ERROR;
+	}
+
+	*value = (negative && n > 0) ? -(long)(n - 1) - 1 : (long)n;
+	return OK;
+}
+
+Status record_get_int(Record *record, int position, char *what, int min, int max, int *value)
+{
+	char message[WORD_SIZE];
+	long n;
+
+	if (!value || record_get_long(record, position, what, &n) == ERROR)
+	{
+		return ERROR;
+	}
+
+	if (n < min || n > max)
+	{
+		sprintf(message, "%.100s %ld is out of range [%d, %d]", what, n, min, max);
+		record_error(record, position, message);
+		return ERROR;
+	}
+
+	*value = (int)n;
+	return OK;
+}
+
+void record_error(Record *record, int position, char *message)
+{
+	int column = 1;
+
+	if (!record || !message)
+	{
+		return;
+	}
+
+	if (position >= 0 && position < record->n_fields)
+	{
+		column = record->fields[position].column;
+	}
+	else if (position >= record->n_fields)
+	{
+		column = record->end_column;
+	}
+
+	fprintf(stderr, "Error: %s:%d:%d: %s.\n", record->name, record->line, column, message);
+}
+
+int record_get_line(Record *record)
+{
+	if (!record)
+	{
+		return 0;
+	}
+
+	return record->line;
+}
+
+Status record_set_line(Record *record, int line)
+{
+	if (!record || line < 1)
+	{
+		return ERROR;
+	}
+
+	record->next_line = line;
+	return OK;
+}
@@ -0,0 +1,296 @@
+/**
+ * @brief It tests record module
+ *
+ * @file record_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "record.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 14
+
+/**
+ * @brief Test that only the records with the tag are returned.
+ */
+void test1_record_next();
+
+/**
+ * @brief Test that the final '|' does not add an empty field.
+ */
+void test2_record_next();
+
+/**
+ * @brief Test that there are no records after the last one.
+ */
+void test3_record_next();
+
+/**
+ * @brief Test that lines longer than WORD_SIZE are not truncated.
+ */
+void test4_record_next();
+
+/**
+ * @brief Test that the fields point into the record without copies.
+ */
+void test1_record_get_field();
+
+/**
+ * @brief Test the column of a field.
+ */
+void test2_record_get_field();
+
+/**
+ * @brief Test that a missing field is an error.
+ */
+void test1_record_get_string();
+
+/**
+ * @brief Test that a too long field is an error.
+ */
+void test2_record_get_string();
+
+/**
+ * @brief Test a valid negative number.
+ */
+void test1_record_get_long();
+
+/**
+ * @brief Test that trailing characters are an error.
+ */
+void test2_record_get_long();
+
+/**
+ * @brief Test that overflowing numbers are an error.
+ */
+void test3_record_get_long();
+
+/**
+ * @brief Test that numbers out of range are an error.
+ */
+void test1_record_get_int();
+
+/**
+ * @brief Test that the chunks keep every record and the lines of the file.
+ */
+void test1_record_split();
+
+/**
+ * @brief Test that records of several types are found in order.
+ */
+void test1_record_next_of();
+
+/**
+ * @brief Main function for RECORD unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Record:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 || test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_record_next();
+	if (all || test == 2)
+		test2_record_next();
+	if (all || test == 3)
+		test3_record_next();
+	if (all || test == 4)
+		test4_record_next();
+	if (all || test == 5)
+		test1_record_get_field();
+	if (all || test == 6)
+		test2_record_get_field();
+	if (all || test == 7)
+		test1_record_get_string();
+	if (all || test == 8)
+		test2_record_get_string();
+	if (all || test == 9)
+		test1_record_get_long();
+	if (all || test == 10)
+		test2_record_get_long();
+	if (all || test == 11)
+		test3_record_get_long();
+	if (all || test == 12)
+		test1_record_get_int();
+	if (all || test == 13)
+		test1_record_split();
+	if (all || test == 14)
+		test1_record_next_of();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+void test1_record_next()
+{
+	Record *r = record_open_text("test", "#s:1|A|\n#o:2|B|1\n#s:3|C|\n");
+	int n1 = record_next(r, "#s:");
+	int line1 = record_get_line(r);
+	int n2 = record_next(r, "#s:");
+	int line2 = record_get_line(r);
+	PRINT_TEST_RESULT(n1 == 2 && line1 == 1 && n2 == 2 && line2 == 3);
+	record_close(r);
+}
+
+void test2_record_next()
+{
+	Record *r = record_open_text("test", "#o:2|B|1|\r\n");
+	PRINT_TEST_RESULT(record_next(r, "#o:") == 3 && strcmp(record_get_field(r, 2)->ptr, "1") == 0);
+	record_close(r);
+}
+
+void test3_record_next()
+{
+	Record *r = record_open_text("test", "#o:2|B|1");
+	record_next(r, "#o:");
+	PRINT_TEST_RESULT(record_next(r, "#o:") == 0 && record_get_field(r, 0) == NULL);
+	record_close(r);
+}
+
+void test4_record_next()
+{
+	char *text = (char *)malloc(2 * WORD_SIZE + 16);
+	Record *r = NULL;
+
+	strcpy(text, "#c:1|");
+	memset(text + 5, 'x', 2 * WORD_SIZE);
+	strcpy(text + 5 + 2 * WORD_SIZE, "|7\n");
+	r = record_open_text("test", text);
+	PRINT_TEST_RESULT(record_next(r, "#c:") == 3 && record_get_field(r, 1)->len == 2 * WORD_SIZE);
+	record_close(r);
+	free(text);
+}
+
+void test1_record_get_field()
+{
+	Record *r = record_open_text("test", "#s:11|Entry|");
+	Field *f1, *f2;
+	record_next(r, "#s:");
+	f1 = record_get_field(r, 0);
+	f2 = record_get_field(r, 1);
+	PRINT_TEST_RESULT(f1->len == 2 && f2->ptr == f1->ptr + 3 && strcmp(f2->ptr, "Entry") == 0);
+	record_close(r);
+}
+
+void test2_record_get_field()
+{
+	Record *r = record_open_text("test", "#s:11|Entry|");
+	record_next(r, "#s:");
+	PRINT_TEST_RESULT(record_get_field(r, 1)->column == 7);
+	record_close(r);
+}
+
+void test1_record_get_string()
+{
+	Record *r = record_open_text("test", "#s:11|");
+	record_next(r, "#s:");
+	PRINT_TEST_RESULT(record_get_string(r, 1, WORD_SIZE, "space name") == NULL);
+	record_close(r);
+}
+
+void test2_record_get_string()
+{
+	Record *r = record_open_text("test", "#p:1|ant|m0^^|");
+	record_next(r, "#p:");
+	PRINT_TEST_RESULT(record_get_string(r, 2, 3, "player graphic description") == NULL);
+	record_close(r);
+}
+
+void test1_record_get_long()
+{
+	Record *r = record_open_text("test", "#o:-42|");
+	long n = 0;
+	record_next(r, "#o:");
+	PRINT_TEST_RESULT(record_get_long(r, 0, "object id", &n) == OK && n == -42);
+	record_close(r);
+}
+
+void test2_record_get_long()
+{
+	Record *r = record_open_text("test", "#o:12x|");
+	long n = 0;
+	record_next(r, "#o:");
+	PRINT_TEST_RESULT(record_get_long(r, 0, "object id", &n) == ERROR && n == 0);
+	record_close(r);
+}
+
+void test3_record_get_long()
+{
+	Record *r = record_open_text("test", "#o:99999999999999999999999|");
+	long n = 0;
+	record_next(r, "#o:");
+	PRINT_TEST_RESULT(record_get_long(r, 0, "object id", &n) == ERROR);
+	record_close(r);
+}
+
+void test1_record_get_int()
+{
+	Record *r = record_open_text("test", "#l:1|a|1|2|4|1|");
+	int dir = 0;
+	record_next(r, "#l:");
+	PRINT_TEST_RESULT(record_get_int(r, 4, "link direction", 0, 3, &dir) == ERROR);
+	record_close(r);
+}
+
+void test1_record_split()
+{
+	Record *r = record_open_text("test", "#s:1|\n#s:2|\n#o:3|\n#s:4|\n#s:5|\n");
+	Record *chunks[3];
+	int n, i, found = 0, last_line = 0;
+
+	n = record_split(r, 3, 0, chunks);
+	for (i = 0; i < n; i++)
+	{
+		while (record_next(chunks[i], "#s:") > 0)
+		{
+			found++;
+			last_line = record_get_line(chunks[i]);
+		}
+		record_close(chunks[i]);
+	}
+	PRINT_TEST_RESULT(n == 3 && found == 4 && last_line == 5);
+	record_close(r);
+}
+
+void test1_record_next_of()
+{
+	char *tags[] = {"#s:", "#o:"};
+	Record *r = record_open_text("test", "#p:1|\n#o:3|\n#s:4|\n");
+	int which1 = -1, which2 = -1;
+
+	record_next_of(r, tags, 2, &which1);
+	record_next_of(r, tags, 2, &which2);
+	PRINT_TEST_RESULT(which1 == 1 && which2 == 0 && record_next_of(r, tags, 2, NULL) == 0);
+	record_close(r);
+}
@@ -0,0 +1,1045 @@
+/**
+ * @brief It implements the region cache
+ *
+ * @file region.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "region.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "game_reader.h"
+#include "record.h"
+
+/**
+ * @brief Approximate heap size of a loaded space with its two sets
+ */
+#define REGION_SPACE_BYTES 2800L
+
+/**
+ * @brief Approximate heap size of a loaded link
+ */
+#define REGION_LINK_BYTES 1040L
+
+/**
+ * @brief Number of directions a link can have
+ */
+#define REGION_DIRECTIONS 4
+
+/**
+ * @brief First bytes of an index file, the last digits are the version
+ */
+static const char region_magic[8] = "AHIDX02";
+
+/**
+ * @brief Header of an index file
+ */
+typedef struct
+{
+	char magic[8];	  /*!< region_magic */
+	long world_size;  /*!< Size of the indexed world file, to find out of date indexes */
+	long world_mtime; /*!< Modification time of the indexed world file, for changes that keep its size */
+	long n_spaces;	  /*!< Number of IndexEntry that follow */
+	long n_others;	  /*!< Number of IndexOther after the entries */
+} IndexHeader;
+
+/**
+ * @brief Entry of an index file for a space, sorted by id
+ */
+typedef struct
+{
+	Id id;							 /*!< Id of the space */
+	long offset;					 /*!< Offset of its #s: record */
+	long links[REGION_DIRECTIONS]; /*!< Offsets of its first #l: record in each direction, -1 if there is none */
+} IndexEntry;
+
+/**
+ * @brief Entry of an index file for a player, object or character record, in file order
+ */
+typedef struct
+{
+	long offset; /*!< Offset of the record */
+	long tag;	 /*!< 'p', 'o' or 'c' */
+} IndexOther;
+
+/**
+ * @brief A space of the index and its entities when its region is loaded
+ */
+typedef struct
+{
+	IndexEntry entry;				/*!< Index entry of the space */
+	Space *space;					/*!< The space, NULL while its region is not loaded */
+	Link *links[REGION_DIRECTIONS]; /*!< Its outgoing links, NULL while its region is not loaded */
+	Bool discovered;				/*!< Whether the space was discovered, kept while it is not loaded */
+} SpaceSlot;
+
+/**
+ * @brief State of a region
+ */
+typedef struct
+{
+	Bool resident;			 /*!< Whether the region is loaded */
+	unsigned long last_use;	 /*!< Value of the cache clock when it was last used */
+	int n_links;			 /*!< Number of loaded links */
+	Character **characters;	 /*!< Characters located in the region, put in their spaces when it is loaded */
+	Id *locations;			 /*!< Spaces of those characters */
+	int n_characters;		 /*!< Number of characters */
+	int max_characters;		 /*!< Capacity of characters and locations */
+} Region;
+
+/**
+ * @brief Private implementation of the region cache
+ */
+struct _RegionCache
+{
+	char *world;		  /*!< Name of the world file */
+	FILE *f;			  /*!< The world file, open while the cache exists */
+	SpaceSlot *slots;	  /*!< Every space of the world, sorted by id */
+	long n_slots;		  /*!< Number of spaces */
+	IndexOther *others;	  /*!< Players, objects and characters of the world */
+	long n_others;		  /*!< Number of those records */
+	Region *regions;	  /*!< Regions, REGION_SPACES slots each */
+	long n_regions;		  /*!< Number of regions */
+	long budget;		  /*!< Memory budget in bytes */
+	long resident_bytes;  /*!< Memory used by the loaded regions */
+	long n_loads;		  /*!< Number of regions read from the file */
+	unsigned long clock;  /*!< Counter of uses, for the LRU order */
+	char *line;			  /*!< Buffer of the last line read */
+	size_t line_size;	  /*!< Size of the line buffer */
+};
+
+/**
+ * @brief Index entries collected while the index is built
+ */
+typedef struct
+{
+	IndexEntry *spaces; /*!< Spaces in file order */
+	long n_spaces;		/*!< Number of spaces */
+	long max_spaces;	/*!< Capacity of spaces */
+	long *links;		/*!< Triplets of origin, direction and offset of the links */
+	long n_links;		/*!< Number of links */
+	long max_links;		/*!< Capacity of links, in triplets */
+	IndexOther *others; /*!< Other records */
+	long n_others;		/*!< Number of other records */
+	long max_others;	/*!< Capacity of others */
+} IndexBuild;
+
+/**
+ * @brief Reads a whole line of any length
+ *
+ * @param f The file
+ * @param line The buffer, grown when needed
+ * @param size The size of the buffer
+ * @return The length of the line, -1 at the end of the file
+ */
+static long region_read_line(FILE *f, char **line, size_t *size)
+{
+	size_t len = 0;
+	char *grown = NULL;
+
+	if (!*line)
+	{
+		if (!(*line = (char *)malloc(256)))
+		{
+			return -1;
+		}
+		*size = 256;
+	}
+
+	while (fgets(*line + len, (int)(*size - len), f))
+	{
+		len += strlen(*line + len);
+		if ((*line)[len - 1] == '\n' || len + 1 < *size)
+		{
+			return (long)len;
+		}
+
+		if (!(grown = (char *)realloc(*line, *size * 2)))
+		{
+			return -1;
+		}
+		*line = grown;
+		*size *= 2;
+	}
+
+	return len > 0 ? (long)len : -1;
+}
+
+/**
+ * @brief Gets the time a file was last modified
+ *
+ * @param name The name of the file
+ * @return The time, -1 if there was an error
+ */
+static long region_get_mtime(char *name)
+{
+	struct stat info;
+
+	if (stat(name, &info) != 0)
+	{
+		return -1;
+	}
+
+	return (long)info.st_mtime;
+}
+
+/**
+ * @brief Grows an array of the index build if it is full
+ *
+ * @return OK if there is room for one more element, ERROR otherwise
+ */
+static Status region_build_grow(void **array, long *max, long n, size_t element)
+{
+	void *grown = NULL;
+
+	if (n < *max)
+	{
+		return OK;
+	}
+
+	if (!(grown = realloc(*array, (*max * 2 + 1024) * element)))
+	{
+		return ERROR;
+	}
+	*array = grown;
+	*max = *max * 2 + 1024;
+
+	return OK;
+}
+
+/**
+ * @brief Parses and indexes one record of the world
+ *
+ * The whole record is checked, so that loading its region later cannot fail.
+ *
+ * @param build The entries collected
+ * @param record The scanner of the line
+ * @param tag The type of the record
+ * @param offset The offset of the line
+ * @return OK if the record is valid, ERROR otherwise
+ */
+static Status region_build_record(IndexBuild *build, Record *record, char tag, long offset)
+{
+	Space *space = NULL;
+	Link *link = NULL;
+	int i;
+
+	if (tag == 's')
+	{
+		if (game_reader_parse_space(record, &space) == ERROR ||
+			region_build_grow((void **)&build->spaces, &build->max_spaces, build->n_spaces, sizeof(IndexEntry)) == ERROR)
+		{
+			space_destroy(space);
+			return ERROR;
+		}
+		build->spaces[build->n_spaces].id = space_get_id(space);
+		build->spaces[build->n_spaces].offset = offset;
+		for (i = 0; i < REGION_DIRECTIONS; i++)
+		{
+			build->spaces[build->n_spaces].links[i] = -1;
+		}
+		build->n_spaces++;
+		space_destroy(space);
+	}
+	else if (tag == 'l')
+	{
+		if (game_reader_parse_link(record, &link) == ERROR ||
+			region_build_grow((void **)&build->links, &build->max_links, build->n_links * 3 + 2, sizeof(long)) == ERROR)
+		{
+			link_destroy(link);
+			return ERROR;
+		}
+		build->links[build->n_links * 3] = link_get_origin(link);
+		build->links[build->n_links * 3 + 1] = link_get_direction(link);
+		build->links[build->n_links * 3 + 2] = offset;
+		build->n_links++;
+		link_destroy(link);
+	}
+	else
+	{
+		if (region_build_grow((void **)&build->others, &build->max_others, build->n_others, sizeof(IndexOther)) == ERROR)
+		{
+			return ERROR;
+		}
+		build->others[build->n_others].offset = offset;
+		build->others[build->n_others].tag = tag;
+		build->n_others++;
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Compares two index entries by id, and by offset for repeated ids, for qsort
+ */
+static int region_compare_entries(const void *a, const void *b)
+{
+	const IndexEntry *ea = (const IndexEntry *)a, *eb = (const IndexEntry *)b;
+
+	if (ea->id != eb->id)
+	{
+		return (ea->id > eb->id) - (ea->id < eb->id);
+	}
+	return (ea->offset > eb->offset) - (ea->offset < eb->offset);
+}
+
+/**
+ * @brief Finds an entry in an array sorted by id
+ *
+ * @return Its position, -1 if there is no entry with that id
+ */
+static long region_find_entry(IndexEntry *entries, long stride, long n, Id id)
+{
+	long low = 0, high = n - 1, mid;
+	Id mid_id;
+
+	while (low <= high)
+	{
+		mid = low + (high - low) / 2;
+		mid_id = ((IndexEntry *)((char *)entries + mid * stride))->id;
+		if (mid_id == id)
+		{
+			return mid;
+		}
+		else if (mid_id < id)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+
+	return -1;
+}
+
+Status region_build_index(char *world, char *index)
+{
+	char *tags[] = {"#s:", "#l:", "#p:", "#o:", "#c:"};
+	IndexBuild build;
+	IndexHeader header;
+	Record *record = NULL;
+	FILE *f = NULL, *out = NULL;
+	char *line = NULL;
+	size_t line_size = 0;
+	long len, offset = 0, mtime, k, i, j;
+	int line_number = 0, which;
+	Status status = OK;
+
+	/* The time is taken before reading, so a change made while the index is built makes it out of date */
+	if (!world || !index || (mtime = region_get_mtime(world)) < 0 || !(f = fopen(world, "rb")))
+	{
+		return ERROR;
+	}
+
+	memset(&build, 0, sizeof(IndexBuild));
+	while (status == OK && (len = region_read_line(f, &line, &line_size)) >= 0)
+	{
+		line_number++;
+		if (line[0] == '#' && (record = record_open_text(world, line)) != NULL)
+		{
+			record_set_line(record, line_number);
+			which = -1;
+			if (record_next_of(record, tags, 5, &which) < 0 ||
+				(which >= 0 && region_build_record(&build, record, tags[which][1], offset) == ERROR))
+			{
+				status = ERROR;
+			}
+			record_close(record);
+		}
+		offset += len;
+	}
+	fclose(f);
+
+	/* Spaces are sorted by id, keeping the first of repeated ids like game_get_space */
+	qsort(build.spaces, build.n_spaces, sizeof(IndexEntry), region_compare_entries);
+	for (i = 0, j = 0; i < build.n_spaces; i++)
+	{
+		if (j == 0 || build.spaces[j - 1].id != build.spaces[i].id)
+		{
+			build.spaces[j++] = build.spaces[i];
+		}
+	}
+	build.n_spaces = j;
+
+	/* And each one gets the first link of the file in each direction, like game_get_connection */
+	for (i = 0; i < build.n_links; i++)
+	{
+		k = region_find_entry(build.spaces, sizeof(IndexEntry), build.n_spaces, build.links[i * 3]);
+		if (k >= 0 && build.spaces[k].links[build.links[i * 3 + 1]] < 0)
+		{
+			build.spaces[k].links[build.links[i * 3 + 1]] = build.links[i * 3 + 2];
+		}
+	}
+
+	if (status == OK && (out = fopen(index, "wb")) != NULL)
+	{
+		memset(&header, 0, sizeof(IndexHeader));
+		memcpy(header.magic, region_magic, sizeof(header.magic));
+		header.world_size = offset;
+		header.world_mtime = mtime;
+		header.n_spaces = build.n_spaces;
+		header.n_others = build.n_others;
+		if (fwrite(&header, sizeof(IndexHeader), 1, out) != 1 ||
+			fwrite(build.spaces, sizeof(IndexEntry), build.n_spaces, out) != (size_t)build.n_spaces ||
+			fwrite(build.others, sizeof(IndexOther), build.n_others, out) != (size_t)build.n_others)
+		{
+			status = ERROR;
+		}
+		if (fclose(out) != 0)
+		{
+			status = ERROR;
+		}
+	}
+	else
+	{
+		status = ERROR;
+	}
+
+	free(line);
+	free(build.spaces);
+	free(build.links);
+	free(build.others);
+	return status;
+}
+
+/**
+ * @brief Reads an index if it matches the size and modification time of the world file
+ *
+ * @param cache The cache where the index is stored
+ * @param index The name of the index file
+ * @param world_size The size of the world file
+ * @param world_mtime The modification time of the world file
+ * @return OK if the index was read, ERROR if it is missing, invalid or out of date
+ */
+static Status region_read_index(RegionCache *cache, char *index, long world_size, long world_mtime)
+{
+	IndexHeader header;
+	FILE *f = NULL;
+	long i;
+	int j;
+	Status status = OK;
+
+	if (!(f = fopen(index, "rb")))
+	{
+		return ERROR;
+	}
+
+	if (fread(&header, sizeof(IndexHeader), 1, f) != 1 || memcmp(header.magic, region_magic, sizeof(header.magic)) != 0 ||
+		header.world_size != world_size || header.world_mtime != world_mtime || header.n_spaces < 0 || header.n_others < 0 ||
+		!(cache->slots = (SpaceSlot *)calloc(header.n_spaces + 1, sizeof(SpaceSlot))) ||
+		!(cache->others = (IndexOther *)calloc(header.n_others + 1, sizeof(IndexOther))))
+	{
+		fclose(f);
+		return ERROR;
+	}
+
+	for (i = 0; i < header.n_spaces && status == OK; i++)
+	{
+		if (fread(&cache->slots[i].entry, sizeof(IndexEntry), 1, f) != 1)
+		{
+			status = ERROR;
+		}
+		for (j = 0; j < REGION_DIRECTIONS; j++)
+		{
+			cache->slots[i].links[j] = NULL;
+		}
+		cache->slots[i].space = NULL;
+		cache->slots[i].discovered = FALSE;
+	}
+	if (status == OK && fread(cache->others, sizeof(IndexOther), header.n_others, f) != (size_t)header.n_others)
+	{
+		status = ERROR;
+	}
+	fclose(f);
+
+	cache->n_slots = header.n_spaces;
+	cache->n_others = header.n_others;
+	return status;
+}
+
+RegionCache *region_cache_open(char *world, long budget)
+{
+	RegionCache *cache = NULL;
+	char *index = NULL;
+	long world_size, world_mtime;
+
+	if (!world || budget < 0 || !(cache = (RegionCache *)calloc(1, sizeof(RegionCache))))
+	{
+		return NULL;
+	}
+
+	cache->budget = budget;
+	if (!(cache->world = (char *)malloc(strlen(world) + 1)) || !(index = (char *)malloc(strlen(world) + 5)) ||
+		!(cache->f = fopen(world, "rb")) || fseek(cache->f, 0, SEEK_END) != 0 || (world_size = ftell(cache->f)) < 0 ||
+		(world_mtime = region_get_mtime(world)) < 0)
+	{
+		free(index);
+		region_cache_close(cache);
+		return NULL;
+	}
+	strcpy(cache->world, world);
+	sprintf(index, "%s.idx", world);
+
+	if (region_read_index(cache, index, world_size, world_mtime) == ERROR)
+	{
+		free(cache->slots);
+		free(cache->others);
+		cache->slots = NULL;
+		cache->others = NULL;
+		if (region_build_index(world, index) == ERROR || region_read_index(cache, index, world_size, world_mtime) == ERROR)
+		{
+			fprintf(stderr, "Error: Could not index %s.\n", world);
+			free(index);
+			region_cache_close(cache);
+			return NULL;
+		}
+	}
+	free(index);
+
+	cache->n_regions = (cache->n_slots + REGION_SPACES - 1) / REGION_SPACES;
+	if (!(cache->regions = (Region *)calloc(cache->n_regions + 1, sizeof(Region))))
+	{
+		region_cache_close(cache);
+		return NULL;
+	}
+
+	return cache;
+}
+
+void region_cache_close(RegionCache *cache)
+{
+	long i;
+
+	if (!cache)
+	{
+		return;
+	}
+
+	for (i = 0; cache->regions && i < cache->n_regions; i++)
+	{
+		free(cache->regions[i].characters);
+		free(cache->regions[i].locations);
+	}
+	if (cache->f)
+	{
+		fclose(cache->f);
+	}
+	free(cache->regions);
+	free(cache->slots);
+	free(cache->others);
+	free(cache->line);
+	free(cache->world);
+	free(cache);
+}
+
+/**
+ * @brief Reads the record at an offset of the world file
+ *
+ * @param cache A pointer to the region cache
+ * @param offset The offset of the record
+ * @param tag The tag of the record
+ * @return A scanner positioned at the record, NULL if there was an error
+ */
+static Record *region_read_record(RegionCache *cache, long offset, char *tag)
+{
+	Record *record = NULL;
+
+	if (fseek(cache->f, offset, SEEK_SET) != 0 || region_read_line(cache->f, &cache->line, &cache->line_size) < 0 ||
+		!(record = record_open_text(cache->world, cache->line)))
+	{
+		return NULL;
+	}
+
+	if (record_next(record, tag) <= 0)
+	{
+		record_close(record);
+		return NULL;
+	}
+
+	return record;
+}
+
+/**
+ * @brief Adds a character to the list of a region
+ *
+ * @return OK if it was added, ERROR otherwise
+ */
+static Status region_add_character(Region *region, Character *character, Id location)
+{
+	Character **characters = NULL;
+	Id *locations = NULL;
+	int max;
+
+	if (region->n_characters == region->max_characters)
+	{
+		max = region->max_characters * 2 + 4;
+		if (!(characters = (Character **)realloc(region->characters, max * sizeof(Character *))))
+		{
+			return ERROR;
+		}
+		region->characters = characters;
+		if (!(locations = (Id *)realloc(region->locations, max * sizeof(Id))))
+		{
+			return ERROR;
+		}
+		region->locations = locations;
+		region->max_characters = max;
+	}
+
+	region->characters[region->n_characters] = character;
+	region->locations[region->n_characters] = location;
+	region->n_characters++;
+
+	return OK;
+}
+
+/**
+ * @brief Reads a region from the world file and adds its spaces and links to the game
+ *
+ * @param cache A pointer to the region cache
+ * @param game A pointer to the game
+ * @param r The region
+ * @return OK if the region was loaded, ERROR otherwise
+ */
+static Status region_load(RegionCache *cache, Game *game, long r)
+{
+	Region *region = &cache->regions[r];
+	SpaceSlot *slot = NULL;
+	Record *record = NULL;
+	long i, last, k;
+	int j;
+	Status status = OK;
+
+	last = (r + 1) * REGION_SPACES < cache->n_slots ? (r + 1) * REGION_SPACES : cache->n_slots;
+	for (i = r * REGION_SPACES; i < last && status == OK; i++)
+	{
+		slot = &cache->slots[i];
+		/* A record that is not the one indexed means the file changed without changing its size or time */
+		if (!(record = region_read_record(cache, slot->entry.offset, "#s:")) || game_reader_parse_space(record, &slot->space) == ERROR ||
+			space_get_id(slot->space) != slot->entry.id || game_add_space(game, slot->space) == ERROR)
+		{
+			space_destroy(slot->space);
+			slot->space = NULL;
+			status = ERROR;
+		}
+		else if (slot->discovered == TRUE)
+		{
+			space_set_discovered(slot->space, TRUE);
+		}
+		record_close(record);
+
+		for (j = 0; j < REGION_DIRECTIONS && status == OK; j++)
+		{
+			if (slot->entry.links[j] < 0)
+			{
+				continue;
+			}
+
+			if (!(record = region_read_record(cache, slot->entry.links[j], "#l:")) || game_reader_parse_link(record, &slot->links[j]) == ERROR ||
+				link_get_origin(slot->links[j]) != slot->entry.id || (int)link_get_direction(slot->links[j]) != j ||
+				game_add_link(game, slot->links[j]) == ERROR)
+			{
+				link_destroy(slot->links[j]);
+				slot->links[j] = NULL;
+				status = ERROR;
+			}
+			else
+			{
+				region->n_links++;
+			}
+			record_close(record);
+		}
+	}
+
+	/* What was loaded stays in the game and is freed with it or by the next eviction */
+	region->resident = TRUE;
+	cache->resident_bytes += (last - r * REGION_SPACES) * REGION_SPACE_BYTES + region->n_links * REGION_LINK_BYTES;
+	cache->n_loads++;
+
+	for (i = 0; i < region->n_characters; i++)
+	{
+		k = region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, region->locations[i]);
+		if (k >= 0 && cache->slots[k].space)
+		{
+			space_add_character(cache->slots[k].space, region->characters[i]);
+		}
+	}
+
+	if (status == ERROR)
+	{
+		fprintf(stderr, "Error: Could not load region %ld of %s.\n", r, cache->world);
+	}
+	return status;
+}
+
+Status region_cache_load_entities(RegionCache *cache, Game *game)
+{
+	char tags[] = {'p', 'o', 'c'};
+	Record *record = NULL;
+	Player *player = NULL;
+	Object *object = NULL;
+	Character *character = NULL;
+	Id location;
+	long i, k;
+	int t, *n_characters = NULL;
+	Status status = OK;
+
+	if (!cache || !game)
+	{
+		return ERROR;
+	}
+
+	/* Same order as the individual loaders: players, objects and characters */
+	for (t = 0; t < 3 && status == OK; t++)
+	{
+		for (i = 0; i < cache->n_others && status == OK; i++)
+		{
+			if (cache->others[i].tag != tags[t])
+			{
+				continue;
+			}
+
+			if (tags[t] == 'p')
+			{
+				if (!(record = region_read_record(cache, cache->others[i].offset, "#p:")) || game_reader_parse_player(record, &player, &location) == ERROR)
+				{
+					status = ERROR;
+				}
+				else if (game_add_player(game, player) == ERROR)
+				{
+					player_destroy(player);
+					status = ERROR;
+				}
+				else
+				{
+					space_set_discovered(region_get_space(cache, game, location), TRUE);
+				}
+			}
+			else if (tags[t] == 'o')
+			{
+				if (!(record = region_read_record(cache, cache->others[i].offset, "#o:")) || game_reader_parse_object(record, &object) == ERROR)
+				{
+					status = ERROR;
+				}
+				else if (game_add_objects(game, object) == ERROR)
+				{
+					object_destroy(object);
+				}
+			}
+			else
+			{
+				n_characters = game_get_n_characters(game);
+				if (!(record = region_read_record(cache, cache->others[i].offset, "#c:")) || game_reader_parse_character(record, &character, &location) == ERROR)
+				{
+					status = ERROR;
+				}
+				else if (game_reserve_characters(game, *n_characters + 1) == ERROR)
+				{
+					character_destroy(character);
+					status = ERROR;
+				}
+				else
+				{
+					/* The character waits in its region until the region is loaded */
+					game_get_character_array(game)[(*n_characters)++] = character;
+					k = region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, location);
+					if (k >= 0)
+					{
+						if (cache->regions[k / REGION_SPACES].resident == TRUE)
+						{
+							space_add_character(cache->slots[k].space, character);
+						}
+						status = region_add_character(&cache->regions[k / REGION_SPACES], character, location);
+					}
+				}
+			}
+			record_close(record);
+			record = NULL;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * @brief Finds the slot of a space and marks its region as used, loading it if needed
+ *
+ * @return The slot, NULL if there is no such space or its region could not be loaded
+ */
+static SpaceSlot *region_use(RegionCache *cache, Game *game, Id id)
+{
+	long k;
+
+	if (!cache || !game || id == NO_ID)
+	{
+		return NULL;
+	}
+
+	if ((k = region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, id)) < 0)
+	{
+		return NULL;
+	}
+
+	if (cache->regions[k / REGION_SPACES].resident == FALSE && region_load(cache, game, k / REGION_SPACES) == ERROR)
+	{
+		return NULL;
+	}
+	cache->regions[k / REGION_SPACES].last_use = ++cache->clock;
+
+	return &cache->slots[k];
+}
+
+Space *region_get_space(RegionCache *cache, Game *game, Id id)
+{
+	SpaceSlot *slot = region_use(cache, game, id);
+
+	return slot ? slot->space : NULL;
+}
+
+Bool region_has_space(RegionCache *cache, Id id)
+{
+	if (!cache || id == NO_ID)
+	{
+		return FALSE;
+	}
+
+	return region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, id) >= 0 ? TRUE : FALSE;
+}
+
+Link *region_get_link(RegionCache *cache, Game *game, Id id_orig, Direction dir)
+{
+	SpaceSlot *slot = NULL;
+
+	if (dir < 0 || dir >= REGION_DIRECTIONS || !(slot = region_use(cache, game, id_orig)))
+	{
+		return NULL;
+	}
+
+	return slot->links[dir];
+}
+
+/**
+ * @brief Gets the region of a space if it is loaded
+ *
+ * @return The region, -1 if the space does not exist or is not loaded
+ */
+static long region_of(RegionCache *cache, Id id)
+{
+	long k = region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, id);
+
+	if (k < 0 || cache->regions[k / REGION_SPACES].resident == FALSE)
+	{
+		return -1;
+	}
+
+	return k / REGION_SPACES;
+}
+
+/**
+ * @brief Whether a region can be freed
+ *
+ * Regions where a player is or can go with one move are about to be used again.
+ *
+ * @param pinned Regions around the players
+ * @param n_pinned Number of pinned regions
+ */
+static Bool region_can_evict(RegionCache *cache, long r, long *pinned, int n_pinned)
+{
+	int j;
+
+	if (cache->regions[r].resident == FALSE)
+	{
+		return FALSE;
+	}
+
+	for (j = 0; j < n_pinned; j++)
+	{
+		if (pinned[j] == r)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+ * @brief Frees a region, keeping its characters for the next time it is loaded
+ *
+ * @param cache A pointer to the region cache
+ * @param game A pointer to the game
+ * @param r The region
+ */
+static void region_unload(RegionCache *cache, Game *game, long r)
+{
+	Region *region = &cache->regions[r];
+	SpaceSlot *slot = NULL;
+	Character **waiting = region->characters, **characters = game_get_character_array(game);
+	Id *locations = region->locations, id;
+	Set *set = NULL;
+	Space **spaces = game_get_spaces(game);
+	Link **links = game_get_links(game), *link = NULL;
+	int *n_spaces = game_get_n_spaces(game), *n_links = game_get_n_links(game), n_waiting = region->n_characters;
+	int i, j, c, n;
+	long k, last;
+
+	/* The characters now in the region are found among the ones that were, or among all */
+	region->characters = NULL;
+	region->locations = NULL;
+	region->n_characters = 0;
+	region->max_characters = 0;
+	last = (r + 1) * REGION_SPACES < cache->n_slots ? (r + 1) * REGION_SPACES : cache->n_slots;
+	for (k = r * REGION_SPACES; k < last; k++)
+	{
+		if (!(set = space_get_characters(cache->slots[k].space)))
+		{
+			continue;
+		}
+		for (i = 0; i < set_get_count(set); i++)
+		{
+			id = set_get_id_at(set, i);
+			for (c = 0; c < n_waiting && character_get_id(waiting[c]) != id; c++)
+				;
+			if (c < n_waiting)
+			{
+				region_add_character(region, waiting[c], cache->slots[k].entry.id);
+				continue;
+			}
+			for (c = 0; c < *game_get_n_characters(game) && character_get_id(characters[c]) != id; c++)
+				;
+			if (c < *game_get_n_characters(game))
+			{
+				region_add_character(region, characters[c], cache->slots[k].entry.id);
+			}
+		}
+	}
+	free(waiting);
+	free(locations);
+
+	/* The game keeps the spaces and links of the other regions, then these are freed */
+	for (i = 0, n = 0; i < *n_spaces; i++)
+	{
+		k = region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, space_get_id(spaces[i]));
+		if (k / REGION_SPACES != r)
+		{
+			spaces[n++] = spaces[i];
+		}
+	}
+	*n_spaces = n;
+
+	for (i = 0, n = 0; i < *n_links; i++)
+	{
+		link = links[i];
+		k = region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, link_get_origin(link));
+		if (k / REGION_SPACES != r)
+		{
+			links[n++] = link;
+		}
+	}
+	*n_links = n;
+
+	for (k = r * REGION_SPACES; k < last; k++)
+	{
+		slot = &cache->slots[k];
+		slot->discovered = space_is_discovered(slot->space);
+		space_destroy(slot->space);
+		slot->space = NULL;
+		for (j = 0; j < REGION_DIRECTIONS; j++)
+		{
+			link_destroy(slot->links[j]);
+			slot->links[j] = NULL;
+		}
+	}
+
+	cache->resident_bytes -= (last - r * REGION_SPACES) * REGION_SPACE_BYTES + region->n_links * REGION_LINK_BYTES;
+	region->n_links = 0;
+	region->resident = FALSE;
+}
+
+int region_evict(RegionCache *cache, Game *game)
+{
+	long *pinned = NULL, best, r;
+	Link *link = NULL;
+	Id location;
+	int n_pinned = 0, i, j, evicted = 0;
+
+	if (!cache || !game || cache->resident_bytes <= cache->budget)
+	{
+		return 0;
+	}
+
+	if (!(pinned = (long *)malloc((game_get_n_players(game) * (REGION_DIRECTIONS + 1) + 1) * sizeof(long))))
+	{
+		return 0;
+	}
+
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		location = player_get_location(game_get_player_at(game, i));
+		if ((r = region_of(cache, location)) < 0)
+		{
+			continue;
+		}
+		pinned[n_pinned++] = r;
+		for (j = 0; j < REGION_DIRECTIONS; j++)
+		{
+			link = cache->slots[region_find_entry(&cache->slots[0].entry, sizeof(SpaceSlot), cache->n_slots, location)].links[j];
+			if (link && (r = region_of(cache, link_get_destination(link))) >= 0)
+			{
+				pinned[n_pinned++] = r;
+			}
+		}
+	}
+
+	while (cache->resident_bytes > cache->budget)
+	{
+		best = -1;
+		for (r = 0; r < cache->n_regions; r++)
+		{
+			if ((best < 0 || cache->regions[r].last_use < cache->regions[best].last_use) && region_can_evict(cache, r, pinned, n_pinned) == TRUE)
+			{
+				best = r;
+			}
+		}
+
+		if (best < 0)
+		{
+			break;
+		}
+		region_unload(cache, game, best);
+		evicted++;
+	}
+
+	free(pinned);
+	return evicted;
+}
+
+long region_get_resident_bytes(RegionCache *cache)
+{
+	if (!cache)
+	{
+		return 0;
+	}
+
+	return cache->resident_bytes;
+}
+
+long region_get_n_loads(RegionCache *cache)
+{
+	if (!cache)
+	{
+		return 0;
+	}
+
+	return cache->n_loads;
+}
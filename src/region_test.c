@@ -0,0 +1,385 @@
+/**
+ * @brief It tests the paging of the regions of a world
+ *
+ * @file region_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include "region.h"
+#include "game_actions.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 6
+
+/**
+ * @brief Files of the tests, in the directory they are run from
+ */
+#define WORLD_FILE "region_test.dat"
+#define INDEX_FILE "region_test.dat.idx"
+
+/**
+ * @brief Spaces of the corridor of the tests, four regions
+ */
+#define WORLD_SPACES (4 * REGION_SPACES)
+
+/**
+ * @brief Budget small enough that every region that can be freed is freed
+ */
+#define WORLD_BUDGET 1
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_region_cache_open();
+
+/**
+ * @brief Test that an index is built again when the world file changes without changing its size.
+ */
+void test2_region_cache_open();
+
+/**
+ * @brief Test that spaces and links that are not the indexed ones are rejected.
+ */
+void test1_region_load();
+
+/**
+ * @brief Test that the regions left behind are freed and read again when they are needed.
+ */
+void test1_region_evict();
+
+/**
+ * @brief Test that the region of the player is never freed.
+ */
+void test2_region_evict();
+
+/**
+ * @brief Test that a paged game plays the same as the game loaded whole.
+ */
+void test1_game_create_paged();
+
+/**
+ * @brief Main function for region unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Region:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_region_cache_open();
+	if (all || test == 2)
+		test1_region_evict();
+	if (all || test == 3)
+		test2_region_evict();
+	if (all || test == 4)
+		test1_game_create_paged();
+	if (all || test == 5)
+		test2_region_cache_open();
+	if (all || test == 6)
+		test1_region_load();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It writes a corridor of spaces 1 to WORLD_SPACES, open both ways, with an object and a hostile character in each region
+ *
+ * @param swap 1 to write the first two spaces the other way round, 2 to do so with the first two links, 0 for neither.
+ *             The file keeps its size, only the records move.
+ */
+static void write_world(int swap)
+{
+	FILE *f = fopen(WORLD_FILE, "w");
+	int i;
+
+	if (!f)
+	{
+		return;
+	}
+
+	fprintf(f, "#p:1|ant|m0^|1|50|3|\n");
+	for (i = 1; i <= WORLD_SPACES; i++)
+	{
+		fprintf(f, "#s:%d|Tunnel_%d|\n", swap == 1 && i <= 2 ? 3 - i : i, swap == 1 && i <= 2 ? 3 - i : i);
+	}
+	for (i = 1; i < WORLD_SPACES; i++)
+	{
+		if (swap == 2 && i == 1)
+		{
+			fprintf(f, "#l:%d|Tunnel_%d|%d|%d|3|1|\n", 2 * i + 1, i + 1, i + 1, i);
+		}
+		fprintf(f, "#l:%d|Tunnel_%d|%d|%d|2|1|\n", 2 * i, i, i, i + 1);
+		if (swap != 2 || i != 1)
+		{
+			fprintf(f, "#l:%d|Tunnel_%d|%d|%d|3|1|\n", 2 * i + 1, i + 1, i + 1, i);
+		}
+	}
+	fprintf(f, "#o:21|Twig|2\n#o:22|Seed|%d\n#o:23|Nut|%d\n", REGION_SPACES + 6, 3 * REGION_SPACES);
+	fprintf(f, "#c:3|Beetle|/\\oo/\\|3|10|0|Go away!|\n#c:4|Moth|  ww  |%d|10|1|Hello|\n#c:5|Wasp|>=oo=<|%d|10|0|Bzz|\n", 2 * REGION_SPACES,
+			3 * REGION_SPACES + 2);
+	fclose(f);
+}
+
+/**
+ * @brief It indexes the world, then writes it again with some records moved and the given modification time
+ *
+ * @param swap The records moved, see write_world
+ * @param later The seconds added to the modification time of the indexed world
+ */
+static void rewrite_world(int swap, long later)
+{
+	RegionCache *cache = NULL;
+	struct stat info;
+	struct utimbuf times;
+
+	write_world(0);
+	cache = region_cache_open(WORLD_FILE, WORLD_BUDGET);
+	region_cache_close(cache);
+	if (stat(WORLD_FILE, &info) == 0)
+	{
+		write_world(swap);
+		times.actime = info.st_atime;
+		times.modtime = info.st_mtime + later;
+		utime(WORLD_FILE, &times);
+	}
+}
+
+/**
+ * @brief It runs a command of the first player, freeing the regions over the budget afterwards as the game loop does
+ */
+static void play(Game *game, const char *input)
+{
+	char buffer[WORD_SIZE];
+	Command *command = game_get_last_command(game);
+
+	strcpy(buffer, input);
+	command_parse_input(command, buffer);
+	game_set_turn(game, 0);
+	game_actions_update(game, command);
+	game_evict_regions(game);
+}
+
+/**
+ * @brief It moves the first player some spaces along the corridor
+ */
+static void walk(Game *game, const char *move, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		play(game, move);
+	}
+}
+
+/**
+ * @brief It plays the same game on a world: it fights in the first and last regions, carries an object across them and comes back
+ */
+static void play_world(Game *game)
+{
+	srand(7);
+	play(game, "m e");
+	play(game, "t Twig");
+	play(game, "m e");
+	play(game, "a");
+	play(game, "a");
+	walk(game, "m e", REGION_SPACES + 3);
+	play(game, "t Seed");
+	walk(game, "m e", 2 * REGION_SPACES - 6);
+	play(game, "t Nut");
+	play(game, "m e");
+	play(game, "m e");
+	play(game, "a");
+	play(game, "d Twig");
+	walk(game, "m w", 3 * REGION_SPACES - 1);
+	play(game, "a");
+	play(game, "d Seed");
+}
+
+/**
+ * @brief It gets a character of a game by its id
+ */
+static Character *find_character(Game *game, Id id)
+{
+	int i;
+
+	for (i = 0; i < *game_get_n_characters(game); i++)
+	{
+		if (character_get_id(game_get_character_array(game)[i]) == id)
+		{
+			return game_get_character_array(game)[i];
+		}
+	}
+
+	return NULL;
+}
+
+void test1_region_cache_open()
+{
+	Game *game = NULL;
+	Status status;
+
+	status = game_create_paged(&game, "region_test.missing", WORLD_BUDGET);
+	PRINT_TEST_RESULT(region_cache_open(NULL, WORLD_BUDGET) == NULL && region_cache_open("region_test.missing", WORLD_BUDGET) == NULL &&
+					  region_build_index(NULL, INDEX_FILE) == ERROR && status == ERROR && region_evict(NULL, NULL) == 0 &&
+					  region_get_resident_bytes(NULL) == 0 && game_evict_regions(NULL) == 0);
+	game_destroy(game);
+}
+
+void test1_region_evict()
+{
+	Game *game = NULL;
+	RegionCache *cache = NULL;
+	long loads, resident;
+
+	write_world(0);
+	game_create_paged(&game, WORLD_FILE, WORLD_BUDGET);
+	cache = game_get_regions(game);
+	walk(game, "m e", 3 * REGION_SPACES);
+	loads = region_get_n_loads(cache);
+	resident = region_get_resident_bytes(cache);
+	walk(game, "m w", 3 * REGION_SPACES);
+	PRINT_TEST_RESULT(cache != NULL && player_get_location(game_get_player_at(game, 0)) == 1 && loads >= 4 &&
+					  region_get_n_loads(cache) >= loads + 2 && resident > 0 && *game_get_n_spaces(game) < WORLD_SPACES &&
+					  space_is_discovered(game_get_space(game, 2 * REGION_SPACES)) == TRUE);
+	game_destroy(game);
+	remove(WORLD_FILE);
+	remove(INDEX_FILE);
+}
+
+void test2_region_evict()
+{
+	Game *game = NULL;
+	RegionCache *cache = NULL;
+	Space *space = NULL;
+	long loads;
+
+	write_world(0);
+	game_create_paged(&game, WORLD_FILE, WORLD_BUDGET);
+	cache = game_get_regions(game);
+	walk(game, "m e", 2 * REGION_SPACES + 5);
+	space = game_get_space(game, 2 * REGION_SPACES + 6);
+	loads = region_get_n_loads(cache);
+	/* Over the budget, but the player and the spaces next to them stay */
+	game_evict_regions(game);
+	PRINT_TEST_RESULT(space != NULL && region_get_resident_bytes(cache) > WORLD_BUDGET && game_get_space(game, 2 * REGION_SPACES + 6) == space &&
+					  game_get_connection(game, 2 * REGION_SPACES + 6, E) == 2 * REGION_SPACES + 7 && region_get_n_loads(cache) == loads);
+	game_destroy(game);
+	remove(WORLD_FILE);
+	remove(INDEX_FILE);
+}
+
+void test1_game_create_paged()
+{
+	Game *paged = NULL, *whole = NULL;
+	Player *a = NULL, *b = NULL;
+	Bool same;
+	Id id;
+	int i;
+
+	write_world(0);
+	game_create_paged(&paged, WORLD_FILE, WORLD_BUDGET);
+	game_create_from_file(&whole, WORLD_FILE);
+	play_world(paged);
+	play_world(whole);
+
+	a = game_get_player_at(paged, 0);
+	b = game_get_player_at(whole, 0);
+	same = a && b && player_get_location(a) == player_get_location(b) && player_get_health(a) == player_get_health(b) &&
+				   player_get_location(a) == 3 && player_has_object(a, 23) == TRUE && player_has_object(a, 21) == FALSE &&
+				   player_has_object(a, 22) == FALSE && region_get_n_loads(game_get_regions(paged)) > 4
+			   ? TRUE
+			   : FALSE;
+	for (i = 0; same == TRUE && i < *game_get_n_objects(whole); i++)
+	{
+		id = object_get_id(game_get_objects(whole)[i]);
+		same = object_get_location(game_get_object_by_id(paged, id)) == object_get_location(game_get_objects(whole)[i]) ? TRUE : FALSE;
+	}
+	for (id = 3; same == TRUE && id <= 5; id++)
+	{
+		same = character_get_health(find_character(paged, id)) == character_get_health(find_character(whole, id)) ? TRUE : FALSE;
+	}
+	/* The fights left their marks in the regions that were freed and read again */
+	same = same == TRUE && character_get_health(find_character(paged, 3)) < 10 && character_get_health(find_character(paged, 5)) < 10 &&
+				   space_get_n_occupants(game_get_space(paged, 3), FALSE) == space_get_n_occupants(game_get_space(whole, 3), FALSE) &&
+				   space_is_discovered(game_get_space(paged, REGION_SPACES)) == TRUE
+			   ? TRUE
+			   : FALSE;
+	PRINT_TEST_RESULT(same == TRUE);
+	game_destroy(paged);
+	game_destroy(whole);
+	remove(WORLD_FILE);
+	remove(INDEX_FILE);
+}
+
+void test2_region_cache_open()
+{
+	Game *game = NULL;
+	Status status;
+
+	rewrite_world(1, 60);
+	status = game_create_paged(&game, WORLD_FILE, WORLD_BUDGET);
+	PRINT_TEST_RESULT(status == OK && space_get_id(game_get_space(game, 1)) == 1 && game_get_connection(game, 1, E) == 2 &&
+					  game_get_connection(game, 2, W) == 1);
+	game_destroy(game);
+	remove(WORLD_FILE);
+	remove(INDEX_FILE);
+}
+
+void test1_region_load()
+{
+	Game *game = NULL;
+	Space *space = NULL;
+	Id east;
+
+	/* The index is taken as up to date, but the records it points to moved */
+	rewrite_world(1, 0);
+	game_create_paged(&game, WORLD_FILE, WORLD_BUDGET);
+	space = game_get_space(game, 1);
+	game_destroy(game);
+	game = NULL;
+	rewrite_world(2, 0);
+	game_create_paged(&game, WORLD_FILE, WORLD_BUDGET);
+	east = game_get_connection(game, 1, E);
+	PRINT_TEST_RESULT(space == NULL && game_get_space(game, 1) != NULL && east == NO_ID);
+	game_destroy(game);
+	remove(WORLD_FILE);
+	remove(INDEX_FILE);
+}
@@ -0,0 +1,1221 @@
+/**
+ * @brief It implements the reload of the data file of a running game
+ *
+ * @file reload.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "reload.h"
+#include "game_reader.h"
+#include "stats.h"
+
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/**
+ * @brief Time the file must stay still before it is parsed, in milliseconds
+ */
+#define RELOAD_SETTLE_MS 20
+
+/**
+ * @brief Room for the events read at once from inotify
+ */
+#define RELOAD_EVENTS_SIZE 4096
+
+/**
+ * @brief Kinds of entities read from the file
+ */
+typedef enum
+{
+	RELOAD_SPACE,	  /*!< Spaces */
+	RELOAD_LINK,	  /*!< Links */
+	RELOAD_OBJECT,	  /*!< Objects */
+	RELOAD_CHARACTER, /*!< Characters */
+	RELOAD_KINDS	  /*!< Number of kinds */
+} ReloadKind;
+
+/**
+ * @brief An entity found by its id
+ */
+typedef struct
+{
+	Id id;	  /*!< Id of the entity */
+	Id value; /*!< Its position in its array, or its location */
+} ReloadEntry;
+
+/**
+ * @brief An entity added, changed or removed between two versions of the file
+ */
+typedef struct
+{
+	ReloadKind kind; /*!< Kind of the entity */
+	Id id;			 /*!< Id of the entity */
+} ReloadChange;
+
+/**
+ * @brief A version of the file, with its entities indexed by id
+ */
+typedef struct
+{
+	Game *game;							/*!< The game loaded from it */
+	ReloadEntry *index[RELOAD_KINDS];	/*!< Positions of the entities of each kind, sorted by id */
+	int n[RELOAD_KINDS];				/*!< Number of entities of each kind */
+	ReloadEntry *locations;				/*!< Locations of the characters, sorted by id */
+	int n_locations;					/*!< Number of characters in a space */
+	ReloadChange *changes;				/*!< Entities changed since the version before, sorted by kind and id */
+	int n_changes;						/*!< Number of entities changed */
+} ReloadVersion;
+
+/**
+ * @brief Private implementation of the watcher
+ */
+struct _Reload
+{
+	char *path;				/*!< Name of the file */
+	char *name;				/*!< Name of the file inside its directory, a part of path */
+	int fd;					/*!< Descriptor of inotify */
+	int wake[2];			/*!< Pipe that gives the thread the versions to free, and NULL to stop it */
+	pthread_t thread;		/*!< Thread that watches and parses the file */
+	Bool started;			/*!< Whether the thread was started */
+	pthread_mutex_t lock;	/*!< Protects the fields below */
+	ReloadVersion *base;	/*!< Version the game holds, or is taking in reload_apply */
+	ReloadVersion *pending; /*!< Version parsed and not applied yet, NULL if none */
+	unsigned long seen;		/*!< When the version pending was written */
+	unsigned long parse;	/*!< Time parsing and comparing the version pending */
+	int n_failed;			/*!< Versions that could not be parsed */
+};
+
+/**
+ * @brief Compares two entries by id, for qsort and bsearch
+ */
+static int reload_compare(const void *a, const void *b)
+{
+	Id x = ((const ReloadEntry *)a)->id, y = ((const ReloadEntry *)b)->id;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Gets the array of the entities of a kind of a game
+ */
+static void **reload_items(Game *game, ReloadKind kind, int **n)
+{
+	switch (kind)
+	{
+	case RELOAD_SPACE:
+		*n = game_get_n_spaces(game);
+		return (void **)game_get_spaces(game);
+
+	case RELOAD_LINK:
+		*n = game_get_n_links(game);
+		return (void **)game_get_links(game);
+
+	case RELOAD_OBJECT:
+		*n = game_get_n_objects(game);
+		return (void **)game_get_objects(game);
+
+	default:
+		*n = game_get_n_characters(game);
+		return (void **)game_get_character_array(game);
+	}
+}
+
+/**
+ * @brief Gets the id of an entity of a kind
+ */
+static Id reload_id(ReloadKind kind, void *item)
+{
+	switch (kind)
+	{
+	case RELOAD_SPACE:
+		return space_get_id((Space *)item);
+
+	case RELOAD_LINK:
+		return link_get_id((Link *)item);
+
+	case RELOAD_OBJECT:
+		return object_get_id((Object *)item);
+
+	default:
+		return character_get_id((Character *)item);
+	}
+}
+
+/**
+ * @brief Indexes the entities of a kind of a game by id
+ *
+ * @return The entries sorted by id, with the positions in the array, NULL if there was not enough memory
+ */
+static ReloadEntry *reload_index(Game *game, ReloadKind kind, int *n)
+{
+	ReloadEntry *index = NULL;
+	void **items = NULL;
+	int *n_items = NULL, i;
+
+	items = reload_items(game, kind, &n_items);
+	if (!(index = (ReloadEntry *)malloc((*n_items + 1) * sizeof(ReloadEntry))))
+	{
+		return NULL;
+	}
+
+	for (i = 0; i < *n_items; i++)
+	{
+		index[i].id = reload_id(kind, items[i]);
+		index[i].value = i;
+	}
+	qsort(index, *n_items, sizeof(ReloadEntry), reload_compare);
+	*n = *n_items;
+	return index;
+}
+
+/**
+ * @brief Indexes the locations of the characters of a game, which only their spaces know
+ *
+ * @return The entries sorted by the id of the character, with its location, NULL if there was not enough memory
+ */
+static ReloadEntry *reload_locate(Game *game, int *n)
+{
+	Space **spaces = game_get_spaces(game);
+	ReloadEntry *index = NULL;
+	Set *set = NULL;
+	int n_spaces = *game_get_n_spaces(game), i, j, total = 0;
+
+	for (i = 0; i < n_spaces; i++)
+	{
+		total += set_get_count(space_get_characters(spaces[i]));
+	}
+	if (!(index = (ReloadEntry *)malloc((total + 1) * sizeof(ReloadEntry))))
+	{
+		return NULL;
+	}
+
+	for (i = 0, *n = 0; i < n_spaces; i++)
+	{
+		set = space_get_characters(spaces[i]);
+		for (j = 0; j < set_get_count(set); j++)
+		{
+			index[*n].id = set_get_id_at(set, j);
+			index[(*n)++].value = space_get_id(spaces[i]);
+		}
+	}
+	qsort(index, *n, sizeof(ReloadEntry), reload_compare);
+	return index;
+}
+
+/**
+ * @brief Finds an entity in an index
+ *
+ * @return Its value, NO_ID if it is not there
+ */
+static Id reload_find(ReloadEntry *index, int n, Id id)
+{
+	ReloadEntry key, *found = NULL;
+
+	key.id = id;
+	found = (ReloadEntry *)bsearch(&key, index, n, sizeof(ReloadEntry), reload_compare);
+	return found ? found->value : NO_ID;
+}
+
+/**
+ * @brief Gets an entity of a version by its id
+ *
+ * @return The entity, NULL if the version does not have it
+ */
+static void *reload_get(ReloadVersion *version, ReloadKind kind, Id id)
+{
+	int *n = NULL;
+	void **items = reload_items(version->game, kind, &n);
+	Id at = reload_find(version->index[kind], version->n[kind], id);
+
+	return at != NO_ID ? items[at] : NULL;
+}
+
+/**
+ * @brief Frees a version and the game loaded from it
+ */
+static void reload_version_destroy(ReloadVersion *version)
+{
+	int kind;
+
+	if (!version)
+	{
+		return;
+	}
+
+	for (kind = 0; kind < RELOAD_KINDS; kind++)
+	{
+		free(version->index[kind]);
+	}
+	free(version->locations);
+	free(version->changes);
+	game_destroy(version->game);
+	free(version);
+}
+
+/**
+ * @brief Indexes the entities of the game of a version
+ *
+ * @return OK if they were indexed, ERROR if there was not enough memory
+ */
+static Status reload_version_index(ReloadVersion *version)
+{
+	int kind;
+
+	for (kind = 0; kind < RELOAD_KINDS; kind++)
+	{
+		if (!(version->index[kind] = reload_index(version->game, (ReloadKind)kind, &version->n[kind])))
+		{
+			return ERROR;
+		}
+	}
+
+	return (version->locations = reload_locate(version->game, &version->n_locations)) != NULL ? OK : ERROR;
+}
+
+/**
+ * @brief Indexes the game loaded from a version of the file
+ *
+ * @param game The game, which the version owns from then on
+ * @return The version, NULL if there was not enough memory (the game is then freed)
+ */
+static ReloadVersion *reload_version_create(Game *game)
+{
+	ReloadVersion *version = NULL;
+
+	if (!game || !(version = (ReloadVersion *)calloc(1, sizeof(ReloadVersion))))
+	{
+		game_destroy(game);
+		return NULL;
+	}
+
+	version->game = game;
+	if (reload_version_index(version) == ERROR)
+	{
+		reload_version_destroy(version);
+		return NULL;
+	}
+
+	return version;
+}
+
+/**
+ * @brief Tells whether two texts read from the file are equal, either of them can be NULL
+ */
+static Bool reload_same(const char *a, const char *b)
+{
+	return strcmp(a ? a : "", b ? b : "") == 0 ? TRUE : FALSE;
+}
+
+/**
+ * @brief Tells whether an entity is different in two versions
+ */
+static Bool reload_differs(ReloadKind kind, ReloadVersion *before, void *old, ReloadVersion *after, void *new)
+{
+	Space *old_space = (Space *)old, *new_space = (Space *)new;
+	Link *old_link = (Link *)old, *new_link = (Link *)new;
+	Object *old_object = (Object *)old, *new_object = (Object *)new;
+	Character *old_character = (Character *)old, *new_character = (Character *)new;
+	Id id;
+	int i;
+
+	switch (kind)
+	{
+	case RELOAD_SPACE:
+		for (i = 0; i < GDESC_ROWS; i++)
+		{
+			if (reload_same(space_get_gdesc_at(old_space, i), space_get_gdesc_at(new_space, i)) == FALSE)
+			{
+				return TRUE;
+			}
+		}
+		return reload_same(space_get_name(old_space), space_get_name(new_space)) == FALSE ? TRUE : FALSE;
+
+	case RELOAD_LINK:
+		return (reload_same(link_get_name(old_link), link_get_name(new_link)) == FALSE || link_get_origin(old_link) != link_get_origin(new_link) ||
+				link_get_destination(old_link) != link_get_destination(new_link) || link_get_direction(old_link) != link_get_direction(new_link) ||
+				link_get_open(old_link) != link_get_open(new_link))
+				   ? TRUE
+				   : FALSE;
+
+	case RELOAD_OBJECT:
+		return (reload_same(object_get_name(old_object), object_get_name(new_object)) == FALSE ||
+				reload_same(object_get_description(old_object), object_get_description(new_object)) == FALSE ||
+				object_get_location(old_object) != object_get_location(new_object))
+				   ? TRUE
+				   : FALSE;
+
+	default:
+		id = character_get_id(old_character);
+		return (reload_same(character_get_name(old_character), character_get_name(new_character)) == FALSE ||
+				reload_same(character_get_gdesc(old_character), character_get_gdesc(new_character)) == FALSE ||
+				reload_same(character_get_message(old_character), character_get_message(new_character)) == FALSE ||
+				character_get_health(old_character) != character_get_health(new_character) ||
+				character_get_friendly(old_character) != character_get_friendly(new_character) ||
+				reload_find(before->locations, before->n_locations, id) != reload_find(after->locations, after->n_locations, id))
+				   ? TRUE
+				   : FALSE;
+	}
+}
+
+/**
+ * @brief Finds the entities added, changed or removed between two versions, stored in the new one
+ *
+ * Both indexes are sorted by id, so they are walked together once.
+ *
+ * @return OK if they were found, ERROR if there was not enough memory
+ */
+static Status reload_compare_versions(ReloadVersion *before, ReloadVersion *after)
+{
+	void **old_items = NULL, **new_items = NULL;
+	ReloadEntry *old_index = NULL, *new_index = NULL;
+	int *n = NULL, kind, i, j, max = 0;
+	Bool changed;
+
+	for (kind = 0; kind < RELOAD_KINDS; kind++)
+	{
+		max += before->n[kind] + after->n[kind];
+	}
+	if (!(after->changes = (ReloadChange *)malloc((max + 1) * sizeof(ReloadChange))))
+	{
+		return ERROR;
+	}
+
+	after->n_changes = 0;
+	for (kind = 0; kind < RELOAD_KINDS; kind++)
+	{
+		old_items = reload_items(before->game, (ReloadKind)kind, &n);
+		new_items = reload_items(after->game, (ReloadKind)kind, &n);
+		old_index = before->index[kind];
+		new_index = after->index[kind];
+		for (i = 0, j = 0; i < before->n[kind] || j < after->n[kind];)
+		{
+			if (j == after->n[kind] || (i < before->n[kind] && old_index[i].id < new_index[j].id))
+			{
+				after->changes[after->n_changes].id = old_index[i++].id;
+				changed = TRUE;
+			}
+			else if (i == before->n[kind] || new_index[j].id < old_index[i].id)
+			{
+				after->changes[after->n_changes].id = new_index[j++].id;
+				changed = TRUE;
+			}
+			else
+			{
+				after->changes[after->n_changes].id = new_index[j].id;
+				changed = reload_differs((ReloadKind)kind, before, old_items[old_index[i].value], after, new_items[new_index[j].value]);
+				i++;
+				j++;
+			}
+			if (changed == TRUE)
+			{
+				after->changes[after->n_changes++].kind = (ReloadKind)kind;
+			}
+		}
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Finds the changes of a kind
+ *
+ * @return The number of them, stored from first on
+ */
+static int reload_range(ReloadVersion *after, ReloadKind kind, ReloadChange **first)
+{
+	int i = 0, n = 0;
+
+	while (i < after->n_changes && after->changes[i].kind != kind)
+	{
+		i++;
+	}
+	*first = after->changes + i;
+	while (i + n < after->n_changes && after->changes[i + n].kind == kind)
+	{
+		n++;
+	}
+
+	return n;
+}
+
+/**
+ * @brief Removes the positions set to NULL from an array of entities, keeping the order of the others
+ */
+static void reload_compact(void **items, int *n)
+{
+	int i, j;
+
+	for (i = 0, j = 0; i < *n; i++)
+	{
+		if (items[i] != NULL)
+		{
+			items[j++] = items[i];
+		}
+	}
+	*n = j;
+}
+
+/**
+ * @brief Tells whether a player stands in a space
+ */
+static Bool reload_has_player(Game *game, Id space)
+{
+	int i;
+
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		if (player_get_location(game_get_player_at(game, i)) == space)
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/**
+ * @brief Tells whether a player carries an object
+ */
+static Bool reload_is_carried(Game *game, Id object)
+{
+	int i;
+
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		if (player_has_object(game_get_player_at(game, i), object) == TRUE)
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/**
+ * @brief Copies the name and the graphic description of a space
+ */
+static void reload_copy_space(Space *to, Space *from)
+{
+	int i;
+
+	space_set_name(to, (char *)space_get_name(from));
+	for (i = 0; i < GDESC_ROWS; i++)
+	{
+		space_set_gdesc_at(to, (char *)space_get_gdesc_at(from, i), i);
+	}
+}
+
+/**
+ * @brief Adds the new spaces and changes the ones changed, the ones removed are left for reload_remove_spaces
+ */
+static Status reload_spaces(Game *game, ReloadVersion *before, ReloadVersion *after, ReloadDiff *diff)
+{
+	ReloadChange *changes = NULL;
+	ReloadEntry *live = NULL;
+	Space *space = NULL, *old = NULL, *new = NULL;
+	int n = reload_range(after, RELOAD_SPACE, &changes), n_live, i;
+	Id at;
+	Status status = OK;
+
+	if (n == 0)
+	{
+		return OK;
+	}
+	if (!(live = reload_index(game, RELOAD_SPACE, &n_live)))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		old = (Space *)reload_get(before, RELOAD_SPACE, changes[i].id);
+		new = (Space *)reload_get(after, RELOAD_SPACE, changes[i].id);
+		at = reload_find(live, n_live, changes[i].id);
+		space = at != NO_ID ? game_get_spaces(game)[at] : NULL;
+		if (!old && new && !space)
+		{
+			if (!(space = space_create(changes[i].id)) || game_add_space(game, space) == ERROR)
+			{
+				space_destroy(space);
+				status = ERROR;
+				break;
+			}
+			reload_copy_space(space, new);
+			diff->added++;
+		}
+		else if (old && new && space)
+		{
+			reload_copy_space(space, new);
+			diff->changed++;
+		}
+	}
+
+	free(live);
+	return status;
+}
+
+/**
+ * @brief Removes the spaces removed from the file, unless a player stands in them
+ *
+ * The objects left in them are taken out of the world and the characters left in them are left without a space.
+ */
+static Status reload_remove_spaces(Game *game, ReloadVersion *before, ReloadVersion *after, ReloadDiff *diff)
+{
+	ReloadChange *changes = NULL;
+	ReloadEntry *live = NULL;
+	Object **objects = game_get_objects(game);
+	Space *space = NULL;
+	int n = reload_range(after, RELOAD_SPACE, &changes), n_live, i, j;
+	Id at;
+
+	if (n == 0)
+	{
+		return OK;
+	}
+	if (!(live = reload_index(game, RELOAD_SPACE, &n_live)))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		if (reload_get(after, RELOAD_SPACE, changes[i].id) || !reload_get(before, RELOAD_SPACE, changes[i].id) ||
+			(at = reload_find(live, n_live, changes[i].id)) == NO_ID)
+		{
+			continue;
+		}
+		if (reload_has_player(game, changes[i].id) == TRUE)
+		{
+			diff->kept++;
+			continue;
+		}
+
+		for (j = 0; j < *game_get_n_objects(game); j++)
+		{
+			if (object_get_location(objects[j]) == changes[i].id)
+			{
+				object_set_location(objects[j], NO_ID);
+			}
+		}
+		space = game_get_spaces(game)[at];
+		game_get_spaces(game)[at] = NULL;
+		space_destroy(space);
+		diff->removed++;
+	}
+	reload_compact((void **)game_get_spaces(game), game_get_n_spaces(game));
+
+	free(live);
+	return OK;
+}
+
+/**
+ * @brief Adds, changes and removes the links changed in the file
+ *
+ * A link keeps the state the players left it in unless the file opens or closes it,
+ * which publishes the event a command would.
+ * The live links are found by their positions, which adding at the end and
+ * setting to NULL keep until the array is compacted.
+ */
+static Status reload_links(Game *game, ReloadVersion *before, ReloadVersion *after, ReloadDiff *diff)
+{
+	ReloadChange *changes = NULL;
+	ReloadEntry *live = NULL;
+	Link *link = NULL, *old = NULL, *new = NULL;
+	int n = reload_range(after, RELOAD_LINK, &changes), n_live, i;
+	Id at;
+	Bool opened = FALSE;
+	Status status = OK;
+
+	if (n == 0)
+	{
+		return OK;
+	}
+	if (!(live = reload_index(game, RELOAD_LINK, &n_live)))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		old = (Link *)reload_get(before, RELOAD_LINK, changes[i].id);
+		new = (Link *)reload_get(after, RELOAD_LINK, changes[i].id);
+		at = reload_find(live, n_live, changes[i].id);
+		link = at != NO_ID ? game_get_links(game)[at] : NULL;
+		if (!old && new && !link)
+		{
+			if (!(link = link_create(changes[i].id)) || game_add_link(game, link) == ERROR)
+			{
+				link_destroy(link);
+				status = ERROR;
+				break;
+			}
+			link_set_open(link, link_get_open(new));
+			diff->added++;
+		}
+		else if (old && !new && link)
+		{
+			link_destroy(link);
+			game_get_links(game)[at] = NULL;
+			diff->removed++;
+			continue;
+		}
+		else if (old && new && link)
+		{
+			if (link_get_open(old) != link_get_open(new))
+			{
+				link_set_open(link, link_get_open(new));
+				opened = TRUE;
+			}
+			diff->changed++;
+		}
+		else
+		{
+			continue;
+		}
+
+		link_set_name(link, (char *)link_get_name(new));
+		link_set_origin(link, link_get_origin(new));
+		link_set_destination(link, link_get_destination(new));
+		link_set_direction(link, link_get_direction(new));
+		if (opened == TRUE)
+		{
+			game_publish_event(game, link_get_open(link) == TRUE ? EVENT_LINK_OPENED : EVENT_LINK_CLOSED, link_get_id(link), link_get_origin(link),
+							   link_get_destination(link), (int)link_get_direction(link));
+			opened = FALSE;
+		}
+	}
+	reload_compact((void **)game_get_links(game), game_get_n_links(game));
+
+	free(live);
+	return status;
+}
+
+/**
+ * @brief Adds, changes and removes the objects changed in the file
+ *
+ * An object a player carries stays with them, even if the file moves it or removes it.
+ * No event is published: the file only moves objects between spaces, and the
+ * events of objects are for those a player takes or drops.
+ */
+static Status reload_objects(Game *game, ReloadVersion *before, ReloadVersion *after, ReloadDiff *diff)
+{
+	ReloadChange *changes = NULL;
+	ReloadEntry *live = NULL;
+	Object *object = NULL, *old = NULL, *new = NULL;
+	int n = reload_range(after, RELOAD_OBJECT, &changes), n_live, i;
+	Id at;
+	Status status = OK;
+
+	if (n == 0)
+	{
+		return OK;
+	}
+	if (!(live = reload_index(game, RELOAD_OBJECT, &n_live)))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		old = (Object *)reload_get(before, RELOAD_OBJECT, changes[i].id);
+		new = (Object *)reload_get(after, RELOAD_OBJECT, changes[i].id);
+		at = reload_find(live, n_live, changes[i].id);
+		object = at != NO_ID ? game_get_objects(game)[at] : NULL;
+		if (!old && new && !object)
+		{
+			if (!(object = object_create(changes[i].id)) || game_add_objects(game, object) == ERROR)
+			{
+				object_destroy(object);
+				status = ERROR;
+				break;
+			}
+			object_set_name(object, (char *)object_get_name(new));
+			object_set_description(object, (char *)object_get_description(new));
+			object_set_location(object, object_get_location(new));
+			diff->added++;
+		}
+		else if (old && object && reload_is_carried(game, changes[i].id) == TRUE &&
+				 (!new || (object_get_location(old) != object_get_location(new) && reload_same(object_get_name(old), object_get_name(new)) == TRUE)))
+		{
+			diff->kept++;
+		}
+		else if (old && !new && object)
+		{
+			object_destroy(object);
+			game_get_objects(game)[at] = NULL;
+			diff->removed++;
+		}
+		else if (old && new && object)
+		{
+			object_set_name(object, (char *)object_get_name(new));
+			object_set_description(object, (char *)object_get_description(new));
+			if (object_get_location(old) != object_get_location(new) && reload_is_carried(game, changes[i].id) == FALSE)
+			{
+				object_set_location(object, object_get_location(new));
+			}
+			diff->changed++;
+		}
+	}
+	reload_compact((void **)game_get_objects(game), game_get_n_objects(game));
+
+	free(live);
+	return status;
+}
+
+/**
+ * @brief Adds, changes and removes the characters changed in the file
+ *
+ * A character following a player stays with them, even if the file moves it.
+ * A change of health or location publishes the event a command would.
+ */
+static Status reload_characters(Game *game, ReloadVersion *before, ReloadVersion *after, ReloadDiff *diff)
+{
+	ReloadChange *changes = NULL;
+	ReloadEntry *live = NULL;
+	Character *character = NULL, *old = NULL, *new = NULL;
+	int n = reload_range(after, RELOAD_CHARACTER, &changes), n_live, i;
+	Id at, location;
+	Status status = OK;
+
+	if (n == 0)
+	{
+		return OK;
+	}
+	if (!(live = reload_index(game, RELOAD_CHARACTER, &n_live)))
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		old = (Character *)reload_get(before, RELOAD_CHARACTER, changes[i].id);
+		new = (Character *)reload_get(after, RELOAD_CHARACTER, changes[i].id);
+		at = reload_find(live, n_live, changes[i].id);
+		character = at != NO_ID ? game_get_character_array(game)[at] : NULL;
+		location = reload_find(after->locations, after->n_locations, changes[i].id);
+		if (!old && new && !character)
+		{
+			if (!(character = character_create(changes[i].id)))
+			{
+				status = ERROR;
+				break;
+			}
+			character_set_name(character, (char *)character_get_name(new));
+			character_set_gdesc(character, (char *)character_get_gdesc(new));
+			character_set_health(character, character_get_health(new));
+			character_set_friendly(character, character_get_friendly(new));
+			character_set_message(character, (char *)character_get_message(new));
+			if (game_add_character(game, character, location) == ERROR)
+			{
+				character_destroy(character);
+				status = ERROR;
+				break;
+			}
+			diff->added++;
+		}
+		else if (old && !new && character)
+		{
+			game_set_character_following(game, character, NO_ID);
+			space_del_character(game_get_space(game, game_find_character(game, changes[i].id)), character);
+			character_destroy(character);
+			game_get_character_array(game)[at] = NULL;
+			diff->removed++;
+		}
+		else if (old && new && character)
+		{
+			character_set_name(character, (char *)character_get_name(new));
+			character_set_gdesc(character, (char *)character_get_gdesc(new));
+			character_set_message(character, (char *)character_get_message(new));
+			if (character_get_health(old) != character_get_health(new))
+			{
+				game_set_character_health(game, character, character_get_health(new));
+				game_publish_event(game, EVENT_HEALTH_CHANGED, changes[i].id, game_find_character(game, changes[i].id), NO_ID,
+								   character_get_health(character));
+			}
+			if (character_get_friendly(old) != character_get_friendly(new))
+			{
+				game_set_character_friendly(game, character, character_get_friendly(new));
+			}
+			if (location != NO_ID && location != reload_find(before->locations, before->n_locations, changes[i].id))
+			{
+				if (character_get_following(character) != NO_ID)
+				{
+					diff->kept++;
+				}
+				else
+				{
+					game_change_character_location(game, character, location);
+				}
+			}
+			diff->changed++;
+		}
+	}
+	reload_compact((void **)game_get_character_array(game), game_get_n_characters(game));
+
+	free(live);
+	return status;
+}
+
+/**
+ * @brief Applies to a game the changes found between two versions
+ *
+ * @return OK if they were applied, ERROR otherwise
+ */
+static Status reload_apply_changes(Game *game, ReloadVersion *before, ReloadVersion *after, ReloadDiff *diff)
+{
+	Status status = OK;
+
+	/* The spaces are added before anything is moved to them and removed after everything left them */
+	memset(diff, 0, sizeof(ReloadDiff));
+	if (reload_spaces(game, before, after, diff) == ERROR || reload_links(game, before, after, diff) == ERROR ||
+		reload_objects(game, before, after, diff) == ERROR || reload_characters(game, before, after, diff) == ERROR ||
+		reload_remove_spaces(game, before, after, diff) == ERROR)
+	{
+		status = ERROR;
+	}
+	if (diff->added + diff->changed + diff->removed > 0)
+	{
+		game_refresh(game);
+	}
+
+	return status;
+}
+
+Status reload_diff(Game *game, Game *before, Game *after, ReloadDiff *diff)
+{
+	ReloadVersion old, new;
+	ReloadDiff changes;
+	Status status = ERROR;
+	int kind;
+
+	if (!game || !before || !after || game_get_regions(game) || game_get_world(game))
+	{
+		return ERROR;
+	}
+
+	/* The versions only borrow the games, so they are freed here and not by reload_version_destroy */
+	memset(&old, 0, sizeof(ReloadVersion));
+	memset(&new, 0, sizeof(ReloadVersion));
+	old.game = before;
+	new.game = after;
+	if (reload_version_index(&old) == OK && reload_version_index(&new) == OK && reload_compare_versions(&old, &new) == OK)
+	{
+		status = reload_apply_changes(game, &old, &new, &changes);
+		if (diff)
+		{
+			*diff = changes;
+		}
+	}
+
+	for (kind = 0; kind < RELOAD_KINDS; kind++)
+	{
+		free(old.index[kind]);
+		free(new.index[kind]);
+	}
+	free(old.locations);
+	free(new.locations);
+	free(new.changes);
+	return status;
+}
+
+/**
+ * @brief Reads the events of inotify waiting
+ *
+ * @return TRUE if one of them is a write of the file, FALSE otherwise
+ */
+static Bool reload_read_events(Reload *reload)
+{
+	union
+	{
+		struct inotify_event event;
+		char bytes[RELOAD_EVENTS_SIZE];
+	} buffer;
+	struct inotify_event *event = NULL;
+	ssize_t n;
+	size_t i;
+	Bool written = FALSE;
+
+	if ((n = read(reload->fd, buffer.bytes, sizeof(buffer))) <= 0)
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i + sizeof(struct inotify_event) <= (size_t)n; i += sizeof(struct inotify_event) + event->len)
+	{
+		event = (struct inotify_event *)(buffer.bytes + i);
+		if (event->len > 0 && strcmp(event->name, reload->name) == 0)
+		{
+			written = TRUE;
+		}
+	}
+
+	return written;
+}
+
+/**
+ * @brief Parses the file, compares it with the version the game holds and leaves it for the game
+ *
+ * @param reload A pointer to the watcher
+ * @param seen When the file was written
+ */
+static void reload_parse(Reload *reload, unsigned long seen)
+{
+	ReloadVersion *version = NULL;
+	Game *game = NULL;
+	unsigned long t = stats_now();
+	Status status;
+
+	if (game_create_from_file(&game, reload->path) == ERROR)
+	{
+		game_destroy(game);
+		game = NULL;
+	}
+	version = reload_version_create(game);
+
+	/* The base does not change while it is compared, so a version taken by the game meanwhile is not compared with the one before it */
+	pthread_mutex_lock(&reload->lock);
+	status = version ? reload_compare_versions(reload->base, version) : ERROR;
+	if (status == ERROR)
+	{
+		reload->n_failed++;
+		reload_version_destroy(version);
+	}
+	else
+	{
+		reload_version_destroy(reload->pending);
+		reload->pending = version;
+		reload->seen = seen;
+		reload->parse = stats_now() - t;
+	}
+	pthread_mutex_unlock(&reload->lock);
+}
+
+/**
+ * @brief Reads a version from the pipe and frees it
+ *
+ * @return TRUE if the thread must stop, FALSE otherwise
+ */
+static Bool reload_wake(Reload *reload)
+{
+	ReloadVersion *version = NULL;
+
+	if (read(reload->wake[0], &version, sizeof(version)) != sizeof(version) || !version)
+	{
+		return TRUE;
+	}
+
+	reload_version_destroy(version);
+	return FALSE;
+}
+
+/**
+ * @brief Watches the file until NULL is written to the pipe, run by the thread
+ */
+static void *reload_watch(void *data)
+{
+	Reload *reload = (Reload *)data;
+	struct pollfd fds[2];
+	unsigned long seen;
+	Bool stop = FALSE;
+
+	fds[0].fd = reload->fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = reload->wake[0];
+	fds[1].events = POLLIN;
+	while (stop == FALSE && poll(fds, 2, -1) >= 0)
+	{
+		if ((fds[1].revents & POLLIN) && (stop = reload_wake(reload)) == TRUE)
+		{
+			break;
+		}
+		if (!(fds[0].revents & POLLIN) || reload_read_events(reload) == FALSE)
+		{
+			continue;
+		}
+
+		/* An editor writes the file in several steps, so it is parsed once it stays still */
+		seen = stats_now();
+		while (stop == FALSE && poll(fds, 2, RELOAD_SETTLE_MS) > 0)
+		{
+			if (fds[1].revents & POLLIN)
+			{
+				stop = reload_wake(reload);
+			}
+			if (fds[0].revents & POLLIN)
+			{
+				reload_read_events(reload);
+			}
+		}
+		if (stop == FALSE)
+		{
+			reload_parse(reload, seen);
+		}
+	}
+
+	return NULL;
+}
+
+Reload *reload_create(const char *path)
+{
+	Reload *reload = NULL;
+	Game *game = NULL;
+	char *dir = NULL, *slash = NULL;
+	int watch = -1;
+
+	if (!path || !(reload = (Reload *)calloc(1, sizeof(Reload))))
+	{
+		return NULL;
+	}
+
+	reload->fd = -1;
+	reload->wake[0] = reload->wake[1] = -1;
+	pthread_mutex_init(&reload->lock, NULL);
+	reload->path = (char *)malloc(strlen(path) + 1);
+	dir = (char *)malloc(strlen(path) + 2);
+	if (!reload->path || !dir)
+	{
+		free(dir);
+		reload_destroy(reload);
+		return NULL;
+	}
+
+	/* The directory is watched, since editors often replace the file instead of writing it */
+	strcpy(reload->path, path);
+	strcpy(dir, path);
+	if ((slash = strrchr(dir, '/')) != NULL)
+	{
+		slash[slash == dir ? 1 : 0] = '\0';
+		reload->name = reload->path + (slash - dir) + 1;
+	}
+	else
+	{
+		strcpy(dir, ".");
+		reload->name = reload->path;
+	}
+
+	if ((reload->fd = inotify_init()) >= 0)
+	{
+		watch = inotify_add_watch(reload->fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+	}
+	free(dir);
+	if (watch < 0 || pipe(reload->wake) != 0 || game_create_from_file(&game, reload->path) == ERROR ||
+		!(reload->base = reload_version_create(game)) || pthread_create(&reload->thread, NULL, reload_watch, reload) != 0)
+	{
+		if (!reload->base)
+		{
+			game_destroy(game);
+		}
+		reload_destroy(reload);
+		return NULL;
+	}
+
+	reload->started = TRUE;
+	return reload;
+}
+
+void reload_destroy(Reload *reload)
+{
+	ReloadVersion *stop = NULL;
+
+	if (!reload)
+	{
+		return;
+	}
+
+	/* The thread frees the versions written before it stops */
+	if (reload->started == TRUE && write(reload->wake[1], &stop, sizeof(stop)) == sizeof(stop))
+	{
+		pthread_join(reload->thread, NULL);
+	}
+	if (reload->fd >= 0)
+	{
+		close(reload->fd);
+	}
+	if (reload->wake[0] >= 0)
+	{
+		close(reload->wake[0]);
+		close(reload->wake[1]);
+	}
+	reload_version_destroy(reload->base);
+	reload_version_destroy(reload->pending);
+	pthread_mutex_destroy(&reload->lock);
+	free(reload->path);
+	free(reload);
+}
+
+int reload_apply(Reload *reload, Game *game, ReloadDiff *diff)
+{
+	ReloadVersion *before = NULL, *after = NULL;
+	ReloadDiff changes;
+	unsigned long t, seen, parse;
+	Status status;
+
+	if (!reload || !game)
+	{
+		return -1;
+	}
+
+	/* The thread holds the lock while it compares a version, which is then taken next round instead of waited for */
+	if (pthread_mutex_trylock(&reload->lock) != 0)
+	{
+		return 0;
+	}
+
+	/* The new version is the base from now on, even if it can not be applied whole */
+	after = reload->pending;
+	reload->pending = NULL;
+	seen = reload->seen;
+	parse = reload->parse;
+	before = reload->base;
+	if (after)
+	{
+		reload->base = after;
+	}
+	pthread_mutex_unlock(&reload->lock);
+	if (!after)
+	{
+		return 0;
+	}
+
+	t = stats_now();
+	status = reload_apply_changes(game, before, after, &changes);
+	changes.apply = stats_now() - t;
+	/* The version before is freed by the thread, which the game does not wait for */
+	if (write(reload->wake[1], &before, sizeof(before)) != sizeof(before))
+	{
+		reload_version_destroy(before);
+	}
+	changes.parse = parse;
+	changes.latency = stats_now() - seen;
+	STATS_STOP(STATS_SLOT_RELOAD, t);
+
+	if (diff)
+	{
+		*diff = changes;
+	}
+	return status == OK ? 1 : -1;
+}
+
+int reload_get_n_failed(Reload *reload)
+{
+	int n_failed;
+
+	if (!reload)
+	{
+		return -1;
+	}
+
+	pthread_mutex_lock(&reload->lock);
+	n_failed = reload->n_failed;
+	pthread_mutex_unlock(&reload->lock);
+	return n_failed;
+}
@@ -0,0 +1,384 @@
+/**
+ * @brief It tests the reload of the data file of a running game
+ *
+ * @file reload_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "reload.h"
+#include "game_actions.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 7
+
+/**
+ * @brief Data file of the tests, in the directory they are run from
+ */
+#define WORLD_FILE "reload_test.dat"
+
+/**
+ * @brief Room for the anthill
+ */
+#define WORLD_SIZE 8192
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_reload_create();
+
+/**
+ * @brief Test that a file without changes changes nothing.
+ */
+void test1_reload_diff();
+
+/**
+ * @brief Test that new spaces and links are added and the spaces changed are changed.
+ */
+void test2_reload_diff();
+
+/**
+ * @brief Test that an object carried stays with its player while the others are moved and removed.
+ */
+void test3_reload_diff();
+
+/**
+ * @brief Test that a space is removed unless a player stands in it.
+ */
+void test4_reload_diff();
+
+/**
+ * @brief Test that the changes a command could make publish its events, and objects take their new descriptions.
+ */
+void test5_reload_diff();
+
+/**
+ * @brief Test that a write of the file is seen and applied between turns.
+ */
+void test1_reload_apply();
+
+/**
+ * @brief Main function for reload unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Reload:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_reload_create();
+	if (all || test == 2)
+		test1_reload_diff();
+	if (all || test == 3)
+		test2_reload_diff();
+	if (all || test == 4)
+		test3_reload_diff();
+	if (all || test == 5)
+		test4_reload_diff();
+	if (all || test == 6)
+		test1_reload_apply();
+	if (all || test == 7)
+		test5_reload_diff();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It writes the anthill to the file of the tests with some of its text replaced
+ *
+ * @param from The texts replaced, the first time they are found, NULL ended
+ * @param to The texts they are replaced with
+ */
+static void write_world(const char **from, const char **to)
+{
+	char world[WORLD_SIZE], copy[WORLD_SIZE], *found = NULL;
+	FILE *f = fopen("resources/anthill.dat", "r");
+	size_t n = 0;
+	int i;
+
+	if (f)
+	{
+		n = fread(world, 1, WORLD_SIZE - 1, f);
+		fclose(f);
+	}
+	world[n] = '\0';
+
+	for (i = 0; from && from[i]; i++)
+	{
+		if ((found = strstr(world, from[i])) != NULL)
+		{
+			strcpy(copy, found + strlen(from[i]));
+			strcpy(found, to[i]);
+			strcat(world, copy);
+		}
+	}
+
+	if ((f = fopen(WORLD_FILE, "w")) != NULL)
+	{
+		fputs(world, f);
+		fclose(f);
+	}
+}
+
+/**
+ * @brief It loads the file of the tests
+ */
+static Game *world_load()
+{
+	Game *game = NULL;
+
+	if (game_create_from_file(&game, WORLD_FILE) == ERROR)
+	{
+		game_destroy(game);
+		return NULL;
+	}
+
+	return game;
+}
+
+/**
+ * @brief It runs a command of the first player, who starts in space 11
+ */
+static void play(Game *game, const char *input)
+{
+	char buffer[WORD_SIZE];
+	Command *command = game_get_last_command(game);
+
+	strcpy(buffer, input);
+	command_parse_input(command, buffer);
+	game_set_turn(game, 0);
+	game_actions_update(game, command);
+}
+
+/**
+ * @brief It gets a character of a game by its id
+ */
+static Character *find_character(Game *game, Id id)
+{
+	int i;
+
+	for (i = 0; i < *game_get_n_characters(game); i++)
+	{
+		if (character_get_id(game_get_character_array(game)[i]) == id)
+		{
+			return game_get_character_array(game)[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief It keeps the events of a batch, the data is an array of EventType ended by EVENT_TYPES
+ */
+static void keep_events(const Event *events, int n_events, void *data)
+{
+	EventType *types = (EventType *)data;
+	int i, n = 0;
+
+	while (types[n] != EVENT_TYPES)
+	{
+		n++;
+	}
+	for (i = 0; i < n_events && n < 7; i++)
+	{
+		types[n++] = events[i].type;
+	}
+	types[n] = EVENT_TYPES;
+}
+
+void test1_reload_create()
+{
+	Game *game = NULL;
+	ReloadDiff diff;
+
+	game_create(&game);
+	PRINT_TEST_RESULT(reload_create(NULL) == NULL && reload_create("reload_test.missing") == NULL && reload_apply(NULL, game, &diff) == -1 &&
+					  reload_diff(game, NULL, game, &diff) == ERROR && reload_diff(NULL, game, game, &diff) == ERROR && reload_get_n_failed(NULL) == -1);
+	game_destroy(game);
+}
+
+void test1_reload_diff()
+{
+	Game *game = NULL, *before = NULL, *after = NULL;
+	ReloadDiff diff;
+	unsigned long hash;
+
+	write_world(NULL, NULL);
+	game = world_load();
+	before = world_load();
+	after = world_load();
+	play(game, "m s");
+	hash = game_get_hash(game);
+	PRINT_TEST_RESULT(reload_diff(game, before, after, &diff) == OK && diff.added == 0 && diff.changed == 0 && diff.removed == 0 && diff.kept == 0 &&
+					  game_get_hash(game) == hash && player_get_location(game_get_player_at(game, 0)) == 121);
+	game_destroy(game);
+	game_destroy(before);
+	game_destroy(after);
+	remove(WORLD_FILE);
+}
+
+void test2_reload_diff()
+{
+	const char *from[] = {"#s:123|Corridor_3|", "#l:200|", NULL};
+	const char *to[] = {"#s:130|Cellar|\n#s:123|Spider_nest|", "#l:230|Cellar|123|130|2|1|\n#l:200|"};
+	Game *game = NULL, *before = NULL, *after = NULL;
+	ReloadDiff diff;
+	Status status;
+
+	write_world(NULL, NULL);
+	game = world_load();
+	before = world_load();
+	write_world(from, to);
+	after = world_load();
+	status = reload_diff(game, before, after, &diff);
+	PRINT_TEST_RESULT(status == OK && diff.added == 2 && diff.changed == 1 && diff.removed == 0 && game_get_space(game, 130) != NULL &&
+					  game_get_connection(game, 123, E) == 130 && game_connection_is_open(game, 123, E) == TRUE &&
+					  strcmp(space_get_name(game_get_space(game, 123)), "Spider_nest") == 0 && game_get_hash(game) == game_compute_hash(game));
+	game_destroy(game);
+	game_destroy(before);
+	game_destroy(after);
+	remove(WORLD_FILE);
+}
+
+void test3_reload_diff()
+{
+	const char *from[] = {"|123|10|0|", "#o:23|Leaf|122", "#o:24|Nut|123\n", "#o:22|Crumb|11", NULL};
+	const char *to[] = {"|123|20|0|", "#o:23|Leaf|123", "", "#o:22|Crumb|121"};
+	Game *game = NULL, *before = NULL, *after = NULL;
+	ReloadDiff diff;
+	Status status;
+	int n_objects;
+
+	write_world(NULL, NULL);
+	game = world_load();
+	before = world_load();
+	write_world(from, to);
+	after = world_load();
+	play(game, "m s");
+	play(game, "m s");
+	play(game, "t Leaf");
+	n_objects = *game_get_n_objects(game);
+	status = reload_diff(game, before, after, &diff);
+	PRINT_TEST_RESULT(status == OK && diff.kept == 1 && diff.removed == 1 && diff.changed == 2 &&
+					  player_has_object(game_get_player_at(game, 0), 23) == TRUE && *game_get_n_objects(game) == n_objects - 1 &&
+					  game_get_object_by_id(game, 24) == NULL && object_get_location(game_get_object_by_id(game, 22)) == 121 &&
+					  character_get_health(find_character(game, 3)) == 20 && game_get_hash(game) == game_compute_hash(game));
+	game_destroy(game);
+	game_destroy(before);
+	game_destroy(after);
+	remove(WORLD_FILE);
+}
+
+void test4_reload_diff()
+{
+	const char *from[] = {"#s:14|", "#s:121|", NULL};
+	const char *to[] = {"#s:15|", "#s:1210|"};
+	Game *game = NULL, *before = NULL, *after = NULL;
+	ReloadDiff diff;
+	Status status;
+
+	write_world(NULL, NULL);
+	game = world_load();
+	before = world_load();
+	write_world(from, to);
+	after = world_load();
+	play(game, "m s");
+	status = reload_diff(game, before, after, &diff);
+	PRINT_TEST_RESULT(status == OK && diff.added == 2 && diff.removed == 1 && diff.kept == 1 && game_get_space(game, 14) == NULL &&
+					  game_get_space(game, 15) != NULL && game_get_space(game, 121) != NULL && game_get_space(game, 1210) != NULL);
+	game_destroy(game);
+	game_destroy(before);
+	game_destroy(after);
+	remove(WORLD_FILE);
+}
+
+void test5_reload_diff()
+{
+	const char *from[] = {"|123|10|0|", "#o:21|Grain|11\n", "#l:205|Corridor_2|122|123|1|1|", NULL};
+	const char *to[] = {"|123|20|0|", "", "#l:205|Corridor_2|122|123|1|0|"};
+	Game *game = NULL, *before = NULL, *after = NULL;
+	EventType types[8] = {EVENT_TYPES};
+	ReloadDiff diff;
+	Status status;
+
+	write_world(NULL, NULL);
+	game = world_load();
+	before = world_load();
+	write_world(from, to);
+	after = world_load();
+	event_bus_subscribe(game_get_events(game), EVENT_ALL, keep_events, types);
+	status = reload_diff(game, before, after, &diff);
+	event_bus_dispatch(game_get_events(game));
+	PRINT_TEST_RESULT(status == OK && types[0] == EVENT_LINK_CLOSED && types[1] == EVENT_HEALTH_CHANGED && types[2] == EVENT_TYPES &&
+					  game_connection_is_open(game, 122, S) == FALSE && character_get_health(find_character(game, 3)) == 20 &&
+					  strcmp(object_get_description(game_get_object_by_id(game, 22)), object_get_description(game_get_object_by_id(after, 22))) == 0 &&
+					  game_get_hash(game) == game_compute_hash(game));
+	game_destroy(game);
+	game_destroy(before);
+	game_destroy(after);
+	remove(WORLD_FILE);
+}
+
+void test1_reload_apply()
+{
+	const char *from[] = {"#s:123|Corridor_3|", NULL};
+	const char *to[] = {"#s:123|Spider_nest|"};
+	Game *game = NULL;
+	Reload *reload = NULL;
+	ReloadDiff diff;
+	int applied = 0, waited;
+
+	write_world(NULL, NULL);
+	game = world_load();
+	reload = reload_create(WORLD_FILE);
+	write_world(from, to);
+	/* The file is parsed in the background, which takes some time */
+	for (waited = 0; reload && applied == 0 && waited < 200; waited++)
+	{
+		struct timespec pause = {0, 10000000};
+
+		nanosleep(&pause, NULL);
+		applied = reload_apply(reload, game, &diff);
+	}
+	PRINT_TEST_RESULT(applied == 1 && diff.changed == 1 && diff.latency >= diff.apply && reload_apply(reload, game, &diff) == 0 &&
+					  strcmp(space_get_name(game_get_space(game, 123)), "Spider_nest") == 0 && reload_get_n_failed(reload) == 0);
+	reload_destroy(reload);
+	game_destroy(game);
+	remove(WORLD_FILE);
+}
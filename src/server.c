@@ -0,0 +1,644 @@
+/**
+ * @brief It implements the game server
+ *
+ * @file server.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "server.h"
+#include "command.h"
+#include "game_actions.h"
+#include "libscreen_null.h"
+
+/**
+ * @brief Maximum length of a command line
+ */
+#define SERVER_LINE_SIZE 256
+
+/**
+ * @brief Maximum number of events handled by each epoll_wait
+ */
+#define SERVER_MAX_EVENTS 64
+
+/**
+ * @brief Text that clears the terminal of the client before each view
+ */
+#define SERVER_CLEAR "\033[H\033[2J"
+
+/**
+ * @brief A connected player
+ */
+typedef struct
+{
+	int fd;						   /*!< Socket of the client, -1 if the slot is free */
+	Game *game;					   /*!< Game or session it plays */
+	int player;					   /*!< Position of its player in the game */
+	char in[SERVER_LINE_SIZE];	   /*!< Start of a line that has not arrived whole */
+	int n_in;					   /*!< Number of characters in in */
+	Bool discarding;			   /*!< Whether the rest of a too long line is being skipped */
+	char *out;					   /*!< View being sent */
+	int out_len;				   /*!< Length of out */
+	int out_sent;				   /*!< Characters of out already sent */
+	char *next;					   /*!< Newest view, sent when out is done */
+	int next_len;				   /*!< Length of next */
+	Bool writing;				   /*!< Whether the socket is waited for writing */
+} Connection;
+
+/**
+ * @brief Game server
+ *
+ * This struct stores the epoll loop and the connection of each player
+ */
+struct _Server
+{
+	Game *world;					 /*!< Game loaded from the world file */
+	Game **games;					 /*!< Games played, the world itself or its sessions */
+	int n_games;					 /*!< Number of games */
+	int n_sessions;					 /*!< Number of sessions of the world, 0 if the world is played */
+	Graphic_engine *gengine;		 /*!< Engine that paints the views */
+	int listen_fd;					 /*!< Listening socket, -1 if there is none */
+	int epoll_fd;					 /*!< Epoll instance of every socket */
+	Connection *connections;		 /*!< Connection of each player of each game, MAX_PLAYERS per game */
+};
+
+/**
+ * @brief Makes a socket non-blocking
+ *
+ * @return OK if it was changed, ERROR otherwise
+ */
+static Status server_set_nonblocking(int fd)
+{
+	int flags = fcntl(fd, F_GETFL, 0);
+
+	if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+	{
+		return ERROR;
+	}
+
+	return OK;
+}
+
+int server_listen(char *address)
+{
+	struct sockaddr_in in_addr;
+	struct sockaddr_un un_addr;
+	int fd, one = 1;
+
+	if (!address)
+	{
+		return -1;
+	}
+
+	if (strncmp(address, "unix:", 5) == 0)
+	{
+		if (strlen(address + 5) >= sizeof(un_addr.sun_path) || (fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		{
+			return -1;
+		}
+		memset(&un_addr, 0, sizeof(un_addr));
+		un_addr.sun_family = AF_UNIX;
+		strcpy(un_addr.sun_path, address + 5);
+		unlink(un_addr.sun_path);
+		if (bind(fd, (struct sockaddr *)&un_addr, sizeof(un_addr)) < 0)
+		{
+			close(fd);
+			return -1;
+		}
+	}
+	else
+	{
+		if (atoi(address) <= 0 || atoi(address) > 65535 || (fd = socket(AF_INET, SOCK_STREAM, 0)) < 0)
+		{
+			return -1;
+		}
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+		memset(&in_addr, 0, sizeof(in_addr));
+		in_addr.sin_family = AF_INET;
+		in_addr.sin_port = htons((unsigned short)atoi(address));
+		in_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (bind(fd, (struct sockaddr *)&in_addr, sizeof(in_addr)) < 0)
+		{
+			close(fd);
+			return -1;
+		}
+	}
+
+	if (listen(fd, MAX_PLAYERS) < 0 || server_set_nonblocking(fd) == ERROR)
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/**
+ * @brief Closes a connection, its player stays in the game
+ */
+static void server_close(int epoll_fd, Connection *connection)
+{
+	epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+	close(connection->fd);
+	free(connection->out);
+	free(connection->next);
+	connection->fd = -1;
+	connection->n_in = 0;
+	connection->discarding = FALSE;
+	connection->out = NULL;
+	connection->next = NULL;
+	connection->writing = FALSE;
+}
+
+/**
+ * @brief Sends as much of the pending views as the socket takes
+ *
+ * The socket is only waited for writing while something is left.
+ *
+ * @return OK if the connection is still valid, ERROR if it must be closed
+ */
+static Status server_flush(int epoll_fd, Connection *connection)
+{
+	struct epoll_event event;
+	ssize_t n;
+
+	while (connection->out)
+	{
+		n = write(connection->fd, connection->out + connection->out_sent, connection->out_len - connection->out_sent);
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			break;
+		}
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n < 0)
+		{
+			return ERROR;
+		}
+
+		connection->out_sent += (int)n;
+		if (connection->out_sent == connection->out_len)
+		{
+			free(connection->out);
+			connection->out = connection->next;
+			connection->out_len = connection->next_len;
+			connection->out_sent = 0;
+			connection->next = NULL;
+		}
+	}
+
+	if ((connection->out != NULL) != (connection->writing == TRUE))
+	{
+		connection->writing = connection->out ? TRUE : FALSE;
+		event.events = EPOLLIN | (connection->writing == TRUE ? EPOLLOUT : 0);
+		event.data.ptr = connection;
+		if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection->fd, &event) < 0)
+		{
+			return ERROR;
+		}
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Paints the view of a player and queues it on its connection
+ *
+ * A view that has not started to be sent is replaced by the new one, so a
+ * slow client holds at most two views.
+ *
+ * @return OK if the connection is still valid, ERROR if it must be closed
+ */
+static Status server_send_view(Graphic_engine *gengine, int epoll_fd, Connection *connection)
+{
+	char *text = NULL, *view = NULL;
+	int len = 0, view_len;
+
+	game_set_turn(connection->game, connection->player);
+	graphic_engine_paint_game(gengine, connection->game);
+	if (!(text = screen_get_text(&len)))
+	{
+		return ERROR;
+	}
+
+	view_len = (int)strlen(SERVER_CLEAR) + len + (int)strlen(SERVER_PROMPT);
+	if (!(view = (char *)malloc(view_len + 1)))
+	{
+		return ERROR;
+	}
+	strcpy(view, SERVER_CLEAR);
+	memcpy(view + strlen(SERVER_CLEAR), text, len);
+	strcpy(view + strlen(SERVER_CLEAR) + len, SERVER_PROMPT);
+
+	if (!connection->out)
+	{
+		connection->out = view;
+		connection->out_len = view_len;
+		connection->out_sent = 0;
+	}
+	else
+	{
+		free(connection->next);
+		connection->next = view;
+		connection->next_len = view_len;
+	}
+
+	return server_flush(epoll_fd, connection);
+}
+
+/**
+ * @brief Sends every connected player of a game its view
+ */
+static void server_broadcast(Server *server, Game *game)
+{
+	int i;
+
+	for (i = 0; i < server->n_games * MAX_PLAYERS; i++)
+	{
+		if (server->connections[i].fd >= 0 && server->connections[i].game == game &&
+			server_send_view(server->gengine, server->epoll_fd, &server->connections[i]) == ERROR)
+		{
+			server_close(server->epoll_fd, &server->connections[i]);
+		}
+	}
+}
+
+/**
+ * @brief Closes every connection of a game, once it has sent them its last view
+ */
+static void server_close_game(Server *server, Game *game)
+{
+	int i;
+
+	for (i = 0; i < server->n_games * MAX_PLAYERS; i++)
+	{
+		if (server->connections[i].fd >= 0 && server->connections[i].game == game)
+		{
+			server_close(server->epoll_fd, &server->connections[i]);
+		}
+	}
+}
+
+/**
+ * @brief Runs the command of a player
+ *
+ * @return FALSE if the player asked to leave, TRUE otherwise
+ */
+static Bool server_run_command(Connection *connection, char *line)
+{
+	Game *game = connection->game;
+	Command *command = NULL;
+	Status status;
+
+	game_set_turn(game, connection->player);
+	command = game_get_last_command(game);
+	command_parse_input(command, line);
+	if (command_get_code(command) == EXIT)
+	{
+		/* The next player that connects to the slot starts again without EXIT */
+		command_set_code(command, NO_CMD);
+		return FALSE;
+	}
+
+	status = game_actions_update(game, command);
+	command_set_status(command, status);
+	event_bus_dispatch(game_get_events(game));
+	if (player_get_health(game_get_player_at(game, connection->player)) <= 0)
+	{
+		game_set_finished(game, TRUE);
+	}
+	game_evict_regions(game);
+
+	return TRUE;
+}
+
+/**
+ * @brief Reads what a client sent and runs its complete lines
+ *
+ * @return OK if the connection is still valid, ERROR if it must be closed
+ */
+static Status server_read(Server *server, Connection *connection)
+{
+	char buffer[SERVER_LINE_SIZE];
+	ssize_t n;
+	int i;
+
+	for (;;)
+	{
+		n = read(connection->fd, buffer, sizeof(buffer));
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			return OK;
+		}
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			return ERROR;
+		}
+
+		for (i = 0; i < n; i++)
+		{
+			if (buffer[i] != '\n')
+			{
+				/* Lines longer than any command are skipped whole */
+				if (connection->n_in == SERVER_LINE_SIZE - 1)
+				{
+					connection->discarding = TRUE;
+					connection->n_in = 0;
+				}
+				if (connection->discarding == FALSE)
+				{
+					connection->in[connection->n_in++] = buffer[i];
+				}
+				continue;
+			}
+
+			connection->in[connection->n_in] = '\0';
+			if (connection->n_in > 0 && connection->in[connection->n_in - 1] == '\r')
+			{
+				connection->in[connection->n_in - 1] = '\0';
+			}
+			connection->n_in = 0;
+			if (connection->discarding == TRUE)
+			{
+				connection->discarding = FALSE;
+				continue;
+			}
+
+			if (server_run_command(connection, connection->in) == FALSE)
+			{
+				return ERROR;
+			}
+			server_broadcast(server, connection->game);
+			if (connection->fd < 0 || game_get_finished(connection->game) == TRUE)
+			{
+				return connection->fd < 0 ? OK : ERROR;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Frees the games a server created and the server itself
+ */
+static void server_free(Server *server)
+{
+	int i;
+
+	for (i = 0; server->games && i < server->n_sessions; i++)
+	{
+		game_destroy(server->games[i]);
+	}
+	if (server->epoll_fd >= 0)
+	{
+		close(server->epoll_fd);
+	}
+	free(server->games);
+	free(server->connections);
+	free(server);
+}
+
+Server *server_create(Game *world, Graphic_engine *gengine, int listen_fd, int n_sessions)
+{
+	Server *server = NULL;
+	struct epoll_event event;
+	int i;
+
+	if (!world || !gengine || n_sessions < 0 || !(server = (Server *)calloc(1, sizeof(Server))))
+	{
+		return NULL;
+	}
+
+	server->world = world;
+	server->n_games = n_sessions > 0 ? n_sessions : 1;
+	server->gengine = gengine;
+	server->listen_fd = listen_fd;
+	server->epoll_fd = -1;
+	if (!(server->games = (Game **)calloc(server->n_games, sizeof(Game *))) ||
+		!(server->connections = (Connection *)calloc(server->n_games * MAX_PLAYERS, sizeof(Connection))))
+	{
+		server_free(server);
+		return NULL;
+	}
+
+	/* Each session plays the world apart, without the world itself being played */
+	server->games[0] = world;
+	for (server->n_sessions = 0; server->n_sessions < n_sessions; server->n_sessions++)
+	{
+		if (game_create_session(&server->games[server->n_sessions], world) == ERROR)
+		{
+			server_free(server);
+			return NULL;
+		}
+	}
+
+	for (i = 0; i < server->n_games * MAX_PLAYERS; i++)
+	{
+		server->connections[i].fd = -1;
+		server->connections[i].game = server->games[i / MAX_PLAYERS];
+		server->connections[i].player = i % MAX_PLAYERS;
+	}
+
+	if ((server->epoll_fd = epoll_create(SERVER_MAX_EVENTS)) < 0)
+	{
+		server_free(server);
+		return NULL;
+	}
+
+	event.events = EPOLLIN;
+	event.data.ptr = NULL;
+	if (listen_fd >= 0 && epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) < 0)
+	{
+		server_free(server);
+		return NULL;
+	}
+
+	return server;
+}
+
+void server_destroy(Server *server)
+{
+	int i;
+
+	if (!server)
+	{
+		return;
+	}
+
+	for (i = 0; i < server->n_games * MAX_PLAYERS; i++)
+	{
+		if (server->connections[i].fd >= 0)
+		{
+			server_close(server->epoll_fd, &server->connections[i]);
+		}
+	}
+	server_free(server);
+}
+
+Status server_add_client(Server *server, int fd)
+{
+	struct epoll_event event;
+	Connection *connection = NULL;
+	int i;
+
+	if (!server || fd < 0)
+	{
+		return ERROR;
+	}
+
+	/* The first free player of a game that is not finished, games in order */
+	for (i = 0; i < server->n_games * MAX_PLAYERS; i++)
+	{
+		connection = &server->connections[i];
+		if (connection->fd < 0 && connection->player < game_get_n_players(connection->game) &&
+			game_get_finished(connection->game) == FALSE)
+		{
+			break;
+		}
+	}
+
+	if (i == server->n_games * MAX_PLAYERS || server_set_nonblocking(fd) == ERROR)
+	{
+		if (write(fd, SERVER_FULL, strlen(SERVER_FULL)) < 0)
+		{
+			/* The client is refused anyway */
+		}
+		close(fd);
+		return ERROR;
+	}
+
+	event.events = EPOLLIN;
+	event.data.ptr = connection;
+	if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+	{
+		close(fd);
+		return ERROR;
+	}
+
+	connection->fd = fd;
+	if (server_send_view(server->gengine, server->epoll_fd, connection) == ERROR)
+	{
+		server_close(server->epoll_fd, connection);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+int server_poll(Server *server, int timeout)
+{
+	struct epoll_event events[SERVER_MAX_EVENTS];
+	Connection *connection = NULL;
+	int fd, n, i;
+
+	if (!server)
+	{
+		return -1;
+	}
+
+	if ((n = epoll_wait(server->epoll_fd, events, SERVER_MAX_EVENTS, timeout)) < 0)
+	{
+		return errno == EINTR ? 0 : -1;
+	}
+
+	for (i = 0; i < n && server_is_finished(server) == FALSE; i++)
+	{
+		/* Each waiting client gets the first free player */
+		if (!(connection = (Connection *)events[i].data.ptr))
+		{
+			while ((fd = accept(server->listen_fd, NULL, NULL)) >= 0)
+			{
+				server_add_client(server, fd);
+			}
+			continue;
+		}
+
+		/* The connection may have been closed by an earlier event of this round */
+		if (connection->fd < 0)
+		{
+			continue;
+		}
+
+		if (((events[i].events & EPOLLOUT) && server_flush(server->epoll_fd, connection) == ERROR) ||
+			((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && server_read(server, connection) == ERROR))
+		{
+			server_close(server->epoll_fd, connection);
+		}
+		if (game_get_finished(connection->game) == TRUE)
+		{
+			server_close_game(server, connection->game);
+		}
+	}
+
+	return n;
+}
+
+int server_get_n_clients(Server *server)
+{
+	int i, n = 0;
+
+	if (!server)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < server->n_games * MAX_PLAYERS; i++)
+	{
+		if (server->connections[i].fd >= 0)
+		{
+			n++;
+		}
+	}
+
+	return n;
+}
+
+Bool server_is_finished(Server *server)
+{
+	int i;
+
+	if (!server)
+	{
+		return TRUE;
+	}
+
+	for (i = 0; i < server->n_games; i++)
+	{
+		if (game_get_finished(server->games[i]) == FALSE)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+Game *server_get_game(Server *server, int position)
+{
+	if (!server || position < 0 || position >= server->n_games)
+	{
+		return NULL;
+	}
+
+	return server->games[position];
+}
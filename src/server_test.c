@@ -0,0 +1,351 @@
+/**
+ * @brief It tests the game server over pairs of connected sockets
+ *
+ * @file server_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "server.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 6
+
+/**
+ * @brief Room for what a client reads at once
+ */
+#define CLIENT_SIZE 65536
+
+/**
+ * @brief Commands sent while another client does not read
+ */
+#define CLIENT_COMMANDS 200
+
+/**
+ * @brief Graphic engine of every test, it can only be created once
+ */
+static Graphic_engine *gengine = NULL;
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_server_create();
+
+/**
+ * @brief Test that each client gets a player and its view.
+ */
+void test1_server_add_client();
+
+/**
+ * @brief Test that a client is refused when every player is taken.
+ */
+void test2_server_add_client();
+
+/**
+ * @brief Test that a command is run and every client gets the new view.
+ */
+void test1_server_poll();
+
+/**
+ * @brief Test that a client that never reads does not stop the others.
+ */
+void test2_server_poll();
+
+/**
+ * @brief Test that the clients fill the sessions in order, and a command only changes its session.
+ */
+void test1_server_get_game();
+
+/**
+ * @brief Main function for server unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	/* Writes to a client that went away fail instead of killing the tests */
+	signal(SIGPIPE, SIG_IGN);
+	gengine = graphic_engine_create();
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Server:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_server_create();
+	if (all || test == 2)
+		test1_server_add_client();
+	if (all || test == 3)
+		test2_server_add_client();
+	if (all || test == 4)
+		test1_server_poll();
+	if (all || test == 5)
+		test2_server_poll();
+	if (all || test == 6)
+		test1_server_get_game();
+
+	graphic_engine_destroy(gengine);
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It connects a client to the server, with a pair of sockets
+ *
+ * @param buffer Bytes of the send buffer of the server and the receive buffer of the client, 0 to leave them
+ * @return The end of the client, non-blocking, -1 if there was an error
+ */
+static int client_connect(Server *server, int buffer)
+{
+	int fds[2];
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+	{
+		return -1;
+	}
+
+	if (buffer > 0)
+	{
+		setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+		setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+	}
+	fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL, 0) | O_NONBLOCK);
+	server_add_client(server, fds[0]);
+
+	return fds[1];
+}
+
+/**
+ * @brief It reads everything a client was sent, ended with '\0'
+ *
+ * @return The number of bytes read
+ */
+static int client_read(int fd, char *text)
+{
+	int n = 0;
+	ssize_t r;
+
+	while (n < CLIENT_SIZE - 1 && ((r = read(fd, text + n, CLIENT_SIZE - 1 - n)) > 0 || (r < 0 && errno == EINTR)))
+	{
+		n += r > 0 ? (int)r : 0;
+	}
+	text[n] = '\0';
+
+	return n;
+}
+
+/**
+ * @brief It tells whether a text ends with the prompt, as a whole view does
+ */
+static Bool ends_with_prompt(const char *text, int n)
+{
+	int len = (int)strlen(SERVER_PROMPT);
+
+	return n >= len && strcmp(text + n - len, SERVER_PROMPT) == 0 ? TRUE : FALSE;
+}
+
+/**
+ * @brief It sends a command line from a client and lets the server serve it
+ */
+static void client_send(Server *server, int fd, const char *line)
+{
+	if (write(fd, line, strlen(line)) == (ssize_t)strlen(line))
+	{
+		server_poll(server, 100);
+	}
+}
+
+void test1_server_create()
+{
+	Game *game = NULL;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	PRINT_TEST_RESULT(server_create(NULL, gengine, -1, 0) == NULL && server_create(game, NULL, -1, 0) == NULL && server_add_client(NULL, 0) == ERROR &&
+					  server_poll(NULL, 0) == -1 && server_get_n_clients(NULL) == -1 && server_listen(NULL) == -1 && server_listen("0") == -1);
+	game_destroy(game);
+}
+
+void test1_server_add_client()
+{
+	Game *game = NULL;
+	Server *server = NULL;
+	char *text = (char *)malloc(CLIENT_SIZE);
+	int ant, worm, n_ant, n_worm;
+	Bool ok;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	server = server_create(game, gengine, -1, 0);
+	ant = client_connect(server, 0);
+	n_ant = client_read(ant, text);
+	ok = ant >= 0 && ends_with_prompt(text, n_ant) == TRUE ? TRUE : FALSE;
+	worm = client_connect(server, 0);
+	n_worm = client_read(worm, text);
+	PRINT_TEST_RESULT(ok == TRUE && worm >= 0 && ends_with_prompt(text, n_worm) == TRUE && server_get_n_clients(server) == 2);
+	server_destroy(server);
+	close(ant);
+	close(worm);
+	free(text);
+	game_destroy(game);
+}
+
+void test2_server_add_client()
+{
+	Game *game = NULL;
+	Server *server = NULL;
+	char *text = (char *)malloc(CLIENT_SIZE);
+	int ant, worm, late, again;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	server = server_create(game, gengine, -1, 0);
+	ant = client_connect(server, 0);
+	worm = client_connect(server, 0);
+	late = client_connect(server, 0);
+	client_read(late, text);
+	/* Once a client leaves, its player can be taken again */
+	close(worm);
+	server_poll(server, 100);
+	again = client_connect(server, 0);
+	PRINT_TEST_RESULT(text != NULL && strcmp(text, SERVER_FULL) == 0 && read(late, text, 1) == 0 && server_get_n_clients(server) == 2 &&
+					  client_read(again, text) > 0 && ends_with_prompt(text, (int)strlen(text)) == TRUE);
+	server_destroy(server);
+	close(ant);
+	close(late);
+	close(again);
+	free(text);
+	game_destroy(game);
+}
+
+void test1_server_poll()
+{
+	Game *game = NULL;
+	Server *server = NULL;
+	char *text = (char *)malloc(CLIENT_SIZE);
+	int ant, worm, n_ant, n_worm;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	server = server_create(game, gengine, -1, 0);
+	ant = client_connect(server, 0);
+	worm = client_connect(server, 0);
+	client_read(ant, text);
+	client_read(worm, text);
+	client_send(server, ant, "m s\n");
+	n_ant = client_read(ant, text);
+	n_worm = client_read(worm, text);
+	PRINT_TEST_RESULT(text != NULL && player_get_location(game_get_player_at(game, 0)) == 121 && player_get_location(game_get_player_at(game, 1)) == 122 &&
+					  ends_with_prompt(text, n_worm) == TRUE && n_ant > 0 && server_poll(server, 0) == 0);
+	server_destroy(server);
+	close(ant);
+	close(worm);
+	free(text);
+	game_destroy(game);
+}
+
+void test2_server_poll()
+{
+	Game *game = NULL;
+	Server *server = NULL;
+	char *text = (char *)malloc(CLIENT_SIZE);
+	int ant, worm, i, answered = 0, n;
+
+	game_create_from_file(&game, "resources/anthill.dat");
+	server = server_create(game, gengine, -1, 0);
+	ant = client_connect(server, 0);
+	/* The worm never reads, and its buffers hold less than a view */
+	worm = client_connect(server, 1024);
+	client_read(ant, text);
+	for (i = 0; i < CLIENT_COMMANDS; i++)
+	{
+		client_send(server, ant, i % 2 == 0 ? "m s\n" : "m n\n");
+		n = client_read(ant, text);
+		answered += ends_with_prompt(text, n) == TRUE ? 1 : 0;
+	}
+	PRINT_TEST_RESULT(text != NULL && answered == CLIENT_COMMANDS && player_get_location(game_get_player_at(game, 0)) == 11 &&
+					  server_get_n_clients(server) == 2);
+	server_destroy(server);
+	close(ant);
+	close(worm);
+	free(text);
+	game_destroy(game);
+}
+
+void test1_server_get_game()
+{
+	Game *world = NULL, *first = NULL, *second = NULL;
+	Server *server = NULL;
+	char *text = (char *)malloc(CLIENT_SIZE);
+	int clients[2 * 2], late, i, n_other;
+	Bool welcomed = TRUE, worm_view, first_moved, second_still;
+
+	game_create_from_file(&world, "resources/anthill.dat");
+	server = server_create(world, gengine, -1, 2);
+	first = server_get_game(server, 0);
+	second = server_get_game(server, 1);
+	/* Two players in each session, then there is no room */
+	for (i = 0; i < 2 * 2; i++)
+	{
+		clients[i] = client_connect(server, 0);
+		if (ends_with_prompt(text, client_read(clients[i], text)) == FALSE)
+		{
+			welcomed = FALSE;
+		}
+	}
+	late = client_connect(server, 0);
+	client_read(late, text);
+	welcomed = welcomed == TRUE && strcmp(text, SERVER_FULL) == 0 ? TRUE : FALSE;
+
+	client_send(server, clients[0], "m s\n");
+	client_read(clients[0], text);
+	worm_view = ends_with_prompt(text, client_read(clients[1], text));
+	n_other = client_read(clients[2], text) + client_read(clients[3], text);
+	game_enter(first);
+	first_moved = player_get_location(game_get_player_at(first, 0)) == 121 ? TRUE : FALSE;
+	game_enter(second);
+	second_still = player_get_location(game_get_player_at(second, 0)) == 11 ? TRUE : FALSE;
+	PRINT_TEST_RESULT(welcomed == TRUE && first != NULL && second != NULL && first != world && game_get_world(second) == world &&
+					  server_get_game(server, 2) == NULL && server_get_n_clients(server) == 2 * 2 && first_moved == TRUE &&
+					  second_still == TRUE && worm_view == TRUE && n_other == 0 &&
+					  server_is_finished(server) == FALSE);
+	server_destroy(server);
+	for (i = 0; i < 2 * 2; i++)
+	{
+		close(clients[i]);
+	}
+	close(late);
+	free(text);
+	game_destroy(world);
+}
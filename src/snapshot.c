@@ -0,0 +1,651 @@
+/**
+ * @brief It implements the snapshots of the state of a game
+ *
+ * @file snapshot.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "snapshot.h"
+#include "inventory.h"
+#include "set.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Private implementation of the snapshot
+ *
+ * The ids in a space or an inventory are stored one set after another, the
+ * set of position i starts at first_*[i] and ends at first_*[i + 1].
+ */
+struct _Snapshot
+{
+	int n_spaces;					   /*!< Number of spaces of the game */
+	int n_objects;					   /*!< Number of objects of the game */
+	int n_characters;				   /*!< Number of characters of the game */
+	int n_links;					   /*!< Number of links of the game */
+	int n_players;					   /*!< Number of players of the game */
+	Bool *discovered;				   /*!< Whether each space is discovered */
+	int *first_occupant;			   /*!< Start of the characters of each space in occupants */
+	Character **occupants;			   /*!< Characters of every space, hostile ones first as the space keeps them */
+	Id *object_locations;			   /*!< Location of each object */
+	int *character_health;			   /*!< Health of each character */
+	Id *character_following;		   /*!< Player each character follows */
+	Bool *link_open;				   /*!< Whether each link is open */
+	Id player_location[MAX_PLAYERS];   /*!< Location of each player */
+	int player_health[MAX_PLAYERS];	   /*!< Health of each player */
+	int first_carried[MAX_PLAYERS + 1]; /*!< Start of the objects of each player in carried */
+	Id *carried;					   /*!< Objects of every inventory, in the order of their sets */
+	int max_spaces;					   /*!< Capacity of the arrays of the spaces */
+	int max_objects;				   /*!< Capacity of object_locations */
+	int max_characters;				   /*!< Capacity of the arrays of the characters */
+	int max_links;					   /*!< Capacity of link_open */
+	int max_occupants;				   /*!< Capacity of occupants */
+	int max_carried;				   /*!< Capacity of carried */
+	unsigned long hash;				   /*!< Hash of the state, see game_get_hash */
+};
+
+/**
+ * @brief Tag of the files of snapshots, the last byte is the version of the format
+ */
+static const char snapshot_magic[8] = "AHSNAP1";
+
+/**
+ * @brief Header of a file of a snapshot
+ *
+ * The arrays follow it in the order of the struct, with the characters of
+ * the spaces written as their ids.
+ */
+typedef struct
+{
+	char magic[8];			/*!< snapshot_magic */
+	long mark;				/*!< Mark given by the writer, such as the turns played */
+	unsigned long hash;		/*!< Hash of the state */
+	long n_spaces;			/*!< Number of spaces of the game */
+	long n_objects;			/*!< Number of objects of the game */
+	long n_characters;		/*!< Number of characters of the game */
+	long n_links;			/*!< Number of links of the game */
+	long n_players;			/*!< Number of players of the game */
+	long n_occupants;		/*!< Number of characters in the spaces */
+	long n_carried;			/*!< Number of objects in the inventories */
+} SnapshotHeader;
+
+/**
+ * @brief Makes room for n elements in an array of the snapshot
+ *
+ * @param array A pointer to the array, updated on success
+ * @param max A pointer to the capacity, updated on success
+ * @param n The number of elements it must hold
+ * @param size The size of an element
+ * @return OK if there is room, ERROR if there was not enough memory (the old array is still valid)
+ */
+static Status snapshot_grow(void **array, int *max, int n, size_t size)
+{
+	void *grown = NULL;
+
+	if (n <= *max && *array)
+	{
+		return OK;
+	}
+
+	if (!(grown = realloc(*array, (n > 0 ? n : 1) * size)))
+	{
+		return ERROR;
+	}
+
+	*array = grown;
+	*max = n;
+	return OK;
+}
+
+/**
+ * @brief Makes a set hold some ids in order, it is not touched if it already does
+ */
+static void snapshot_set_ids(Set *set, const Id *ids, int n)
+{
+	int i, count = set_get_count(set);
+
+	if (count == n)
+	{
+		for (i = 0; i < n && set_get_id_at(set, i) == ids[i]; i++)
+			;
+		if (i == n)
+		{
+			return;
+		}
+	}
+
+	for (i = count - 1; i >= 0; i--)
+	{
+		set_del(set, set_get_id_at(set, i));
+	}
+	for (i = 0; i < n; i++)
+	{
+		set_add(set, ids[i]);
+	}
+}
+
+/**
+ * @brief Makes a space hold some characters in order, hostile ones first, it is not touched if it already does
+ */
+static void snapshot_set_occupants(Space *space, Character **occupants, int n)
+{
+	int i, n_hostiles = space_get_n_occupants(space, FALSE), n_friends = space_get_n_occupants(space, TRUE);
+	Character *character = NULL;
+
+	if (n_hostiles + n_friends == n)
+	{
+		for (i = 0; i < n && occupants[i] == (i < n_hostiles ? space_get_occupant_at(space, FALSE, i) : space_get_occupant_at(space, TRUE, i - n_hostiles));
+			 i++)
+			;
+		if (i == n)
+		{
+			return;
+		}
+	}
+
+	while ((character = space_get_occupant_at(space, FALSE, 0)) != NULL || (character = space_get_occupant_at(space, TRUE, 0)) != NULL)
+	{
+		space_del_character(space, character);
+	}
+	for (i = 0; i < n; i++)
+	{
+		space_add_character(space, occupants[i]);
+	}
+}
+
+/**
+ * @brief Compares two characters by id, for qsort and bsearch
+ */
+static int snapshot_compare_characters(const void *a, const void *b)
+{
+	Id id_a = character_get_id(*(Character *const *)a), id_b = character_get_id(*(Character *const *)b);
+
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Finds a character by id in an array sorted by snapshot_compare_characters
+ *
+ * @return The character, NULL if there is none with that id
+ */
+static Character *snapshot_find_character(Character **sorted, int n, Id id)
+{
+	int low = 0, high = n - 1, middle;
+
+	while (low <= high)
+	{
+		middle = low + (high - low) / 2;
+		if (character_get_id(sorted[middle]) == id)
+		{
+			return sorted[middle];
+		}
+		if (character_get_id(sorted[middle]) < id)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	return NULL;
+}
+
+Snapshot *snapshot_create(Game *game)
+{
+	Snapshot *snapshot = NULL;
+
+	if (!game || game_get_regions(game) || !(snapshot = (Snapshot *)calloc(1, sizeof(Snapshot))))
+	{
+		return NULL;
+	}
+
+	if (snapshot_save(snapshot, game) == ERROR)
+	{
+		snapshot_destroy(snapshot);
+		return NULL;
+	}
+
+	return snapshot;
+}
+
+Snapshot *snapshot_copy(Snapshot *snapshot)
+{
+	Snapshot *copy = NULL;
+	int n_spaces, n_occupants, n_carried;
+
+	if (!snapshot || !(copy = (Snapshot *)malloc(sizeof(Snapshot))))
+	{
+		return NULL;
+	}
+
+	/* The arrays only take the positions in use */
+	*copy = *snapshot;
+	n_spaces = snapshot->n_spaces + 1;
+	n_occupants = snapshot->first_occupant[snapshot->n_spaces];
+	n_carried = snapshot->first_carried[snapshot->n_players];
+	copy->max_spaces = n_spaces;
+	copy->max_objects = snapshot->n_objects;
+	copy->max_characters = snapshot->n_characters;
+	copy->max_links = snapshot->n_links;
+	copy->max_occupants = n_occupants;
+	copy->max_carried = n_carried;
+	copy->discovered = (Bool *)malloc(n_spaces * sizeof(Bool));
+	copy->first_occupant = (int *)malloc(n_spaces * sizeof(int));
+	copy->occupants = (Character **)malloc((n_occupants > 0 ? n_occupants : 1) * sizeof(Character *));
+	copy->object_locations = (Id *)malloc((copy->max_objects > 0 ? copy->max_objects : 1) * sizeof(Id));
+	copy->character_health = (int *)malloc((copy->max_characters > 0 ? copy->max_characters : 1) * sizeof(int));
+	copy->character_following = (Id *)malloc((copy->max_characters > 0 ? copy->max_characters : 1) * sizeof(Id));
+	copy->link_open = (Bool *)malloc((copy->max_links > 0 ? copy->max_links : 1) * sizeof(Bool));
+	copy->carried = (Id *)malloc((n_carried > 0 ? n_carried : 1) * sizeof(Id));
+	if (!copy->discovered || !copy->first_occupant || !copy->occupants || !copy->object_locations || !copy->character_health ||
+		!copy->character_following || !copy->link_open || !copy->carried)
+	{
+		snapshot_destroy(copy);
+		return NULL;
+	}
+
+	memcpy(copy->discovered, snapshot->discovered, snapshot->n_spaces * sizeof(Bool));
+	memcpy(copy->first_occupant, snapshot->first_occupant, n_spaces * sizeof(int));
+	memcpy(copy->occupants, snapshot->occupants, n_occupants * sizeof(Character *));
+	memcpy(copy->object_locations, snapshot->object_locations, snapshot->n_objects * sizeof(Id));
+	memcpy(copy->character_health, snapshot->character_health, snapshot->n_characters * sizeof(int));
+	memcpy(copy->character_following, snapshot->character_following, snapshot->n_characters * sizeof(Id));
+	memcpy(copy->link_open, snapshot->link_open, snapshot->n_links * sizeof(Bool));
+	memcpy(copy->carried, snapshot->carried, n_carried * sizeof(Id));
+	return copy;
+}
+
+void snapshot_destroy(Snapshot *snapshot)
+{
+	if (!snapshot)
+	{
+		return;
+	}
+
+	free(snapshot->discovered);
+	free(snapshot->first_occupant);
+	free(snapshot->occupants);
+	free(snapshot->object_locations);
+	free(snapshot->character_health);
+	free(snapshot->character_following);
+	free(snapshot->link_open);
+	free(snapshot->carried);
+	free(snapshot);
+}
+
+Status snapshot_save(Snapshot *snapshot, Game *game)
+{
+	Space **spaces = NULL;
+	Object **objects = NULL;
+	Character **characters = NULL;
+	Link **links = NULL;
+	Player *player = NULL;
+	Set *set = NULL;
+	int n_spaces, n_objects, n_characters, n_links, n_players;
+	int i, j, n, total;
+
+	if (!snapshot || !game || game_get_regions(game))
+	{
+		return ERROR;
+	}
+
+	spaces = game_get_spaces(game);
+	objects = game_get_objects(game);
+	characters = game_get_character_array(game);
+	links = game_get_links(game);
+	n_spaces = *game_get_n_spaces(game);
+	n_objects = *game_get_n_objects(game);
+	n_characters = *game_get_n_characters(game);
+	n_links = *game_get_n_links(game);
+	n_players = game_get_n_players(game);
+	if (n_players < 0 || n_players > MAX_PLAYERS)
+	{
+		return ERROR;
+	}
+
+	/* The arrays of the spaces have one more position, the end of the occupants of the last space.
+	   A pair of arrays shares a capacity, only updated by the second one, so a failed save is retried whole */
+	n = snapshot->max_spaces;
+	if (snapshot_grow((void **)&snapshot->first_occupant, &n, n_spaces + 1, sizeof(int)) == ERROR ||
+		snapshot_grow((void **)&snapshot->discovered, &snapshot->max_spaces, n_spaces + 1, sizeof(Bool)) == ERROR ||
+		snapshot_grow((void **)&snapshot->object_locations, &snapshot->max_objects, n_objects, sizeof(Id)) == ERROR ||
+		snapshot_grow((void **)&snapshot->link_open, &snapshot->max_links, n_links, sizeof(Bool)) == ERROR)
+	{
+		return ERROR;
+	}
+	n = snapshot->max_characters;
+	if (snapshot_grow((void **)&snapshot->character_following, &n, n_characters, sizeof(Id)) == ERROR ||
+		snapshot_grow((void **)&snapshot->character_health, &snapshot->max_characters, n_characters, sizeof(int)) == ERROR)
+	{
+		return ERROR;
+	}
+
+	/* Characters of the spaces */
+	for (i = 0, total = 0; i < n_spaces; i++)
+	{
+		total += set_get_count(space_get_characters(spaces[i]));
+	}
+	if (snapshot_grow((void **)&snapshot->occupants, &snapshot->max_occupants, total, sizeof(Character *)) == ERROR)
+	{
+		return ERROR;
+	}
+	for (i = 0, total = 0; i < n_spaces; i++)
+	{
+		snapshot->discovered[i] = space_is_discovered(spaces[i]);
+		snapshot->first_occupant[i] = total;
+		n = space_get_n_occupants(spaces[i], FALSE);
+		for (j = 0; j < n; j++)
+		{
+			snapshot->occupants[total++] = space_get_occupant_at(spaces[i], FALSE, j);
+		}
+		n = space_get_n_occupants(spaces[i], TRUE);
+		for (j = 0; j < n; j++)
+		{
+			snapshot->occupants[total++] = space_get_occupant_at(spaces[i], TRUE, j);
+		}
+	}
+	snapshot->first_occupant[n_spaces] = total;
+
+	for (i = 0; i < n_objects; i++)
+	{
+		snapshot->object_locations[i] = object_get_location(objects[i]);
+	}
+
+	for (i = 0; i < n_characters; i++)
+	{
+		snapshot->character_health[i] = character_get_health(characters[i]);
+		snapshot->character_following[i] = character_get_following(characters[i]);
+	}
+
+	for (i = 0; i < n_links; i++)
+	{
+		snapshot->link_open[i] = link_get_open(links[i]);
+	}
+
+	/* Players and their inventories */
+	for (i = 0, total = 0; i < n_players; i++)
+	{
+		total += inventory_get_count(player_get_inventory(game_get_player_at(game, i)));
+	}
+	if (snapshot_grow((void **)&snapshot->carried, &snapshot->max_carried, total, sizeof(Id)) == ERROR)
+	{
+		return ERROR;
+	}
+	for (i = 0, total = 0; i < n_players; i++)
+	{
+		player = game_get_player_at(game, i);
+		snapshot->player_location[i] = player_get_location(player);
+		snapshot->player_health[i] = player_get_health(player);
+		snapshot->first_carried[i] = total;
+		set = inventory_get_objects(player_get_inventory(player));
+		n = set_get_count(set);
+		for (j = 0; j < n; j++)
+		{
+			snapshot->carried[total++] = set_get_id_at(set, j);
+		}
+	}
+	snapshot->first_carried[n_players] = total;
+
+	snapshot->n_spaces = n_spaces;
+	snapshot->n_objects = n_objects;
+	snapshot->n_characters = n_characters;
+	snapshot->n_links = n_links;
+	snapshot->n_players = n_players;
+	snapshot->hash = game_get_hash(game);
+	return OK;
+}
+
+Status snapshot_restore(Snapshot *snapshot, Game *game)
+{
+	Space **spaces = NULL;
+	Object **objects = NULL;
+	Character **characters = NULL;
+	Link **links = NULL;
+	Player *player = NULL;
+	int i;
+
+	if (!snapshot || !game || game_get_regions(game) || snapshot->n_spaces != *game_get_n_spaces(game) ||
+		snapshot->n_objects != *game_get_n_objects(game) || snapshot->n_characters != *game_get_n_characters(game) ||
+		snapshot->n_links != *game_get_n_links(game) || snapshot->n_players != game_get_n_players(game))
+	{
+		return ERROR;
+	}
+
+	spaces = game_get_spaces(game);
+	objects = game_get_objects(game);
+	characters = game_get_character_array(game);
+	links = game_get_links(game);
+
+	for (i = 0; i < snapshot->n_spaces; i++)
+	{
+		space_set_discovered(spaces[i], snapshot->discovered[i]);
+		snapshot_set_occupants(spaces[i], snapshot->occupants + snapshot->first_occupant[i],
+							   snapshot->first_occupant[i + 1] - snapshot->first_occupant[i]);
+	}
+
+	for (i = 0; i < snapshot->n_objects; i++)
+	{
+		*(object_get_location_pointer(objects[i])) = snapshot->object_locations[i];
+	}
+
+	for (i = 0; i < snapshot->n_characters; i++)
+	{
+		character_set_health(characters[i], snapshot->character_health[i]);
+		game_set_character_following(game, characters[i], snapshot->character_following[i]);
+	}
+
+	for (i = 0; i < snapshot->n_links; i++)
+	{
+		link_set_open(links[i], snapshot->link_open[i]);
+	}
+
+	for (i = 0; i < snapshot->n_players; i++)
+	{
+		player = game_get_player_at(game, i);
+		player_set_location(player, snapshot->player_location[i]);
+		player_set_health(player, snapshot->player_health[i]);
+		snapshot_set_ids(inventory_get_objects(player_get_inventory(player)), snapshot->carried + snapshot->first_carried[i],
+						 snapshot->first_carried[i + 1] - snapshot->first_carried[i]);
+	}
+
+	return game_set_hash(game, snapshot->hash);
+}
+
+Bool snapshot_equal(Snapshot *a, Snapshot *b)
+{
+	if (!a || !b || a->n_spaces != b->n_spaces || a->n_objects != b->n_objects || a->n_characters != b->n_characters ||
+		a->n_links != b->n_links || a->n_players != b->n_players || a->first_occupant[a->n_spaces] != b->first_occupant[b->n_spaces] ||
+		a->first_carried[a->n_players] != b->first_carried[b->n_players])
+	{
+		return FALSE;
+	}
+
+	if (memcmp(a->discovered, b->discovered, a->n_spaces * sizeof(Bool)) != 0 ||
+		memcmp(a->first_occupant, b->first_occupant, (a->n_spaces + 1) * sizeof(int)) != 0 ||
+		memcmp(a->occupants, b->occupants, a->first_occupant[a->n_spaces] * sizeof(Character *)) != 0 ||
+		memcmp(a->object_locations, b->object_locations, a->n_objects * sizeof(Id)) != 0 ||
+		memcmp(a->character_health, b->character_health, a->n_characters * sizeof(int)) != 0 ||
+		memcmp(a->character_following, b->character_following, a->n_characters * sizeof(Id)) != 0 ||
+		memcmp(a->link_open, b->link_open, a->n_links * sizeof(Bool)) != 0 ||
+		memcmp(a->player_location, b->player_location, a->n_players * sizeof(Id)) != 0 ||
+		memcmp(a->player_health, b->player_health, a->n_players * sizeof(int)) != 0 ||
+		memcmp(a->first_carried, b->first_carried, (a->n_players + 1) * sizeof(int)) != 0 ||
+		memcmp(a->carried, b->carried, a->first_carried[a->n_players] * sizeof(Id)) != 0)
+	{
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+Status snapshot_set_hash(Snapshot *snapshot, unsigned long hash)
+{
+	if (!snapshot)
+	{
+		return ERROR;
+	}
+
+	snapshot->hash = hash;
+	return OK;
+}
+
+long snapshot_get_size(Snapshot *snapshot)
+{
+	if (!snapshot)
+	{
+		return -1;
+	}
+
+	return (long)sizeof(Snapshot) + (long)snapshot->max_spaces * (sizeof(Bool) + sizeof(int)) +
+		   (long)snapshot->max_occupants * sizeof(Character *) + (long)snapshot->max_objects * sizeof(Id) +
+		   (long)snapshot->max_characters * (sizeof(int) + sizeof(Id)) + (long)snapshot->max_links * sizeof(Bool) +
+		   (long)snapshot->max_carried * sizeof(Id);
+}
+
+Status snapshot_write(Snapshot *snapshot, FILE *f, long mark)
+{
+	SnapshotHeader header;
+	Id id;
+	int i;
+
+	if (!snapshot || !f)
+	{
+		return ERROR;
+	}
+
+	memset(&header, 0, sizeof(SnapshotHeader));
+	memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+	header.mark = mark;
+	header.hash = snapshot->hash;
+	header.n_spaces = snapshot->n_spaces;
+	header.n_objects = snapshot->n_objects;
+	header.n_characters = snapshot->n_characters;
+	header.n_links = snapshot->n_links;
+	header.n_players = snapshot->n_players;
+	header.n_occupants = snapshot->first_occupant[snapshot->n_spaces];
+	header.n_carried = snapshot->first_carried[snapshot->n_players];
+	if (fwrite(&header, sizeof(SnapshotHeader), 1, f) != 1 ||
+		fwrite(snapshot->discovered, sizeof(Bool), snapshot->n_spaces, f) != (size_t)snapshot->n_spaces ||
+		fwrite(snapshot->first_occupant, sizeof(int), snapshot->n_spaces + 1, f) != (size_t)snapshot->n_spaces + 1)
+	{
+		return ERROR;
+	}
+	for (i = 0; i < header.n_occupants; i++)
+	{
+		id = character_get_id(snapshot->occupants[i]);
+		if (fwrite(&id, sizeof(Id), 1, f) != 1)
+		{
+			return ERROR;
+		}
+	}
+	if (fwrite(snapshot->object_locations, sizeof(Id), snapshot->n_objects, f) != (size_t)snapshot->n_objects ||
+		fwrite(snapshot->character_health, sizeof(int), snapshot->n_characters, f) != (size_t)snapshot->n_characters ||
+		fwrite(snapshot->character_following, sizeof(Id), snapshot->n_characters, f) != (size_t)snapshot->n_characters ||
+		fwrite(snapshot->link_open, sizeof(Bool), snapshot->n_links, f) != (size_t)snapshot->n_links ||
+		fwrite(snapshot->player_location, sizeof(Id), snapshot->n_players, f) != (size_t)snapshot->n_players ||
+		fwrite(snapshot->player_health, sizeof(int), snapshot->n_players, f) != (size_t)snapshot->n_players ||
+		fwrite(snapshot->first_carried, sizeof(int), snapshot->n_players + 1, f) != (size_t)snapshot->n_players + 1 ||
+		fwrite(snapshot->carried, sizeof(Id), header.n_carried, f) != (size_t)header.n_carried)
+	{
+		return ERROR;
+	}
+
+	return OK;
+}
+
+Snapshot *snapshot_read(FILE *f, Game *game, long *mark)
+{
+	Snapshot *snapshot = NULL;
+	SnapshotHeader header;
+	Character **sorted = NULL;
+	Id id;
+	int i, n_characters;
+	Status status = OK;
+
+	if (!f || !game || game_get_regions(game) || fread(&header, sizeof(SnapshotHeader), 1, f) != 1 ||
+		memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0 || header.n_spaces != *game_get_n_spaces(game) ||
+		header.n_objects != *game_get_n_objects(game) || header.n_characters != *game_get_n_characters(game) ||
+		header.n_links != *game_get_n_links(game) || header.n_players != game_get_n_players(game) || header.n_occupants < 0 ||
+		header.n_occupants > header.n_characters || header.n_carried < 0 || header.n_carried > header.n_objects)
+	{
+		return NULL;
+	}
+
+	/* Every array is allocated with the counts of the game, as snapshot_save would */
+	if (!(snapshot = snapshot_create(game)) || snapshot_grow((void **)&snapshot->occupants, &snapshot->max_occupants, header.n_occupants,
+															  sizeof(Character *)) == ERROR ||
+		snapshot_grow((void **)&snapshot->carried, &snapshot->max_carried, header.n_carried, sizeof(Id)) == ERROR)
+	{
+		snapshot_destroy(snapshot);
+		return NULL;
+	}
+
+	n_characters = *game_get_n_characters(game);
+	if (!(sorted = (Character **)malloc((n_characters > 0 ? n_characters : 1) * sizeof(Character *))))
+	{
+		snapshot_destroy(snapshot);
+		return NULL;
+	}
+	memcpy(sorted, game_get_character_array(game), n_characters * sizeof(Character *));
+	qsort(sorted, n_characters, sizeof(Character *), snapshot_compare_characters);
+
+	if (fread(snapshot->discovered, sizeof(Bool), header.n_spaces, f) != (size_t)header.n_spaces ||
+		fread(snapshot->first_occupant, sizeof(int), header.n_spaces + 1, f) != (size_t)header.n_spaces + 1 ||
+		snapshot->first_occupant[header.n_spaces] != header.n_occupants)
+	{
+		status = ERROR;
+	}
+	for (i = 0; status == OK && i < header.n_spaces; i++)
+	{
+		if (snapshot->first_occupant[i] < 0 || snapshot->first_occupant[i] > snapshot->first_occupant[i + 1])
+		{
+			status = ERROR;
+		}
+	}
+	for (i = 0; status == OK && i < header.n_occupants; i++)
+	{
+		if (fread(&id, sizeof(Id), 1, f) != 1 || !(snapshot->occupants[i] = snapshot_find_character(sorted, n_characters, id)))
+		{
+			status = ERROR;
+		}
+	}
+	if (status == OK &&
+		(fread(snapshot->object_locations, sizeof(Id), header.n_objects, f) != (size_t)header.n_objects ||
+		 fread(snapshot->character_health, sizeof(int), header.n_characters, f) != (size_t)header.n_characters ||
+		 fread(snapshot->character_following, sizeof(Id), header.n_characters, f) != (size_t)header.n_characters ||
+		 fread(snapshot->link_open, sizeof(Bool), header.n_links, f) != (size_t)header.n_links ||
+		 fread(snapshot->player_location, sizeof(Id), header.n_players, f) != (size_t)header.n_players ||
+		 fread(snapshot->player_health, sizeof(int), header.n_players, f) != (size_t)header.n_players ||
+		 fread(snapshot->first_carried, sizeof(int), header.n_players + 1, f) != (size_t)header.n_players + 1 ||
+		 snapshot->first_carried[0] != 0 || snapshot->first_carried[header.n_players] != header.n_carried ||
+		 fread(snapshot->carried, sizeof(Id), header.n_carried, f) != (size_t)header.n_carried))
+	{
+		status = ERROR;
+	}
+	for (i = 0; status == OK && i < header.n_players; i++)
+	{
+		if (snapshot->first_carried[i] > snapshot->first_carried[i + 1])
+		{
+			status = ERROR;
+		}
+	}
+	free(sorted);
+
+	if (status == ERROR)
+	{
+		snapshot_destroy(snapshot);
+		return NULL;
+	}
+
+	snapshot->hash = header.hash;
+	if (mark)
+	{
+		*mark = header.mark;
+	}
+	return snapshot;
+}
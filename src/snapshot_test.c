@@ -0,0 +1,474 @@
+/**
+ * @brief It tests the snapshots of the state of a game, the undo of commands and the sessions of a world
+ *
+ * @file snapshot_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot.h"
+#include "game_actions.h"
+#include "game_reader.h"
+#include "test.h"
+#include "test_game.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 16
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_snapshot_create();
+
+/**
+ * @brief Test that a snapshot sees the changes of the commands.
+ */
+void test1_snapshot_equal();
+
+/**
+ * @brief Test that moves, takes and recruits are restored.
+ */
+void test1_snapshot_restore();
+
+/**
+ * @brief Test that a game with other entities is not restored.
+ */
+void test2_snapshot_restore();
+
+/**
+ * @brief Test that saving again reuses the memory of the snapshot.
+ */
+void test1_snapshot_save();
+
+/**
+ * @brief Test that the undo command puts back the state before the last command.
+ */
+void test1_game_undo();
+
+/**
+ * @brief Test that commands that failed or change nothing are not saved.
+ */
+void test2_game_undo();
+
+/**
+ * @brief Test that only the last GAME_UNDO_DEPTH states are kept.
+ */
+void test3_game_undo();
+
+/**
+ * @brief Test that undoing with nothing saved fails.
+ */
+void test4_game_undo();
+
+/**
+ * @brief Test that a copy holds the same state and does not change with the original.
+ */
+void test1_snapshot_copy();
+
+/**
+ * @brief Test that invalid sessions are rejected and a new one starts as the world was loaded.
+ */
+void test1_game_session();
+
+/**
+ * @brief Test that sessions of a world played in turns keep their own state.
+ */
+void test2_game_session();
+
+/**
+ * @brief Test that the world is left as it was loaded when its sessions are destroyed.
+ */
+void test3_game_session();
+
+/**
+ * @brief Test that a party moves with its player and restoring puts the characters back in their parties.
+ */
+void test3_snapshot_restore();
+
+/**
+ * @brief Test that a snapshot read from a file restores the state it was written with.
+ */
+void test1_snapshot_write();
+
+/**
+ * @brief Test that files that are not snapshots of the game are not read.
+ */
+void test1_snapshot_read();
+
+/**
+ * @brief Main function for snapshot unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Snapshot:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_snapshot_create();
+	if (all || test == 2)
+		test1_snapshot_equal();
+	if (all || test == 3)
+		test1_snapshot_restore();
+	if (all || test == 4)
+		test2_snapshot_restore();
+	if (all || test == 5)
+		test1_snapshot_save();
+	if (all || test == 6)
+		test1_game_undo();
+	if (all || test == 7)
+		test2_game_undo();
+	if (all || test == 8)
+		test3_game_undo();
+	if (all || test == 9)
+		test4_game_undo();
+	if (all || test == 10)
+		test1_snapshot_copy();
+	if (all || test == 11)
+		test1_game_session();
+	if (all || test == 12)
+		test2_game_session();
+	if (all || test == 13)
+		test3_game_session();
+	if (all || test == 14)
+		test3_snapshot_restore();
+	if (all || test == 15)
+		test1_snapshot_write();
+	if (all || test == 16)
+		test1_snapshot_read();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+void test1_snapshot_create()
+{
+	Game *game = test_game_create();
+	Snapshot *snapshot = snapshot_create(game);
+
+	PRINT_TEST_RESULT(snapshot && snapshot_create(NULL) == NULL && snapshot_save(NULL, game) == ERROR && snapshot_save(snapshot, NULL) == ERROR &&
+					  snapshot_restore(NULL, game) == ERROR && snapshot_restore(snapshot, NULL) == ERROR && snapshot_equal(snapshot, NULL) == FALSE &&
+					  snapshot_get_size(NULL) == -1 && snapshot_set_hash(NULL, 0) == ERROR && game_save_undo(NULL) == ERROR && game_undo(NULL) == ERROR && game_get_n_undo(NULL) == -1);
+	snapshot_destroy(snapshot);
+	game_destroy(game);
+}
+
+void test1_snapshot_equal()
+{
+	Game *game = test_game_create();
+	Snapshot *before = snapshot_create(game), *again = snapshot_create(game), *after = NULL;
+
+	test_game_play(game, 0, "m s");
+	after = snapshot_create(game);
+	PRINT_TEST_RESULT(snapshot_equal(before, again) == TRUE && snapshot_equal(before, after) == FALSE);
+	snapshot_destroy(before);
+	snapshot_destroy(again);
+	snapshot_destroy(after);
+	game_destroy(game);
+}
+
+void test1_snapshot_restore()
+{
+	Game *game = test_game_create();
+	Snapshot *before = snapshot_create(game), *after = NULL;
+	Player *player = NULL;
+
+	test_game_play(game, 0, "t Grain");
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "r Ant");
+	player = game_get_player_at(game, 0);
+	if (player_has_object(player, 21) == FALSE || player_get_location(player) != 122 ||
+		character_get_following(game_get_character_array(game)[1]) != player_get_id(player))
+	{
+		PRINT_TEST_RESULT(FALSE);
+	}
+	else
+	{
+		snapshot_restore(before, game);
+		after = snapshot_create(game);
+		PRINT_TEST_RESULT(snapshot_equal(before, after) == TRUE && player_has_object(player, 21) == FALSE && player_get_location(player) == 11 &&
+						  game_get_object_location(game, 0) == 11 && character_get_following(game_get_character_array(game)[1]) == NO_ID &&
+						  space_is_discovered(game_get_space(game, 121)) == FALSE);
+	}
+	snapshot_destroy(before);
+	snapshot_destroy(after);
+	game_destroy(game);
+}
+
+void test2_snapshot_restore()
+{
+	Game *game = test_game_create(), *other = NULL;
+	Snapshot *snapshot = snapshot_create(game);
+
+	game_create(&other);
+	PRINT_TEST_RESULT(snapshot_restore(snapshot, other) == ERROR && snapshot_restore(snapshot, game) == OK);
+	snapshot_destroy(snapshot);
+	game_destroy(other);
+	game_destroy(game);
+}
+
+void test1_snapshot_save()
+{
+	Game *game = test_game_create();
+	Snapshot *snapshot = snapshot_create(game);
+	long size = snapshot_get_size(snapshot);
+
+	test_game_play(game, 0, "m s");
+	PRINT_TEST_RESULT(size > 0 && snapshot_save(snapshot, game) == OK && snapshot_get_size(snapshot) == size);
+	snapshot_destroy(snapshot);
+	game_destroy(game);
+}
+
+void test1_game_undo()
+{
+	Game *game = test_game_create();
+	Player *player = NULL;
+
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "t Grain");
+	player = game_get_player_at(game, 0);
+	PRINT_TEST_RESULT(game_get_n_undo(game) == 1 && test_game_play(game, 0, "u") == OK && player_get_location(player) == 11 && game_get_n_undo(game) == 0 &&
+					  test_game_play(game, 0, "t Grain") == OK && test_game_play(game, 0, "undo") == OK && player_has_object(player, 21) == FALSE &&
+					  game_get_object_location(game, 0) == 11);
+	game_destroy(game);
+}
+
+void test2_game_undo()
+{
+	Game *game = test_game_create();
+
+	test_game_play(game, 0, "t Nothing");
+	test_game_play(game, 0, "i Grain");
+	test_game_play(game, 0, "st");
+	PRINT_TEST_RESULT(game_get_n_undo(game) == 0 && test_game_play(game, 0, "m s") == OK && game_get_n_undo(game) == 1);
+	game_destroy(game);
+}
+
+void test3_game_undo()
+{
+	Game *game = test_game_create();
+	int i, undone = 0;
+
+	for (i = 0; i < GAME_UNDO_DEPTH + 9; i++)
+	{
+		test_game_play(game, 0, i % 2 ? "m n" : "m s");
+	}
+	while (test_game_play(game, 0, "u") == OK)
+	{
+		undone++;
+	}
+	PRINT_TEST_RESULT(undone == GAME_UNDO_DEPTH && player_get_location(game_get_player_at(game, 0)) == 121);
+	game_destroy(game);
+}
+
+void test4_game_undo()
+{
+	Game *game = test_game_create();
+
+	PRINT_TEST_RESULT(test_game_play(game, 0, "u") == ERROR && game_undo(game) == ERROR && game_get_n_undo(game) == 0);
+	game_destroy(game);
+}
+
+void test1_snapshot_copy()
+{
+	Game *game = test_game_create();
+	Snapshot *snapshot = snapshot_create(game), *copy = snapshot_copy(snapshot), *before = snapshot_create(game);
+
+	test_game_play(game, 0, "t Grain");
+	test_game_play(game, 0, "m s");
+	snapshot_save(snapshot, game);
+	PRINT_TEST_RESULT(snapshot_copy(NULL) == NULL && snapshot_equal(copy, before) == TRUE && snapshot_equal(copy, snapshot) == FALSE &&
+					  snapshot_restore(copy, game) == OK && player_get_location(game_get_player_at(game, 0)) == 11 &&
+					  game_get_object_location(game, 0) == 11 && snapshot_get_size(copy) <= snapshot_get_size(snapshot));
+	snapshot_destroy(snapshot);
+	snapshot_destroy(copy);
+	snapshot_destroy(before);
+	game_destroy(game);
+}
+
+void test1_game_session()
+{
+	Game *world = test_game_create(), *session = NULL, *nested = NULL;
+
+	PRINT_TEST_RESULT(game_create_session(NULL, world) == ERROR && game_create_session(&nested, NULL) == ERROR && game_enter(NULL) == ERROR &&
+					  game_create_session(&session, world) == OK && game_create_session(&nested, session) == ERROR && nested == NULL &&
+					  game_get_world(session) == world && game_get_world(world) == NULL && game_enter(world) == OK && game_enter(session) == OK &&
+					  game_get_n_players(session) == 2 && player_get_location(game_get_player_at(session, 0)) == 11 &&
+					  game_get_hash(session) == game_compute_hash(session) && game_get_n_undo(session) == 0);
+	game_destroy(session);
+	game_destroy(world);
+}
+
+void test2_game_session()
+{
+	Game *world = test_game_create(), *first = NULL, *second = NULL;
+	Player *player = NULL;
+	Bool second_fresh;
+
+	game_create_session(&first, world);
+	game_create_session(&second, world);
+	player = game_get_player_at(world, 0);
+
+	game_enter(first);
+	test_game_play(first, 0, "t Grain");
+	test_game_play(first, 0, "m s");
+	game_enter(second);
+	second_fresh = player_get_location(player) == 11 && player_has_object(player, 21) == FALSE && game_get_object_location(second, 0) == 11
+					   ? TRUE
+					   : FALSE;
+	test_game_play(second, 0, "m s");
+	test_game_play(second, 0, "m s");
+	game_enter(first);
+	PRINT_TEST_RESULT(second_fresh == TRUE && player_get_location(player) == 121 && player_has_object(player, 21) == TRUE &&
+					  game_get_hash(first) == game_compute_hash(first) && game_get_n_undo(first) == 2 && test_game_play(first, 0, "u") == OK &&
+					  player_get_location(player) == 11 && game_enter(second) == OK && player_get_location(player) == 122 &&
+					  player_has_object(player, 21) == FALSE && game_get_hash(second) == game_compute_hash(second) && game_get_n_undo(second) == 2);
+	game_destroy(first);
+	game_destroy(second);
+	game_destroy(world);
+}
+
+void test3_game_session()
+{
+	Game *world = test_game_create(), *session = NULL;
+	Snapshot *before = snapshot_create(world), *after = NULL;
+	unsigned long hash = game_get_hash(world);
+
+	game_create_session(&session, world);
+	game_enter(session);
+	test_game_play(session, 0, "t Grain");
+	test_game_play(session, 0, "m s");
+	game_destroy(session);
+	after = snapshot_create(world);
+	PRINT_TEST_RESULT(snapshot_equal(before, after) == TRUE && game_get_hash(world) == hash);
+	snapshot_destroy(before);
+	snapshot_destroy(after);
+	game_destroy(world);
+}
+
+void test3_snapshot_restore()
+{
+	Game *game = test_game_create();
+	Snapshot *before = NULL;
+	Player *player = game_get_player_at(game, 0);
+	Character *ant = game_get_character_array(game)[1];
+	Id to;
+	Bool moved;
+
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "m s");
+	before = snapshot_create(game);
+	test_game_play(game, 0, "r Ant");
+	test_game_play(game, 0, "m e");
+	to = player_get_location(player);
+	moved = to != 122 && game_find_character(game, character_get_id(ant)) == to && player_get_followers(player) == ant ? TRUE : FALSE;
+	snapshot_restore(before, game);
+	PRINT_TEST_RESULT(moved == TRUE && player_get_followers(player) == NULL && game_find_character(game, character_get_id(ant)) == 122 &&
+					  test_game_play(game, 0, "r Ant") == OK && player_get_followers(player) == ant && test_game_play(game, 0, "ab Ant") == OK &&
+					  player_get_followers(player) == NULL && game_get_hash(game) == game_compute_hash(game));
+	snapshot_destroy(before);
+	game_destroy(game);
+}
+
+void test1_snapshot_write()
+{
+	Game *game = test_game_create();
+	Snapshot *before = NULL, *read = NULL, *after = NULL;
+	FILE *f = tmpfile();
+	unsigned long hash;
+	long mark = 0;
+
+	test_game_play(game, 0, "t Grain");
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "r Ant");
+	before = snapshot_create(game);
+	hash = game_get_hash(game);
+	if (!f || snapshot_write(before, f, 4) == ERROR)
+	{
+		PRINT_TEST_RESULT(FALSE);
+	}
+	else
+	{
+		test_game_play(game, 0, "ab Ant");
+		test_game_play(game, 0, "m n");
+		test_game_play(game, 0, "d Grain");
+		rewind(f);
+		read = snapshot_read(f, game, &mark);
+		snapshot_restore(read, game);
+		after = snapshot_create(game);
+		PRINT_TEST_RESULT(read && mark == 4 && snapshot_equal(before, read) == TRUE && snapshot_equal(before, after) == TRUE &&
+						  game_get_hash(game) == hash && game_compute_hash(game) == hash && player_get_location(game_get_player_at(game, 0)) == 122 &&
+						  character_get_following(game_get_character_array(game)[1]) == player_get_id(game_get_player_at(game, 0)));
+	}
+	if (f)
+	{
+		fclose(f);
+	}
+	snapshot_destroy(before);
+	snapshot_destroy(read);
+	snapshot_destroy(after);
+	game_destroy(game);
+}
+
+void test1_snapshot_read()
+{
+	Game *game = test_game_create(), *other = NULL;
+	Snapshot *snapshot = snapshot_create(game);
+	FILE *f = tmpfile(), *junk = tmpfile();
+
+	game_create(&other);
+	snapshot_write(snapshot, f, 0);
+	if (junk)
+	{
+		fputs("#s:11|Entrance|", junk);
+		rewind(junk);
+	}
+	if (f)
+	{
+		rewind(f);
+	}
+	PRINT_TEST_RESULT(f && junk && snapshot_write(NULL, f, 0) == ERROR && snapshot_read(NULL, game, NULL) == NULL &&
+					  snapshot_read(junk, game, NULL) == NULL && snapshot_read(f, other, NULL) == NULL);
+	if (f)
+	{
+		fclose(f);
+	}
+	if (junk)
+	{
+		fclose(junk);
+	}
+	snapshot_destroy(snapshot);
+	game_destroy(other);
+	game_destroy(game);
+}
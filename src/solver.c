@@ -0,0 +1,521 @@
+/**
+ * @brief It implements the solvability checker of a world
+ *
+ * @file solver.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "solver.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "command.h"
+#include "game_actions.h"
+#include "snapshot.h"
+#include "transposition.h"
+
+/**
+ * @brief Number of directions tried from each state
+ */
+#define SOLVER_DIRS 4
+
+/**
+ * @brief Separator of the commands of a path
+ */
+#define SOLVER_SEPARATOR ", "
+
+/**
+ * @brief Commands that move the player, in the order of Direction
+ */
+static const char *solver_moves[SOLVER_DIRS] = {"m n", "m s", "m e", "m w"};
+
+/**
+ * @brief A goal and the shortest way found to it
+ */
+typedef struct
+{
+	SolverGoalKind kind; /*!< Kind of goal */
+	Id subject;			 /*!< Player or object of the goal */
+	int player;			 /*!< Position of the player that reaches it, -1 if none */
+	int length;			 /*!< Number of commands, -1 if it was not reached */
+	char *path;			 /*!< Commands of the way, NULL if it was not reached */
+} SolverGoal;
+
+/**
+ * @brief Private implementation of the solver
+ *
+ * The states of a search are kept in arrays in the order they are found,
+ * which is the queue of the breadth first search.
+ */
+struct _Solver
+{
+	Game *game;				   /*!< Game searched */
+	Id goal;				   /*!< Space the players have to reach */
+	long max_states;		   /*!< States explored for each player before giving up */
+	SolverGoal *goals;		   /*!< Goals, the players and then the objects */
+	int n_goals;			   /*!< Number of goals */
+	Id *location;			   /*!< Space of the player in each state */
+	long *parent;			   /*!< State each state was reached from, -1 for the first one */
+	char *step;				   /*!< Direction of the move that reached each state */
+	int *depth;				   /*!< Number of moves to each state */
+	long n_nodes;			   /*!< Number of states of the current search */
+	long capacity;			   /*!< Size of the arrays of states */
+	Transpositions *seen;	   /*!< Hash of each state found, to its position */
+	Transpositions *spaces;	   /*!< Id of each space reached, to its first state */
+	long n_states;			   /*!< States explored by the searches of every player */
+	Bool truncated;			   /*!< Whether a search stopped at the limit */
+};
+
+Solver *solver_create(Game *game, Id goal, long max_states)
+{
+	Solver *solver = NULL;
+	int i, n_players, n_objects;
+
+	if (!game || goal == NO_ID || max_states < 1 || !(solver = (Solver *)calloc(1, sizeof(Solver))))
+	{
+		return NULL;
+	}
+
+	solver->game = game;
+	solver->goal = goal;
+	solver->max_states = max_states;
+	n_players = game_get_n_players(game);
+	n_objects = *game_get_n_objects(game);
+	solver->n_goals = n_players + n_objects;
+	if (!(solver->goals = (SolverGoal *)calloc(solver->n_goals + 1, sizeof(SolverGoal))) || !(solver->seen = transposition_create(64)) ||
+		!(solver->spaces = transposition_create(64)))
+	{
+		solver_destroy(solver);
+		return NULL;
+	}
+
+	for (i = 0; i < solver->n_goals; i++)
+	{
+		solver->goals[i].kind = i < n_players ? SOLVER_GOAL_REACH : SOLVER_GOAL_TAKE;
+		solver->goals[i].subject = i < n_players ? player_get_id(game_get_player_at(game, i)) : object_get_id(game_get_objects(game)[i - n_players]);
+		solver->goals[i].player = -1;
+		solver->goals[i].length = -1;
+	}
+
+	return solver;
+}
+
+void solver_destroy(Solver *solver)
+{
+	int i;
+
+	if (!solver)
+	{
+		return;
+	}
+
+	if (solver->goals)
+	{
+		for (i = 0; i < solver->n_goals; i++)
+		{
+			free(solver->goals[i].path);
+		}
+	}
+	free(solver->goals);
+	free(solver->location);
+	free(solver->parent);
+	free(solver->step);
+	free(solver->depth);
+	transposition_destroy(solver->seen);
+	transposition_destroy(solver->spaces);
+	free(solver);
+}
+
+/**
+ * @brief Makes room for one more state
+ *
+ * @return OK if there is room, ERROR if there was not enough memory
+ */
+static Status solver_reserve(Solver *solver)
+{
+	long capacity;
+	void *p = NULL;
+
+	if (solver->n_nodes < solver->capacity)
+	{
+		return OK;
+	}
+
+	/* Each array keeps its new size as soon as it has it, the capacity is only raised when all of them do */
+	capacity = solver->capacity ? solver->capacity * 2 : 64;
+	if (!(p = realloc(solver->location, capacity * sizeof(Id))))
+	{
+		return ERROR;
+	}
+	solver->location = (Id *)p;
+	if (!(p = realloc(solver->parent, capacity * sizeof(long))))
+	{
+		return ERROR;
+	}
+	solver->parent = (long *)p;
+	if (!(p = realloc(solver->step, capacity * sizeof(char))))
+	{
+		return ERROR;
+	}
+	solver->step = (char *)p;
+	if (!(p = realloc(solver->depth, capacity * sizeof(int))))
+	{
+		return ERROR;
+	}
+	solver->depth = (int *)p;
+	solver->capacity = capacity;
+
+	return OK;
+}
+
+/**
+ * @brief Adds a state found from another one
+ *
+ * @param parent The state it was reached from, -1 for the first one
+ * @param step The direction of the move that reached it
+ * @param location The space of the player
+ * @param hash The hash of the state
+ * @return OK if it was added, ERROR otherwise
+ */
+static Status solver_add(Solver *solver, long parent, int step, Id location, unsigned long hash)
+{
+	if (solver_reserve(solver) == ERROR || transposition_store(solver->seen, hash, solver->n_nodes) == ERROR)
+	{
+		return ERROR;
+	}
+
+	solver->location[solver->n_nodes] = location;
+	solver->parent[solver->n_nodes] = parent;
+	solver->step[solver->n_nodes] = (char)step;
+	solver->depth[solver->n_nodes] = parent < 0 ? 0 : solver->depth[parent] + 1;
+	if (transposition_lookup(solver->spaces, (unsigned long)location, NULL) == FALSE &&
+		transposition_store(solver->spaces, (unsigned long)location, solver->n_nodes) == ERROR)
+	{
+		return ERROR;
+	}
+	solver->n_nodes++;
+
+	return OK;
+}
+
+/**
+ * @brief Runs a command in the shadow where the search is done
+ */
+static Status solver_play(Game *shadow, const char *line)
+{
+	char input[WORD_SIZE];
+
+	strcpy(input, line);
+	command_parse_input(game_get_last_command(shadow), input);
+
+	return game_actions_update(shadow, game_get_last_command(shadow));
+}
+
+/**
+ * @brief Records the way to a goal if it is shorter than the one it had
+ *
+ * @param node The state the goal is reached from
+ * @param last The command run in that state to reach it, NULL if it is reached just by being there
+ * @param player The position of the player that reaches it
+ * @return OK if it was recorded or was not shorter, ERROR if there was not enough memory
+ */
+static Status solver_reach(Solver *solver, SolverGoal *goal, long node, const char *last, int player)
+{
+	int length = solver->depth[node] + (last ? 1 : 0);
+	long size, i;
+	char *path = NULL;
+
+	if (goal->length >= 0 && goal->length <= length)
+	{
+		return OK;
+	}
+
+	/* Every command is "m x" or the last one, plus the separators */
+	size = (long)solver->depth[node] * (strlen(solver_moves[0]) + strlen(SOLVER_SEPARATOR)) + (last ? strlen(last) : 0) + 1;
+	if (!(path = (char *)malloc(size)))
+	{
+		return ERROR;
+	}
+
+	/* The moves are found from the last one, and written from the end of the path */
+	path[size - 1] = '\0';
+	i = size - 1;
+	if (last)
+	{
+		i -= strlen(last);
+		memcpy(path + i, last, strlen(last));
+	}
+	for (; solver->parent[node] >= 0; node = solver->parent[node])
+	{
+		if (i < size - 1)
+		{
+			i -= strlen(SOLVER_SEPARATOR);
+			memcpy(path + i, SOLVER_SEPARATOR, strlen(SOLVER_SEPARATOR));
+		}
+		i -= strlen(solver_moves[(int)solver->step[node]]);
+		memcpy(path + i, solver_moves[(int)solver->step[node]], strlen(solver_moves[(int)solver->step[node]]));
+	}
+	memmove(path, path + i, size - i);
+
+	free(goal->path);
+	goal->path = path;
+	goal->length = length;
+	goal->player = player;
+
+	return OK;
+}
+
+/**
+ * @brief Leaves in the shadow only the state that changes what a player can do
+ *
+ * Moves discover spaces and take followers along, which would make two
+ * visits to a space look like different states.
+ */
+static void solver_prepare(Game *shadow, Id player_id)
+{
+	Character **characters = game_get_character_array(shadow);
+	int i;
+
+	for (i = 0; i < *game_get_n_spaces(shadow); i++)
+	{
+		game_set_space_discovered(shadow, space_get_id(game_get_spaces(shadow)[i]), TRUE);
+	}
+	for (i = 0; i < *game_get_n_characters(shadow); i++)
+	{
+		if (character_get_following(characters[i]) == player_id)
+		{
+			game_set_character_following(shadow, characters[i], NO_ID);
+		}
+	}
+}
+
+/**
+ * @brief Searches the states of one player and records the goals it reaches
+ *
+ * @param shadow A shadow of the game where the player acts
+ * @param player The position of the player
+ * @return OK if the search was done, ERROR if there was not enough memory
+ */
+static Status solver_search(Solver *solver, Game *shadow, int player)
+{
+	Object **objects = game_get_objects(shadow);
+	Player *p = game_get_player_at(shadow, player);
+	int n_players = game_get_n_players(shadow), dir, i;
+	long node, found;
+	char take[WORD_SIZE];
+
+	solver->n_nodes = 0;
+	transposition_clear(solver->seen);
+	transposition_clear(solver->spaces);
+	solver_prepare(shadow, player_get_id(p));
+	if (solver_add(solver, -1, 0, game_get_player_location(shadow), game_get_hash(shadow)) == ERROR)
+	{
+		return ERROR;
+	}
+
+	for (node = 0; node < solver->n_nodes; node++)
+	{
+		for (dir = 0; dir < SOLVER_DIRS; dir++)
+		{
+			if (game_get_player_location(shadow) != solver->location[node])
+			{
+				game_set_player_location(shadow, solver->location[node]);
+			}
+			solver_play(shadow, solver_moves[dir]);
+			if (transposition_lookup(solver->seen, game_get_hash(shadow), NULL) == TRUE)
+			{
+				continue;
+			}
+			if (solver->n_nodes >= solver->max_states)
+			{
+				solver->truncated = TRUE;
+				break;
+			}
+			if (solver_add(solver, node, dir, game_get_player_location(shadow), game_get_hash(shadow)) == ERROR)
+			{
+				return ERROR;
+			}
+		}
+	}
+	solver->n_states += solver->n_nodes;
+
+	if (transposition_lookup(solver->spaces, (unsigned long)solver->goal, &found) == TRUE &&
+		solver_reach(solver, &solver->goals[player], found, NULL, player) == ERROR)
+	{
+		return ERROR;
+	}
+
+	/* Each object is taken in the first state where the player stands on it, and put back, carried ones need nothing */
+	for (i = 0; i < *game_get_n_objects(shadow); i++)
+	{
+		if (player_has_object(p, object_get_id(objects[i])) == TRUE)
+		{
+			if (solver_reach(solver, &solver->goals[n_players + i], 0, NULL, player) == ERROR)
+			{
+				return ERROR;
+			}
+			continue;
+		}
+		if (transposition_lookup(solver->spaces, (unsigned long)game_get_object_location(shadow, i), &found) == FALSE ||
+			(solver->goals[n_players + i].length >= 0 && solver->goals[n_players + i].length <= solver->depth[found] + 1))
+		{
+			continue;
+		}
+
+		game_set_player_location(shadow, solver->location[found]);
+		strcpy(take, "t ");
+		strncat(take, object_get_name(objects[i]), WORD_SIZE - strlen(take) - 1);
+		if (solver_play(shadow, take) == OK && player_has_object(p, object_get_id(objects[i])) == TRUE)
+		{
+			game_del_player_object(shadow, player, object_get_id(objects[i]));
+			game_set_object_location(shadow, solver->location[found], i);
+			if (solver_reach(solver, &solver->goals[n_players + i], found, take, player) == ERROR)
+			{
+				return ERROR;
+			}
+		}
+	}
+
+	return OK;
+}
+
+Status solver_run(Solver *solver)
+{
+	Snapshot *before = NULL;
+	Game *shadow = NULL;
+	Status status = OK;
+	int i;
+
+	if (!solver || !(before = snapshot_create(solver->game)))
+	{
+		return ERROR;
+	}
+
+	solver->n_states = 0;
+	solver->truncated = FALSE;
+	for (i = 0; i < game_get_n_players(solver->game) && status == OK; i++)
+	{
+		/* Commands run in a shadow do not save states to undo */
+		if (!(shadow = game_create_shadow(solver->game, i)))
+		{
+			status = ERROR;
+			break;
+		}
+		status = solver_search(solver, shadow, i);
+		game_merge_shadow(solver->game, shadow);
+	}
+
+	if (snapshot_restore(before, solver->game) == ERROR)
+	{
+		status = ERROR;
+	}
+	snapshot_destroy(before);
+
+	return status;
+}
+
+int solver_get_n_goals(Solver *solver)
+{
+	return solver ? solver->n_goals : -1;
+}
+
+SolverGoalKind solver_get_goal_kind(Solver *solver, int position)
+{
+	if (!solver || position < 0 || position >= solver->n_goals)
+	{
+		return SOLVER_GOAL_REACH;
+	}
+
+	return solver->goals[position].kind;
+}
+
+Id solver_get_goal_subject(Solver *solver, int position)
+{
+	if (!solver || position < 0 || position >= solver->n_goals)
+	{
+		return NO_ID;
+	}
+
+	return solver->goals[position].subject;
+}
+
+int solver_get_goal_length(Solver *solver, int position)
+{
+	if (!solver || position < 0 || position >= solver->n_goals)
+	{
+		return -1;
+	}
+
+	return solver->goals[position].length;
+}
+
+const char *solver_get_goal_path(Solver *solver, int position)
+{
+	if (!solver || position < 0 || position >= solver->n_goals)
+	{
+		return NULL;
+	}
+
+	return solver->goals[position].path;
+}
+
+int solver_get_goal_player(Solver *solver, int position)
+{
+	if (!solver || position < 0 || position >= solver->n_goals)
+	{
+		return -1;
+	}
+
+	return solver->goals[position].player;
+}
+
+long solver_get_n_states(Solver *solver)
+{
+	return solver ? solver->n_states : -1;
+}
+
+Bool solver_get_truncated(Solver *solver)
+{
+	return solver ? solver->truncated : FALSE;
+}
+
+int solver_print(FILE *pf, Solver *solver)
+{
+	SolverGoal *goal = NULL;
+	int i, missing = 0;
+
+	if (!pf || !solver)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < solver->n_goals; i++)
+	{
+		goal = &solver->goals[i];
+		if (goal->kind == SOLVER_GOAL_REACH)
+		{
+			fprintf(pf, "player %ld reaches space %ld: ", goal->subject, solver->goal);
+		}
+		else
+		{
+			fprintf(pf, "object %ld is taken: ", goal->subject);
+		}
+
+		if (goal->length < 0)
+		{
+			fprintf(pf, "%s\n", solver->truncated == TRUE ? "not found within the limit of states" : "unreachable");
+			missing++;
+		}
+		else
+		{
+			fprintf(pf, "%d commands by player %ld (%s)\n", goal->length, player_get_id(game_get_player_at(solver->game, goal->player)),
+					goal->length ? goal->path : "already there");
+		}
+	}
+	fprintf(pf, "%d of %d goals reached, %ld states explored\n", solver->n_goals - missing, solver->n_goals, solver->n_states);
+
+	return missing;
+}
@@ -0,0 +1,223 @@
+/**
+ * @brief It tests the solvability checker of a world
+ *
+ * @file solver_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "solver.h"
+#include "snapshot.h"
+#include "test.h"
+#include "test_game.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 7
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_solver_create();
+
+/**
+ * @brief Test that there is a goal for each player and each object.
+ */
+void test2_solver_create();
+
+/**
+ * @brief Test the shortest ways of the players to the Pantry.
+ */
+void test1_solver_run();
+
+/**
+ * @brief Test that each object is taken by the player closest to it.
+ */
+void test2_solver_run();
+
+/**
+ * @brief Test that the game is left as it was.
+ */
+void test3_solver_run();
+
+/**
+ * @brief Test that closing a door leaves the Pantry unreachable.
+ */
+void test4_solver_run();
+
+/**
+ * @brief Test that the search stops at the limit of states.
+ */
+void test5_solver_run();
+
+/**
+ * @brief Main function for solver unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Solver:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_solver_create();
+	if (all || test == 2)
+		test2_solver_create();
+	if (all || test == 3)
+		test1_solver_run();
+	if (all || test == 4)
+		test2_solver_run();
+	if (all || test == 5)
+		test3_solver_run();
+	if (all || test == 6)
+		test4_solver_run();
+	if (all || test == 7)
+		test5_solver_run();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It gets the position of the goal of an object
+ */
+static int object_goal(Solver *solver, Id id)
+{
+	int i;
+
+	for (i = 0; i < solver_get_n_goals(solver); i++)
+	{
+		if (solver_get_goal_kind(solver, i) == SOLVER_GOAL_TAKE && solver_get_goal_subject(solver, i) == id)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void test1_solver_create()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 0);
+
+	PRINT_TEST_RESULT(solver == NULL && solver_create(NULL, SOLVER_GOAL_SPACE, 10) == NULL && solver_create(game, NO_ID, 10) == NULL &&
+					  solver_run(NULL) == ERROR && solver_get_n_goals(NULL) == -1 && solver_get_goal_length(NULL, 0) == -1 &&
+					  solver_get_goal_path(NULL, 0) == NULL && solver_get_n_states(NULL) == -1 && solver_print(stdout, NULL) == -1);
+	game_destroy(game);
+}
+
+void test2_solver_create()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 100);
+
+	PRINT_TEST_RESULT(solver_get_n_goals(solver) == 6 && solver_get_goal_kind(solver, 1) == SOLVER_GOAL_REACH && solver_get_goal_subject(solver, 1) == 2 &&
+					  solver_get_goal_kind(solver, 2) == SOLVER_GOAL_TAKE && solver_get_goal_subject(solver, 2) == 21 &&
+					  solver_get_goal_length(solver, 6) == -1 && solver_get_goal_player(solver, 0) == -1);
+	solver_destroy(solver);
+	game_destroy(game);
+}
+
+void test1_solver_run()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 100);
+
+	/* Space 124 is only behind a closed door, the way goes round by the east corridors */
+	PRINT_TEST_RESULT(solver_run(solver) == OK && solver_get_goal_length(solver, 0) == 6 &&
+					  strcmp(solver_get_goal_path(solver, 0), "m s, m s, m e, m e, m e, m s") == 0 && solver_get_goal_player(solver, 0) == 0 &&
+					  solver_get_goal_length(solver, 1) == 4 && strcmp(solver_get_goal_path(solver, 1), "m e, m e, m e, m s") == 0 &&
+					  solver_get_truncated(solver) == FALSE);
+	solver_destroy(solver);
+	game_destroy(game);
+}
+
+void test2_solver_run()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 100);
+	int grain, nut;
+
+	solver_run(solver);
+	grain = object_goal(solver, 21);
+	nut = object_goal(solver, 24);
+	PRINT_TEST_RESULT(strcmp(solver_get_goal_path(solver, grain), "t Grain") == 0 && solver_get_goal_player(solver, grain) == 0 &&
+					  strcmp(solver_get_goal_path(solver, nut), "m s, t Nut") == 0 && solver_get_goal_player(solver, nut) == 1 &&
+					  solver_get_goal_length(solver, object_goal(solver, 23)) == 1);
+	solver_destroy(solver);
+	game_destroy(game);
+}
+
+void test3_solver_run()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 100);
+	Snapshot *before = snapshot_create(game), *after = NULL;
+	unsigned long hash = game_get_hash(game);
+
+	solver_run(solver);
+	after = snapshot_create(game);
+	PRINT_TEST_RESULT(snapshot_equal(before, after) == TRUE && game_get_hash(game) == hash && game_get_n_undo(game) == 0 &&
+					  space_is_discovered(game_get_space(game, 13)) == FALSE && player_has_object(game_get_player_at(game, 0), 21) == FALSE);
+	snapshot_destroy(before);
+	snapshot_destroy(after);
+	solver_destroy(solver);
+	game_destroy(game);
+}
+
+void test4_solver_run()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 100);
+	FILE *pf = tmpfile();
+
+	game_set_link_open(game, 127, S, FALSE);
+	PRINT_TEST_RESULT(solver_run(solver) == OK && solver_get_goal_length(solver, 0) == -1 && solver_get_goal_path(solver, 1) == NULL &&
+					  solver_get_goal_length(solver, object_goal(solver, 22)) == 1 && solver_print(pf, solver) == 2);
+	if (pf)
+	{
+		fclose(pf);
+	}
+	solver_destroy(solver);
+	game_destroy(game);
+}
+
+void test5_solver_run()
+{
+	Game *game = test_game_create();
+	Solver *solver = solver_create(game, SOLVER_GOAL_SPACE, 3);
+
+	PRINT_TEST_RESULT(solver_run(solver) == OK && solver_get_truncated(solver) == TRUE && solver_get_goal_length(solver, 0) == -1 &&
+					  solver_get_n_states(solver) == 6);
+	solver_destroy(solver);
+	game_destroy(game);
+}
@@ -10,25 +10,57 @@
 
 #include "space.h"
 #include "objects.h"
+#include "pool.h"
 #include "set.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief Number of spaces in each block of the pool
+ */
+#define SPACE_BLOCK 1024
+
+/**
+ * @brief What is only read to paint, describe or act in a space
+ *
+ * The occupants are the characters of the set of the space, hostile ones
+ * first, so attacks and chats only look at the side they need.
+ */
+typedef struct
+{
+	char name[WORD_SIZE + 1];				/*!< Name of the space */
+	char gdesc[GDESC_ROWS][GDESC_COLS + 1]; /*!< Graphical description of the space */
+	Set *object_locations;					/*!< Set of objects in the space, created the first time it is asked for */
+	Character **occupants;					/*!< Characters in the space, created when the first one arrives */
+	int n_occupants;						/*!< Number of occupants */
+	int n_hostiles;							/*!< Number of occupants that are not friendly, the first ones */
+	int max_occupants;						/*!< Capacity of occupants */
+} SpaceDetail;
+
 /**
  * @brief Private implementation of space datatype
+ *
+ * Only what moves and paint read for every space is kept here, a few dozen
+ * bytes, and the name and the graphic description are in its detail.
  */
 struct _Space
 {
-	Id id;								/*!< Id number of the space, it must be unique */
-	char name[WORD_SIZE + 1];			/*!< Name of the space */
-	Set *characters;					/*!< Set of the characters in that space*/
-	Set *object_locations;				/*!< Set of objects in the space */
-	char gdesc[GDESC_ROWS][GDESC_COLS]; /*!< Graphical description of the space */
-	Bool discovered;					/*!< Wether the space is discovered or not*/
+	Id id;				 /*!< Id number of the space, it must be unique */
+	Bool discovered;	 /*!< Wether the space is discovered or not*/
+	Set *characters;	 /*!< Set of the characters in that space*/
+	SpaceDetail *detail; /*!< Name and graphic description of the space */
 };
 
+/**
+ * @brief Pool the spaces are taken from
+ *
+ * The spaces of a world are created one after another, so they end up next
+ * to each other in its blocks and walking them reads contiguous memory.
+ */
+static Pool space_pool = POOL_INITIALIZER(struct _Space, SPACE_BLOCK);
+
 Space *space_create(Id id)
 {
 	Space *newSpace = NULL;
@@ -37,29 +69,36 @@ Space *space_create(Id id)
 	if (id == NO_ID)
 		return NULL;
 
-	newSpace = (Space *)malloc(sizeof(Space));
+	newSpace = (Space *)pool_alloc(&space_pool);
 	if (newSpace == NULL)
 	{
 		return NULL;
 	}
 
 	newSpace->id = id;
-	newSpace->name[0] = '\0';
-	newSpace->characters = set_create();
 	newSpace->discovered = FALSE;
-
-	newSpace->object_locations = set_create();
-	if (newSpace->object_locations == NULL)
+	newSpace->characters = set_create();
+	newSpace->detail = (SpaceDetail *)malloc(sizeof(SpaceDetail));
+	if (newSpace->characters == NULL || newSpace->detail == NULL)
 	{
-		free(newSpace);
+		set_destroy(newSpace->characters);
+		free(newSpace->detail);
+		pool_release(&space_pool, newSpace);
 		return NULL;
 	}
 
+	newSpace->detail->name[0] = '\0';
+	newSpace->detail->object_locations = NULL;
+	newSpace->detail->occupants = NULL;
+	newSpace->detail->n_occupants = 0;
+	newSpace->detail->n_hostiles = 0;
+	newSpace->detail->max_occupants = 0;
+
 	/* Initialize graphical description */
 	for (i = 0; i < GDESC_ROWS; i++)
 	{
-		memset(newSpace->gdesc[i], ' ', GDESC_COLS);
-		newSpace->gdesc[i][GDESC_COLS] = '\0';
+		memset(newSpace->detail->gdesc[i], ' ', GDESC_COLS);
+		newSpace->detail->gdesc[i][GDESC_COLS] = '\0';
 	}
 
 	return newSpace;
@@ -72,9 +111,9 @@ Status space_destroy(Space *space)
 		return ERROR;
 	}
 
-	if (space->object_locations != NULL)
+	if (space->detail->object_locations != NULL)
 	{
-		set_destroy(space->object_locations);
+		set_destroy(space->detail->object_locations);
 	}
 
 	if (space->characters != NULL)
@@ -82,7 +121,9 @@ Status space_destroy(Space *space)
 		set_destroy(space->characters);
 	}
 
-	free(space);
+	free(space->detail->occupants);
+	free(space->detail);
+	pool_release(&space_pool, space);
 	space = NULL;
 	return OK;
 }
@@ -103,7 +144,7 @@ Status space_set_name(Space *space, char *name)
 		return ERROR;
 	}
 
-	if (!strcpy(space->name, name))
+	if (!strcpy(space->detail->name, name))
 	{
 		return ERROR;
 	}
@@ -116,7 +157,7 @@ const char *space_get_name(Space *space)
 	{
 		return NULL;
 	}
-	return space->name;
+	return space->detail->name;
 }
 
 Status space_set_object(Space *space, Bool value)
@@ -126,7 +167,7 @@ Status space_set_object(Space *space, Bool value)
 		return ERROR;
 	}
 
-	if (set_get_count(space->object_locations) > 0)
+	if (set_get_count(space->detail->object_locations) > 0)
 	{
 		value = TRUE;
 	}
@@ -147,10 +188,10 @@ Bool space_get_object(Space *space, Id id)
 		return FALSE;
 	}
 
-	n_ids = set_get_count(space->object_locations);
+	n_ids = set_get_count(space->detail->object_locations);
 	for (i = 0; i < n_ids; i++)
 	{
-		if (set_get_id_at(space->object_locations, i) == id)
+		if (set_get_id_at(space->detail->object_locations, i) == id)
 		{
 			return TRUE;
 		}
@@ -167,15 +208,15 @@ Status space_print(Space *space)
 		return ERROR;
 	}
 
-	fprintf(stdout, "--> Space (Id: %ld; Name: %s)\n", space->id, space->name);
+	fprintf(stdout, "--> Space (Id: %ld; Name: %s)\n", space->id, space->detail->name);
 
-	n_ids = set_get_count(space->object_locations);
+	n_ids = set_get_count(space->detail->object_locations);
 	if (n_ids > 0)
 	{
 		fprintf(stdout, "---> Objects in the space:\n");
 		for (i = 0; i < n_ids; i++)
 		{
-			fprintf(stdout, "------> Object Id: %ld\n", set_get_id_at(space->object_locations, i));
+			fprintf(stdout, "------> Object Id: %ld\n", set_get_id_at(space->detail->object_locations, i));
 		}
 	}
 	else
@@ -186,7 +227,7 @@ Status space_print(Space *space)
 	fprintf(stdout, "---> Graphical description:\n");
 	for (i = 0; i < GDESC_ROWS; i++)
 	{
-		fprintf(stdout, "     %s\n", space->gdesc[i]);
+		fprintf(stdout, "     %s\n", space->detail->gdesc[i]);
 	}
 
 	return OK;
@@ -202,7 +243,7 @@ Status space_set_gdesc(Space *space, char gdesc[GDESC_ROWS][GDESC_COLS + 1])
 
 	for (i = 0; i < GDESC_ROWS; i++)
 	{
-		strcpy(space->gdesc[i], gdesc[i]);
+		strcpy(space->detail->gdesc[i], gdesc[i]);
 	}
 
 	return OK;
@@ -214,7 +255,7 @@ const char **space_get_gdesc(Space *space)
 	{
 		return NULL;
 	}
-	return (const char **)space->gdesc;
+	return (const char **)space->detail->gdesc;
 }
 Set *space_get_object_locations(Space *space)
 {
@@ -222,7 +263,11 @@ Set *space_get_object_locations(Space *space)
 	{
 		return NULL;
 	}
-	return space->object_locations;
+	if (!space->detail->object_locations)
+	{
+		space->detail->object_locations = set_create();
+	}
+	return space->detail->object_locations;
 }
 
 const char *space_get_gdesc_at(Space *space, int position)
@@ -232,7 +277,7 @@ const char *space_get_gdesc_at(Space *space, int position)
 		return NULL;
 	}
 
-	return space->gdesc[position];
+	return space->detail->gdesc[position];
 }
 
 Status space_set_gdesc_at(Space *space, char *gdesc_new, int position)
@@ -242,7 +287,7 @@ Status space_set_gdesc_at(Space *space, char *gdesc_new, int position)
 		return ERROR;
 	}
 
-	strcpy(space->gdesc[position], gdesc_new);
+	strcpy(space->detail->gdesc[position], gdesc_new);
 	return OK;
 }
 
@@ -267,6 +312,65 @@ Status space_set_discovered(Space *space, Bool discovered)
 	return OK;
 }
 
+/**
+ * @brief Puts a character among the occupants, on the side of its disposition
+ *
+ * @return OK if it was added, ERROR if there was not enough memory
+ */
+static Status space_add_occupant(SpaceDetail *detail, Character *character)
+{
+	Character **occupants = NULL;
+	int max;
+
+	if (detail->n_occupants == detail->max_occupants)
+	{
+		max = detail->max_occupants ? detail->max_occupants * 2 : 4;
+		if (!(occupants = (Character **)realloc(detail->occupants, max * sizeof(Character *))))
+		{
+			return ERROR;
+		}
+		detail->occupants = occupants;
+		detail->max_occupants = max;
+	}
+
+	/* A hostile one takes the place of the first friendly one, which goes to the end */
+	if (character_get_friendly(character) == FALSE && detail->n_hostiles < detail->n_occupants)
+	{
+		detail->occupants[detail->n_occupants++] = detail->occupants[detail->n_hostiles];
+		detail->occupants[detail->n_hostiles++] = character;
+	}
+	else
+	{
+		detail->n_hostiles += character_get_friendly(character) == FALSE ? 1 : 0;
+		detail->occupants[detail->n_occupants++] = character;
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Takes a character out of the occupants
+ */
+static void space_del_occupant(SpaceDetail *detail, Character *character)
+{
+	int i;
+
+	for (i = 0; i < detail->n_occupants && detail->occupants[i] != character; i++)
+		;
+	if (i == detail->n_occupants)
+	{
+		return;
+	}
+
+	/* The last hostile one fills the gap, and the last occupant fills its place */
+	if (i < detail->n_hostiles)
+	{
+		detail->occupants[i] = detail->occupants[--detail->n_hostiles];
+		i = detail->n_hostiles;
+	}
+	detail->occupants[i] = detail->occupants[--detail->n_occupants];
+}
+
 Status space_add_character(Space *space, Character *character)
 {
 	Id char_id = NO_ID;
@@ -277,7 +381,11 @@ Status space_add_character(Space *space, Character *character)
 	}
 
 	char_id = character_get_id(character);
-	set_add(space->characters, char_id);
+	if (set_add(space->characters, char_id) == OK && space_add_occupant(space->detail, character) == ERROR)
+	{
+		set_del(space->characters, char_id);
+		return ERROR;
+	}
 
 	return OK;
 }
@@ -292,11 +400,45 @@ Status space_del_character(Space *space, Character *character)
 	}
 
 	char_id = character_get_id(character);
-	set_del(space->characters, char_id);
+	if (set_del(space->characters, char_id) == OK)
+	{
+		space_del_occupant(space->detail, character);
+	}
 
 	return OK;
 }
 
+int space_get_n_occupants(Space *space, Bool friendly)
+{
+	if (!space)
+	{
+		return -1;
+	}
+
+	return friendly == TRUE ? space->detail->n_occupants - space->detail->n_hostiles : space->detail->n_hostiles;
+}
+
+Character *space_get_occupant_at(Space *space, Bool friendly, int position)
+{
+	if (!space || position < 0 || position >= space_get_n_occupants(space, friendly))
+	{
+		return NULL;
+	}
+
+	return space->detail->occupants[friendly == TRUE ? space->detail->n_hostiles + position : position];
+}
+
+Status space_update_occupant(Space *space, Character *character)
+{
+	if (!space || !character || space_has_character(space, character_get_id(character)) == FALSE)
+	{
+		return ERROR;
+	}
+
+	space_del_occupant(space->detail, character);
+	return space_add_occupant(space->detail, character);
+}
+
 Set *space_get_characters(Space *space)
 {
 	if (!space)
@@ -305,4 +447,25 @@ Set *space_get_characters(Space *space)
 	}
 
 	return space->characters;
-}
\ No newline at end of file
+}
+
+Bool space_has_character(Space *space, Id id)
+{
+	int i, n;
+
+	if (!space || id == NO_ID)
+	{
+		return FALSE;
+	}
+
+	n = set_get_count(space->characters);
+	for (i = 0; i < n; i++)
+	{
+		if (set_get_id_at(space->characters, i) == id)
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
@@ -93,6 +93,14 @@ int main(int argc, char **argv)
 		test1_space_add_character();
 	if (all || test == 20)
 		test2_space_add_character();
+	if (all || test == 21)
+		test1_space_get_n_occupants();
+	if (all || test == 22)
+		test1_space_get_occupant_at();
+	if (all || test == 23)
+		test1_space_update_occupant();
+	if (all || test == 24)
+		test1_space_has_character();
 
 	PRINT_PASSED_PERCENTAGE;
 
@@ -272,4 +280,93 @@ void test2_space_add_character()
 	s = space_create(1);
 	PRINT_TEST_RESULT(space_del_character(s, c) == ERROR);
 	space_destroy(s);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief It creates a character with a disposition
+ */
+static Character *occupant_create(Id id, Bool friendly)
+{
+	Character *c = character_create(id);
+
+	character_set_friendly(c, friendly);
+	return c;
+}
+
+void test1_space_get_n_occupants()
+{
+	Space *s = space_create(1);
+	Character *c[4];
+	int i;
+
+	c[0] = occupant_create(2, TRUE);
+	c[1] = occupant_create(3, FALSE);
+	c[2] = occupant_create(4, TRUE);
+	c[3] = occupant_create(5, FALSE);
+	for (i = 0; i < 4; i++)
+	{
+		space_add_character(s, c[i]);
+	}
+	PRINT_TEST_RESULT(space_get_n_occupants(s, TRUE) == 2 && space_get_n_occupants(s, FALSE) == 2 && space_get_occupant_at(s, FALSE, 0) == c[1] &&
+					  space_get_occupant_at(s, FALSE, 1) == c[3] && character_get_friendly(space_get_occupant_at(s, TRUE, 0)) == TRUE &&
+					  character_get_friendly(space_get_occupant_at(s, TRUE, 1)) == TRUE && space_get_occupant_at(s, TRUE, 2) == NULL &&
+					  space_get_n_occupants(NULL, TRUE) == -1 && set_get_count(space_get_characters(s)) == 4);
+	space_destroy(s);
+	for (i = 0; i < 4; i++)
+	{
+		character_destroy(c[i]);
+	}
+}
+
+void test1_space_get_occupant_at()
+{
+	Space *s = space_create(1);
+	Character *c[4];
+	int i;
+
+	c[0] = occupant_create(2, FALSE);
+	c[1] = occupant_create(3, TRUE);
+	c[2] = occupant_create(4, FALSE);
+	c[3] = occupant_create(5, TRUE);
+	for (i = 0; i < 4; i++)
+	{
+		space_add_character(s, c[i]);
+	}
+	space_del_character(s, c[0]);
+	space_del_character(s, c[3]);
+	space_del_character(s, c[3]);
+	PRINT_TEST_RESULT(space_get_n_occupants(s, FALSE) == 1 && space_get_occupant_at(s, FALSE, 0) == c[2] && space_get_n_occupants(s, TRUE) == 1 &&
+					  space_get_occupant_at(s, TRUE, 0) == c[1] && set_get_count(space_get_characters(s)) == 2);
+	space_destroy(s);
+	for (i = 0; i < 4; i++)
+	{
+		character_destroy(c[i]);
+	}
+}
+
+void test1_space_update_occupant()
+{
+	Space *s = space_create(1);
+	Character *c = occupant_create(2, TRUE), *other = occupant_create(3, TRUE);
+
+	space_add_character(s, c);
+	space_add_character(s, other);
+	character_set_friendly(c, FALSE);
+	PRINT_TEST_RESULT(space_update_occupant(s, c) == OK && space_get_n_occupants(s, FALSE) == 1 && space_get_occupant_at(s, FALSE, 0) == c &&
+					  space_get_n_occupants(s, TRUE) == 1 && space_get_occupant_at(s, TRUE, 0) == other &&
+					  space_update_occupant(s, NULL) == ERROR);
+	space_destroy(s);
+	character_destroy(c);
+	character_destroy(other);
+}
+
+void test1_space_has_character()
+{
+	Space *s = space_create(1);
+	Character *c = character_create(2);
+
+	space_add_character(s, c);
+	PRINT_TEST_RESULT(space_has_character(s, 2) == TRUE && space_has_character(s, 3) == FALSE && space_has_character(NULL, 2) == FALSE);
+	space_destroy(s);
+	character_destroy(c);
+}
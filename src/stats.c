@@ -0,0 +1,294 @@
+/**
+ * @brief It implements the runtime statistics module
+ *
+ * @file stats.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "stats.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Measures of one slot
+ */
+typedef struct
+{
+	unsigned long count;				   /*!< Number of measures */
+	unsigned long total;				   /*!< Sum of every measure */
+	unsigned long min;					   /*!< Smallest measure */
+	unsigned long max;					   /*!< Biggest measure */
+	unsigned long buckets[STATS_BUCKETS]; /*!< Latency histogram */
+} StatsHistogram;
+
+/**
+ * @brief Histograms of every slot
+ */
+static StatsHistogram stats_slots[STATS_N_SLOTS];
+
+/**
+ * @brief Protects the histograms, commands of a turn can be measured from several threads
+ */
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Names of the slots that are not commands
+ */
+static const char *stats_names[STATS_N_SLOTS - N_CMD] = {"paint", "input", "load_parse", "load_merge", "npc_tick", "autosave", "reload"};
+
+/**
+ * @brief Gets the bucket of a value
+ *
+ * Values under 4 have their own bucket, the rest are split in 4 buckets per power of two.
+ *
+ * @param v The value
+ * @return The bucket index
+ */
+static int stats_bucket_of(unsigned long v)
+{
+	int msb = 0;
+
+	if (v < 4)
+	{
+		return (int)v;
+	}
+
+	while ((v >> msb) > 1)
+	{
+		msb++;
+	}
+
+	return 4 * (msb - 1) + (int)((v >> (msb - 2)) & 3);
+}
+
+/**
+ * @brief Gets the middle value of a bucket
+ *
+ * @param bucket The bucket index
+ * @return The value in the middle of the bucket range
+ */
+static unsigned long stats_bucket_value(int bucket)
+{
+	int msb;
+	unsigned long low;
+
+	if (bucket < 4)
+	{
+		return (unsigned long)bucket;
+	}
+
+	msb = bucket / 4 + 1;
+	low = (unsigned long)(4 + bucket % 4) << (msb - 2);
+
+	return low + ((1UL << (msb - 2)) >> 1);
+}
+
+Bool stats_enabled()
+{
+#ifdef USE_STATS
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
+
+unsigned long stats_now()
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+	{
+		return 0;
+	}
+
+	return (unsigned long)ts.tv_sec * 1000000000UL + (unsigned long)ts.tv_nsec;
+}
+
+StatsSlot stats_slot_for_command(CommandCode cmd)
+{
+	if (cmd < NO_CMD || cmd - NO_CMD >= N_CMD)
+	{
+		return STATS_N_SLOTS;
+	}
+
+	return (StatsSlot)(STATS_SLOT_ACTIONS + cmd - NO_CMD);
+}
+
+void stats_record(StatsSlot slot, unsigned long ns)
+{
+	StatsHistogram *h = NULL;
+
+	if (slot < 0 || slot >= STATS_N_SLOTS)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&stats_lock);
+	h = &stats_slots[slot];
+	if (h->count == 0 || ns < h->min)
+	{
+		h->min = ns;
+	}
+	if (ns > h->max)
+	{
+		h->max = ns;
+	}
+	h->count++;
+	h->total += ns;
+	h->buckets[stats_bucket_of(ns)]++;
+	pthread_mutex_unlock(&stats_lock);
+}
+
+void stats_reset()
+{
+	memset(stats_slots, 0, sizeof(stats_slots));
+}
+
+unsigned long stats_get_count(StatsSlot slot)
+{
+	if (slot < 0 || slot >= STATS_N_SLOTS)
+	{
+		return 0;
+	}
+
+	return stats_slots[slot].count;
+}
+
+unsigned long stats_get_percentile(StatsSlot slot, int percentile)
+{
+	StatsHistogram *h = NULL;
+	unsigned long rank, seen = 0, value;
+	int i;
+
+	if (slot < 0 || slot >= STATS_N_SLOTS || percentile < 0 || percentile > 100)
+	{
+		return 0;
+	}
+
+	h = &stats_slots[slot];
+	if (h->count == 0)
+	{
+		return 0;
+	}
+
+	/* Rank of the wanted measure, counting from 1 */
+	rank = (h->count * (unsigned long)percentile + 99) / 100;
+	if (rank == 0)
+	{
+		rank = 1;
+	}
+
+	for (i = 0; i < STATS_BUCKETS; i++)
+	{
+		seen += h->buckets[i];
+		if (seen >= rank)
+		{
+			break;
+		}
+	}
+
+	value = stats_bucket_value(i);
+	if (value < h->min)
+	{
+		value = h->min;
+	}
+	if (value > h->max)
+	{
+		value = h->max;
+	}
+
+	return value;
+}
+
+const char *stats_slot_name(StatsSlot slot)
+{
+	extern char *cmd_to_str[N_CMD][N_CMDT];
+
+	if (slot < 0 || slot >= STATS_N_SLOTS)
+	{
+		return "?";
+	}
+
+	if (slot < N_CMD)
+	{
+		return cmd_to_str[slot - STATS_SLOT_ACTIONS][CMDL];
+	}
+
+	return stats_names[slot - N_CMD];
+}
+
+Status stats_summary(char *buffer, int size)
+{
+	char entry[128];
+	int i, used = 0, len;
+
+	if (!buffer || size <= 0)
+	{
+		return ERROR;
+	}
+
+	buffer[0] = '\0';
+
+	if (stats_enabled() == FALSE)
+	{
+		strncpy(buffer, "Statistics are disabled (build with make STATS=1)", size - 1);
+		buffer[size - 1] = '\0';
+		return OK;
+	}
+
+	for (i = 0; i < STATS_N_SLOTS; i++)
+	{
+		if (stats_slots[i].count == 0)
+		{
+			continue;
+		}
+
+		sprintf(entry, "%s%s n=%lu p50=%luus p99=%luus", used ? "; " : "", stats_slot_name((StatsSlot)i), stats_slots[i].count,
+				stats_get_percentile((StatsSlot)i, 50) / 1000, stats_get_percentile((StatsSlot)i, 99) / 1000);
+
+		len = (int)strlen(entry);
+		if (used + len >= size)
+		{
+			break;
+		}
+
+		strcpy(buffer + used, entry);
+		used += len;
+	}
+
+	if (used == 0)
+	{
+		strncpy(buffer, "No statistics recorded yet", size - 1);
+		buffer[size - 1] = '\0';
+	}
+
+	return OK;
+}
+
+void stats_print(FILE *f)
+{
+	int i;
+
+	if (!f || stats_enabled() == FALSE)
+	{
+		return;
+	}
+
+	fprintf(f, "%-16s %10s %12s %12s %12s %12s\n", "slot", "calls", "p50_ns", "p99_ns", "max_ns", "total_ns");
+	for (i = 0; i < STATS_N_SLOTS; i++)
+	{
+		if (stats_slots[i].count == 0)
+		{
+			continue;
+		}
+
+		fprintf(f, "%-16s %10lu %12lu %12lu %12lu %12lu\n", stats_slot_name((StatsSlot)i), stats_slots[i].count,
+				stats_get_percentile((StatsSlot)i, 50), stats_get_percentile((StatsSlot)i, 99), stats_slots[i].max, stats_slots[i].total);
+	}
+}
@@ -0,0 +1,199 @@
+/**
+ * @brief It tests stats module
+ *
+ * @file stats_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 10
+
+/**
+ * @brief Test that a new measure is counted.
+ */
+void test1_stats_record();
+
+/**
+ * @brief Test that measures on invalid slots are ignored.
+ */
+void test2_stats_record();
+
+/**
+ * @brief Test that reset clears every slot.
+ */
+void test1_stats_reset();
+
+/**
+ * @brief Test the median of a slot with known measures.
+ */
+void test1_stats_get_percentile();
+
+/**
+ * @brief Test that the p99 stays within the recorded maximum.
+ */
+void test2_stats_get_percentile();
+
+/**
+ * @brief Test that an empty slot has no percentile.
+ */
+void test3_stats_get_percentile();
+
+/**
+ * @brief Test the slot of a command code.
+ */
+void test1_stats_slot_for_command();
+
+/**
+ * @brief Test the slot of an invalid command code.
+ */
+void test2_stats_slot_for_command();
+
+/**
+ * @brief Test that the monotonic clock never goes back.
+ */
+void test1_stats_now();
+
+/**
+ * @brief Test the summary with a NULL buffer.
+ */
+void test1_stats_summary();
+
+/**
+ * @brief Main function for STATS unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Stats:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 || test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_stats_record();
+	if (all || test == 2)
+		test2_stats_record();
+	if (all || test == 3)
+		test1_stats_reset();
+	if (all || test == 4)
+		test1_stats_get_percentile();
+	if (all || test == 5)
+		test2_stats_get_percentile();
+	if (all || test == 6)
+		test3_stats_get_percentile();
+	if (all || test == 7)
+		test1_stats_slot_for_command();
+	if (all || test == 8)
+		test2_stats_slot_for_command();
+	if (all || test == 9)
+		test1_stats_now();
+	if (all || test == 10)
+		test1_stats_summary();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+void test1_stats_record()
+{
+	stats_reset();
+	stats_record(STATS_SLOT_PAINT, 1000);
+	stats_record(STATS_SLOT_PAINT, 2000);
+	PRINT_TEST_RESULT(stats_get_count(STATS_SLOT_PAINT) == 2);
+}
+
+void test2_stats_record()
+{
+	stats_reset();
+	stats_record(STATS_N_SLOTS, 1000);
+	PRINT_TEST_RESULT(stats_get_count(STATS_N_SLOTS) == 0);
+}
+
+void test1_stats_reset()
+{
+	stats_record(STATS_SLOT_INPUT, 10);
+	stats_reset();
+	PRINT_TEST_RESULT(stats_get_count(STATS_SLOT_INPUT) == 0);
+}
+
+void test1_stats_get_percentile()
+{
+	unsigned long p50;
+	int i;
+
+	stats_reset();
+	for (i = 0; i < 99; i++)
+	{
+		stats_record(STATS_SLOT_PAINT, 1000);
+	}
+	stats_record(STATS_SLOT_PAINT, 1000000);
+
+	/* Buckets are 25% wide, so the median must be close to the real one */
+	p50 = stats_get_percentile(STATS_SLOT_PAINT, 50);
+	PRINT_TEST_RESULT(p50 >= 750 && p50 <= 1250);
+}
+
+void test2_stats_get_percentile()
+{
+	stats_reset();
+	stats_record(STATS_SLOT_PAINT, 10);
+	stats_record(STATS_SLOT_PAINT, 5000);
+	PRINT_TEST_RESULT(stats_get_percentile(STATS_SLOT_PAINT, 99) <= 5000);
+}
+
+void test3_stats_get_percentile()
+{
+	stats_reset();
+	PRINT_TEST_RESULT(stats_get_percentile(STATS_SLOT_PAINT, 50) == 0);
+}
+
+void test1_stats_slot_for_command()
+{
+	PRINT_TEST_RESULT(stats_slot_for_command(MOVE) == STATS_SLOT_ACTIONS + MOVE - NO_CMD);
+}
+
+void test2_stats_slot_for_command()
+{
+	PRINT_TEST_RESULT(stats_slot_for_command((CommandCode)(NO_CMD + N_CMD)) == STATS_N_SLOTS);
+}
+
+void test1_stats_now()
+{
+	unsigned long t1 = stats_now();
+	unsigned long t2 = stats_now();
+	PRINT_TEST_RESULT(t1 > 0 && t2 >= t1);
+}
+
+void test1_stats_summary()
+{
+	PRINT_TEST_RESULT(stats_summary(NULL, 10) == ERROR);
+}
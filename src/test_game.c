@@ -0,0 +1,42 @@
+/**
+ * @brief It implements the game the unit tests play on
+ *
+ * @file test_game.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "test_game.h"
+
+#include <string.h>
+
+#include "game_actions.h"
+
+Game *test_game_create()
+{
+	Game *game = NULL;
+
+	if (game_create_from_file(&game, TEST_GAME_FILE) == ERROR)
+	{
+		return NULL;
+	}
+
+	return game;
+}
+
+Command *test_game_command(Game *game, int player, const char *input)
+{
+	char buffer[WORD_SIZE];
+
+	strncpy(buffer, input, WORD_SIZE - 1);
+	buffer[WORD_SIZE - 1] = '\0';
+	game_set_turn(game, player);
+	command_parse_input(game_get_last_command(game), buffer);
+	return game_get_last_command(game);
+}
+
+Status test_game_play(Game *game, int player, const char *input)
+{
+	return game_actions_update(game, test_game_command(game, player, input));
+}
@@ -0,0 +1,197 @@
+/**
+ * @brief It implements a transposition table keyed by the hash of a game state
+ *
+ * @file transposition.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "transposition.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief A position of the table
+ */
+typedef struct
+{
+	unsigned long hash; /*!< Hash of the state */
+	long value;			/*!< Value of the state */
+	Bool used;			/*!< Whether the position holds a state */
+} TranspositionEntry;
+
+/**
+ * @brief Private implementation of the table
+ *
+ * The number of positions is a power of two, so the low bits of a hash are
+ * its first position. Zobrist hashes are already mixed, they need no more.
+ */
+struct _Transpositions
+{
+	TranspositionEntry *entries; /*!< Positions of the table */
+	unsigned long mask;			 /*!< Number of positions minus one */
+	int n_entries;				 /*!< Number of states stored */
+};
+
+/**
+ * @brief Finds the position of a hash, or the empty one where it would go
+ */
+static TranspositionEntry *transposition_find(Transpositions *table, unsigned long hash)
+{
+	unsigned long i = hash & table->mask;
+
+	while (table->entries[i].used == TRUE && table->entries[i].hash != hash)
+	{
+		i = (i + 1) & table->mask;
+	}
+
+	return &table->entries[i];
+}
+
+/**
+ * @brief Doubles the positions of the table and stores every state again
+ *
+ * @return OK if it grew, ERROR if there was not enough memory (the table is not changed)
+ */
+static Status transposition_grow(Transpositions *table)
+{
+	TranspositionEntry *old = table->entries, *entry = NULL;
+	unsigned long i, n_old = table->mask + 1;
+
+	if (!(table->entries = (TranspositionEntry *)calloc(n_old * 2, sizeof(TranspositionEntry))))
+	{
+		table->entries = old;
+		return ERROR;
+	}
+
+	table->mask = n_old * 2 - 1;
+	for (i = 0; i < n_old; i++)
+	{
+		if (old[i].used == TRUE)
+		{
+			entry = transposition_find(table, old[i].hash);
+			*entry = old[i];
+		}
+	}
+
+	free(old);
+	return OK;
+}
+
+Transpositions *transposition_create(int capacity)
+{
+	Transpositions *table = NULL;
+	unsigned long n = 16;
+
+	if (capacity < 1 || !(table = (Transpositions *)malloc(sizeof(Transpositions))))
+	{
+		return NULL;
+	}
+
+	/* Room for capacity states below the load limit */
+	while (n / 4 * 3 < (unsigned long)capacity)
+	{
+		n *= 2;
+	}
+
+	if (!(table->entries = (TranspositionEntry *)calloc(n, sizeof(TranspositionEntry))))
+	{
+		free(table);
+		return NULL;
+	}
+
+	table->mask = n - 1;
+	table->n_entries = 0;
+	return table;
+}
+
+void transposition_destroy(Transpositions *table)
+{
+	if (!table)
+	{
+		return;
+	}
+
+	free(table->entries);
+	free(table);
+}
+
+Status transposition_store(Transpositions *table, unsigned long hash, long value)
+{
+	TranspositionEntry *entry = NULL;
+
+	if (!table)
+	{
+		return ERROR;
+	}
+
+	entry = transposition_find(table, hash);
+	if (entry->used == FALSE)
+	{
+		if ((unsigned long)table->n_entries + 1 > (table->mask + 1) / 4 * 3)
+		{
+			if (transposition_grow(table) == ERROR)
+			{
+				return ERROR;
+			}
+			entry = transposition_find(table, hash);
+		}
+		entry->used = TRUE;
+		entry->hash = hash;
+		table->n_entries++;
+	}
+
+	entry->value = value;
+	return OK;
+}
+
+Bool transposition_lookup(Transpositions *table, unsigned long hash, long *value)
+{
+	TranspositionEntry *entry = NULL;
+
+	if (!table)
+	{
+		return FALSE;
+	}
+
+	entry = transposition_find(table, hash);
+	if (entry->used == FALSE)
+	{
+		return FALSE;
+	}
+
+	if (value)
+	{
+		*value = entry->value;
+	}
+	return TRUE;
+}
+
+int transposition_get_count(Transpositions *table)
+{
+	if (!table)
+	{
+		return -1;
+	}
+
+	return table->n_entries;
+}
+
+Status transposition_clear(Transpositions *table)
+{
+	unsigned long i;
+
+	if (!table)
+	{
+		return ERROR;
+	}
+
+	for (i = 0; i <= table->mask; i++)
+	{
+		table->entries[i].used = FALSE;
+	}
+
+	table->n_entries = 0;
+	return OK;
+}
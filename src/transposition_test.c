@@ -0,0 +1,154 @@
+/**
+ * @brief It tests the transposition table
+ *
+ * @file transposition_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "transposition.h"
+#include "zobrist.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 5
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test1_transposition_create();
+
+/**
+ * @brief Test that stored values are found and replaced.
+ */
+void test1_transposition_store();
+
+/**
+ * @brief Test that the table grows and keeps every state.
+ */
+void test2_transposition_store();
+
+/**
+ * @brief Test that hashes with the same low bits are told apart.
+ */
+void test1_transposition_lookup();
+
+/**
+ * @brief Test that clearing removes every state.
+ */
+void test1_transposition_clear();
+
+/**
+ * @brief Main function for transposition unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Transposition:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_transposition_create();
+	if (all || test == 2)
+		test1_transposition_store();
+	if (all || test == 3)
+		test2_transposition_store();
+	if (all || test == 4)
+		test1_transposition_lookup();
+	if (all || test == 5)
+		test1_transposition_clear();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+void test1_transposition_create()
+{
+	long value = 0;
+
+	PRINT_TEST_RESULT(transposition_create(0) == NULL && transposition_store(NULL, 1, 1) == ERROR && transposition_lookup(NULL, 1, &value) == FALSE &&
+					  transposition_get_count(NULL) == -1 && transposition_clear(NULL) == ERROR);
+}
+
+void test1_transposition_store()
+{
+	Transpositions *table = transposition_create(8);
+	unsigned long hash = zobrist_key(ZOBRIST_PLAYER_AT, 1, 11);
+	long value = 0;
+
+	transposition_store(table, hash, 3);
+	transposition_store(table, 0, 7);
+	PRINT_TEST_RESULT(transposition_lookup(table, hash, &value) == TRUE && value == 3 && transposition_store(table, hash, 5) == OK &&
+					  transposition_lookup(table, hash, &value) == TRUE && value == 5 && transposition_lookup(table, 0, &value) == TRUE && value == 7 &&
+					  transposition_lookup(table, hash + 1, NULL) == FALSE && transposition_get_count(table) == 2);
+	transposition_destroy(table);
+}
+
+void test2_transposition_store()
+{
+	Transpositions *table = transposition_create(1);
+	Bool found = TRUE;
+	long i, value;
+
+	for (i = 0; i < 10000; i++)
+	{
+		transposition_store(table, zobrist_key(ZOBRIST_OBJECT_AT, i, 0), i);
+	}
+	for (i = 0; i < 10000 && found == TRUE; i++)
+	{
+		found = transposition_lookup(table, zobrist_key(ZOBRIST_OBJECT_AT, i, 0), &value) == TRUE && value == i ? TRUE : FALSE;
+	}
+	PRINT_TEST_RESULT(found == TRUE && transposition_get_count(table) == 10000);
+	transposition_destroy(table);
+}
+
+void test1_transposition_lookup()
+{
+	Transpositions *table = transposition_create(4);
+	long a = 0, b = 0, c = 0;
+
+	transposition_store(table, 1UL << 40, 1);
+	transposition_store(table, 2UL << 40, 2);
+	transposition_store(table, 3UL << 40, 3);
+	PRINT_TEST_RESULT(transposition_lookup(table, 1UL << 40, &a) == TRUE && transposition_lookup(table, 2UL << 40, &b) == TRUE &&
+					  transposition_lookup(table, 3UL << 40, &c) == TRUE && a == 1 && b == 2 && c == 3 && transposition_lookup(table, 4UL << 40, NULL) == FALSE);
+	transposition_destroy(table);
+}
+
+void test1_transposition_clear()
+{
+	Transpositions *table = transposition_create(4);
+
+	transposition_store(table, 42, 1);
+	PRINT_TEST_RESULT(transposition_clear(table) == OK && transposition_get_count(table) == 0 && transposition_lookup(table, 42, NULL) == FALSE &&
+					  transposition_store(table, 42, 2) == OK && transposition_get_count(table) == 1);
+	transposition_destroy(table);
+}
@@ -0,0 +1,577 @@
+/**
+ * @brief It implements the resolution of the commands of a turn
+ *
+ * @file turns.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "turns.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "character.h"
+#include "game_actions.h"
+#include "player.h"
+#include "snapshot.h"
+
+/**
+ * @brief The command moves followers from one space to another, walking the party of its player
+ */
+#define TURNS_MOVES_CHARACTERS 2
+
+/**
+ * @brief The command scans the location of every object
+ */
+#define TURNS_READS_OBJECTS 4
+
+/**
+ * @brief The command changes the location of an object
+ */
+#define TURNS_MOVES_OBJECTS 8
+
+/**
+ * @brief The command draws random numbers, whose order must be kept
+ */
+#define TURNS_USES_RAND 16
+
+/**
+ * @brief The command reads data of the whole game, so it conflicts with every other one
+ */
+#define TURNS_GLOBAL 32
+
+/**
+ * @brief The command takes a character out of a party, which can be another player's
+ */
+#define TURNS_CHANGES_PARTIES 64
+
+/**
+ * @brief What a queued command can touch
+ */
+typedef struct
+{
+	int player;		   /*!< Position of the player */
+	Command *command;  /*!< The command */
+	int flags;		   /*!< TURNS_* flags of the command */
+	Id *spaces;		   /*!< Spaces the command can touch */
+	int n_spaces;	   /*!< Number of spaces */
+	int parent;		   /*!< Parent in the union-find of the groups */
+	int group;		   /*!< Group of the command, set before the threads start */
+	Game *shadow;	   /*!< Shadow of the game where the command runs */
+	Snapshot *undo;	   /*!< State before the command, taken in its shadow if it can change it */
+	unsigned int seed; /*!< Seed given to srand() before the command, 0 if none */
+} TurnEntry;
+
+/**
+ * @brief Groups shared by the threads of a turn
+ */
+typedef struct
+{
+	TurnEntry *entries;	  /*!< Every command of the turn */
+	int n;				  /*!< Number of commands */
+	int *roots;			  /*!< Root entry of each group */
+	int n_groups;		  /*!< Number of groups */
+	int next;			  /*!< Next group to run */
+	pthread_mutex_t lock; /*!< Protects next */
+} TurnWork;
+
+/**
+ * @brief Adds a space to the footprint of a command if it is not there
+ *
+ * @return OK if it was added or was there, ERROR if there was no memory
+ */
+static Status turns_add_space(TurnEntry *entry, int *max, Id id)
+{
+	Id *spaces = NULL;
+	int i;
+
+	for (i = 0; i < entry->n_spaces; i++)
+	{
+		if (entry->spaces[i] == id)
+		{
+			return OK;
+		}
+	}
+
+	if (entry->n_spaces == *max)
+	{
+		if (!(spaces = (Id *)realloc(entry->spaces, (*max * 2 + 8) * sizeof(Id))))
+		{
+			return ERROR;
+		}
+		entry->spaces = spaces;
+		*max = *max * 2 + 8;
+	}
+
+	entry->spaces[entry->n_spaces++] = id;
+	return OK;
+}
+
+/**
+ * @brief Finds the spaces a command can touch
+ *
+ * They are the spaces within radius moves of the player, where radius is one
+ * more than the moves that the player queued before this command.
+ *
+ * @return OK if the footprint was found, ERROR if there was no memory
+ */
+static Status turns_footprint(Game *game, TurnEntry *entry, int radius)
+{
+	int max = 0, first = 0, last, i, r;
+	Direction dir;
+	Id next;
+
+	entry->spaces = NULL;
+	entry->n_spaces = 0;
+	if (turns_add_space(entry, &max, player_get_location(game_get_player_at(game, entry->player))) == ERROR)
+	{
+		return ERROR;
+	}
+
+	/* Breadth-first by rings, the links do not change while the turn is resolved */
+	for (r = 0; r < radius; r++)
+	{
+		last = entry->n_spaces;
+		for (i = first; i < last; i++)
+		{
+			for (dir = N; dir <= W; dir++)
+			{
+				if ((next = game_get_connection(game, entry->spaces[i], dir)) != NO_ID && turns_add_space(entry, &max, next) == ERROR)
+				{
+					return ERROR;
+				}
+			}
+		}
+		first = last;
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Whether a character follows a player
+ */
+static Bool turns_has_followers(Game *game, int player)
+{
+	return player_get_followers(game_get_player_at(game, player)) != NULL ? TRUE : FALSE;
+}
+
+/**
+ * @brief Finds what a command touches besides its spaces
+ *
+ * @param game A pointer to the game
+ * @param entries The commands of the turn
+ * @param k The position of the command
+ * @return The TURNS_* flags of the command
+ */
+static int turns_flags(Game *game, TurnEntry *entries, int k)
+{
+	int i;
+
+	switch (command_get_code(entries[k].command))
+	{
+	case MOVE:
+		/* A RECRUIT queued before by the same player can give it followers */
+		for (i = 0; i < k; i++)
+		{
+			if (entries[i].player == entries[k].player && command_get_code(entries[i].command) == RECRUIT)
+			{
+				return TURNS_MOVES_CHARACTERS;
+			}
+		}
+		return turns_has_followers(game, entries[k].player) == TRUE ? TURNS_MOVES_CHARACTERS : 0;
+
+	case ATTACK:
+		return TURNS_USES_RAND;
+
+	case RECRUIT:
+	case ABANDON:
+		return TURNS_CHANGES_PARTIES;
+
+	case TAKE:
+	case DROP:
+		return TURNS_READS_OBJECTS | TURNS_MOVES_OBJECTS;
+
+	case INSPECT:
+		return TURNS_READS_OBJECTS;
+
+	case STATS:
+	case UNDO:
+		return TURNS_GLOBAL;
+
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Whether two commands can change what the other one reads
+ */
+static Bool turns_conflict(TurnEntry *a, TurnEntry *b)
+{
+	int i, j;
+
+	if (a->player == b->player || ((a->flags | b->flags) & TURNS_GLOBAL) ||
+		((a->flags & TURNS_CHANGES_PARTIES) && (b->flags & (TURNS_CHANGES_PARTIES | TURNS_MOVES_CHARACTERS))) ||
+		((b->flags & TURNS_CHANGES_PARTIES) && (a->flags & TURNS_MOVES_CHARACTERS)) ||
+		((a->flags & TURNS_MOVES_OBJECTS) && (b->flags & TURNS_READS_OBJECTS)) ||
+		((b->flags & TURNS_MOVES_OBJECTS) && (a->flags & TURNS_READS_OBJECTS)) ||
+		((a->flags & TURNS_USES_RAND) && (b->flags & TURNS_USES_RAND)))
+	{
+		return TRUE;
+	}
+
+	for (i = 0; i < a->n_spaces; i++)
+	{
+		for (j = 0; j < b->n_spaces; j++)
+		{
+			if (a->spaces[i] == b->spaces[j])
+			{
+				return TRUE;
+			}
+		}
+	}
+
+	return FALSE;
+}
+
+/**
+ * @brief Finds the root of the group of a command
+ */
+static int turns_find(TurnEntry *entries, int k)
+{
+	while (entries[k].parent != k)
+	{
+		entries[k].parent = entries[entries[k].parent].parent;
+		k = entries[k].parent;
+	}
+
+	return k;
+}
+
+/**
+ * @brief Builds the groups of the commands of a turn
+ *
+ * The root of every group is its first command.
+ *
+ * @return The number of groups, -1 if there was an error
+ */
+static int turns_group(Game *game, TurnEntry *entries, int n)
+{
+	int i, j, a, b, radius, n_groups = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		entries[i].flags = turns_flags(game, entries, i);
+		for (j = 0, radius = 1; j < i; j++)
+		{
+			if (entries[j].player == entries[i].player && command_get_code(entries[j].command) == MOVE)
+			{
+				radius++;
+			}
+		}
+		if (turns_footprint(game, &entries[i], radius) == ERROR)
+		{
+			return -1;
+		}
+		entries[i].parent = i;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		for (j = i + 1; j < n; j++)
+		{
+			a = turns_find(entries, i);
+			b = turns_find(entries, j);
+			if (a != b && turns_conflict(&entries[i], &entries[j]) == TRUE)
+			{
+				/* The smaller root stays, so every group keeps its first command as root */
+				entries[a > b ? a : b].parent = a < b ? a : b;
+			}
+		}
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		if (turns_find(entries, i) == i)
+		{
+			n_groups++;
+		}
+	}
+
+	return n_groups;
+}
+
+/**
+ * @brief Creates the entries of a turn
+ *
+ * @return The entries, NULL if the arguments are not valid or there was no memory
+ */
+static TurnEntry *turns_create_entries(Game *game, int *players, Command **commands, int n)
+{
+	TurnEntry *entries = NULL;
+	int i;
+
+	if (!game || !players || !commands || n <= 0 || !(entries = (TurnEntry *)calloc(n, sizeof(TurnEntry))))
+	{
+		return NULL;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		if (players[i] < 0 || players[i] >= game_get_n_players(game) || !commands[i])
+		{
+			free(entries);
+			return NULL;
+		}
+		entries[i].player = players[i];
+		entries[i].command = commands[i];
+	}
+
+	return entries;
+}
+
+/**
+ * @brief Frees the entries of a turn
+ */
+static void turns_destroy_entries(TurnEntry *entries, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		free(entries[i].spaces);
+		snapshot_destroy(entries[i].undo);
+	}
+	free(entries);
+}
+
+/**
+ * @brief Whether the commands that can change the state are all in one group
+ *
+ * The other groups then only read the game, so the state a shadow saves
+ * before each of its commands is the one the command would find in serial
+ * order, and it can be undone as if the turn had run in order.
+ */
+static Bool turns_undo_in_one_group(TurnEntry *entries, int n)
+{
+	int i, group = -1;
+
+	for (i = 0; i < n; i++)
+	{
+		if (game_actions_changes_state(command_get_code(entries[i].command)) == TRUE)
+		{
+			if (group >= 0 && entries[i].group != group)
+			{
+				return FALSE;
+			}
+			group = entries[i].group;
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+ * @brief Gets the number of the group of a command
+ *
+ * @param entries The commands of the turn
+ * @param roots The first command of each group, in queued order
+ * @param n_groups The number of groups
+ * @param k The position of the command
+ * @return The position of its root in roots
+ */
+static int turns_group_of(TurnEntry *entries, int *roots, int n_groups, int k)
+{
+	int root = turns_find(entries, k), g;
+
+	for (g = 0; g < n_groups && roots[g] != root; g++)
+		;
+
+	return g;
+}
+
+int turns_plan(Game *game, int *players, Command **commands, int n, int *groups)
+{
+	TurnEntry *entries = NULL;
+	int *roots = NULL;
+	int n_groups, i;
+
+	if (!groups || !(entries = turns_create_entries(game, players, commands, n)))
+	{
+		return -1;
+	}
+
+	if ((n_groups = turns_group(game, entries, n)) >= 0 && (roots = (int *)malloc(n * sizeof(int))) != NULL)
+	{
+		for (i = 0, n_groups = 0; i < n; i++)
+		{
+			if (turns_find(entries, i) == i)
+			{
+				roots[n_groups++] = i;
+			}
+		}
+		for (i = 0; i < n; i++)
+		{
+			groups[i] = turns_group_of(entries, roots, n_groups, i);
+		}
+		free(roots);
+	}
+	else
+	{
+		n_groups = -1;
+	}
+
+	turns_destroy_entries(entries, n);
+	return n_groups;
+}
+
+/**
+ * @brief Runs groups of commands until there are none left
+ *
+ * @param arg The TurnWork of the turn
+ * @return NULL
+ */
+static void *turns_worker(void *arg)
+{
+	TurnWork *work = (TurnWork *)arg;
+	int g, i;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&work->lock);
+		g = work->next++;
+		pthread_mutex_unlock(&work->lock);
+		if (g >= work->n_groups)
+		{
+			return NULL;
+		}
+
+		/* The commands of a group run in their queued order, and the state before each one that can change it is saved */
+		for (i = work->roots[g]; i < work->n; i++)
+		{
+			if (work->entries[i].group == g)
+			{
+				if (game_actions_changes_state(command_get_code(work->entries[i].command)) == TRUE)
+				{
+					work->entries[i].undo = snapshot_create(work->entries[i].shadow);
+				}
+				/* The commands that draw random numbers are all in this group, the others never see the seed */
+				if (work->entries[i].seed != 0 && (work->entries[i].flags & TURNS_USES_RAND))
+				{
+					srand(work->entries[i].seed);
+				}
+				game_actions_update(work->entries[i].shadow, work->entries[i].command);
+			}
+		}
+	}
+}
+
+Status turns_resolve(Game *game, int *players, Command **commands, int n, unsigned int *seeds, int n_threads)
+{
+	pthread_t threads[TURNS_MAX_THREADS];
+	TurnWork work;
+	TurnEntry *entries = NULL;
+	int i, n_started = 0;
+
+	if (!(entries = turns_create_entries(game, players, commands, n)))
+	{
+		return ERROR;
+	}
+	for (i = 0; seeds && i < n; i++)
+	{
+		entries[i].seed = seeds[i];
+	}
+
+	if (n_threads > TURNS_MAX_THREADS)
+	{
+		n_threads = TURNS_MAX_THREADS;
+	}
+
+	memset(&work, 0, sizeof(TurnWork));
+	work.entries = entries;
+	work.n = n;
+	if (n_threads > 1 && game_get_regions(game) == NULL && (work.n_groups = turns_group(game, entries, n)) > 1 &&
+		(work.roots = (int *)malloc(work.n_groups * sizeof(int))) != NULL)
+	{
+		for (i = 0, work.n_groups = 0; i < n; i++)
+		{
+			if (turns_find(entries, i) == i)
+			{
+				work.roots[work.n_groups++] = i;
+			}
+		}
+		for (i = 0; i < n; i++)
+		{
+			entries[i].group = turns_group_of(entries, work.roots, work.n_groups, i);
+		}
+		/* Changes in several groups would be saved mixed with each other, so that turn runs in order */
+		i = turns_undo_in_one_group(entries, n) == TRUE ? 0 : -1;
+		for (; i >= 0 && i < n && (entries[i].shadow = game_create_shadow(game, entries[i].player)) != NULL; i++)
+			;
+
+		if (i == n && pthread_mutex_init(&work.lock, NULL) == 0)
+		{
+			for (n_started = 0; n_started < n_threads && n_started < work.n_groups; n_started++)
+			{
+				if (pthread_create(&threads[n_started], NULL, turns_worker, &work) != 0)
+				{
+					break;
+				}
+			}
+			/* Groups left by threads that could not start are run here */
+			turns_worker(&work);
+			for (i = 0; i < n_started; i++)
+			{
+				pthread_join(threads[i], NULL);
+			}
+			pthread_mutex_destroy(&work.lock);
+
+			/* Feedback, events and the states to undo are taken in queued order, so the last command that set the feedback wins,
+			   and the states are saved and dropped as game_actions_update does, even the oldest one a failed command forgets */
+			for (i = 0; i < n; i++)
+			{
+				/* A shadow only holds the changes to the hash made in it, those before are the ones merged so far */
+				snapshot_set_hash(entries[i].undo, game_get_hash(game));
+				game_merge_shadow(game, entries[i].shadow);
+				entries[i].shadow = NULL;
+				if (entries[i].undo && game_push_undo(game, entries[i].undo) == OK && command_get_status(entries[i].command) == ERROR)
+				{
+					game_drop_undo(game);
+				}
+				entries[i].undo = NULL;
+			}
+
+			free(work.roots);
+			turns_destroy_entries(entries, n);
+			return OK;
+		}
+
+		/* Nothing ran in the shadows, merging them only frees them */
+		for (i = 0; i < n; i++)
+		{
+			game_merge_shadow(game, entries[i].shadow);
+			entries[i].shadow = NULL;
+		}
+	}
+	free(work.roots);
+
+	/* A single group, or a game that cannot be shared, runs in order here */
+	for (i = 0; i < n; i++)
+	{
+		game_set_turn(game, entries[i].player);
+		if (entries[i].seed != 0)
+		{
+			srand(entries[i].seed);
+		}
+		game_actions_update(game, entries[i].command);
+	}
+
+	turns_destroy_entries(entries, n);
+	return OK;
+}
@@ -0,0 +1,721 @@
+/**
+ * @brief It tests the resolution of the commands of a turn
+ *
+ * @file turns_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "turns.h"
+#include "game_actions.h"
+#include "game_reader.h"
+#include "record.h"
+#include "test.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 9
+
+/**
+ * @brief Width and height of the grid of the test world
+ */
+#define GRID 12
+
+/**
+ * @brief Number of rounds of the replay
+ */
+#define ROUNDS 400
+
+/**
+ * @brief Maximum number of commands of a round, some players queue two
+ */
+#define ROUND_MAX (2 * MAX_PLAYERS)
+
+/**
+ * @brief Seed of the random numbers of the replay
+ */
+#define SEED 4242
+
+/**
+ * @brief Column and row of the start of each player
+ */
+static const int starts[MAX_PLAYERS][2] = {{1, 1}, {10, 1}, {1, 10}, {10, 10}, {5, 1}, {1, 5}, {10, 6}, {6, 10}};
+
+/**
+ * @brief Commands the replay picks from, moves are repeated to be more frequent
+ */
+static char *script_commands[] = {"m n", "m s", "m e", "m w", "m n", "m s", "m e", "m w", "t leaf", "t seed", "d leaf", "d seed", "a", "c ant", "r ant", "ab ant", "i leaf", "st", "u"};
+
+/**
+ * @brief Test that players far from each other are in different groups.
+ */
+void test1_turns_plan();
+
+/**
+ * @brief Test that players in neighbouring spaces are in the same group.
+ */
+void test2_turns_plan();
+
+/**
+ * @brief Test that attacks are in the same group, they share the random numbers.
+ */
+void test3_turns_plan();
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test4_turns_plan();
+
+/**
+ * @brief Test that a replay gives the same game in parallel and in serial order.
+ */
+void test1_turns_resolve();
+
+/**
+ * @brief Test that a replay with a single thread gives the same game.
+ */
+void test2_turns_resolve();
+
+/**
+ * @brief Test that invalid arguments are rejected.
+ */
+void test3_turns_resolve();
+
+/**
+ * @brief Test that an undo after a parallel round undoes the same command as in serial order.
+ */
+void test4_turns_resolve();
+
+/**
+ * @brief Test that commands given their own seeds draw the same random numbers as in serial order.
+ */
+void test5_turns_resolve();
+
+/**
+ * @brief Main function for turns unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Turns:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_turns_plan();
+	if (all || test == 2)
+		test2_turns_plan();
+	if (all || test == 3)
+		test3_turns_plan();
+	if (all || test == 4)
+		test4_turns_plan();
+	if (all || test == 5)
+		test1_turns_resolve();
+	if (all || test == 6)
+		test2_turns_resolve();
+	if (all || test == 7)
+		test3_turns_resolve();
+	if (all || test == 8)
+		test4_turns_resolve();
+	if (all || test == 9)
+		test5_turns_resolve();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief It parses a record of the test world and adds it to the game
+ *
+ * @param game A pointer to the game
+ * @param text The record
+ * @return OK if it was added, ERROR otherwise
+ */
+static Status world_add(Game *game, char *text)
+{
+	Record *record = NULL;
+	Space *space = NULL;
+	Link *link = NULL;
+	Player *player = NULL;
+	Object *object = NULL;
+	Character *character = NULL;
+	Status status = ERROR;
+	char *tags[] = {"#s:", "#l:", "#p:", "#o:", "#c:"};
+	int which = -1;
+	Id location;
+
+	if (!(record = record_open_text("turns_test", text)) || record_next_of(record, tags, 5, &which) <= 0)
+	{
+		record_close(record);
+		return ERROR;
+	}
+
+	switch (which)
+	{
+	case 0:
+		status = game_reader_parse_space(record, &space) == OK ? game_add_space(game, space) : ERROR;
+		break;
+	case 1:
+		status = game_reader_parse_link(record, &link) == OK ? game_add_link(game, link) : ERROR;
+		break;
+	case 2:
+		if (game_reader_parse_player(record, &player, &location) == OK)
+		{
+			space_set_discovered(game_get_space(game, location), TRUE);
+			status = game_add_player(game, player);
+		}
+		break;
+	case 3:
+		status = game_reader_parse_object(record, &object) == OK ? game_add_objects(game, object) : ERROR;
+		break;
+	default:
+		status = game_reader_parse_character(record, &character, &location) == OK ? game_add_character(game, character, location) : ERROR;
+		break;
+	}
+
+	record_close(record);
+	return status;
+}
+
+/**
+ * @brief It creates a grid of spaces with a player in each start, and objects and characters near them
+ *
+ * @return A new game, NULL if there was an error
+ */
+static Game *world_create()
+{
+	Game *game = NULL;
+	char text[WORD_SIZE];
+	int x, y, i;
+	Id id, link = 1000;
+
+	if (game_create(&game) == ERROR)
+	{
+		return NULL;
+	}
+
+	for (id = 1; id <= GRID * GRID; id++)
+	{
+		sprintf(text, "#s:%ld|Cell %ld|", id, id);
+		world_add(game, text);
+	}
+
+	/* Links both ways to the east and to the south, some of them closed */
+	for (y = 0; y < GRID; y++)
+	{
+		for (x = 0; x < GRID; x++)
+		{
+			id = 1 + y * GRID + x;
+			if (x < GRID - 1)
+			{
+				sprintf(text, "#l:%ld|East|%ld|%ld|%d|%d|", link++, id, id + 1, E, (id % 9 != 0));
+				world_add(game, text);
+				sprintf(text, "#l:%ld|West|%ld|%ld|%d|%d|", link++, id + 1, id, W, (id % 9 != 0));
+				world_add(game, text);
+			}
+			if (y < GRID - 1)
+			{
+				sprintf(text, "#l:%ld|South|%ld|%ld|%d|1|", link++, id, id + GRID, S);
+				world_add(game, text);
+				sprintf(text, "#l:%ld|North|%ld|%ld|%d|1|", link++, id + GRID, id, N);
+				world_add(game, text);
+			}
+		}
+	}
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		id = 1 + starts[i][1] * GRID + starts[i][0];
+		sprintf(text, "#p:%d|Ant %d|^A>|%ld|20|3|", i + 1, i + 1, id);
+		world_add(game, text);
+		sprintf(text, "#o:%d|leaf|%ld|", 100 + 2 * i, id);
+		world_add(game, text);
+		sprintf(text, "#o:%d|seed|%ld|", 101 + 2 * i, id + 1);
+		world_add(game, text);
+		sprintf(text, "#c:%d|ant|^a|%ld|5|1|Hello|", 200 + 2 * i, id);
+		world_add(game, text);
+		sprintf(text, "#c:%d|spider|/\\|%ld|3|0|", 201 + 2 * i, id + GRID);
+		world_add(game, text);
+	}
+
+	if (game_get_n_players(game) != MAX_PLAYERS || *game_get_n_objects(game) != 2 * MAX_PLAYERS || *game_get_n_characters(game) != 2 * MAX_PLAYERS)
+	{
+		game_destroy(game);
+		return NULL;
+	}
+
+	/* The world was added line by line, its hash is kept from here on */
+	game_set_hash(game, game_compute_hash(game));
+	return game;
+}
+
+/**
+ * @brief It adds a number to a hash
+ */
+static unsigned long hash_add(unsigned long hash, long value)
+{
+	return (hash ^ (unsigned long)value) * 16777619UL;
+}
+
+/**
+ * @brief It hashes a string into a hash
+ */
+static unsigned long hash_add_string(unsigned long hash, const char *s)
+{
+	for (; s && *s; s++)
+	{
+		hash = hash_add(hash, *s);
+	}
+	return hash_add(hash, 0);
+}
+
+/**
+ * @brief It hashes everything the commands can change
+ *
+ * @param game A pointer to the game
+ * @return The hash
+ */
+static unsigned long world_hash(Game *game)
+{
+	Character **characters = game_get_character_array(game);
+	Object **objects = game_get_objects(game);
+	Player *player = NULL;
+	unsigned long hash = 2166136261UL;
+	int i, j, turn = game_get_turn(game);
+
+	for (i = 0; i < game_get_n_players(game); i++)
+	{
+		player = game_get_player_at(game, i);
+		hash = hash_add(hash, player_get_location(player));
+		hash = hash_add(hash, player_get_health(player));
+		for (j = 0; j < *game_get_n_objects(game); j++)
+		{
+			hash = hash_add(hash, player_has_object(player, object_get_id(objects[j])));
+		}
+		game_set_turn(game, i);
+		hash = hash_add_string(hash, game_get_last_message(game));
+	}
+	game_set_turn(game, turn);
+
+	for (i = 0; i < *game_get_n_objects(game); i++)
+	{
+		hash = hash_add(hash, object_get_location(objects[i]));
+	}
+	for (i = 0; i < *game_get_n_characters(game); i++)
+	{
+		hash = hash_add(hash, game_find_character(game, character_get_id(characters[i])));
+		hash = hash_add(hash, character_get_health(characters[i]));
+		hash = hash_add(hash, character_get_following(characters[i]));
+	}
+	for (i = 0; i < *game_get_n_spaces(game); i++)
+	{
+		hash = hash_add(hash, space_is_discovered(game_get_spaces(game)[i]));
+	}
+
+	return hash_add_string(hash, game_get_temporal_feedback(game));
+}
+
+/**
+ * @brief It swaps the last command of every player with the ones given
+ *
+ * The game frees the last commands, while the replay runs its own ones.
+ *
+ * @param game A pointer to the game
+ * @param commands The commands to swap, one for each player
+ */
+static void swap_commands(Game *game, Command **commands)
+{
+	Command *command = NULL;
+	int i, turn = game_get_turn(game);
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		game_set_turn(game, i);
+		command = game_get_last_command(game);
+		game_set_last_command(game, commands[i]);
+		commands[i] = command;
+	}
+	game_set_turn(game, turn);
+}
+
+/**
+ * @brief It writes the commands of a round
+ *
+ * @param players Where the player of each command is stored
+ * @param inputs Where the input of each command is stored
+ * @return The number of commands
+ */
+static int script_round(int *players, char **inputs)
+{
+	int n = 0, i, n_commands = sizeof(script_commands) / sizeof(script_commands[0]);
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		players[n] = i;
+		inputs[n++] = script_commands[rand() % n_commands];
+	}
+	/* A second command of the same player moves it further before the others */
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		if (rand() % 4 == 0)
+		{
+			players[n] = i;
+			inputs[n++] = script_commands[rand() % n_commands];
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Subscriber that adds every event of a batch to a hash
+ *
+ * @param events The events
+ * @param n_events The number of events
+ * @param data A pointer to the hash
+ */
+static void events_hash(const Event *events, int n_events, void *data)
+{
+	unsigned long *hash = (unsigned long *)data;
+	int i;
+
+	for (i = 0; i < n_events; i++)
+	{
+		*hash = hash_add(*hash, events[i].type);
+		*hash = hash_add(*hash, events[i].turn);
+		*hash = hash_add(*hash, events[i].subject);
+		*hash = hash_add(*hash, events[i].from);
+		*hash = hash_add(*hash, events[i].to);
+		*hash = hash_add(*hash, events[i].value);
+	}
+}
+
+/**
+ * @brief It plays the same random script on a game in serial order and with turns_resolve
+ *
+ * @param n_threads The threads given to turns_resolve
+ * @param seeded TRUE to give each command its own seed, FALSE to seed the random numbers once
+ * @param parallel Where the number of rounds with more than one group is stored
+ * @return TRUE if every round gave the same game, with the same Zobrist hash, and the same events in the same order
+ */
+static Bool replay(int n_threads, Bool seeded, int *parallel)
+{
+	Game *serial = NULL, *resolved = NULL;
+	Command *commands[ROUND_MAX], *own_serial[MAX_PLAYERS], *own_resolved[MAX_PLAYERS];
+	char *inputs[ROUNDS][ROUND_MAX], buffer[WORD_SIZE];
+	int players[ROUNDS][ROUND_MAX], n[ROUNDS], groups[ROUND_MAX];
+	unsigned long hashes[ROUNDS], zobrist[ROUNDS], event_hashes[ROUNDS], serial_events = 0, resolved_events = 0;
+	unsigned int seeds[ROUNDS][ROUND_MAX];
+	int undos[ROUNDS];
+	Status statuses[ROUNDS][ROUND_MAX];
+	Bool same = TRUE;
+	int r, i;
+
+	if (!(serial = world_create()) || !(resolved = world_create()))
+	{
+		game_destroy(serial);
+		return FALSE;
+	}
+
+	srand(SEED);
+	for (r = 0; r < ROUNDS; r++)
+	{
+		n[r] = script_round(players[r], inputs[r]);
+		for (i = 0; i < n[r]; i++)
+		{
+			seeds[r][i] = seeded == TRUE ? (unsigned int)rand() + 1 : 0;
+		}
+	}
+	for (i = 0; i < ROUND_MAX; i++)
+	{
+		commands[i] = command_create();
+	}
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		own_serial[i] = own_resolved[i] = NULL;
+	}
+	swap_commands(serial, own_serial);
+	swap_commands(resolved, own_resolved);
+	event_bus_subscribe(game_get_events(serial), EVENT_ALL, events_hash, &serial_events);
+	event_bus_subscribe(game_get_events(resolved), EVENT_ALL, events_hash, &resolved_events);
+
+	/* The attacks of both games see the same random numbers */
+	srand(SEED);
+	for (r = 0; r < ROUNDS; r++)
+	{
+		for (i = 0; i < n[r]; i++)
+		{
+			strcpy(buffer, inputs[r][i]);
+			command_parse_input(commands[i], buffer);
+			game_set_turn(serial, players[r][i]);
+			if (seeds[r][i] != 0)
+			{
+				srand(seeds[r][i]);
+			}
+			statuses[r][i] = game_actions_update(serial, commands[i]);
+		}
+		hashes[r] = world_hash(serial);
+		zobrist[r] = game_get_hash(serial);
+		undos[r] = game_get_n_undo(serial);
+		if (zobrist[r] != game_compute_hash(serial))
+		{
+			same = FALSE;
+		}
+		event_bus_dispatch(game_get_events(serial));
+		event_hashes[r] = serial_events;
+	}
+
+	*parallel = 0;
+	srand(SEED);
+	for (r = 0; r < ROUNDS && same == TRUE; r++)
+	{
+		for (i = 0; i < n[r]; i++)
+		{
+			strcpy(buffer, inputs[r][i]);
+			command_parse_input(commands[i], buffer);
+		}
+		if (turns_plan(resolved, players[r], commands, n[r], groups) > 1)
+		{
+			(*parallel)++;
+		}
+		turns_resolve(resolved, players[r], commands, n[r], seeded == TRUE ? seeds[r] : NULL, n_threads);
+		event_bus_dispatch(game_get_events(resolved));
+		for (i = 0; i < n[r]; i++)
+		{
+			if (command_get_status(commands[i]) != statuses[r][i])
+			{
+				same = FALSE;
+			}
+		}
+		if (world_hash(resolved) != hashes[r] || game_get_hash(resolved) != zobrist[r] || resolved_events != event_hashes[r] ||
+			game_get_turn(resolved) != players[r][n[r] - 1] || game_get_n_undo(resolved) != undos[r])
+		{
+			same = FALSE;
+		}
+	}
+
+	swap_commands(serial, own_serial);
+	swap_commands(resolved, own_resolved);
+	for (i = 0; i < ROUND_MAX; i++)
+	{
+		command_destroy(commands[i]);
+	}
+	game_destroy(serial);
+	game_destroy(resolved);
+	return same;
+}
+
+/**
+ * @brief It plays a round of commands given as text with turns_resolve
+ *
+ * @param game A pointer to the game
+ * @param n The number of commands
+ * @param players The position of the player of each command
+ * @param inputs The commands
+ * @param n_threads The threads given to turns_resolve
+ * @return The number of groups of the round
+ */
+static int resolve_round(Game *game, int n, int *players, char **inputs, int n_threads)
+{
+	Command *commands[ROUND_MAX], *own[MAX_PLAYERS];
+	char buffer[WORD_SIZE];
+	int groups[ROUND_MAX], n_groups, i;
+
+	for (i = 0; i < MAX_PLAYERS; i++)
+	{
+		own[i] = NULL;
+	}
+	swap_commands(game, own);
+	for (i = 0; i < n; i++)
+	{
+		commands[i] = command_create();
+		strcpy(buffer, inputs[i]);
+		command_parse_input(commands[i], buffer);
+	}
+	n_groups = turns_plan(game, players, commands, n, groups);
+	turns_resolve(game, players, commands, n, NULL, n_threads);
+	/* The game gets its own commands back before these are freed */
+	swap_commands(game, own);
+	for (i = 0; i < n; i++)
+	{
+		command_destroy(commands[i]);
+	}
+
+	return n_groups;
+}
+
+/**
+ * @brief It plans a round where every player moves
+ *
+ * @param game A pointer to the game
+ * @param n The number of players that move
+ * @param input The command of every player
+ * @param groups Where the groups are stored
+ * @return The number of groups
+ */
+static int plan_all(Game *game, int n, char *input, int *groups)
+{
+	Command *commands[MAX_PLAYERS];
+	char buffer[WORD_SIZE];
+	int players[MAX_PLAYERS], i, n_groups;
+
+	for (i = 0; i < n; i++)
+	{
+		players[i] = i;
+		commands[i] = command_create();
+		strcpy(buffer, input);
+		command_parse_input(commands[i], buffer);
+	}
+	n_groups = turns_plan(game, players, commands, n, groups);
+	for (i = 0; i < n; i++)
+	{
+		command_destroy(commands[i]);
+	}
+
+	return n_groups;
+}
+
+void test1_turns_plan()
+{
+	Game *game = world_create();
+	int groups[MAX_PLAYERS];
+
+	/* The first four players are in the corners */
+	PRINT_TEST_RESULT(game && plan_all(game, 4, "m e", groups) == 4 && groups[0] == 0 && groups[3] == 3);
+	game_destroy(game);
+}
+
+void test2_turns_plan()
+{
+	Game *game = world_create();
+	int groups[MAX_PLAYERS];
+
+	/* The second player is moved next to the first one */
+	if (game)
+	{
+		player_set_location(game_get_player_at(game, 1), 1 + 1 * GRID + 2);
+	}
+	PRINT_TEST_RESULT(game && plan_all(game, 4, "m e", groups) == 3 && groups[0] == groups[1] && groups[2] == 1);
+	game_destroy(game);
+}
+
+void test3_turns_plan()
+{
+	Game *game = world_create();
+	int groups[MAX_PLAYERS];
+
+	PRINT_TEST_RESULT(game && plan_all(game, 4, "a", groups) == 1 && groups[3] == 0);
+	game_destroy(game);
+}
+
+void test4_turns_plan()
+{
+	Game *game = world_create();
+	Command *command = command_create();
+	int player = 0, groups[1];
+
+	PRINT_TEST_RESULT(turns_plan(NULL, &player, &command, 1, groups) == -1 && turns_plan(game, NULL, &command, 1, groups) == -1 &&
+					  turns_plan(game, &player, &command, 1, NULL) == -1 && turns_plan(game, &player, &command, -1, groups) == -1);
+	command_destroy(command);
+	game_destroy(game);
+}
+
+void test1_turns_resolve()
+{
+	int parallel = 0;
+
+	PRINT_TEST_RESULT(replay(4, FALSE, &parallel) == TRUE && parallel > 0);
+}
+
+void test2_turns_resolve()
+{
+	int parallel = 0;
+
+	PRINT_TEST_RESULT(replay(1, FALSE, &parallel) == TRUE);
+}
+
+/**
+ * @brief It plays two rounds where the first two players move, and an undo
+ *
+ * @param n_threads The threads given to turns_resolve
+ * @param locations Where the location of the first two players are stored
+ * @param undos Where the number of states to undo are stored, before and after the undo
+ * @param hash Where the Zobrist hash after the undo is stored
+ * @return The number of groups of the second round
+ */
+static int undo_rounds(int n_threads, Id *locations, int *undos, unsigned long *hash)
+{
+	Game *game = world_create();
+	int players[2] = {0, 1}, undoer = 1, n_groups;
+	char *both[2] = {"m e", "m e"}, *one[2] = {"m e", "c ant"}, *undo[1] = {"u"};
+
+	resolve_round(game, 2, players, both, n_threads);
+	/* Only the first player changes the game, so the round runs in parallel */
+	n_groups = resolve_round(game, 2, players, one, n_threads);
+	undos[0] = game_get_n_undo(game);
+	resolve_round(game, 1, &undoer, undo, n_threads);
+	undos[1] = game_get_n_undo(game);
+	*hash = game_get_hash(game);
+	locations[0] = player_get_location(game_get_player_at(game, 0));
+	locations[1] = player_get_location(game_get_player_at(game, 1));
+	game_destroy(game);
+	return n_groups;
+}
+
+void test3_turns_resolve()
+{
+	Game *game = world_create();
+	Command *command = command_create();
+	int player = 0;
+
+	PRINT_TEST_RESULT(turns_resolve(NULL, &player, &command, 1, NULL, 2) == ERROR && turns_resolve(game, NULL, &command, 1, NULL, 2) == ERROR &&
+					  turns_resolve(game, &player, NULL, 1, NULL, 2) == ERROR);
+	command_destroy(command);
+	game_destroy(game);
+}
+
+void test4_turns_resolve()
+{
+	Id serial[2], parallel[2];
+	int serial_undos[2], parallel_undos[2], n_groups;
+	unsigned long hashes[2];
+
+	undo_rounds(1, serial, serial_undos, &hashes[0]);
+	n_groups = undo_rounds(4, parallel, parallel_undos, &hashes[1]);
+	PRINT_TEST_RESULT(n_groups == 2 && serial[0] == 15 && serial[1] == 24 && parallel[0] == serial[0] && parallel[1] == serial[1] &&
+					  serial_undos[0] == 3 && serial_undos[1] == 2 && parallel_undos[0] == 3 && parallel_undos[1] == 2 && hashes[1] == hashes[0]);
+}
+
+void test5_turns_resolve()
+{
+	int parallel = 0;
+
+	PRINT_TEST_RESULT(replay(4, TRUE, &parallel) == TRUE && parallel > 0);
+}
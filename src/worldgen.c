@@ -0,0 +1,464 @@
+/**
+ * @brief Synthetic world generator
+ *
+ * Writes a world data file with the same #s:, #l:, #o:, #c: and #p: records
+ * the loaders read, with a configurable size and shape, so that the engine
+ * can be measured on maps much bigger than anthill.dat. The same seed always
+ * gives the same world.
+ *
+ * @file worldgen.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "types.h"
+
+/**
+ * @brief Number of directions a space can be linked in
+ */
+#define WG_DIRS 4
+
+/**
+ * @brief Number of different graphic description rows
+ */
+#define WG_N_ROWS 8
+
+/**
+ * @brief Grid or random topology
+ */
+typedef enum
+{
+	WG_GRID,  /*!< Spaces in a square grid, linked to their neighbours */
+	WG_RANDOM /*!< Random spanning tree plus random extra links */
+} WgTopology;
+
+/**
+ * @brief Options of the generator
+ */
+typedef struct
+{
+	long n_spaces;		 /*!< Number of spaces */
+	WgTopology topology; /*!< Shape of the map */
+	double density;		 /*!< Fraction of the possible links that are created */
+	long n_objects;		 /*!< Number of objects */
+	long n_characters;	 /*!< Number of characters */
+	int n_players;		 /*!< Number of players */
+	double closed;		 /*!< Fraction of the doors that start closed */
+	unsigned long seed;	 /*!< Seed of the random generator */
+	char *output;		 /*!< Output file, NULL for stdout */
+} WgOptions;
+
+/**
+ * @brief Rows used for the graphic descriptions, all 9 characters wide and without the '|' separator
+ */
+static const char *wg_rows[WG_N_ROWS] = {"  _   _  ", " / \\_/ \\ ", "(  o  o )", " \\_____/ ", "  .  .   ", " ~~~~~~~ ", "   [_]   ", " o   0 o "};
+
+/**
+ * @brief State of the random generator
+ */
+static unsigned long wg_state = 1;
+
+/**
+ * @brief Next number of a xorshift generator, so worlds do not depend on the libc rand()
+ *
+ * @return A pseudo-random number
+ */
+static unsigned long wg_rand()
+{
+	wg_state ^= wg_state << 13;
+	wg_state ^= wg_state >> 7;
+	wg_state ^= wg_state << 17;
+	return wg_state;
+}
+
+/**
+ * @brief Pseudo-random number in a range
+ *
+ * @param n The size of the range
+ * @return A number from 0 to n - 1
+ */
+static long wg_rand_below(long n)
+{
+	return n > 0 ? (long)(wg_rand() % (unsigned long)n) : 0;
+}
+
+/**
+ * @brief Pseudo-random number between 0 and 1
+ *
+ * @return A number in [0, 1)
+ */
+static double wg_rand_unit()
+{
+	return (double)(wg_rand() >> 11) / 9007199254740992.0;
+}
+
+/**
+ * @brief Gets the opposite of a direction
+ *
+ * @param dir The direction
+ * @return The opposite direction
+ */
+static Direction wg_opposite(Direction dir)
+{
+	switch (dir)
+	{
+	case N:
+		return S;
+	case S:
+		return N;
+	case E:
+		return W;
+	default:
+		return E;
+	}
+}
+
+/**
+ * @brief Writes the two links of a door, one in each direction
+ *
+ * @param f The output file
+ * @param next_id The id of the next link, updated
+ * @param a The index of the first space
+ * @param b The index of the second space
+ * @param dir The direction from a to b
+ * @param open Whether the door is open
+ */
+static void wg_write_door(FILE *f, long *next_id, long a, long b, Direction dir, Bool open)
+{
+	fprintf(f, "#l:%ld|Space_%ld|%ld|%ld|%d|%d|\n", (*next_id)++, a + 1, a + 1, b + 1, (int)dir, (int)open);
+	fprintf(f, "#l:%ld|Space_%ld|%ld|%ld|%d|%d|\n", (*next_id)++, b + 1, b + 1, a + 1, (int)wg_opposite(dir), (int)open);
+}
+
+/**
+ * @brief Writes the links of a grid world
+ *
+ * @param f The output file
+ * @param opt The options of the generator
+ * @param next_id The id of the next link, updated
+ * @return The number of links written
+ */
+static long wg_grid_links(FILE *f, WgOptions *opt, long *next_id)
+{
+	long width = (long)ceil(sqrt((double)opt->n_spaces));
+	long k, n_links = 0;
+
+	for (k = 0; k < opt->n_spaces; k++)
+	{
+		if ((k + 1) % width != 0 && k + 1 < opt->n_spaces && wg_rand_unit() < opt->density)
+		{
+			wg_write_door(f, next_id, k, k + 1, E, wg_rand_unit() >= opt->closed);
+			n_links += 2;
+		}
+		if (k + width < opt->n_spaces && wg_rand_unit() < opt->density)
+		{
+			wg_write_door(f, next_id, k, k + width, S, wg_rand_unit() >= opt->closed);
+			n_links += 2;
+		}
+	}
+
+	return n_links;
+}
+
+/**
+ * @brief Tries to link two spaces of a random world through free directions
+ *
+ * @param f The output file
+ * @param opt The options of the generator
+ * @param used Bit mask of the directions already used by each space
+ * @param next_id The id of the next link, updated
+ * @param a The index of the first space
+ * @param b The index of the second space
+ * @return TRUE if the door was written, FALSE if the spaces have no free directions in common
+ */
+static Bool wg_try_door(FILE *f, WgOptions *opt, unsigned char *used, long *next_id, long a, long b)
+{
+	int i, first = (int)wg_rand_below(WG_DIRS);
+	Direction dir;
+
+	if (a == b)
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < WG_DIRS; i++)
+	{
+		dir = (Direction)((first + i) % WG_DIRS);
+		if (!(used[a] & (1 << dir)) && !(used[b] & (1 << wg_opposite(dir))))
+		{
+			used[a] |= 1 << dir;
+			used[b] |= 1 << wg_opposite(dir);
+			wg_write_door(f, next_id, a, b, dir, wg_rand_unit() >= opt->closed);
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/**
+ * @brief Writes the links of a random world
+ *
+ * A random spanning tree keeps every space reachable from the first one
+ * (doors aside), then extra doors are added until the density is reached.
+ *
+ * @param f The output file
+ * @param opt The options of the generator
+ * @param next_id The id of the next link, updated
+ * @return The number of links written, -1 if there was not enough memory
+ */
+static long wg_random_links(FILE *f, WgOptions *opt, long *next_id)
+{
+	unsigned char *used = NULL;
+	long *order = NULL;
+	long i, j, tmp, tries, doors = 0, target;
+
+	used = (unsigned char *)calloc(opt->n_spaces, 1);
+	order = (long *)malloc(opt->n_spaces * sizeof(long));
+	if (!used || !order)
+	{
+		free(used);
+		free(order);
+		return -1;
+	}
+
+	/* The first space stays first, it is where the players start */
+	for (i = 0; i < opt->n_spaces; i++)
+	{
+		order[i] = i;
+	}
+	for (i = opt->n_spaces - 1; i > 1; i--)
+	{
+		j = 1 + wg_rand_below(i);
+		tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+
+	for (i = 1; i < opt->n_spaces; i++)
+	{
+		for (tries = 0; tries < 32; tries++)
+		{
+			if (wg_try_door(f, opt, used, next_id, order[wg_rand_below(i)], order[i]) == TRUE)
+			{
+				doors++;
+				break;
+			}
+		}
+	}
+
+	/* Every door fills two of the four directions of a space */
+	target = (long)(opt->density * 2 * opt->n_spaces);
+	for (tries = 0; doors < target && tries < 8 * target; tries++)
+	{
+		if (wg_try_door(f, opt, used, next_id, wg_rand_below(opt->n_spaces), wg_rand_below(opt->n_spaces)) == TRUE)
+		{
+			doors++;
+		}
+	}
+
+	free(used);
+	free(order);
+	return 2 * doors;
+}
+
+/**
+ * @brief Writes the whole world
+ *
+ * @param f The output file
+ * @param opt The options of the generator
+ * @return OK if the world was written, ERROR otherwise
+ */
+static Status wg_write(FILE *f, WgOptions *opt)
+{
+	long k, next_id, n_links;
+	int i;
+
+	wg_state = opt->seed ? opt->seed : 1;
+
+	for (i = 0; i < opt->n_players; i++)
+	{
+		fprintf(f, "#p:%ld|Player_%d|m0^|1|%d|%d|\n", 1L + i, i + 1, 20, 3);
+	}
+
+	next_id = opt->n_players + 1;
+	for (k = 0; k < opt->n_characters; k++)
+	{
+		if (k % 2 == 0)
+		{
+			fprintf(f, "#c:%ld|Ant_%ld|^0m   |%ld|10|1|Hello from ant %ld|\n", next_id++, k, 1 + wg_rand_below(opt->n_spaces), k);
+		}
+		else
+		{
+			fprintf(f, "#c:%ld|Spider_%ld|/\\oo/\\|%ld|10|0|\n", next_id++, k, 1 + wg_rand_below(opt->n_spaces));
+		}
+	}
+
+	for (k = 0; k < opt->n_spaces; k++)
+	{
+		fprintf(f, "#s:%ld|Space_%ld", k + 1, k + 1);
+		for (i = 0; i < 5; i++)
+		{
+			fprintf(f, "|%s", wg_rows[wg_rand_below(WG_N_ROWS)]);
+		}
+		fprintf(f, "|\n");
+	}
+
+	for (k = 0; k < opt->n_objects; k++)
+	{
+		fprintf(f, "#o:%ld|Object_%ld|%ld\n", opt->n_spaces + 1 + k, k, 1 + wg_rand_below(opt->n_spaces));
+	}
+
+	next_id = opt->n_spaces + opt->n_objects + 1;
+	if (opt->topology == WG_GRID)
+	{
+		n_links = wg_grid_links(f, opt, &next_id);
+	}
+	else
+	{
+		n_links = wg_random_links(f, opt, &next_id);
+	}
+
+	if (n_links < 0 || ferror(f))
+	{
+		return ERROR;
+	}
+
+	fprintf(stderr, "worldgen: %ld spaces, %ld links, %ld objects, %ld characters, %d players\n", opt->n_spaces, n_links, opt->n_objects, opt->n_characters, opt->n_players);
+	return OK;
+}
+
+/**
+ * @brief Reads a number option
+ *
+ * @param text The text of the option
+ * @param min The minimum value accepted
+ * @param max The maximum value accepted
+ * @param value Where the number is stored
+ * @return OK if the text is a number within range, ERROR otherwise
+ */
+static Status wg_parse_number(const char *text, double min, double max, double *value)
+{
+	char *end = NULL;
+
+	if (!text)
+	{
+		return ERROR;
+	}
+
+	*value = strtod(text, &end);
+	if (end == text || *end != '\0' || *value < min || *value > max)
+	{
+		return ERROR;
+	}
+
+	return OK;
+}
+
+/**
+ * @brief Prints how to call the generator
+ *
+ * @param name The name of the program
+ */
+static void wg_usage(const char *name)
+{
+	fprintf(stderr, "Use: %s [-n spaces] [-t grid|random] [-d density] [-o objects] [-c characters]\n", name);
+	fprintf(stderr, "       [-p players] [-x closed_ratio] [-s seed] [-f output_file]\n");
+}
+
+/**
+ * @brief Main function of the generator
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return 0 if the world was written, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	WgOptions opt = {100, WG_GRID, 0.8, 10, 5, 1, 0.1, 1, NULL};
+	FILE *f = stdout;
+	double value = 0;
+	Status st = OK;
+	int i;
+
+	for (i = 1; i < argc && st == OK; i += 2)
+	{
+		if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc)
+		{
+			st = ERROR;
+			break;
+		}
+
+		switch (argv[i][1])
+		{
+		case 'n':
+			st = wg_parse_number(argv[i + 1], 1, 2147483647.0, &value);
+			opt.n_spaces = (long)value;
+			break;
+		case 't':
+			opt.topology = strcmp(argv[i + 1], "random") == 0 ? WG_RANDOM : WG_GRID;
+			st = (strcmp(argv[i + 1], "random") == 0 || strcmp(argv[i + 1], "grid") == 0) ? OK : ERROR;
+			break;
+		case 'd':
+			st = wg_parse_number(argv[i + 1], 0, 1, &opt.density);
+			break;
+		case 'o':
+			st = wg_parse_number(argv[i + 1], 0, 2147483647.0, &value);
+			opt.n_objects = (long)value;
+			break;
+		case 'c':
+			st = wg_parse_number(argv[i + 1], 0, 2147483647.0, &value);
+			opt.n_characters = (long)value;
+			break;
+		case 'p':
+			st = wg_parse_number(argv[i + 1], 1, 8, &value);
+			opt.n_players = (int)value;
+			break;
+		case 'x':
+			st = wg_parse_number(argv[i + 1], 0, 1, &opt.closed);
+			break;
+		case 's':
+			st = wg_parse_number(argv[i + 1], 0, 4294967295.0, &value);
+			opt.seed = (unsigned long)value;
+			break;
+		case 'f':
+			opt.output = argv[i + 1];
+			break;
+		default:
+			st = ERROR;
+			break;
+		}
+	}
+
+	if (st == ERROR)
+	{
+		wg_usage(argv[0]);
+		return 1;
+	}
+
+	if (opt.output && !(f = fopen(opt.output, "w")))
+	{
+		fprintf(stderr, "Error: Could not open file %s.\n", opt.output);
+		return 1;
+	}
+
+	st = wg_write(f, &opt);
+
+	if (f != stdout && fclose(f) != 0)
+	{
+		st = ERROR;
+	}
+
+	if (st == ERROR)
+	{
+		fprintf(stderr, "Error while writing the world.\n");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @brief It implements the Zobrist hash of the state of a game
+ *
+ * @file zobrist.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "zobrist.h"
+
+/**
+ * @brief Final mix of splitmix64, every bit of the input changes half the bits of the output
+ */
+static unsigned long zobrist_mix(unsigned long x)
+{
+	x += 0x9E3779B97F4A7C15UL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9UL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBUL;
+	return x ^ (x >> 31);
+}
+
+unsigned long zobrist_key(ZobristKind kind, Id subject, Id value)
+{
+	return zobrist_mix(zobrist_mix(zobrist_mix((unsigned long)kind) ^ (unsigned long)subject) ^ (unsigned long)value);
+}
+
+unsigned long zobrist_change(ZobristKind kind, Id subject, Id old_value, Id new_value)
+{
+	if (old_value == new_value)
+	{
+		return 0;
+	}
+
+	return zobrist_key(kind, subject, old_value) ^ zobrist_key(kind, subject, new_value);
+}
@@ -0,0 +1,245 @@
+/**
+ * @brief It tests the Zobrist hash of the state of a game
+ *
+ * @file zobrist_test.c
+ * @version 1.0
+ * @date 19-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "zobrist.h"
+#include "game.h"
+#include "game_actions.h"
+#include "game_reader.h"
+#include "snapshot.h"
+#include "test.h"
+#include "test_game.h"
+
+/**
+ * @brief Defines maximum number of tests per execution
+ */
+#define MAX_TESTS 8
+
+/**
+ * @brief Test that the keys depend on the kind, the subject and the value.
+ */
+void test1_zobrist_key();
+
+/**
+ * @brief Test that a change is the XOR of both keys, and nothing for the same value.
+ */
+void test1_zobrist_change();
+
+/**
+ * @brief Test that a loaded game has the hash computed from scratch.
+ */
+void test1_game_get_hash();
+
+/**
+ * @brief Test that the hash follows every command, and comes back with the state.
+ */
+void test2_game_get_hash();
+
+/**
+ * @brief Test that the same states reached in different orders have the same hash.
+ */
+void test3_game_get_hash();
+
+/**
+ * @brief Test that the changes made in shadows are added when they are merged.
+ */
+void test4_game_get_hash();
+
+/**
+ * @brief Test that undo puts back the hash.
+ */
+void test5_game_get_hash();
+
+/**
+ * @brief Test that the setters of the game keep the hash.
+ */
+void test1_game_hash_change();
+
+/**
+ * @brief Main function for zobrist unit tests.
+ *
+ * You may execute ALL or a SINGLE test
+ *   1.- No parameter -> ALL test are executed
+ *   2.- A number means a particular test (the one identified by that number)
+ *       is executed
+ *
+ */
+int main(int argc, char **argv)
+{
+
+	int test = 0;
+	int all = 1;
+
+	if (argc < 2)
+	{
+		printf("Running all test for module Zobrist:\n");
+	}
+	else
+	{
+		test = atoi(argv[1]);
+		all = 0;
+		printf("Running test %d:\t", test);
+		if (test < 1 && test > MAX_TESTS)
+		{
+			printf("Error: unknown test %d\t", test);
+			exit(EXIT_SUCCESS);
+		}
+	}
+
+	if (all || test == 1)
+		test1_zobrist_key();
+	if (all || test == 2)
+		test1_zobrist_change();
+	if (all || test == 3)
+		test1_game_get_hash();
+	if (all || test == 4)
+		test2_game_get_hash();
+	if (all || test == 5)
+		test3_game_get_hash();
+	if (all || test == 6)
+		test4_game_get_hash();
+	if (all || test == 7)
+		test5_game_get_hash();
+	if (all || test == 8)
+		test1_game_hash_change();
+
+	PRINT_PASSED_PERCENTAGE;
+
+	return 1;
+}
+
+/**
+ * @brief Whether the kept hash is the one computed from scratch
+ */
+static Bool in_sync(Game *game)
+{
+	return game_get_hash(game) == game_compute_hash(game) ? TRUE : FALSE;
+}
+
+void test1_zobrist_key()
+{
+	unsigned long key = zobrist_key(ZOBRIST_PLAYER_AT, 1, 11);
+
+	PRINT_TEST_RESULT(key == zobrist_key(ZOBRIST_PLAYER_AT, 1, 11) && key != zobrist_key(ZOBRIST_OBJECT_AT, 1, 11) &&
+					  key != zobrist_key(ZOBRIST_PLAYER_AT, 2, 11) && key != zobrist_key(ZOBRIST_PLAYER_AT, 1, 12) &&
+					  zobrist_key(ZOBRIST_PLAYER_AT, 1, 12) != zobrist_key(ZOBRIST_PLAYER_AT, 12, 1) && key != 0);
+}
+
+void test1_zobrist_change()
+{
+	PRINT_TEST_RESULT(zobrist_change(ZOBRIST_LINK_OPEN, 200, TRUE, TRUE) == 0 &&
+					  zobrist_change(ZOBRIST_LINK_OPEN, 200, TRUE, FALSE) == (zobrist_key(ZOBRIST_LINK_OPEN, 200, TRUE) ^ zobrist_key(ZOBRIST_LINK_OPEN, 200, FALSE)));
+}
+
+void test1_game_get_hash()
+{
+	Game *game = test_game_create(), *empty = NULL;
+
+	game_create(&empty);
+	PRINT_TEST_RESULT(game && game_get_hash(game) != 0 && in_sync(game) == TRUE && game_get_hash(NULL) == 0 && game_compute_hash(NULL) == 0 &&
+					  game_get_hash(empty) == game_compute_hash(empty));
+	game_destroy(empty);
+	game_destroy(game);
+}
+
+void test2_game_get_hash()
+{
+	char *script[] = {"t Grain", "m s", "m s", "r Ant", "m e", "ab Ant", "d Grain", "m w", "m n", "a", "c Ant", "i Grain"};
+	Game *game = test_game_create();
+	unsigned long start = game_get_hash(game);
+	Snapshot *snapshot = snapshot_create(game);
+	Bool synced = TRUE;
+	int i;
+
+	for (i = 0; i < (int)(sizeof(script) / sizeof(script[0])); i++)
+	{
+		test_game_play(game, 0, script[i]);
+		test_game_play(game, 1, "a");
+		if (in_sync(game) == FALSE)
+		{
+			synced = FALSE;
+		}
+	}
+	PRINT_TEST_RESULT(synced == TRUE && game_get_hash(game) != start && snapshot_restore(snapshot, game) == OK && game_get_hash(game) == start &&
+					  in_sync(game) == TRUE);
+	snapshot_destroy(snapshot);
+	game_destroy(game);
+}
+
+void test3_game_get_hash()
+{
+	Game *one = test_game_create(), *other = test_game_create();
+
+	test_game_play(one, 0, "t Grain");
+	test_game_play(one, 0, "t Crumb");
+	test_game_play(one, 0, "m s");
+	test_game_play(other, 0, "t Crumb");
+	test_game_play(other, 0, "m s");
+	test_game_play(other, 0, "m n");
+	test_game_play(other, 0, "t Grain");
+	test_game_play(other, 0, "m s");
+	PRINT_TEST_RESULT(game_get_hash(one) == game_get_hash(other) && game_get_hash(one) == game_compute_hash(other));
+	game_destroy(one);
+	game_destroy(other);
+}
+
+void test4_game_get_hash()
+{
+	Game *game = test_game_create(), *first = NULL, *second = NULL;
+	Command *take = NULL, *move = NULL;
+	char buffer[WORD_SIZE];
+
+	/* The commands of the game are used, the shadows share them */
+	game_set_turn(game, 0);
+	take = game_get_last_command(game);
+	strcpy(buffer, "t Grain");
+	command_parse_input(take, buffer);
+	game_set_turn(game, 1);
+	move = game_get_last_command(game);
+	strcpy(buffer, "m n");
+	command_parse_input(move, buffer);
+	first = game_create_shadow(game, 0);
+	second = game_create_shadow(game, 1);
+	game_actions_update(first, take);
+	game_actions_update(second, move);
+	PRINT_TEST_RESULT(game_get_hash(first) != 0 && game_get_hash(second) != 0 && game_merge_shadow(game, second) == OK &&
+					  game_merge_shadow(game, first) == OK && in_sync(game) == TRUE);
+	game_destroy(game);
+}
+
+void test5_game_get_hash()
+{
+	Game *game = test_game_create();
+	unsigned long start = game_get_hash(game);
+
+	test_game_play(game, 0, "m s");
+	test_game_play(game, 0, "m s");
+	PRINT_TEST_RESULT(game_get_hash(game) != start && test_game_play(game, 0, "u") == OK && test_game_play(game, 0, "u") == OK && game_get_hash(game) == start);
+	game_destroy(game);
+}
+
+void test1_game_hash_change()
+{
+	Game *game = test_game_create();
+	unsigned long start = game_get_hash(game);
+	Character *spider = game_get_character_array(game)[0];
+
+	game_set_link_open(game, 123, S, TRUE);
+	game_set_space_discovered(game, 13, TRUE);
+	game_set_character_health(game, spider, 3);
+	game_set_player_health(game, 1, 1);
+	game_change_character_location(game, spider, 13);
+	PRINT_TEST_RESULT(game_get_hash(game) != start && in_sync(game) == TRUE && game_set_link_open(game, 123, S, FALSE) == OK &&
+					  game_set_space_discovered(game, 13, FALSE) == OK && game_set_character_health(game, spider, 10) == OK &&
+					  game_set_player_health(game, 1, 5) == OK && game_change_character_location(game, spider, 123) == OK && game_get_hash(game) == start &&
+					  game_hash_change(NULL, ZOBRIST_PLAYER_AT, 1, 11, 12) == ERROR);
+	game_destroy(game);
+}